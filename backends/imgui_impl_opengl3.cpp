@@ -6,6 +6,10 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID!
 //  [x] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset) [Desktop OpenGL only!]
+//  [x] Renderer: Instanced rectangles (ImGuiBackendFlags_RendererHasRectInstances) [Desktop OpenGL 3.3+ and OpenGL ES 3.0+ only!]
+//  [x] Renderer: Signed distance rounded rectangles, circles and ellipses (ImGuiBackendFlags_RendererHasSdfShapes) [Desktop OpenGL 3.3+ and OpenGL ES 3.0+ only!]
+//  [X] Renderer: Partial font texture updates (ImGuiBackendFlags_RendererHasTexUpdates), for ImFontAtlasFlags_DynamicGlyphs and ImFontAtlasFlags_IncrementalBuild.
+//  [x] Renderer: Signed distance field font atlas (ImGuiBackendFlags_RendererHasSdfFonts), for ImFontAtlasFlags_SignedDistanceField. [GLSL 1.30+ and GLSL ES 3.00+ only!]
 
 // About WebGL/ES:
 // - You need to '#define IMGUI_IMPL_OPENGL_ES2' or '#define IMGUI_IMPL_OPENGL_ES3' to use WebGL or OpenGL ES.
@@ -22,6 +26,12 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2025-02-26: OpenGL: Recreate font texture storage when its height changed (ImFontAtlasFlags_IncrementalBuild).
+//  2025-02-25: OpenGL: Added support for ImGuiBackendFlags_RendererHasSdfFonts: threshold the font texture alpha with screen-space derivatives when the atlas uses ImFontAtlasFlags_SignedDistanceField.
+//  2025-02-24: OpenGL: Added support for ImGuiBackendFlags_RendererHasTexUpdates: upload font texture lines modified by glyphs loaded on demand (ImFontAtlasFlags_DynamicGlyphs).
+//  2025-02-23: OpenGL: Added support for IMGUI_USE_COMPACT_DRAWVERT (12 bytes vertices with 16-bit fixed-point positions and 16-bit normalized UVs).
+//  2025-02-21: OpenGL: Added support for ImGuiBackendFlags_RendererHasSdfShapes: rounded rectangles (per-corner), strokes and ellipses evaluated as signed distances.
+//  2025-02-20: OpenGL: Added support for ImGuiBackendFlags_RendererHasRectInstances: expand ImDrawRectInstance on the GPU with glDrawArraysInstanced() on GL 3.3+/ES 3.0+.
 //  2024-10-07: OpenGL: Changed default texture sampler to Clamp instead of Repeat/Wrap.
 //  2024-06-28: OpenGL: ImGui_ImplOpenGL3_NewFrame() recreates font texture if it has been destroyed by ImGui_ImplOpenGL3_DestroyFontsTexture(). (#7748)
 //  2024-05-07: OpenGL: Update loader for Linux to support EGL/GLVND. (#7562)
@@ -210,6 +220,23 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 3.3+ and GL ES 3.0+ have glVertexAttribDivisor() and glDrawArraysInstanced()
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && (defined(IMGUI_IMPL_OPENGL_ES3) || defined(GL_VERSION_3_3))
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+#endif
+
+// Vertex attribute formats for ImDrawVert.
+// With IMGUI_USE_COMPACT_DRAWVERT, positions are 16-bit fixed-point (the scale is folded into our projection matrix) and UVs are 16-bit normalized.
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#define IMGUI_IMPL_OPENGL_VTX_POS_TYPE          GL_SHORT
+#define IMGUI_IMPL_OPENGL_VTX_UV_TYPE           GL_UNSIGNED_SHORT
+#define IMGUI_IMPL_OPENGL_VTX_UV_NORMALIZED     GL_TRUE
+#else
+#define IMGUI_IMPL_OPENGL_VTX_POS_TYPE          GL_FLOAT
+#define IMGUI_IMPL_OPENGL_VTX_UV_TYPE           GL_FLOAT
+#define IMGUI_IMPL_OPENGL_VTX_UV_NORMALIZED     GL_FALSE
+#endif
+
 // [Debugging]
 //#define IMGUI_IMPL_OPENGL_DEBUG
 #ifdef IMGUI_IMPL_OPENGL_DEBUG
@@ -229,17 +256,30 @@ struct ImGui_ImplOpenGL3_Data
     bool            GlProfileIsCompat;
     GLint           GlProfileMask;
     GLuint          FontTexture;
+    int             FontTextureHeight;       // Recreate texture storage when atlas height changes (ImFontAtlasFlags_IncrementalBuild)
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
+    GLint           AttribLocationTexSdf;
     GLuint          AttribLocationVtxPos;    // Vertex attributes location
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
     unsigned int    VboHandle, ElementsHandle;
     GLsizeiptr      VertexBufferSize;
     GLsizeiptr      IndexBufferSize;
+    GLuint          InstShaderHandle;        // Shader program for ImDrawRectInstance (when HasRectInstances)
+    GLint           InstAttribLocationTex;   // Uniforms location
+    GLint           InstAttribLocationProjMtx;
+    GLint           InstAttribLocationTexSdf;
+    GLuint          InstAttribLocationPos;   // Instance attributes location
+    GLuint          InstAttribLocationUV;
+    GLuint          InstAttribLocationColor;
+    GLuint          InstAttribLocationShape;
+    GLuint          InstAttribLocationShapeFlags;
+    unsigned int    InstHandle;
     bool            HasPolygonMode;
     bool            HasClipOrigin;
+    bool            HasRectInstances;
     bool            UseBufferSubData;
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
@@ -344,6 +384,7 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     if (bd->GlVersion >= 320)
         io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
 #endif
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates;     // We can upload parts of the font texture modified after its creation.
 
     // Store GLSL version string so we can refer to it later in case we recreate shaders.
     // Note: GLSL version is NOT the same as GL version. Leave this to nullptr if unsure.
@@ -363,6 +404,24 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     strcpy(bd->GlslVersionString, glsl_version);
     strcat(bd->GlslVersionString, "\n");
 
+    // Signed distance field fonts require fwidth(), which our GLSL 1.20/ES 1.00 shaders don't use (it is an extension on ES 2.0).
+    // With those versions, the flag isn't set: ImGui::NewFrame() asserts when using ImFontAtlasFlags_SignedDistanceField, and our shaders
+    // would sample distances as plain alpha.
+    int glsl_version_num = 130;
+    sscanf(bd->GlslVersionString, "#version %d", &glsl_version_num);
+    if (glsl_version_num >= 130)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasSdfFonts;   // We can threshold font texture alpha as a distance (ImFontAtlasFlags_SignedDistanceField).
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    // Rectangle instances require glVertexAttribDivisor() + glDrawArraysInstanced() and a GLSL version exposing gl_VertexID.
+    if ((bd->GlVersion >= 330 || bd->GlProfileIsES3) && glsl_version_num >= 130)
+    {
+        bd->HasRectInstances = true;
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasRectInstances;  // We can honor ImDrawCmd::InstCount, rendering rectangles from ImDrawList::InstBuffer (used when io.ConfigDrawRectInstances is set).
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasSdfShapes;      // We can honor all ImDrawRectInstance shape fields (rounding corners, thickness, ellipse).
+    }
+#endif
+
     // Make an arbitrary GL call (we don't actually need the result)
     // IF YOU GET A CRASH HERE: it probably means the OpenGL function loader didn't do its job. Let us know!
     GLint current_texture;
@@ -396,7 +455,7 @@ void    ImGui_ImplOpenGL3_Shutdown()
     ImGui_ImplOpenGL3_DestroyDeviceObjects();
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasVtxOffset;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasRectInstances | ImGuiBackendFlags_RendererHasSdfShapes | ImGuiBackendFlags_RendererHasTexUpdates | ImGuiBackendFlags_RendererHasSdfFonts);
     IM_DELETE(bd);
 }
 
@@ -460,9 +519,29 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
+    if (bd->InstShaderHandle)
+    {
+        glUseProgram(bd->InstShaderHandle);
+        glUniform1i(bd->InstAttribLocationTex, 0);
+        glUniform1i(bd->InstAttribLocationTexSdf, 0);
+        glUniformMatrix4fv(bd->InstAttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    }
     glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
+    glUniform1i(bd->AttribLocationTexSdf, 0);
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    // Fold fixed-point scale of ImDrawVert positions into projection matrix (rectangle instances use float positions)
+    float vtx_projection[4][4];
+    memcpy(vtx_projection, ortho_projection, sizeof(ortho_projection));
+    for (int n = 0; n < 4; n++)
+    {
+        vtx_projection[0][n] /= IM_DRAWVERT_POS_SCALE;
+        vtx_projection[1][n] /= IM_DRAWVERT_POS_SCALE;
+    }
+    glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &vtx_projection[0][0]);
+#else
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+#endif
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->GlVersion >= 330 || bd->GlProfileIsES3)
@@ -480,11 +559,87 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxPos));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxUV));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxColor));
-    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, pos)));
-    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, uv)));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, IMGUI_IMPL_OPENGL_VTX_POS_TYPE, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, pos)));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, IMGUI_IMPL_OPENGL_VTX_UV_TYPE, IMGUI_IMPL_OPENGL_VTX_UV_NORMALIZED, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, uv)));
     GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, col)));
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+// Switch between rendering ImDrawVert triangles (default state) and ImDrawRectInstance quads.
+// Attribute locations of both programs may alias, so we always fully (re)configure the attributes we need.
+static void ImGui_ImplOpenGL3_SetupRectInstanceState(bool enable)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const GLuint inst_attribs[] = { bd->InstAttribLocationPos, bd->InstAttribLocationUV, bd->InstAttribLocationColor, bd->InstAttribLocationShape, bd->InstAttribLocationShapeFlags };
+    if (enable)
+    {
+        GL_CALL(glDisableVertexAttribArray(bd->AttribLocationVtxPos));
+        GL_CALL(glDisableVertexAttribArray(bd->AttribLocationVtxUV));
+        GL_CALL(glDisableVertexAttribArray(bd->AttribLocationVtxColor));
+        glUseProgram(bd->InstShaderHandle);
+        for (GLuint attrib : inst_attribs)
+        {
+            GL_CALL(glEnableVertexAttribArray(attrib));
+            GL_CALL(glVertexAttribDivisor(attrib, 1));
+        }
+    }
+    else
+    {
+        for (GLuint attrib : inst_attribs)
+        {
+            GL_CALL(glVertexAttribDivisor(attrib, 0));
+            GL_CALL(glDisableVertexAttribArray(attrib));
+        }
+        glUseProgram(bd->ShaderHandle);
+        GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxPos));
+        GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxUV));
+        GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxColor));
+        GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, IMGUI_IMPL_OPENGL_VTX_POS_TYPE, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, pos)));
+        GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, IMGUI_IMPL_OPENGL_VTX_UV_TYPE, IMGUI_IMPL_OPENGL_VTX_UV_NORMALIZED, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, uv)));
+        GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, col)));
+    }
+}
+
+// We don't rely on glDrawArraysInstancedBaseInstance() (GL 4.2+), so attribute pointers are offset for each command.
+static void ImGui_ImplOpenGL3_SetupRectInstanceAttribs(unsigned int inst_offset)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const size_t base = inst_offset * sizeof(ImDrawRectInstance);
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->InstHandle));
+    GL_CALL(glVertexAttribPointer(bd->InstAttribLocationPos,      4, GL_FLOAT,         GL_FALSE, sizeof(ImDrawRectInstance), (GLvoid*)(base + offsetof(ImDrawRectInstance, PosMin))));
+    GL_CALL(glVertexAttribPointer(bd->InstAttribLocationUV,       4, GL_FLOAT,         GL_FALSE, sizeof(ImDrawRectInstance), (GLvoid*)(base + offsetof(ImDrawRectInstance, UvMin))));
+    GL_CALL(glVertexAttribPointer(bd->InstAttribLocationColor,    4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawRectInstance), (GLvoid*)(base + offsetof(ImDrawRectInstance, Col))));
+    GL_CALL(glVertexAttribPointer(bd->InstAttribLocationShape,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawRectInstance), (GLvoid*)(base + offsetof(ImDrawRectInstance, Rounding))));        // Rounding, Thickness
+    GL_CALL(glVertexAttribPointer(bd->InstAttribLocationShapeFlags, 4, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(ImDrawRectInstance), (GLvoid*)(base + offsetof(ImDrawRectInstance, RoundingCorners)))); // RoundingCorners, Ellipse
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
+}
+#endif
+
+// Upload lines of the font texture modified since last call (ImFontAtlasFlags_DynamicGlyphs, ImFontAtlasFlags_IncrementalBuild)
+// Whole lines are uploaded as GL_UNPACK_ROW_LENGTH is not available on WebGL/ES 2.0. The whole texture is uploaded again when its height changed.
+static void ImGui_ImplOpenGL3_UpdateFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    int x, y, w, h;
+    if (bd->FontTexture == 0 || !io.Fonts->GetTexDataUpdateRect(&x, &y, &w, &h))
+        return;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, bd->FontTexture));
+#ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+    GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#endif
+    if (height != bd->FontTextureHeight)
+    {
+        GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        bd->FontTextureHeight = height;
+        return;
+    }
+    GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (size_t)y * width * 4));
+}
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -537,6 +692,9 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     GLboolean last_enable_primitive_restart = (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
 #endif
 
+    // Upload font texture pixels modified by glyphs loaded on demand
+    ImGui_ImplOpenGL3_UpdateFontsTexture();
+
     // Setup desired GL state
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
@@ -546,9 +704,16 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 #endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
+    // With ImFontAtlasFlags_SignedDistanceField, the font texture alpha is a distance to threshold (see 'TexSdf' in our shaders).
+    // The uniform is only updated when it changes, separately for our two programs (TexSdf is reset to 0 by ImGui_ImplOpenGL3_SetupRenderState()).
+    ImGuiIO& io = ImGui::GetIO();
+    const bool font_tex_sdf = (io.Fonts->Flags & ImFontAtlasFlags_SignedDistanceField) != 0;
+    bool program_tex_sdf[2] = { false, false };
+
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+    bool rendering_instances = false;
 
     // Render command lists
     for (int n = 0; n < draw_data->CmdListsCount; n++)
@@ -585,16 +750,34 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
             GL_CALL(glBufferData(GL_ARRAY_BUFFER, vtx_buffer_size, (const GLvoid*)draw_list->VtxBuffer.Data, GL_STREAM_DRAW));
             GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_size, (const GLvoid*)draw_list->IdxBuffer.Data, GL_STREAM_DRAW));
         }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+        if (draw_list->InstBuffer.Size > 0)
+        {
+            GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->InstHandle));
+            GL_CALL(glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)draw_list->InstBuffer.Size * (int)sizeof(ImDrawRectInstance), (const GLvoid*)draw_list->InstBuffer.Data, GL_STREAM_DRAW));
+            GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
+        }
+#endif
 
         for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
         {
             const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+            if (rendering_instances != (pcmd->InstCount > 0 && pcmd->UserCallback == nullptr))
+            {
+                rendering_instances = !rendering_instances;
+                ImGui_ImplOpenGL3_SetupRectInstanceState(rendering_instances);
+            }
+#endif
             if (pcmd->UserCallback != nullptr)
             {
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                    program_tex_sdf[0] = program_tex_sdf[1] = false;
+                }
                 else
                     pcmd->UserCallback(draw_list, pcmd);
             }
@@ -611,6 +794,20 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 
                 // Bind texture, Draw
                 GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
+                const bool tex_sdf = font_tex_sdf && pcmd->GetTexID() == io.Fonts->TexID;
+                if (program_tex_sdf[rendering_instances] != tex_sdf)
+                {
+                    program_tex_sdf[rendering_instances] = tex_sdf;
+                    GL_CALL(glUniform1i(rendering_instances ? bd->InstAttribLocationTexSdf : bd->AttribLocationTexSdf, tex_sdf ? 1 : 0));
+                }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+                if (pcmd->InstCount > 0)
+                {
+                    ImGui_ImplOpenGL3_SetupRectInstanceAttribs(pcmd->InstOffset);
+                    GL_CALL(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)pcmd->InstCount));
+                    continue;
+                }
+#endif
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
                     GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset));
@@ -621,6 +818,11 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         }
     }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    if (rendering_instances)
+        ImGui_ImplOpenGL3_SetupRectInstanceState(false);
+#endif
+
     // Destroy the temporary VAO
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
@@ -690,6 +892,7 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
 #endif
     GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    bd->FontTextureHeight = height;
 
     // Store identifier
     io.Fonts->SetTexID((ImTextureID)(intptr_t)bd->FontTexture);
@@ -842,33 +1045,45 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     const GLchar* fragment_shader_glsl_130 =
         "uniform sampler2D Texture;\n"
+        "uniform int TexSdf;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 col = texture(Texture, Frag_UV.st);\n"
+        "    if (TexSdf != 0)\n"
+        "        col.a = clamp((col.a - 0.5) / max(fwidth(col.a), 1.0 / 255.0) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = Frag_Color * col;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_300_es =
         "precision mediump float;\n"
         "uniform sampler2D Texture;\n"
+        "uniform int TexSdf;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 col = texture(Texture, Frag_UV.st);\n"
+        "    if (TexSdf != 0)\n"
+        "        col.a = clamp((col.a - 0.5) / max(fwidth(col.a), 1.0 / 255.0) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = Frag_Color * col;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_410_core =
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "uniform sampler2D Texture;\n"
+        "uniform int TexSdf;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 col = texture(Texture, Frag_UV.st);\n"
+        "    if (TexSdf != 0)\n"
+        "        col.a = clamp((col.a - 0.5) / max(fwidth(col.a), 1.0 / 255.0) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = Frag_Color * col;\n"
         "}\n";
 
     // Select shaders matching our GLSL versions
@@ -876,6 +1091,7 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
     const GLchar* fragment_shader = nullptr;
     if (glsl_version < 130)
     {
+        // No signed distance field support: see ImGuiBackendFlags_RendererHasSdfFonts in ImGui_ImplOpenGL3_Init()
         vertex_shader = vertex_shader_glsl_120;
         fragment_shader = fragment_shader_glsl_120;
     }
@@ -924,6 +1140,7 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
+    bd->AttribLocationTexSdf = glGetUniformLocation(bd->ShaderHandle, "TexSdf"); // -1 with GLSL 1.20/ES 1.00 shaders, glUniform1i() ignores it.
     bd->AttribLocationVtxPos = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Position");
     bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
     bd->AttribLocationVtxColor = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
@@ -932,6 +1149,125 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
     glGenBuffers(1, &bd->VboHandle);
     glGenBuffers(1, &bd->ElementsHandle);
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_INSTANCING
+    // Rectangle instances: each ImDrawRectInstance is expanded into a 4 vertices strip using gl_VertexID.
+    // Rounded boxes, strokes and ellipses are evaluated analytically (signed distance) in the fragment shader.
+    if (bd->HasRectInstances)
+    {
+        const GLchar* vertex_shader_inst =
+            "uniform mat4 ProjMtx;\n"
+            "in vec4 InstPos;\n"
+            "in vec4 InstUV;\n"
+            "in vec4 InstColor;\n"
+            "in vec2 InstShape;\n"
+            "in vec4 InstShapeFlags;\n"
+            "out vec2 Frag_UV;\n"
+            "out vec4 Frag_Color;\n"
+            "out vec2 Frag_Local;\n"
+            "flat out vec4 Frag_Shape;\n"
+            "flat out vec2 Frag_ShapeFlags;\n"
+            "void main()\n"
+            "{\n"
+            "    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));\n"
+            "    vec2 size = InstPos.zw - InstPos.xy;\n"
+            "    vec2 dir = corner * 2.0 - 1.0;\n"
+            "    float expand = (InstShape.x > 0.0 || InstShape.y > 0.0 || InstShapeFlags.y > 0.0) ? InstShape.y * 0.5 + 1.0 : 0.0;\n"
+            "    vec2 pos = mix(InstPos.xy, InstPos.zw, corner) + dir * (step(0.0, size) * 2.0 - 1.0) * expand;\n"
+            "    Frag_UV = mix(InstUV.xy, InstUV.zw, corner + dir * expand / max(abs(size), vec2(1e-4)));\n"
+            "    Frag_Color = InstColor;\n"
+            "    Frag_Local = pos - (InstPos.xy + InstPos.zw) * 0.5;\n"
+            "    Frag_Shape = vec4(abs(size) * 0.5, InstShape);\n"
+            "    Frag_ShapeFlags = InstShapeFlags.xy;\n"
+            "    gl_Position = ProjMtx * vec4(pos,0,1);\n"
+            "}\n";
+
+        const GLchar* fragment_shader_inst =
+            "uniform sampler2D Texture;\n"
+            "uniform int TexSdf;\n"
+            "in vec2 Frag_UV;\n"
+            "in vec4 Frag_Color;\n"
+            "in vec2 Frag_Local;\n"
+            "flat in vec4 Frag_Shape;\n"      // half_size.xy, rounding, thickness
+            "flat in vec2 Frag_ShapeFlags;\n" // rounding corners, ellipse
+            "out vec4 Out_Color;\n"
+            "void main()\n"
+            "{\n"
+            "    vec4 col = texture(Texture, Frag_UV.st);\n"
+            "    if (TexSdf != 0)\n"
+            "        col.a = clamp((col.a - 0.5) / max(fwidth(col.a), 1.0 / 255.0) + 0.5, 0.0, 1.0);\n"
+            "    col *= Frag_Color;\n"
+            "    if (Frag_Shape.z > 0.0 || Frag_Shape.w > 0.0 || Frag_ShapeFlags.y > 0.0)\n"
+            "    {\n"
+            "        float dist;\n"
+            "        if (Frag_ShapeFlags.y > 0.0)\n"
+            "        {\n"
+            "            vec2 r = max(Frag_Shape.xy, vec2(1e-4));\n"
+            "            float k0 = length(Frag_Local / r);\n"
+            "            float k1 = length(Frag_Local / (r * r));\n"
+            "            dist = k0 * (k0 - 1.0) / max(k1, 1e-4);\n"
+            "        }\n"
+            "        else\n"
+            "        {\n"
+            "            int corner_bit = (Frag_Local.x > 0.0 ? 1 : 0) + (Frag_Local.y > 0.0 ? 2 : 0);\n"
+            "            float rounding = ((int(Frag_ShapeFlags.x + 0.5) >> corner_bit) & 1) != 0 ? Frag_Shape.z : 0.0;\n"
+            "            vec2 q = abs(Frag_Local) - Frag_Shape.xy + rounding;\n"
+            "            dist = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - rounding;\n"
+            "        }\n"
+            "        if (Frag_Shape.w > 0.0)\n"
+            "            dist = abs(dist) - Frag_Shape.w * 0.5;\n"
+            "        col.a *= clamp(0.5 - dist, 0.0, 1.0);\n"
+            "    }\n"
+            "    Out_Color = col;\n"
+            "}\n";
+
+        // GLSL ES needs a default precision. Use highp in the fragment shader as Frag_Local is in pixels.
+        const GLchar* precision = (glsl_version == 300) ? "precision highp float;\n" : "";
+        const GLchar* vertex_shader_inst_with_version[3] = { bd->GlslVersionString, precision, vertex_shader_inst };
+        GL_CALL(vert_handle = glCreateShader(GL_VERTEX_SHADER));
+        glShaderSource(vert_handle, 3, vertex_shader_inst_with_version, nullptr);
+        glCompileShader(vert_handle);
+        bool inst_ok = CheckShader(vert_handle, "instance vertex shader");
+
+        const GLchar* fragment_shader_inst_with_version[3] = { bd->GlslVersionString, precision, fragment_shader_inst };
+        GL_CALL(frag_handle = glCreateShader(GL_FRAGMENT_SHADER));
+        glShaderSource(frag_handle, 3, fragment_shader_inst_with_version, nullptr);
+        glCompileShader(frag_handle);
+        inst_ok &= CheckShader(frag_handle, "instance fragment shader");
+
+        bd->InstShaderHandle = glCreateProgram();
+        glAttachShader(bd->InstShaderHandle, vert_handle);
+        glAttachShader(bd->InstShaderHandle, frag_handle);
+        glLinkProgram(bd->InstShaderHandle);
+        inst_ok &= CheckProgram(bd->InstShaderHandle, "instance shader program");
+
+        glDetachShader(bd->InstShaderHandle, vert_handle);
+        glDetachShader(bd->InstShaderHandle, frag_handle);
+        glDeleteShader(vert_handle);
+        glDeleteShader(frag_handle);
+
+        if (inst_ok)
+        {
+            bd->InstAttribLocationTex = glGetUniformLocation(bd->InstShaderHandle, "Texture");
+            bd->InstAttribLocationProjMtx = glGetUniformLocation(bd->InstShaderHandle, "ProjMtx");
+            bd->InstAttribLocationTexSdf = glGetUniformLocation(bd->InstShaderHandle, "TexSdf");
+            bd->InstAttribLocationPos = (GLuint)glGetAttribLocation(bd->InstShaderHandle, "InstPos");
+            bd->InstAttribLocationUV = (GLuint)glGetAttribLocation(bd->InstShaderHandle, "InstUV");
+            bd->InstAttribLocationColor = (GLuint)glGetAttribLocation(bd->InstShaderHandle, "InstColor");
+            bd->InstAttribLocationShape = (GLuint)glGetAttribLocation(bd->InstShaderHandle, "InstShape");
+            bd->InstAttribLocationShapeFlags = (GLuint)glGetAttribLocation(bd->InstShaderHandle, "InstShapeFlags");
+            glGenBuffers(1, &bd->InstHandle);
+        }
+        else
+        {
+            // Fallback to triangles: core library won't emit instances anymore starting from next frame.
+            glDeleteProgram(bd->InstShaderHandle);
+            bd->InstShaderHandle = 0;
+            bd->HasRectInstances = false;
+            ImGui::GetIO().BackendFlags &= ~(ImGuiBackendFlags_RendererHasRectInstances | ImGuiBackendFlags_RendererHasSdfShapes);
+        }
+    }
+#endif
+
     ImGui_ImplOpenGL3_CreateFontsTexture();
 
     // Restore modified GL state
@@ -953,6 +1289,8 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
     if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
+    if (bd->InstHandle)     { glDeleteBuffers(1, &bd->InstHandle); bd->InstHandle = 0; }
+    if (bd->InstShaderHandle) { glDeleteProgram(bd->InstShaderHandle); bd->InstShaderHandle = 0; }
     ImGui_ImplOpenGL3_DestroyFontsTexture();
 }
 
@@ -0,0 +1,968 @@
+// dear imgui: Renderer Backend for software rasterization (CPU only, no graphics API)
+// This needs to be used along with a Platform Backend (e.g. GLFW, SDL, Win32, custom..), or none for headless applications.
+// Output is a 32-bit RGBA pixel buffer that you can display, stream (e.g. VNC) or save (e.g. screenshots, reference images for tests).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftRaster_Texture*' as texture identifier. Read the FAQ about ImTextureID!
+//  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
+//  [X] Renderer: Instanced rectangles (ImGuiBackendFlags_RendererHasRectInstances).
+//  [X] Renderer: Signed distance rounded rectangles, circles and ellipses (ImGuiBackendFlags_RendererHasSdfShapes).
+//  [X] Renderer: Partial font texture updates (ImGuiBackendFlags_RendererHasTexUpdates), for ImFontAtlasFlags_DynamicGlyphs and ImFontAtlasFlags_IncrementalBuild.
+//  [X] Renderer: Multi-threaded rasterization. Output doesn't depend on number of threads.
+// Missing features or Issues:
+//  [ ] Renderer: Textures are sampled with nearest filtering.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+// CHANGELOG
+// (minor and older changes stripped away, please see git history for details)
+//  2025-03-03: Copy whole font texture again when its height changed (ImFontAtlasFlags_IncrementalBuild).
+//  2025-03-02: Added support for ImGuiBackendFlags_RendererHasTexUpdates: copy font texture lines modified by glyphs loaded on demand (ImFontAtlasFlags_DynamicGlyphs).
+//  2025-03-01: Initial version.
+
+// How it works:
+// - RenderDrawData() converts triangles and rectangle instances into primitives (bounds, edge functions, attribute planes),
+//   and bins them into 64x64 pixels tiles. Tiles are then rasterized in parallel, each tile processing its primitives in submission order.
+//   No locking is needed as tiles don't overlap, and output is the same whatever the number of threads.
+// - Edge functions, attribute interpolation, signed distance shapes and blending are evaluated 4 pixels at a time with SSE2.
+// - Pixels are covered when their center is inside a primitive. Edges shared by two triangles are evaluated from the same
+//   vertex with the same formula in both triangles, and a top-left rule decides ties, so no pixel is blended twice or missed.
+// - User callbacks are honored: primitives submitted before a callback are rasterized before calling it.
+// - Define IMGUI_IMPL_SOFTRASTER_DISABLE_THREADS to not use <thread>: rasterization then always happens on calling thread.
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_softraster.h"
+#include <stdint.h>     // intptr_t
+#include <string.h>     // memcpy
+#include <math.h>       // floorf, ceilf, sqrtf
+#ifndef IMGUI_IMPL_SOFTRASTER_DISABLE_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#endif
+
+// Same SSE2 detection as imgui_internal.h
+#if (defined __SSE2__ || defined __x86_64__ || defined _M_X64 || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))) && !defined(IMGUI_DISABLE_SSE)
+#define IMGUI_IMPL_SOFTRASTER_SSE
+#include <emmintrin.h>
+#endif
+
+#define IMGUI_IMPL_SOFTRASTER_TILE_SIZE     64
+
+enum ImGui_ImplSoftRaster_PrimFlags_
+{
+    ImGui_ImplSoftRaster_PrimFlags_Triangle     = 1 << 0,   // Test edge functions (otherwise: axis-aligned rectangle)
+    ImGui_ImplSoftRaster_PrimFlags_Shape        = 1 << 1,   // Rectangle with signed distance shape (rounding, stroke, ellipse)
+    ImGui_ImplSoftRaster_PrimFlags_ConstColor   = 1 << 2,   // Same vertex color over the whole primitive
+    ImGui_ImplSoftRaster_PrimFlags_ConstTexel   = 1 << 3,   // Same texel over the whole primitive (e.g. white pixel), ConstCol[] is multiplied by it
+    ImGui_ImplSoftRaster_PrimFlags_Opaque       = 1 << 4,   // ConstColor + ConstTexel + opaque: write ConstPacked without blending
+};
+
+// A triangle or rectangle instance, ready to be rasterized
+struct ImGui_ImplSoftRaster_Prim
+{
+    int             Flags;                  // ImGui_ImplSoftRaster_PrimFlags_
+    int             MinX, MinY, MaxX, MaxY; // Pixel bounds, clipped (MaxX/MaxY excluded)
+    const ImGui_ImplSoftRaster_Texture* Texture;
+    float           OriginX, OriginY;       // Attribute planes are relative to this point (center of shapes)
+    float           U[3], V[3];             // Attribute planes (value at origin, d/dx, d/dy). U/V are in texels.
+    float           Col[4][3];              // R, G, B in 0..255, A in 0..1
+    float           ConstCol[4];            // When ConstColor is set
+    ImU32           ConstPacked;            // When Opaque is set
+    float           EdgeA[3], EdgeB[3];     // Triangle edge functions: E = A * (x - X) + B * (y - Y). Pixel is inside when E > 0, or E == 0 on top-left edges.
+    float           EdgeX[3], EdgeY[3];
+    bool            EdgeTopLeft[3];
+    bool            ShapeEllipse;
+    float           ShapeHalfW, ShapeHalfH;
+    float           ShapeThickness;         // 0.0f: filled
+    float           ShapeRounding[4];       // Top-left, top-right, bottom-left, bottom-right
+};
+
+#ifndef IMGUI_IMPL_SOFTRASTER_DISABLE_THREADS
+struct ImGui_ImplSoftRaster_ThreadPool
+{
+    ImVector<std::thread*>  Threads;
+    std::mutex              Mutex;
+    std::condition_variable WakeCond;
+    std::condition_variable DoneCond;
+    int                     Generation = 0;     // Incremented to wake up workers
+    int                     BusyCount = 0;      // Workers which haven't finished current generation
+    bool                    Quit = false;
+    std::atomic<int>        NextJob{0};
+};
+#endif
+
+// Software rasterizer data
+struct ImGui_ImplSoftRaster_Data
+{
+    ImGui_ImplSoftRaster_Texture        FontTexture;
+    ImVector<unsigned char>             FontPixels;
+    int                                 ThreadsCount;
+
+    // Current frame
+    unsigned char*                      TargetPixels;
+    int                                 TargetWidth;
+    int                                 TargetHeight;
+    int                                 TargetPitch;
+    int                                 TilesX, TilesY;
+    ImVector<ImGui_ImplSoftRaster_Prim> Prims;
+    ImVector<int>                       TileOffsets;    // Start of each tile in TilePrims[] (TilesX * TilesY + 1 entries)
+    ImVector<int>                       TilePrims;      // Indices into Prims[], sorted by tile then submission order
+    ImVector<int>                       ActiveTiles;    // Tiles with at least one primitive
+#ifndef IMGUI_IMPL_SOFTRASTER_DISABLE_THREADS
+    ImGui_ImplSoftRaster_ThreadPool*    Pool;
+#endif
+
+    ImGui_ImplSoftRaster_Data()
+    {
+        memset((void*)&FontTexture, 0, sizeof(FontTexture));
+        ThreadsCount = 1;
+        TargetPixels = nullptr;
+        TargetWidth = TargetHeight = TargetPitch = TilesX = TilesY = 0;
+#ifndef IMGUI_IMPL_SOFTRASTER_DISABLE_THREADS
+        Pool = nullptr;
+#endif
+    }
+};
+
+// Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
+// It is STRONGLY preferred that you use docking branch with multi-viewports (== single Dear ImGui context + multiple windows) instead of multiple Dear ImGui contexts.
+static ImGui_ImplSoftRaster_Data* ImGui_ImplSoftRaster_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplSoftRaster_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
+}
+
+static void ImGui_ImplSoftRaster_RasterTile(ImGui_ImplSoftRaster_Data* bd, int tile_idx);
+
+//-----------------------------------------------------------------------------
+// Threads
+//-----------------------------------------------------------------------------
+
+#ifndef IMGUI_IMPL_SOFTRASTER_DISABLE_THREADS
+static void ImGui_ImplSoftRaster_RunJobs(ImGui_ImplSoftRaster_Data* bd)
+{
+    ImGui_ImplSoftRaster_ThreadPool* pool = bd->Pool;
+    const int jobs_count = bd->ActiveTiles.Size;
+    for (int job_n = pool->NextJob++; job_n < jobs_count; job_n = pool->NextJob++)
+        ImGui_ImplSoftRaster_RasterTile(bd, bd->ActiveTiles[job_n]);
+}
+
+static void ImGui_ImplSoftRaster_WorkerThread(ImGui_ImplSoftRaster_Data* bd)
+{
+    ImGui_ImplSoftRaster_ThreadPool* pool = bd->Pool;
+    int generation = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(pool->Mutex);
+            pool->WakeCond.wait(lock, [&] { return pool->Quit || pool->Generation != generation; });
+            if (pool->Quit)
+                return;
+            generation = pool->Generation;
+        }
+        ImGui_ImplSoftRaster_RunJobs(bd);
+        std::lock_guard<std::mutex> lock(pool->Mutex);
+        if (--pool->BusyCount == 0)
+            pool->DoneCond.notify_one();
+    }
+}
+
+static void ImGui_ImplSoftRaster_CreateThreads(ImGui_ImplSoftRaster_Data* bd)
+{
+    if (bd->ThreadsCount <= 1)
+        return;
+    bd->Pool = IM_NEW(ImGui_ImplSoftRaster_ThreadPool)();
+    for (int n = 0; n < bd->ThreadsCount - 1; n++) // Calling thread also participates
+        bd->Pool->Threads.push_back(IM_NEW(std::thread)(ImGui_ImplSoftRaster_WorkerThread, bd));
+}
+
+static void ImGui_ImplSoftRaster_DestroyThreads(ImGui_ImplSoftRaster_Data* bd)
+{
+    ImGui_ImplSoftRaster_ThreadPool* pool = bd->Pool;
+    if (pool == nullptr)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(pool->Mutex);
+        pool->Quit = true;
+    }
+    pool->WakeCond.notify_all();
+    for (std::thread* thread : pool->Threads)
+    {
+        thread->join();
+        IM_DELETE(thread);
+    }
+    IM_DELETE(pool);
+    bd->Pool = nullptr;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Primitives setup
+//-----------------------------------------------------------------------------
+
+static inline float ImGui_ImplSoftRaster_Min(float a, float b)             { return (a < b) ? a : b; }
+static inline float ImGui_ImplSoftRaster_Max(float a, float b)             { return (a > b) ? a : b; }
+static inline int   ImGui_ImplSoftRaster_Min(int a, int b)                 { return (a < b) ? a : b; }
+static inline int   ImGui_ImplSoftRaster_Max(int a, int b)                 { return (a > b) ? a : b; }
+static inline float ImGui_ImplSoftRaster_Abs(float v)                      { return (v < 0.0f) ? -v : v; }
+static inline float ImGui_ImplSoftRaster_Clamp(float v, float mn, float mx) { return (v < mn) ? mn : (v > mx) ? mx : v; }
+
+// Nearest texel, clamped to edges. U/V are in texels.
+static inline void ImGui_ImplSoftRaster_SampleTexel(const ImGui_ImplSoftRaster_Texture* tex, float u, float v, float out_texel[4])
+{
+    if (tex == nullptr)
+    {
+        out_texel[0] = out_texel[1] = out_texel[2] = out_texel[3] = 1.0f;
+        return;
+    }
+    const int x = (int)ImGui_ImplSoftRaster_Clamp(u, 0.0f, (float)(tex->Width - 1));
+    const int y = (int)ImGui_ImplSoftRaster_Clamp(v, 0.0f, (float)(tex->Height - 1));
+    if (tex->BytesPerPixel == 1)
+    {
+        out_texel[0] = out_texel[1] = out_texel[2] = 1.0f;
+        out_texel[3] = ((const unsigned char*)tex->Pixels)[y * tex->Width + x] * (1.0f / 255.0f);
+        return;
+    }
+    const ImU32 c = ((const ImU32*)tex->Pixels)[y * tex->Width + x];
+    out_texel[0] = ((c >> IM_COL32_R_SHIFT) & 0xFF) * (1.0f / 255.0f);
+    out_texel[1] = ((c >> IM_COL32_G_SHIFT) & 0xFF) * (1.0f / 255.0f);
+    out_texel[2] = ((c >> IM_COL32_B_SHIFT) & 0xFF) * (1.0f / 255.0f);
+    out_texel[3] = ((c >> IM_COL32_A_SHIFT) & 0xFF) * (1.0f / 255.0f);
+}
+
+// Color as R, G, B in 0..255, A in 0..1
+static inline void ImGui_ImplSoftRaster_UnpackColor(ImU32 col, float out_col[4])
+{
+    out_col[0] = (float)((col >> IM_COL32_R_SHIFT) & 0xFF);
+    out_col[1] = (float)((col >> IM_COL32_G_SHIFT) & 0xFF);
+    out_col[2] = (float)((col >> IM_COL32_B_SHIFT) & 0xFF);
+    out_col[3] = ((col >> IM_COL32_A_SHIFT) & 0xFF) * (1.0f / 255.0f);
+}
+
+// Constant color and texel: premultiply, and detect opaque primitives which don't need blending
+static void ImGui_ImplSoftRaster_SetupConstColor(ImGui_ImplSoftRaster_Prim* prim, ImU32 col, float u, float v)
+{
+    ImGui_ImplSoftRaster_UnpackColor(col, prim->ConstCol);
+    prim->Flags |= ImGui_ImplSoftRaster_PrimFlags_ConstColor;
+    if (!(prim->Flags & ImGui_ImplSoftRaster_PrimFlags_ConstTexel))
+        return;
+    float texel[4];
+    ImGui_ImplSoftRaster_SampleTexel(prim->Texture, u, v, texel);
+    for (int c = 0; c < 4; c++)
+        prim->ConstCol[c] *= texel[c];
+    if (prim->ConstCol[3] >= 1.0f && !(prim->Flags & ImGui_ImplSoftRaster_PrimFlags_Shape))
+    {
+        prim->Flags |= ImGui_ImplSoftRaster_PrimFlags_Opaque;
+        prim->ConstPacked = ((ImU32)(prim->ConstCol[0] + 0.5f) << IM_COL32_R_SHIFT) | ((ImU32)(prim->ConstCol[1] + 0.5f) << IM_COL32_G_SHIFT) | ((ImU32)(prim->ConstCol[2] + 0.5f) << IM_COL32_B_SHIFT) | IM_COL32_A_MASK;
+    }
+}
+
+// Pixels whose center is within [min, max), clipped
+static bool ImGui_ImplSoftRaster_SetupBounds(ImGui_ImplSoftRaster_Prim* prim, float min_x, float min_y, float max_x, float max_y, const int clip[4])
+{
+    prim->MinX = (int)ceilf(ImGui_ImplSoftRaster_Clamp(min_x - 0.5f, (float)clip[0], (float)clip[2]));
+    prim->MinY = (int)ceilf(ImGui_ImplSoftRaster_Clamp(min_y - 0.5f, (float)clip[1], (float)clip[3]));
+    prim->MaxX = (int)ceilf(ImGui_ImplSoftRaster_Clamp(max_x - 0.5f, (float)clip[0], (float)clip[2]));
+    prim->MaxY = (int)ceilf(ImGui_ImplSoftRaster_Clamp(max_y - 0.5f, (float)clip[1], (float)clip[3]));
+    return prim->MinX < prim->MaxX && prim->MinY < prim->MaxY;
+}
+
+static bool ImGui_ImplSoftRaster_SetupTriangle(ImGui_ImplSoftRaster_Prim* prim, const ImDrawVert* vtx[3], const ImVec2& offset, const ImVec2& scale, const int clip[4])
+{
+    ImVec2 p[3], uv[3];
+    ImU32 col[3];
+    for (int n = 0; n < 3; n++)
+    {
+        const ImVec2 pos = ImDrawVert_GetPos(vtx[n]);
+        p[n] = ImVec2((pos.x - offset.x) * scale.x, (pos.y - offset.y) * scale.y);
+        uv[n] = ImDrawVert_GetUV(vtx[n]);
+        col[n] = vtx[n]->col;
+    }
+    float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+    if (area == 0.0f)
+        return false;
+    if (area < 0.0f)
+    {
+        ImVec2 tmp_p = p[1]; p[1] = p[2]; p[2] = tmp_p;
+        ImVec2 tmp_uv = uv[1]; uv[1] = uv[2]; uv[2] = tmp_uv;
+        ImU32 tmp_col = col[1]; col[1] = col[2]; col[2] = tmp_col;
+        area = -area;
+    }
+
+    const float min_x = ImGui_ImplSoftRaster_Min(ImGui_ImplSoftRaster_Min(p[0].x, p[1].x), p[2].x), max_x = ImGui_ImplSoftRaster_Max(ImGui_ImplSoftRaster_Max(p[0].x, p[1].x), p[2].x);
+    const float min_y = ImGui_ImplSoftRaster_Min(ImGui_ImplSoftRaster_Min(p[0].y, p[1].y), p[2].y), max_y = ImGui_ImplSoftRaster_Max(ImGui_ImplSoftRaster_Max(p[0].y, p[1].y), p[2].y);
+    if (!ImGui_ImplSoftRaster_SetupBounds(prim, min_x, min_y, max_x, max_y, clip))
+        return false;
+    prim->Flags = ImGui_ImplSoftRaster_PrimFlags_Triangle;
+
+    // Edge (a -> b) is inside when cross(b - a, p - a) > 0. Evaluate it from the lowest vertex so that the
+    // same edge in a neighbor triangle (b -> a) gives exactly the opposite value.
+    for (int n = 0; n < 3; n++)
+    {
+        const ImVec2& a = p[n];
+        const ImVec2& b = p[(n + 1) % 3];
+        const bool a_first = (a.x < b.x) || (a.x == b.x && a.y < b.y);
+        const ImVec2& o = a_first ? a : b;
+        const ImVec2& e = a_first ? b : a;
+        const float sign = a_first ? 1.0f : -1.0f;
+        prim->EdgeA[n] = -(e.y - o.y) * sign;
+        prim->EdgeB[n] = (e.x - o.x) * sign;
+        prim->EdgeX[n] = o.x;
+        prim->EdgeY[n] = o.y;
+        const float dx = b.x - a.x, dy = b.y - a.y;
+        prim->EdgeTopLeft[n] = (dy < 0.0f) || (dy == 0.0f && dx > 0.0f);
+    }
+
+    // Attribute planes
+    const float d1x = p[1].x - p[0].x, d1y = p[1].y - p[0].y;
+    const float d2x = p[2].x - p[0].x, d2y = p[2].y - p[0].y;
+    const float inv_area = 1.0f / area;
+    prim->OriginX = p[0].x;
+    prim->OriginY = p[0].y;
+    const ImGui_ImplSoftRaster_Texture* tex = prim->Texture;
+    const float tex_w = tex ? (float)tex->Width : 1.0f;
+    const float tex_h = tex ? (float)tex->Height : 1.0f;
+    float attr[6][3];
+    for (int n = 0; n < 3; n++)
+    {
+        float c[4];
+        ImGui_ImplSoftRaster_UnpackColor(col[n], c);
+        attr[0][n] = uv[n].x * tex_w;
+        attr[1][n] = uv[n].y * tex_h;
+        for (int ch = 0; ch < 4; ch++)
+            attr[2 + ch][n] = c[ch];
+    }
+    float* planes[6] = { prim->U, prim->V, prim->Col[0], prim->Col[1], prim->Col[2], prim->Col[3] };
+    for (int a = 0; a < 6; a++)
+    {
+        const float da1 = attr[a][1] - attr[a][0];
+        const float da2 = attr[a][2] - attr[a][0];
+        planes[a][0] = attr[a][0];
+        planes[a][1] = (da1 * d2y - da2 * d1y) * inv_area;
+        planes[a][2] = (da2 * d1x - da1 * d2x) * inv_area;
+    }
+
+    if (tex == nullptr || (uv[0].x == uv[1].x && uv[0].x == uv[2].x && uv[0].y == uv[1].y && uv[0].y == uv[2].y))
+        prim->Flags |= ImGui_ImplSoftRaster_PrimFlags_ConstTexel;
+    if (col[0] == col[1] && col[0] == col[2])
+        ImGui_ImplSoftRaster_SetupConstColor(prim, col[0], attr[0][0], attr[1][0]);
+    else if (prim->Flags & ImGui_ImplSoftRaster_PrimFlags_ConstTexel)
+        ImGui_ImplSoftRaster_SampleTexel(tex, attr[0][0], attr[1][0], prim->ConstCol); // Constant texel only: stored in ConstCol[]
+    return true;
+}
+
+static bool ImGui_ImplSoftRaster_SetupRectInstance(ImGui_ImplSoftRaster_Prim* prim, const ImDrawRectInstance* inst, const ImVec2& offset, const ImVec2& scale, const int clip[4])
+{
+    const float x0 = (inst->PosMin.x - offset.x) * scale.x, y0 = (inst->PosMin.y - offset.y) * scale.y;
+    const float x1 = (inst->PosMax.x - offset.x) * scale.x, y1 = (inst->PosMax.y - offset.y) * scale.y;
+    const bool is_shape = (inst->Rounding > 0.0f || inst->Thickness > 0.0f || inst->Ellipse != 0);
+    const float expand = is_shape ? inst->Thickness * scale.x * 0.5f + 1.0f : 0.0f;
+    if (!ImGui_ImplSoftRaster_SetupBounds(prim, ImGui_ImplSoftRaster_Min(x0, x1) - expand, ImGui_ImplSoftRaster_Min(y0, y1) - expand, ImGui_ImplSoftRaster_Max(x0, x1) + expand, ImGui_ImplSoftRaster_Max(y0, y1) + expand, clip))
+        return false;
+    prim->Flags = is_shape ? ImGui_ImplSoftRaster_PrimFlags_Shape : 0;
+
+    // Attribute planes are relative to the center. UV are linearly extrapolated over the expanded area.
+    const ImGui_ImplSoftRaster_Texture* tex = prim->Texture;
+    const float tex_w = tex ? (float)tex->Width : 1.0f;
+    const float tex_h = tex ? (float)tex->Height : 1.0f;
+    prim->OriginX = (x0 + x1) * 0.5f;
+    prim->OriginY = (y0 + y1) * 0.5f;
+    prim->U[0] = (inst->UvMin.x + inst->UvMax.x) * 0.5f * tex_w;
+    prim->U[1] = (x1 != x0) ? (inst->UvMax.x - inst->UvMin.x) * tex_w / (x1 - x0) : 0.0f;
+    prim->U[2] = 0.0f;
+    prim->V[0] = (inst->UvMin.y + inst->UvMax.y) * 0.5f * tex_h;
+    prim->V[1] = 0.0f;
+    prim->V[2] = (y1 != y0) ? (inst->UvMax.y - inst->UvMin.y) * tex_h / (y1 - y0) : 0.0f;
+    if (is_shape)
+    {
+        prim->ShapeEllipse = (inst->Ellipse != 0);
+        prim->ShapeHalfW = ImGui_ImplSoftRaster_Abs(x1 - x0) * 0.5f;
+        prim->ShapeHalfH = ImGui_ImplSoftRaster_Abs(y1 - y0) * 0.5f;
+        prim->ShapeThickness = inst->Thickness * scale.x;
+        for (int corner_n = 0; corner_n < 4; corner_n++)
+            prim->ShapeRounding[corner_n] = (inst->RoundingCorners & (1 << corner_n)) ? inst->Rounding * scale.x : 0.0f;
+    }
+    if (tex == nullptr || (inst->UvMin.x == inst->UvMax.x && inst->UvMin.y == inst->UvMax.y))
+        prim->Flags |= ImGui_ImplSoftRaster_PrimFlags_ConstTexel;
+    ImGui_ImplSoftRaster_SetupConstColor(prim, inst->Col, prim->U[0], prim->V[0]);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Rasterization
+//-----------------------------------------------------------------------------
+
+// Signed distance to a shape (negative inside), 'lx'/'ly' relative to its center
+static inline float ImGui_ImplSoftRaster_ShapeDistance(const ImGui_ImplSoftRaster_Prim& prim, float lx, float ly)
+{
+    float dist;
+    if (prim.ShapeEllipse)
+    {
+        const float rx = ImGui_ImplSoftRaster_Max(prim.ShapeHalfW, 1e-4f), ry = ImGui_ImplSoftRaster_Max(prim.ShapeHalfH, 1e-4f);
+        const float k0 = sqrtf((lx / rx) * (lx / rx) + (ly / ry) * (ly / ry));
+        const float k1 = sqrtf((lx / (rx * rx)) * (lx / (rx * rx)) + (ly / (ry * ry)) * (ly / (ry * ry)));
+        dist = k0 * (k0 - 1.0f) / ImGui_ImplSoftRaster_Max(k1, 1e-4f);
+    }
+    else
+    {
+        const float rounding = prim.ShapeRounding[(lx > 0.0f ? 1 : 0) + (ly > 0.0f ? 2 : 0)];
+        const float qx = ImGui_ImplSoftRaster_Abs(lx) - prim.ShapeHalfW + rounding;
+        const float qy = ImGui_ImplSoftRaster_Abs(ly) - prim.ShapeHalfH + rounding;
+        const float ox = ImGui_ImplSoftRaster_Max(qx, 0.0f), oy = ImGui_ImplSoftRaster_Max(qy, 0.0f);
+        dist = sqrtf(ox * ox + oy * oy) + ImGui_ImplSoftRaster_Min(ImGui_ImplSoftRaster_Max(qx, qy), 0.0f) - rounding;
+    }
+    if (prim.ShapeThickness > 0.0f)
+        dist = ImGui_ImplSoftRaster_Abs(dist) - prim.ShapeThickness * 0.5f;
+    return dist;
+}
+
+#ifdef IMGUI_IMPL_SOFTRASTER_SSE
+
+static inline __m128 ImGui_ImplSoftRaster_Plane(const float plane[3], float fy, __m128 fx)
+{
+    return _mm_add_ps(_mm_set1_ps(plane[0] + plane[2] * fy), _mm_mul_ps(_mm_set1_ps(plane[1]), fx));
+}
+
+static inline __m128 ImGui_ImplSoftRaster_Abs4(__m128 v)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+
+// Signed distance to a shape for 4 pixels (see scalar version above)
+static inline __m128 ImGui_ImplSoftRaster_ShapeDistance4(const ImGui_ImplSoftRaster_Prim& prim, __m128 lx, float ly)
+{
+    const __m128 zero = _mm_setzero_ps();
+    __m128 dist;
+    if (prim.ShapeEllipse)
+    {
+        const float rx = ImGui_ImplSoftRaster_Max(prim.ShapeHalfW, 1e-4f), ry = ImGui_ImplSoftRaster_Max(prim.ShapeHalfH, 1e-4f);
+        const __m128 nx0 = _mm_mul_ps(lx, _mm_set1_ps(1.0f / rx));
+        const __m128 nx1 = _mm_mul_ps(lx, _mm_set1_ps(1.0f / (rx * rx)));
+        const float ny0 = ly / ry, ny1 = ly / (ry * ry);
+        const __m128 k0 = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(nx0, nx0), _mm_set1_ps(ny0 * ny0)));
+        const __m128 k1 = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(nx1, nx1), _mm_set1_ps(ny1 * ny1)));
+        dist = _mm_div_ps(_mm_mul_ps(k0, _mm_sub_ps(k0, _mm_set1_ps(1.0f))), _mm_max_ps(k1, _mm_set1_ps(1e-4f)));
+    }
+    else
+    {
+        const int row = (ly > 0.0f) ? 2 : 0;
+        const __m128 right = _mm_cmpgt_ps(lx, zero);
+        const __m128 rounding = _mm_or_ps(_mm_and_ps(right, _mm_set1_ps(prim.ShapeRounding[row + 1])), _mm_andnot_ps(right, _mm_set1_ps(prim.ShapeRounding[row])));
+        const __m128 qx = _mm_add_ps(_mm_sub_ps(ImGui_ImplSoftRaster_Abs4(lx), _mm_set1_ps(prim.ShapeHalfW)), rounding);
+        const __m128 qy = _mm_add_ps(_mm_set1_ps(ImGui_ImplSoftRaster_Abs(ly) - prim.ShapeHalfH), rounding);
+        const __m128 ox = _mm_max_ps(qx, zero), oy = _mm_max_ps(qy, zero);
+        dist = _mm_sub_ps(_mm_add_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(ox, ox), _mm_mul_ps(oy, oy))), _mm_min_ps(_mm_max_ps(qx, qy), zero)), rounding);
+    }
+    if (prim.ShapeThickness > 0.0f)
+        dist = _mm_sub_ps(ImGui_ImplSoftRaster_Abs4(dist), _mm_set1_ps(prim.ShapeThickness * 0.5f));
+    return dist;
+}
+
+// Shade and blend pixels [x, x_end) of line 'py'. 'edge_row' holds the B * (y - Y) part of edge functions.
+static void ImGui_ImplSoftRaster_RasterSpan(const ImGui_ImplSoftRaster_Prim& prim, ImU32* dst, int x, int x_end, float py, const float edge_row[3])
+{
+    const int flags = prim.Flags;
+    const float fy = py - prim.OriginY;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 c255 = _mm_set1_ps(255.0f);
+    const __m128i mask_ff = _mm_set1_epi32(0xFF);
+    const __m128 lane_offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128i lane_indices = _mm_setr_epi32(0, 1, 2, 3);
+    const ImGui_ImplSoftRaster_Texture* tex = prim.Texture;
+    for (; x < x_end; x += 4, dst += 4)
+    {
+        const int count = (x_end - x < 4) ? x_end - x : 4;
+        const __m128 px = _mm_add_ps(_mm_set1_ps((float)x), lane_offsets);
+        __m128 mask = _mm_castsi128_ps(_mm_cmplt_epi32(lane_indices, _mm_set1_epi32(count)));
+        if (flags & ImGui_ImplSoftRaster_PrimFlags_Triangle)
+        {
+            for (int e = 0; e < 3; e++)
+            {
+                const __m128 edge = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(prim.EdgeA[e]), _mm_sub_ps(px, _mm_set1_ps(prim.EdgeX[e]))), _mm_set1_ps(edge_row[e]));
+                const __m128 inside = prim.EdgeTopLeft[e] ? _mm_cmpge_ps(edge, zero) : _mm_cmpgt_ps(edge, zero);
+                mask = _mm_and_ps(mask, inside);
+            }
+            if (_mm_movemask_ps(mask) == 0)
+                continue;
+        }
+
+        // Read destination
+        ImU32 tmp[4] = { 0, 0, 0, 0 };
+        ImU32* io_pixels = (count == 4) ? dst : tmp;
+        if (count < 4)
+            memcpy(tmp, dst, (size_t)count * sizeof(ImU32));
+        const __m128i d = _mm_loadu_si128((const __m128i*)(void*)io_pixels);
+
+        __m128i out;
+        if (flags & ImGui_ImplSoftRaster_PrimFlags_Opaque)
+        {
+            out = _mm_set1_epi32((int)prim.ConstPacked);
+        }
+        else
+        {
+            // Vertex color
+            const __m128 fx = _mm_sub_ps(px, _mm_set1_ps(prim.OriginX));
+            __m128 r, g, b, a;
+            if (flags & ImGui_ImplSoftRaster_PrimFlags_ConstColor)
+            {
+                r = _mm_set1_ps(prim.ConstCol[0]);
+                g = _mm_set1_ps(prim.ConstCol[1]);
+                b = _mm_set1_ps(prim.ConstCol[2]);
+                a = _mm_set1_ps(prim.ConstCol[3]);
+            }
+            else
+            {
+                r = ImGui_ImplSoftRaster_Plane(prim.Col[0], fy, fx);
+                g = ImGui_ImplSoftRaster_Plane(prim.Col[1], fy, fx);
+                b = ImGui_ImplSoftRaster_Plane(prim.Col[2], fy, fx);
+                a = ImGui_ImplSoftRaster_Plane(prim.Col[3], fy, fx);
+                if (flags & ImGui_ImplSoftRaster_PrimFlags_ConstTexel) // ConstCol[] holds the texel
+                {
+                    r = _mm_mul_ps(r, _mm_set1_ps(prim.ConstCol[0]));
+                    g = _mm_mul_ps(g, _mm_set1_ps(prim.ConstCol[1]));
+                    b = _mm_mul_ps(b, _mm_set1_ps(prim.ConstCol[2]));
+                    a = _mm_mul_ps(a, _mm_set1_ps(prim.ConstCol[3]));
+                }
+                r = _mm_min_ps(_mm_max_ps(r, zero), c255);
+                g = _mm_min_ps(_mm_max_ps(g, zero), c255);
+                b = _mm_min_ps(_mm_max_ps(b, zero), c255);
+            }
+
+            // Texture
+            if (!(flags & ImGui_ImplSoftRaster_PrimFlags_ConstTexel))
+            {
+                const __m128 u = _mm_min_ps(_mm_max_ps(ImGui_ImplSoftRaster_Plane(prim.U, fy, fx), zero), _mm_set1_ps((float)(tex->Width - 1)));
+                const __m128 v = _mm_min_ps(_mm_max_ps(ImGui_ImplSoftRaster_Plane(prim.V, fy, fx), zero), _mm_set1_ps((float)(tex->Height - 1)));
+                const __m128 iu = _mm_cvtepi32_ps(_mm_cvttps_epi32(u));
+                const __m128 iv = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+                int offsets[4];
+                _mm_storeu_si128((__m128i*)(void*)offsets, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(iv, _mm_set1_ps((float)tex->Width)), iu)));
+                if (tex->BytesPerPixel == 1)
+                {
+                    const unsigned char* src = (const unsigned char*)tex->Pixels;
+                    const __m128 ta = _mm_cvtepi32_ps(_mm_setr_epi32(src[offsets[0]], src[offsets[1]], src[offsets[2]], src[offsets[3]]));
+                    a = _mm_mul_ps(a, _mm_mul_ps(ta, _mm_set1_ps(1.0f / 255.0f)));
+                }
+                else
+                {
+                    const ImU32* src = (const ImU32*)tex->Pixels;
+                    const __m128i t = _mm_setr_epi32((int)src[offsets[0]], (int)src[offsets[1]], (int)src[offsets[2]], (int)src[offsets[3]]);
+                    const __m128 inv_255 = _mm_set1_ps(1.0f / 255.0f);
+                    r = _mm_mul_ps(r, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(t, IM_COL32_R_SHIFT), mask_ff)), inv_255));
+                    g = _mm_mul_ps(g, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(t, IM_COL32_G_SHIFT), mask_ff)), inv_255));
+                    b = _mm_mul_ps(b, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(t, IM_COL32_B_SHIFT), mask_ff)), inv_255));
+                    a = _mm_mul_ps(a, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(t, IM_COL32_A_SHIFT), mask_ff)), inv_255));
+                }
+            }
+
+            // Shape coverage
+            if (flags & ImGui_ImplSoftRaster_PrimFlags_Shape)
+            {
+                const __m128 dist = ImGui_ImplSoftRaster_ShapeDistance4(prim, fx, fy);
+                a = _mm_mul_ps(a, _mm_min_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(0.5f), dist), zero), one));
+            }
+            a = _mm_min_ps(_mm_max_ps(a, zero), one);
+            mask = _mm_and_ps(mask, _mm_cmpgt_ps(a, zero));
+
+            // Blend: RGB = src * a + dst * (1 - a), A = a + dst * (1 - a)
+            const __m128 inv_a = _mm_sub_ps(one, a);
+            const __m128 dr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(d, IM_COL32_R_SHIFT), mask_ff));
+            const __m128 dg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(d, IM_COL32_G_SHIFT), mask_ff));
+            const __m128 db = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(d, IM_COL32_B_SHIFT), mask_ff));
+            const __m128 da = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(d, IM_COL32_A_SHIFT), mask_ff));
+            const __m128i or_ = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(r, a), _mm_mul_ps(dr, inv_a)));
+            const __m128i og = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(g, a), _mm_mul_ps(dg, inv_a)));
+            const __m128i ob = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(b, a), _mm_mul_ps(db, inv_a)));
+            const __m128i oa = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(c255, a), _mm_mul_ps(da, inv_a)));
+            out = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(or_, IM_COL32_R_SHIFT), _mm_slli_epi32(og, IM_COL32_G_SHIFT)), _mm_or_si128(_mm_slli_epi32(ob, IM_COL32_B_SHIFT), _mm_slli_epi32(oa, IM_COL32_A_SHIFT)));
+        }
+
+        // Write covered pixels
+        const __m128i mask_i = _mm_castps_si128(mask);
+        _mm_storeu_si128((__m128i*)(void*)io_pixels, _mm_or_si128(_mm_and_si128(mask_i, out), _mm_andnot_si128(mask_i, d)));
+        if (count < 4)
+            memcpy(dst, tmp, (size_t)count * sizeof(ImU32));
+    }
+}
+
+#else
+
+static inline float ImGui_ImplSoftRaster_Plane(const float plane[3], float fx, float fy)
+{
+    return plane[0] + plane[1] * fx + plane[2] * fy;
+}
+
+// Shade and blend pixels [x, x_end) of line 'py'. 'edge_row' holds the B * (y - Y) part of edge functions.
+static void ImGui_ImplSoftRaster_RasterSpan(const ImGui_ImplSoftRaster_Prim& prim, ImU32* dst, int x, int x_end, float py, const float edge_row[3])
+{
+    const int flags = prim.Flags;
+    const float fy = py - prim.OriginY;
+    for (; x < x_end; x++, dst++)
+    {
+        const float px = (float)x + 0.5f;
+        if (flags & ImGui_ImplSoftRaster_PrimFlags_Triangle)
+        {
+            bool inside = true;
+            for (int e = 0; e < 3 && inside; e++)
+            {
+                const float edge = prim.EdgeA[e] * (px - prim.EdgeX[e]) + edge_row[e];
+                inside = prim.EdgeTopLeft[e] ? (edge >= 0.0f) : (edge > 0.0f);
+            }
+            if (!inside)
+                continue;
+        }
+        if (flags & ImGui_ImplSoftRaster_PrimFlags_Opaque)
+        {
+            *dst = prim.ConstPacked;
+            continue;
+        }
+
+        const float fx = px - prim.OriginX;
+        float col[4];
+        if (flags & ImGui_ImplSoftRaster_PrimFlags_ConstColor)
+        {
+            for (int c = 0; c < 4; c++)
+                col[c] = prim.ConstCol[c];
+        }
+        else
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                col[c] = ImGui_ImplSoftRaster_Plane(prim.Col[c], fx, fy);
+                if (flags & ImGui_ImplSoftRaster_PrimFlags_ConstTexel) // ConstCol[] holds the texel
+                    col[c] *= prim.ConstCol[c];
+            }
+            for (int c = 0; c < 3; c++)
+                col[c] = ImGui_ImplSoftRaster_Clamp(col[c], 0.0f, 255.0f);
+        }
+        if (!(flags & ImGui_ImplSoftRaster_PrimFlags_ConstTexel))
+        {
+            float texel[4];
+            ImGui_ImplSoftRaster_SampleTexel(prim.Texture, ImGui_ImplSoftRaster_Plane(prim.U, fx, fy), ImGui_ImplSoftRaster_Plane(prim.V, fx, fy), texel);
+            for (int c = 0; c < 4; c++)
+                col[c] *= texel[c];
+        }
+        if (flags & ImGui_ImplSoftRaster_PrimFlags_Shape)
+            col[3] *= ImGui_ImplSoftRaster_Clamp(0.5f - ImGui_ImplSoftRaster_ShapeDistance(prim, fx, fy), 0.0f, 1.0f);
+        const float a = ImGui_ImplSoftRaster_Clamp(col[3], 0.0f, 1.0f);
+        if (a <= 0.0f)
+            continue;
+
+        // Blend: RGB = src * a + dst * (1 - a), A = a + dst * (1 - a)
+        const ImU32 d = *dst;
+        const float inv_a = 1.0f - a;
+        const ImU32 r = (ImU32)(col[0] * a + ((d >> IM_COL32_R_SHIFT) & 0xFF) * inv_a + 0.5f);
+        const ImU32 g = (ImU32)(col[1] * a + ((d >> IM_COL32_G_SHIFT) & 0xFF) * inv_a + 0.5f);
+        const ImU32 b = (ImU32)(col[2] * a + ((d >> IM_COL32_B_SHIFT) & 0xFF) * inv_a + 0.5f);
+        const ImU32 al = (ImU32)(255.0f * a + ((d >> IM_COL32_A_SHIFT) & 0xFF) * inv_a + 0.5f);
+        *dst = (r << IM_COL32_R_SHIFT) | (g << IM_COL32_G_SHIFT) | (b << IM_COL32_B_SHIFT) | (al << IM_COL32_A_SHIFT);
+    }
+}
+
+#endif // #ifdef IMGUI_IMPL_SOFTRASTER_SSE
+
+static void ImGui_ImplSoftRaster_RasterPrim(ImGui_ImplSoftRaster_Data* bd, const ImGui_ImplSoftRaster_Prim& prim, int tile_x0, int tile_y0, int tile_x1, int tile_y1)
+{
+    const int x0 = ImGui_ImplSoftRaster_Max(prim.MinX, tile_x0), x1 = ImGui_ImplSoftRaster_Min(prim.MaxX, tile_x1);
+    const int y0 = ImGui_ImplSoftRaster_Max(prim.MinY, tile_y0), y1 = ImGui_ImplSoftRaster_Min(prim.MaxY, tile_y1);
+    float edge_row[3] = { 0.0f, 0.0f, 0.0f };
+    for (int y = y0; y < y1; y++)
+    {
+        const float py = (float)y + 0.5f;
+        int span_x0 = x0, span_x1 = x1;
+        if (prim.Flags & ImGui_ImplSoftRaster_PrimFlags_Triangle)
+        {
+            // Narrow span to where edge functions may be positive (conservatively: exact test is done per pixel)
+            for (int e = 0; e < 3; e++)
+            {
+                const float row = prim.EdgeB[e] * (py - prim.EdgeY[e]);
+                edge_row[e] = row;
+                const float a = prim.EdgeA[e];
+                if (a == 0.0f)
+                {
+                    if (row < 0.0f)
+                        span_x1 = span_x0;
+                    continue;
+                }
+                const float cross_x = ImGui_ImplSoftRaster_Clamp(prim.EdgeX[e] - row / a - 0.5f, (float)x0 - 1.0f, (float)x1 + 1.0f);
+                if (a > 0.0f)
+                    span_x0 = ImGui_ImplSoftRaster_Max(span_x0, (int)floorf(cross_x));
+                else
+                    span_x1 = ImGui_ImplSoftRaster_Min(span_x1, (int)ceilf(cross_x) + 1);
+            }
+            if (span_x0 >= span_x1)
+                continue;
+        }
+        ImU32* dst = (ImU32*)(void*)(bd->TargetPixels + (size_t)y * bd->TargetPitch) + span_x0;
+        ImGui_ImplSoftRaster_RasterSpan(prim, dst, span_x0, span_x1, py, edge_row);
+    }
+}
+
+static void ImGui_ImplSoftRaster_RasterTile(ImGui_ImplSoftRaster_Data* bd, int tile_idx)
+{
+    const int tile_x0 = (tile_idx % bd->TilesX) * IMGUI_IMPL_SOFTRASTER_TILE_SIZE;
+    const int tile_y0 = (tile_idx / bd->TilesX) * IMGUI_IMPL_SOFTRASTER_TILE_SIZE;
+    const int tile_x1 = ImGui_ImplSoftRaster_Min(tile_x0 + IMGUI_IMPL_SOFTRASTER_TILE_SIZE, bd->TargetWidth);
+    const int tile_y1 = ImGui_ImplSoftRaster_Min(tile_y0 + IMGUI_IMPL_SOFTRASTER_TILE_SIZE, bd->TargetHeight);
+    for (int n = bd->TileOffsets[tile_idx]; n < bd->TileOffsets[tile_idx + 1]; n++)
+        ImGui_ImplSoftRaster_RasterPrim(bd, bd->Prims[bd->TilePrims[n]], tile_x0, tile_y0, tile_x1, tile_y1);
+}
+
+// Bin primitives into tiles and rasterize them
+static void ImGui_ImplSoftRaster_Flush(ImGui_ImplSoftRaster_Data* bd)
+{
+    if (bd->Prims.Size == 0)
+        return;
+
+    // Count primitives per tile, then store primitive indices in submission order
+    const int tiles_count = bd->TilesX * bd->TilesY;
+    bd->TileOffsets.resize(tiles_count + 1);
+    memset(bd->TileOffsets.Data, 0, (size_t)bd->TileOffsets.size_in_bytes());
+    for (const ImGui_ImplSoftRaster_Prim& prim : bd->Prims)
+        for (int ty = prim.MinY / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; ty <= (prim.MaxY - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; ty++)
+            for (int tx = prim.MinX / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; tx <= (prim.MaxX - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; tx++)
+                bd->TileOffsets[ty * bd->TilesX + tx + 1]++;
+    bd->ActiveTiles.resize(0);
+    for (int tile_n = 0; tile_n < tiles_count; tile_n++)
+    {
+        if (bd->TileOffsets[tile_n + 1] > 0)
+            bd->ActiveTiles.push_back(tile_n);
+        bd->TileOffsets[tile_n + 1] += bd->TileOffsets[tile_n];
+    }
+    bd->TilePrims.resize(bd->TileOffsets[tiles_count]);
+    for (int prim_n = 0; prim_n < bd->Prims.Size; prim_n++)
+    {
+        const ImGui_ImplSoftRaster_Prim& prim = bd->Prims[prim_n];
+        for (int ty = prim.MinY / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; ty <= (prim.MaxY - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; ty++)
+            for (int tx = prim.MinX / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; tx <= (prim.MaxX - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; tx++)
+                bd->TilePrims[bd->TileOffsets[ty * bd->TilesX + tx]++] = prim_n;
+    }
+    for (int tile_n = tiles_count; tile_n > 0; tile_n--) // Offsets were advanced to the end of each tile: shift them back
+        bd->TileOffsets[tile_n] = bd->TileOffsets[tile_n - 1];
+    bd->TileOffsets[0] = 0;
+
+    // Rasterize
+#ifndef IMGUI_IMPL_SOFTRASTER_DISABLE_THREADS
+    ImGui_ImplSoftRaster_ThreadPool* pool = bd->Pool;
+    if (pool != nullptr && bd->ActiveTiles.Size > 1)
+    {
+        {
+            std::lock_guard<std::mutex> lock(pool->Mutex);
+            pool->NextJob = 0;
+            pool->BusyCount = pool->Threads.Size;
+            pool->Generation++;
+        }
+        pool->WakeCond.notify_all();
+        ImGui_ImplSoftRaster_RunJobs(bd);
+        std::unique_lock<std::mutex> lock(pool->Mutex);
+        pool->DoneCond.wait(lock, [&] { return pool->BusyCount == 0; });
+    }
+    else
+#endif
+    {
+        for (int tile_idx : bd->ActiveTiles)
+            ImGui_ImplSoftRaster_RasterTile(bd, tile_idx);
+    }
+    bd->Prims.resize(0);
+}
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+
+bool    ImGui_ImplSoftRaster_Init(int threads_count)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IMGUI_CHECKVERSION();
+    IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
+
+    // Setup backend capabilities flags
+    ImGui_ImplSoftRaster_Data* bd = IM_NEW(ImGui_ImplSoftRaster_Data)();
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_softraster";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;          // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasRectInstances;      // We can honor ImDrawCmd::InstCount, rendering rectangles from ImDrawList::InstBuffer (used when io.ConfigDrawRectInstances is set).
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasSdfShapes;          // We can honor all ImDrawRectInstance shape fields (rounding corners, thickness, ellipse).
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates;         // We can update parts of the font texture modified after its creation.
+
+#ifndef IMGUI_IMPL_SOFTRASTER_DISABLE_THREADS
+    if (threads_count <= 0)
+        threads_count = (int)std::thread::hardware_concurrency();
+    bd->ThreadsCount = ImGui_ImplSoftRaster_Min(ImGui_ImplSoftRaster_Max(threads_count, 1), 64);
+    ImGui_ImplSoftRaster_CreateThreads(bd);
+#else
+    IM_UNUSED(threads_count);
+#endif
+    return true;
+}
+
+void    ImGui_ImplSoftRaster_Shutdown()
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    ImGui_ImplSoftRaster_DestroyFontsTexture();
+#ifndef IMGUI_IMPL_SOFTRASTER_DISABLE_THREADS
+    ImGui_ImplSoftRaster_DestroyThreads(bd);
+#endif
+    io.BackendRendererName = nullptr;
+    io.BackendRendererUserData = nullptr;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasRectInstances | ImGuiBackendFlags_RendererHasSdfShapes | ImGuiBackendFlags_RendererHasTexUpdates);
+    IM_DELETE(bd);
+}
+
+void    ImGui_ImplSoftRaster_NewFrame()
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoftRaster_Init()?");
+
+    if (!bd->FontTexture.Pixels)
+        ImGui_ImplSoftRaster_CreateFontsTexture();
+}
+
+// Copy lines of the font texture modified since last call (ImFontAtlasFlags_DynamicGlyphs, ImFontAtlasFlags_IncrementalBuild)
+static void ImGui_ImplSoftRaster_UpdateFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    int x, y, w, h;
+    if (bd->FontTexture.Pixels == nullptr || !io.Fonts->GetTexDataUpdateRect(&x, &y, &w, &h))
+        return;
+    if ((io.Fonts->TexPixelsUseColors && bd->FontTexture.BytesPerPixel == 1) || io.Fonts->TexHeight != bd->FontTexture.Height)
+    {
+        ImGui_ImplSoftRaster_CreateFontsTexture(); // First colored glyph: switch to RGBA texture. Texture grew: copy it again.
+        return;
+    }
+    unsigned char* pixels;
+    int width, height, bytes_per_pixel;
+    if (bd->FontTexture.BytesPerPixel == 4)
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height, &bytes_per_pixel);
+    else
+        io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height, &bytes_per_pixel);
+    const size_t offset = (size_t)y * width * bytes_per_pixel;
+    memcpy(bd->FontPixels.Data + offset, pixels + offset, (size_t)h * width * bytes_per_pixel);
+}
+
+void    ImGui_ImplSoftRaster_RenderDrawData(ImDrawData* draw_data, void* pixels, int width, int height, int pitch)
+{
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoftRaster_Init()?");
+    IM_ASSERT(pixels != nullptr && pitch >= width * 4);
+    if (width <= 0 || height <= 0)
+        return;
+
+    // Copy font texture pixels modified by glyphs loaded on demand
+    ImGui_ImplSoftRaster_UpdateFontsTexture();
+
+    bd->TargetPixels = (unsigned char*)pixels;
+    bd->TargetWidth = width;
+    bd->TargetHeight = height;
+    bd->TargetPitch = pitch;
+    bd->TilesX = (width + IMGUI_IMPL_SOFTRASTER_TILE_SIZE - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE;
+    bd->TilesY = (height + IMGUI_IMPL_SOFTRASTER_TILE_SIZE - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE;
+    bd->Prims.resize(0);
+
+    // Will project scissor/clipping rectangles into framebuffer space
+    const ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+    const ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+    ImGui_ImplSoftRaster_Prim prim;
+    memset((void*)&prim, 0, sizeof(prim));
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != nullptr)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                ImGui_ImplSoftRaster_Flush(bd);
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(draw_list, pcmd);
+                continue;
+            }
+
+            // Project scissor/clipping rectangles into framebuffer space
+            int clip[4];
+            clip[0] = (int)ImGui_ImplSoftRaster_Clamp((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, 0.0f, (float)width);
+            clip[1] = (int)ImGui_ImplSoftRaster_Clamp((pcmd->ClipRect.y - clip_off.y) * clip_scale.y, 0.0f, (float)height);
+            clip[2] = (int)ImGui_ImplSoftRaster_Clamp((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, 0.0f, (float)width);
+            clip[3] = (int)ImGui_ImplSoftRaster_Clamp((pcmd->ClipRect.w - clip_off.y) * clip_scale.y, 0.0f, (float)height);
+            if (clip[2] <= clip[0] || clip[3] <= clip[1])
+                continue;
+
+            const ImGui_ImplSoftRaster_Texture* tex = (const ImGui_ImplSoftRaster_Texture*)(intptr_t)pcmd->GetTexID();
+            if (pcmd->InstCount > 0)
+            {
+                for (unsigned int inst_n = 0; inst_n < pcmd->InstCount; inst_n++)
+                {
+                    prim.Texture = tex;
+                    if (ImGui_ImplSoftRaster_SetupRectInstance(&prim, &draw_list->InstBuffer[pcmd->InstOffset + inst_n], clip_off, clip_scale, clip))
+                        bd->Prims.push_back(prim);
+                }
+                continue;
+            }
+            const ImDrawIdx* idx = draw_list->IdxBuffer.Data + pcmd->IdxOffset;
+            const ImDrawVert* vtx = draw_list->VtxBuffer.Data + pcmd->VtxOffset;
+            for (unsigned int idx_n = 0; idx_n + 2 < pcmd->ElemCount; idx_n += 3)
+            {
+                const ImDrawVert* tri[3] = { &vtx[idx[idx_n]], &vtx[idx[idx_n + 1]], &vtx[idx[idx_n + 2]] };
+                prim.Texture = tex;
+                if (ImGui_ImplSoftRaster_SetupTriangle(&prim, tri, clip_off, clip_scale, clip))
+                    bd->Prims.push_back(prim);
+            }
+        }
+    }
+    ImGui_ImplSoftRaster_Flush(bd);
+}
+
+bool ImGui_ImplSoftRaster_CreateFontsTexture()
+{
+    // Build texture atlas. Keep a copy of the pixels as the application may clear the atlas data.
+    // Use alpha only texture unless the atlas has colored glyphs.
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    unsigned char* pixels;
+    int width, height, bytes_per_pixel;
+    if (io.Fonts->TexPixelsUseColors)
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height, &bytes_per_pixel);
+    else
+        io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height, &bytes_per_pixel);
+    bd->FontPixels.resize(width * height * bytes_per_pixel);
+    memcpy(bd->FontPixels.Data, pixels, (size_t)bd->FontPixels.Size);
+    bd->FontTexture.Pixels = bd->FontPixels.Data;
+    bd->FontTexture.Width = width;
+    bd->FontTexture.Height = height;
+    bd->FontTexture.BytesPerPixel = bytes_per_pixel;
+
+    // Store our identifier
+    io.Fonts->SetTexID((ImTextureID)(intptr_t)&bd->FontTexture);
+    return true;
+}
+
+void ImGui_ImplSoftRaster_DestroyFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoftRaster_Data* bd = ImGui_ImplSoftRaster_GetBackendData();
+    if (bd->FontTexture.Pixels)
+    {
+        bd->FontPixels.clear();
+        memset((void*)&bd->FontTexture, 0, sizeof(bd->FontTexture));
+        io.Fonts->SetTexID(0);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+#endif // #ifndef IMGUI_DISABLE
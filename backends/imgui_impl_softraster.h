@@ -0,0 +1,50 @@
+// dear imgui: Renderer Backend for software rasterization (CPU only, no graphics API)
+// This needs to be used along with a Platform Backend (e.g. GLFW, SDL, Win32, custom..), or none for headless applications.
+// Output is a 32-bit RGBA pixel buffer that you can display, stream (e.g. VNC) or save (e.g. screenshots, reference images for tests).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftRaster_Texture*' as texture identifier. Read the FAQ about ImTextureID!
+//  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
+//  [X] Renderer: Instanced rectangles (ImGuiBackendFlags_RendererHasRectInstances).
+//  [X] Renderer: Signed distance rounded rectangles, circles and ellipses (ImGuiBackendFlags_RendererHasSdfShapes).
+//  [X] Renderer: Partial font texture updates (ImGuiBackendFlags_RendererHasTexUpdates), for ImFontAtlasFlags_DynamicGlyphs and ImFontAtlasFlags_IncrementalBuild.
+//  [X] Renderer: Multi-threaded rasterization. Output doesn't depend on number of threads.
+// Missing features or Issues:
+//  [ ] Renderer: Textures are sampled with nearest filtering.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+#ifndef IMGUI_DISABLE
+
+// A texture that can be sampled by the rasterizer. Pass '(ImTextureID)(intptr_t)&my_texture' to ImGui::Image() etc.
+// Pixels are not copied and need to stay valid while rendering.
+struct ImGui_ImplSoftRaster_Texture
+{
+    const void*     Pixels;         // Width * Height pixels, no padding between lines.
+    int             Width;
+    int             Height;
+    int             BytesPerPixel;  // 1: alpha only (color is white), 4: RGBA (same byte order as ImU32 colors built with IM_COL32())
+};
+
+// Follow "Getting Started" link and check examples/ folder to learn about using backends!
+// - threads_count: 0 = one per hardware thread, 1 = rasterize on calling thread only.
+// - RenderDrawData() blends into 'pixels' (32-bit per pixel, same byte order as IM_COL32()), which your application needs to clear first.
+//   'pitch' is the number of bytes between two lines. Pixels are mapped to draw_data->DisplayPos, scaled by draw_data->FramebufferScale.
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_Init(int threads_count = 0);
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_NewFrame();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_RenderDrawData(ImDrawData* draw_data, void* pixels, int width, int height, int pitch);
+
+// Called by Init/NewFrame/Shutdown
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_CreateFontsTexture();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_DestroyFontsTexture();
+
+#endif // #ifndef IMGUI_DISABLE
@@ -5,6 +5,8 @@
 //  [!] Renderer: User texture binding. Use 'VkDescriptorSet' as ImTextureID. Call ImGui_ImplVulkan_AddTexture() to register one. Read the FAQ about ImTextureID! See https://github.com/ocornut/imgui/pull/914 for discussions.
 //  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
 //  [X] Renderer: Expose selected render state for draw callbacks to use. Access in '(ImGui_ImplXXXX_RenderState*)GetPlatformIO().Renderer_RenderState'.
+// Missing features or Issues:
+//  [ ] Renderer: Signed distance field font atlas (ImGuiBackendFlags_RendererHasSdfFonts). ImFontAtlasFlags_SignedDistanceField asserts when creating the font texture.
 
 // The aim of imgui_impl_vulkan.h/.cpp is to be usable in your engine without any modification.
 // IF YOU FEEL YOU NEED TO MAKE ANY CHANGE TO THIS CODE, please share them and your feedback at https://github.com/ocornut/imgui/
@@ -26,6 +28,8 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2025-02-23: Vulkan: Added support for IMGUI_USE_COMPACT_DRAWVERT (12 bytes vertices with 16-bit fixed-point positions and 16-bit normalized UVs).
+//  2025-02-22: Vulkan: Skip uploading vertex/index buffers when the frame buffers already hold the same ImDrawData contents (requires io.ConfigDrawDataChangeDetection).
 //  2025-01-09: Vulkan: Added IMGUI_IMPL_VULKAN_MINIMUM_IMAGE_SAMPLER_POOL_SIZE to clarify how many image sampler descriptors are expected to be available in descriptor pool. (#6642)
 //  2025-01-06: Vulkan: Added more ImGui_ImplVulkanH_XXXX helper functions to simplify our examples.
 //  2024-12-11: Vulkan: Fixed setting VkSwapchainCreateInfoKHR::preTransform for platforms not supporting VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR. (#8222)
@@ -208,6 +212,7 @@ struct ImGui_ImplVulkan_FrameRenderBuffers
     VkDeviceSize        IndexBufferSize;
     VkBuffer            VertexBuffer;
     VkBuffer            IndexBuffer;
+    ImU64               ContentHash;        // ImDrawData::ContentHash of the data currently held by VertexBuffer/IndexBuffer, or 0
 };
 
 // Each viewport will hold 1 ImGui_ImplVulkanH_WindowRenderBuffers
@@ -480,6 +485,11 @@ static void ImGui_ImplVulkan_SetupRenderState(ImDrawData* draw_data, VkPipeline
         float translate[2];
         translate[0] = -1.0f - draw_data->DisplayPos.x * scale[0];
         translate[1] = -1.0f - draw_data->DisplayPos.y * scale[1];
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+        // Compact ImDrawVert positions are read as R16G16_SNORM (== value / 32767): fold fixed-point scale into our scale.
+        scale[0] *= 32767.0f / IM_DRAWVERT_POS_SCALE;
+        scale[1] *= 32767.0f / IM_DRAWVERT_POS_SCALE;
+#endif
         vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 0, sizeof(float) * 2, scale);
         vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 2, sizeof(float) * 2, translate);
     }
@@ -518,36 +528,49 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
         VkDeviceSize vertex_size = AlignBufferSize(draw_data->TotalVtxCount * sizeof(ImDrawVert), bd->BufferMemoryAlignment);
         VkDeviceSize index_size = AlignBufferSize(draw_data->TotalIdxCount * sizeof(ImDrawIdx), bd->BufferMemoryAlignment);
         if (rb->VertexBuffer == VK_NULL_HANDLE || rb->VertexBufferSize < vertex_size)
+        {
             CreateOrResizeBuffer(rb->VertexBuffer, rb->VertexBufferMemory, rb->VertexBufferSize, vertex_size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+            rb->ContentHash = 0;
+        }
         if (rb->IndexBuffer == VK_NULL_HANDLE || rb->IndexBufferSize < index_size)
+        {
             CreateOrResizeBuffer(rb->IndexBuffer, rb->IndexBufferMemory, rb->IndexBufferSize, index_size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+            rb->ContentHash = 0;
+        }
 
-        // Upload vertex/index data into a single contiguous GPU buffer
-        ImDrawVert* vtx_dst = nullptr;
-        ImDrawIdx* idx_dst = nullptr;
-        VkResult err = vkMapMemory(v->Device, rb->VertexBufferMemory, 0, vertex_size, 0, (void**)&vtx_dst);
-        check_vk_result(err);
-        err = vkMapMemory(v->Device, rb->IndexBufferMemory, 0, index_size, 0, (void**)&idx_dst);
-        check_vk_result(err);
-        for (int n = 0; n < draw_data->CmdListsCount; n++)
+        // Skip uploading when this frame's buffers already hold the same contents (see io.ConfigDrawDataChangeDetection).
+        // As we cycle through one set of buffers per in-flight frame, this happens once the ImDrawData stayed unchanged for ImageCount frames.
+        const bool skip_upload = (draw_data->ContentHash != 0 && draw_data->ContentHash == rb->ContentHash);
+        rb->ContentHash = draw_data->ContentHash;
+        if (!skip_upload)
         {
-            const ImDrawList* draw_list = draw_data->CmdLists[n];
-            memcpy(vtx_dst, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
-            memcpy(idx_dst, draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
-            vtx_dst += draw_list->VtxBuffer.Size;
-            idx_dst += draw_list->IdxBuffer.Size;
+            // Upload vertex/index data into a single contiguous GPU buffer
+            ImDrawVert* vtx_dst = nullptr;
+            ImDrawIdx* idx_dst = nullptr;
+            VkResult err = vkMapMemory(v->Device, rb->VertexBufferMemory, 0, vertex_size, 0, (void**)&vtx_dst);
+            check_vk_result(err);
+            err = vkMapMemory(v->Device, rb->IndexBufferMemory, 0, index_size, 0, (void**)&idx_dst);
+            check_vk_result(err);
+            for (int n = 0; n < draw_data->CmdListsCount; n++)
+            {
+                const ImDrawList* draw_list = draw_data->CmdLists[n];
+                memcpy(vtx_dst, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
+                memcpy(idx_dst, draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+                vtx_dst += draw_list->VtxBuffer.Size;
+                idx_dst += draw_list->IdxBuffer.Size;
+            }
+            VkMappedMemoryRange range[2] = {};
+            range[0].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+            range[0].memory = rb->VertexBufferMemory;
+            range[0].size = VK_WHOLE_SIZE;
+            range[1].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+            range[1].memory = rb->IndexBufferMemory;
+            range[1].size = VK_WHOLE_SIZE;
+            err = vkFlushMappedMemoryRanges(v->Device, 2, range);
+            check_vk_result(err);
+            vkUnmapMemory(v->Device, rb->VertexBufferMemory);
+            vkUnmapMemory(v->Device, rb->IndexBufferMemory);
         }
-        VkMappedMemoryRange range[2] = {};
-        range[0].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        range[0].memory = rb->VertexBufferMemory;
-        range[0].size = VK_WHOLE_SIZE;
-        range[1].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        range[1].memory = rb->IndexBufferMemory;
-        range[1].size = VK_WHOLE_SIZE;
-        err = vkFlushMappedMemoryRanges(v->Device, 2, range);
-        check_vk_result(err);
-        vkUnmapMemory(v->Device, rb->VertexBufferMemory);
-        vkUnmapMemory(v->Device, rb->IndexBufferMemory);
     }
 
     // Setup desired Vulkan state
@@ -637,6 +660,9 @@ bool ImGui_ImplVulkan_CreateFontsTexture()
     ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
     VkResult err;
 
+    // Our shaders don't threshold distance fields: glyphs would be rendered as blurry boxes
+    IM_ASSERT(!(io.Fonts->Flags & ImFontAtlasFlags_SignedDistanceField) && "ImFontAtlasFlags_SignedDistanceField is not supported by the Vulkan backend!");
+
     // Destroy existing texture (if any)
     if (bd->FontTexture.DescriptorSet)
     {
@@ -892,11 +918,19 @@ static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationC
     VkVertexInputAttributeDescription attribute_desc[3] = {};
     attribute_desc[0].location = 0;
     attribute_desc[0].binding = binding_desc[0].binding;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    attribute_desc[0].format = VK_FORMAT_R16G16_SNORM;  // Fixed-point, see ImGui_ImplVulkan_SetupRenderState(). (SNORM has mandatory vertex buffer support, SSCALED doesn't)
+#else
     attribute_desc[0].format = VK_FORMAT_R32G32_SFLOAT;
+#endif
     attribute_desc[0].offset = offsetof(ImDrawVert, pos);
     attribute_desc[1].location = 1;
     attribute_desc[1].binding = binding_desc[0].binding;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    attribute_desc[1].format = VK_FORMAT_R16G16_UNORM;
+#else
     attribute_desc[1].format = VK_FORMAT_R32G32_SFLOAT;
+#endif
     attribute_desc[1].offset = offsetof(ImDrawVert, uv);
     attribute_desc[2].location = 2;
     attribute_desc[2].binding = binding_desc[0].binding;
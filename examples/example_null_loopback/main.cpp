@@ -0,0 +1,124 @@
+// dear imgui: "null" loopback example application
+// (compile and link imgui, create context, run headless with simulated inputs, NO GRAPHICS OUTPUT)
+// Draw data is encoded with misc/drawdata_stream/ and decoded back in the same process, as a remote renderer would do.
+// Prints the number of bytes transmitted per frame and verifies that decoded draw data matches the original.
+#include "imgui.h"
+#include "imgui_drawdata_stream.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// Our "connection": a byte buffer holding the last message
+static void WriteToBuffer(const void* data, size_t size, void* user_data)
+{
+    ImVector<unsigned char>* buf = (ImVector<unsigned char>*)user_data;
+    buf->resize((int)size);
+    memcpy(buf->Data, data, size);
+}
+
+template<typename T>
+static bool BuffersMatch(const ImVector<T>& a, const ImVector<T>& b)
+{
+    return a.Size == b.Size && (a.Size == 0 || memcmp(a.Data, b.Data, (size_t)a.Size * sizeof(T)) == 0);
+}
+
+static bool DrawDataMatch(const ImDrawData* a, const ImDrawData* b)
+{
+    if (a->CmdListsCount != b->CmdListsCount || a->DisplaySize.x != b->DisplaySize.x || a->DisplaySize.y != b->DisplaySize.y)
+        return false;
+    for (int list_n = 0; list_n < a->CmdListsCount; list_n++)
+    {
+        const ImDrawList* la = a->CmdLists[list_n];
+        const ImDrawList* lb = b->CmdLists[list_n];
+        if (!BuffersMatch(la->VtxBuffer, lb->VtxBuffer) || !BuffersMatch(la->IdxBuffer, lb->IdxBuffer) || !BuffersMatch(la->InstBuffer, lb->InstBuffer) || la->CmdBuffer.Size != lb->CmdBuffer.Size)
+            return false;
+        for (int cmd_n = 0; cmd_n < la->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd& ca = la->CmdBuffer[cmd_n];
+            const ImDrawCmd& cb = lb->CmdBuffer[cmd_n];
+            if (memcmp(&ca.ClipRect, &cb.ClipRect, sizeof(ImVec4)) != 0 || ca.TextureId != cb.TextureId || ca.VtxOffset != cb.VtxOffset || ca.IdxOffset != cb.IdxOffset ||
+                ca.ElemCount != cb.ElemCount || ca.InstOffset != cb.InstOffset || ca.InstCount != cb.InstCount || ca.UserCallback != cb.UserCallback)
+                return false;
+        }
+    }
+    return true;
+}
+
+int main(int, char**)
+{
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+
+    // Build atlas
+    unsigned char* tex_pixels = nullptr;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    io.Fonts->SetTexID((ImTextureID)1);
+
+    ImDrawDataStreamWriter writer;
+    ImDrawDataStreamReader reader;
+    ImVector<unsigned char> connection;
+
+    const int frames_count = 300;
+    int key_frames_count = 0, key_frames_bytes = 0;
+    int delta_frames_count = 0, delta_frames_bytes = 0, raw_bytes = 0;
+    int errors_count = 0;
+    for (int n = 0; n < frames_count; n++)
+    {
+        // Simulate a user moving the mouse around, clicking and scrolling
+        io.DisplaySize = ImVec2(1920, 1080);
+        io.DeltaTime = 1.0f / 60.0f;
+        const float t = n * 0.05f;
+        io.AddMousePosEvent(750.0f + cosf(t) * 100.0f, 250.0f + sinf(t * 1.3f) * 200.0f);
+        io.AddMouseButtonEvent(0, (n % 40) >= 20 && (n % 40) < 22);
+        io.AddMouseWheelEvent(0.0f, (n % 50) == 25 ? -1.0f : 0.0f);
+        ImGui::NewFrame();
+        ImGui::ShowDemoWindow(nullptr);
+        ImGui::Render();
+
+        // Send
+        if (n == frames_count / 2)
+        {
+            // Simulate a new client connecting: it needs a key frame
+            reader.Clear();
+            writer.RequestKeyFrame();
+        }
+        writer.SetTexture(io.Fonts->TexID, tex_w, tex_h, tex_pixels, 4);
+        writer.WriteFrame(ImGui::GetDrawData(), WriteToBuffer, &connection);
+
+        // Receive
+        if (!reader.ReadFrame(connection.Data, (size_t)connection.Size) || !DrawDataMatch(ImGui::GetDrawData(), &reader.DrawData))
+        {
+            printf("Frame %d: decoded draw data doesn't match!\n", n);
+            errors_count++;
+        }
+        if (reader.FindTexture(io.Fonts->TexID) == nullptr)
+            errors_count++;
+
+        // Stats
+        if (n == 0 || n == frames_count / 2)
+        {
+            key_frames_count++;
+            key_frames_bytes += writer.LastFrameSize;
+        }
+        else
+        {
+            delta_frames_count++;
+            delta_frames_bytes += writer.LastFrameSize;
+        }
+        raw_bytes += writer.LastFrameRawSize;
+    }
+
+    printf("Frames: %d, errors: %d\n", frames_count, errors_count);
+    printf("Key frames (including %d KB texture): %d bytes\n", (tex_w * tex_h * 4) / 1024, key_frames_bytes / key_frames_count);
+    printf("Delta frames: %d bytes/frame on average\n", delta_frames_bytes / delta_frames_count);
+    printf("Raw draw data: %d bytes/frame on average\n", raw_bytes / frames_count);
+
+    writer.Clear();
+    reader.Clear();
+    printf("DestroyContext()\n");
+    ImGui::DestroyContext();
+    return errors_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,3 @@
+@REM Build for Visual Studio compiler. Run your copy of vcvars32.bat or vcvarsall.bat to setup command-line compiler.
+mkdir Release
+cl /nologo /Zi /MD /O2 /utf-8 /I ..\.. /I ..\..\backends %* *.cpp ..\..\*.cpp ..\..\backends\imgui_impl_softraster.cpp /FeRelease/example_null_softraster.exe /FoRelease/ /link gdi32.lib shell32.lib imm32.lib
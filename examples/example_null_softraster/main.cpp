@@ -0,0 +1,82 @@
+// dear imgui: "null" example application with software rasterizer
+// (compile and link imgui, create context, run headless with simulated inputs, render into a memory buffer)
+// Usage: example_null_softraster [screenshot.tga] [threads_count]
+// This is useful to produce screenshots and measure rendering cost on machines without a GPU.
+#include "imgui.h"
+#include "imgui_impl_softraster.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+// Save 32-bit RGBA pixels (IM_COL32 byte order) as an uncompressed TGA file
+static bool SaveTGA(const char* filename, const ImU32* pixels, int width, int height)
+{
+    FILE* f = fopen(filename, "wb");
+    if (f == nullptr)
+        return false;
+    const unsigned char header[18] = { 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, (unsigned char)(width & 0xFF), (unsigned char)(width >> 8), (unsigned char)(height & 0xFF), (unsigned char)(height >> 8), 32, 0x28 };
+    fwrite(header, 1, sizeof(header), f);
+    for (int n = 0; n < width * height; n++)
+    {
+        const ImU32 c = pixels[n];
+        const unsigned char bgra[4] = { (unsigned char)(c >> IM_COL32_B_SHIFT), (unsigned char)(c >> IM_COL32_G_SHIFT), (unsigned char)(c >> IM_COL32_R_SHIFT), (unsigned char)(c >> IM_COL32_A_SHIFT) };
+        fwrite(bgra, 1, 4, f);
+    }
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    const char* screenshot_filename = (argc > 1) ? argv[1] : nullptr;
+    const int threads_count = (argc > 2) ? atoi(argv[2]) : 0;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.ConfigDrawRectInstances = true;
+    ImGui_ImplSoftRaster_Init(threads_count);
+
+    const int width = 1280, height = 800;
+    ImVector<ImU32> framebuffer;
+    framebuffer.resize(width * height);
+    const ImU32 clear_color = IM_COL32(115, 140, 153, 255);
+
+    const int frames_count = 120;
+    double render_time = 0.0;
+    for (int n = 0; n < frames_count; n++)
+    {
+        // Simulate a user moving the mouse around and clicking
+        io.DisplaySize = ImVec2((float)width, (float)height);
+        io.DeltaTime = 1.0f / 60.0f;
+        const float t = n * 0.05f;
+        io.AddMousePosEvent(750.0f + cosf(t) * 100.0f, 250.0f + sinf(t * 1.3f) * 200.0f);
+        io.AddMouseButtonEvent(0, (n % 40) >= 20 && (n % 40) < 22);
+
+        ImGui_ImplSoftRaster_NewFrame();
+        ImGui::NewFrame();
+        ImGui::ShowDemoWindow(nullptr);
+        ImGui::Render();
+
+        const auto time_start = std::chrono::high_resolution_clock::now();
+        for (ImU32& pixel : framebuffer)
+            pixel = clear_color;
+        ImGui_ImplSoftRaster_RenderDrawData(ImGui::GetDrawData(), framebuffer.Data, width, height, width * (int)sizeof(ImU32));
+        render_time += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - time_start).count();
+    }
+    printf("Rendered %d frames at %dx%d: %.3f ms/frame on average\n", frames_count, width, height, render_time * 1000.0 / frames_count);
+
+    if (screenshot_filename != nullptr)
+    {
+        if (SaveTGA(screenshot_filename, framebuffer.Data, width, height))
+            printf("Saved '%s'\n", screenshot_filename);
+        else
+            printf("Failed to save '%s'\n", screenshot_filename);
+    }
+
+    ImGui_ImplSoftRaster_Shutdown();
+    ImGui::DestroyContext();
+    return 0;
+}
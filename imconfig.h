@@ -50,6 +50,7 @@
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_DEFAULT_FONT                        // Disable default embedded font (ProggyClean.ttf), remove ~9.5 KB from output binary. AddFontDefault() will assert.
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
+//#define IMGUI_DISABLE_NEON                                // Disable use of NEON intrinsics even if available
 
 //---- Enable Test Engine / Automation features.
 //#define IMGUI_ENABLE_TEST_ENGINE                          // Enable imgui_test_engine hooks. Generally set automatically by include "imgui_te_config.h", see Test Engine for details.
@@ -119,6 +120,14 @@
 // Read about ImGuiBackendFlags_RendererHasVtxOffset for details.
 //#define ImDrawIdx unsigned int
 
+//---- Use a compact 12 bytes ImDrawVert (16-bit fixed-point positions, 16-bit normalized texture coordinates) instead of the default 20 bytes.
+// Reduces vertex memory and upload bandwidth by 40%. Your renderer backend will need to support it (the OpenGL3 and Vulkan backends do).
+// Positions are stored with IM_DRAWVERT_POS_FRAC_BITS fractional bits (default 3 = 1/8th of a pixel, positions within [-4096,+4096)).
+// Positions beyond that range are clamped, not clipped: shapes crossing it are visibly distorted. Don't use with viewports/framebuffers larger than 4096 pixels,
+// or lower IM_DRAWVERT_POS_FRAC_BITS (2 = +/-8192). With IMGUI_DEBUG_PARANOID, out-of-range positions assert.
+//#define IMGUI_USE_COMPACT_DRAWVERT
+//#define IM_DRAWVERT_POS_FRAC_BITS 3
+
 //---- Override ImDrawCallback signature (will need to modify renderer backends accordingly)
 //struct ImDrawList;
 //struct ImDrawCmd;
@@ -430,6 +430,8 @@ CODE
  When you are not sure about an old symbol or function name, try using the Search/Find function of your IDE to look for comments or references in all imgui files.
  You can read releases logs https://github.com/ocornut/imgui/releases for more details.
 
+ - 2025/02/24 (1.91.9) - drawlist: rectangle instances are now opt-in with io.ConfigDrawRectInstances, even when the backend sets ImGuiBackendFlags_RendererHasRectInstances. When enabled, code post-processing vertices (e.g. ShadeVertsXXX functions) needs to clear ImDrawListFlags_AllowRectInstances in draw_list->Flags around its drawing.
+ - 2025/02/10 (1.91.9) - fonts: ImFont::IndexAdvanceX[] and ImFont::IndexLookup[] are now paged: use ImFont::GetIndexSlot(c) instead of indexing them with a codepoint. removed ImFont::GrowIndex(), use ImFont::AllocIndexSlot().
  - 2025/02/06 (1.91.9) - renamed ImFontConfig::GlyphExtraSpacing.x to ImFontConfig::GlyphExtraAdvanceX.
  - 2025/01/22 (1.91.8) - removed ImGuiColorEditFlags_AlphaPreview (made value 0): it is now the default behavior.
                          prior to 1.91.8: alpha was made opaque in the preview by default _unless_ using ImGuiColorEditFlags_AlphaPreview. We now display the preview as transparent by default. You can use ImGuiColorEditFlags_AlphaOpaque to use old behavior.
@@ -1448,6 +1450,11 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsCopyContentsWithCtrlC = false;
     ConfigScrollbarScrollByPage = true;
     ConfigMemoryCompactTimer = 60.0f;
+    ConfigDrawRectInstances = false;
+    ConfigDrawDataChangeDetection = false;
+    ConfigDrawDataCulling = false;
+    ConfigDrawDataMergeCommands = false;
+    ConfigTextMeasureCache = false;
     ConfigDebugIsDebuggerPresent = false;
     ConfigDebugHighlightIdConflicts = true;
     ConfigDebugBeginReturnValueOnce = false;
@@ -3888,6 +3895,7 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
     FontAtlasOwnedByContext = shared_font_atlas ? false : true;
     Font = NULL;
     FontSize = FontBaseSize = FontScale = CurrentDpiScale = 0.0f;
+    DetachedDrawListsCount = 0;
     IO.Fonts = shared_font_atlas ? shared_font_atlas : IM_NEW(ImFontAtlas)();
     Time = 0.0f;
     FrameCount = 0;
@@ -4080,6 +4088,7 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
     DebugItemPickerBreakId = 0;
     DebugFlashStyleColorTime = 0.0f;
     DebugFlashStyleColorIdx = ImGuiCol_COUNT;
+    DebugAllocUntrackedScope = 0;
 
     // Same as DebugBreakClearData(). Those fields are scattered in their respective subsystem to stay in hot-data locations
     DebugBreakInWindow = 0;
@@ -4158,6 +4167,8 @@ void ImGui::Shutdown()
     }
     g.IO.Fonts = NULL;
     g.DrawListSharedData.TempBuffer.clear();
+    g.DrawListSharedData.GlyphRequests.clear();
+    g.TextMeasureCache.Clear();
 
     // Cleanup of other data are conditional on actually having initialized Dear ImGui.
     if (!g.Initialized)
@@ -4744,13 +4755,27 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
     return ImMax(wrap_pos_x - pos.x, 1.0f);
 }
 
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+// Detached draw lists may be recorded by other threads, which allocate and free through the same functions.
+// While some exist, only track allocations from the thread which created them (the one running frames), and never their own memory.
+static thread_local ImGuiContext* GImAllocatorTrackedThreadContext = NULL;
+
+static bool IsDebugAllocTracked(ImGuiContext* ctx)
+{
+    if (GImAllocatorTrackedThreadContext == ctx)
+        return ctx->DebugAllocUntrackedScope == 0;
+    return ctx->DetachedDrawListsCount == 0;
+}
+#endif
+
 // IM_ALLOC() == ImGui::MemAlloc()
 void* ImGui::MemAlloc(size_t size)
 {
     void* ptr = (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (ImGuiContext* ctx = GImGui)
-        DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
+        if (IsDebugAllocTracked(ctx))
+            DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
 #endif
     return ptr;
 }
@@ -4761,7 +4786,8 @@ void ImGui::MemFree(void* ptr)
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (ptr != NULL)
         if (ImGuiContext* ctx = GImGui)
-            DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
+            if (IsDebugAllocTracked(ctx))
+                DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
 #endif
     return (*GImAllocatorFreeFunc)(ptr, GImAllocatorUserData);
 }
@@ -4905,6 +4931,72 @@ ImDrawListSharedData* ImGui::GetDrawListSharedData()
     return &GImGui->DrawListSharedData;
 }
 
+ImDrawList* ImGui::CreateDetachedDrawList(const char* debug_name)
+{
+    ImGuiContext& g = *GImGui;
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+    GImAllocatorTrackedThreadContext = &g;
+#endif
+    g.DebugAllocUntrackedScope++;
+    ImDrawList* draw_list = IM_NEW(ImDrawList)(IM_NEW(ImDrawListSharedData)());
+    g.DebugAllocUntrackedScope--;
+    draw_list->_OwnerName = debug_name;
+    g.DetachedDrawListsCount++;
+    ImFontAtlasDynamicUpdateState(g.IO.Fonts, g.FrameCount, true); // Glyphs loaded on demand: lookups won't modify fonts
+    SyncDetachedDrawList(draw_list);
+    return draw_list;
+}
+
+// Refresh snapshot of shared data and reset for a new frame. Must not be called while another thread is recording into the draw list.
+void ImGui::SyncDetachedDrawList(ImDrawList* draw_list)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawListSharedData* data = draw_list->_Data;
+    IM_ASSERT(data != &g.DrawListSharedData && "Not a detached draw list!");
+
+    // Forward glyphs missed while recording, they will be loaded by Render()
+    for (const ImFontGlyphRequest& req : data->GlyphRequests)
+        g.DrawListSharedData.GlyphRequests.push_back(req);
+    data->GlyphRequests.resize(0);
+
+    // Memory of the draw list is not tracked (see MemAlloc()): other threads may grow its buffers, freeing what we allocate here.
+    g.DebugAllocUntrackedScope++;
+
+    // Copy everything but the scratch buffers, which need to stay owned by this draw list
+    ImVector<ImVec2> temp_buffer;
+    ImVector<ImFontGlyphRequest> glyph_requests;
+    ImSweepTriangulator* temp_sweep_triangulator = data->TempSweepTriangulator;
+    temp_buffer.swap(data->TempBuffer);
+    glyph_requests.swap(data->GlyphRequests);
+    memcpy((void*)data, (const void*)&g.DrawListSharedData, sizeof(*data));
+    memset((void*)&data->TempBuffer, 0, sizeof(data->TempBuffer));
+    memset((void*)&data->GlyphRequests, 0, sizeof(data->GlyphRequests));
+    data->TempBuffer.swap(temp_buffer);
+    data->GlyphRequests.swap(glyph_requests);
+    data->TempSweepTriangulator = temp_sweep_triangulator;
+
+    // Our ImDrawList system requires that there is always a command
+    draw_list->_ResetForNewFrame();
+    draw_list->PushTextureID(g.IO.Fonts->TexID);
+    draw_list->PushClipRectFullScreen();
+    g.DebugAllocUntrackedScope--;
+}
+
+void ImGui::DestroyDetachedDrawList(ImDrawList* draw_list)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawListSharedData* data = draw_list->_Data;
+    IM_ASSERT(data != &g.DrawListSharedData && "Not a detached draw list!");
+    IM_ASSERT(g.DetachedDrawListsCount > 0);
+    g.DebugAllocUntrackedScope++;
+    IM_DELETE(draw_list);
+    IM_DELETE(data);
+    g.DebugAllocUntrackedScope--;
+    g.DetachedDrawListsCount--;
+    if (g.DetachedDrawListsCount == 0)
+        ImFontAtlasDynamicUpdateState(g.IO.Fonts, g.FrameCount, false);
+}
+
 void ImGui::StartMouseMovingWindow(ImGuiWindow* window)
 {
     // Set ActiveId even if the _NoMove flag is set. Without it, dragging away from a window with _NoMove would activate hover on other windows.
@@ -5126,12 +5218,16 @@ static void SetupDrawListSharedData()
     g.DrawListSharedData.InitialFlags = ImDrawListFlags_None;
     if (g.Style.AntiAliasedLines)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLines;
-    if (g.Style.AntiAliasedLinesUseTex && !(g.IO.Fonts->Flags & ImFontAtlasFlags_NoBakedLines))
+    if (g.Style.AntiAliasedLinesUseTex && !(g.IO.Fonts->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SignedDistanceField)))
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLinesUseTex;
     if (g.Style.AntiAliasedFill)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    if (g.IO.ConfigDrawRectInstances && (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasRectInstances))
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowRectInstances;
+    if (g.IO.ConfigDrawRectInstances && (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasRectInstances) && (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasSdfShapes))
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowSdfShapes;
 }
 
 void ImGui::NewFrame()
@@ -5176,9 +5272,14 @@ void ImGui::NewFrame()
 
     // Setup current font and draw list shared data
     g.IO.Fonts->Locked = true;
+    ImFontAtlasDynamicUpdateState(g.IO.Fonts, g.FrameCount, g.DetachedDrawListsCount > 0);
     SetupDrawListSharedData();
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
+    if (g.IO.ConfigTextMeasureCache)
+        g.TextMeasureCache.NewFrame(g.FrameCount, g.IO.Fonts->BuildCount);
+    else if (g.TextMeasureCache.Entries.Size > 0)
+        g.TextMeasureCache.Clear();
 
     // Mark rendering data as invalid to prevent user who may have a handle on it to use it.
     for (ImGuiViewportP* viewport : g.Viewports)
@@ -5469,6 +5570,128 @@ static void FlattenDrawDataIntoSingleLayer(ImDrawDataBuilder* builder)
     }
 }
 
+// Shrink 'rect' when 'occluder' spans it along one axis and covers one of its sides
+static void ShrinkRectOutsideOccluder(ImRect* rect, const ImRect& occluder)
+{
+    if (occluder.Min.x <= rect->Min.x && occluder.Max.x >= rect->Max.x)
+    {
+        if (occluder.Min.y <= rect->Min.y && occluder.Max.y > rect->Min.y)
+            rect->Min.y = occluder.Max.y;
+        else if (occluder.Max.y >= rect->Max.y && occluder.Min.y < rect->Max.y)
+            rect->Max.y = occluder.Min.y;
+    }
+    if (occluder.Min.y <= rect->Min.y && occluder.Max.y >= rect->Max.y)
+    {
+        if (occluder.Min.x <= rect->Min.x && occluder.Max.x > rect->Min.x)
+            rect->Min.x = occluder.Max.x;
+        else if (occluder.Max.x >= rect->Max.x && occluder.Min.x < rect->Max.x)
+            rect->Max.x = occluder.Min.x;
+    }
+}
+
+// Remove draw commands outside of viewport or hidden behind opaque windows (io.ConfigDrawDataCulling)
+// - Lists are processed from top-most to bottom-most, accumulating ImGuiWindow::OccludingRect of windows above.
+// - Clipping rectangles partially hidden are trimmed. Index and instance buffers are compacted, vertices are left untouched.
+static void CullDrawDataCommands(ImGuiViewportP* viewport)
+{
+    ImDrawData* draw_data = &viewport->DrawDataP;
+    ImDrawDataBuilder* builder = &viewport->DrawDataBuilder;
+    const ImRect viewport_rect = viewport->GetMainRect();
+    builder->CullOccluders.resize(0);
+    int culled_lists_count = 0;
+    for (int list_n = draw_data->CmdLists.Size - 1; list_n >= 0; list_n--)
+    {
+        ImDrawList* draw_list = draw_data->CmdLists[list_n];
+        ImDrawCmd* cmd_begin = draw_list->CmdBuffer.Data;
+        ImDrawCmd* cmd_end = cmd_begin + draw_list->CmdBuffer.Size;
+        ImDrawCmd* cmd_write = cmd_begin;
+        unsigned int idx_write = 0;
+        unsigned int inst_write = 0;
+
+        // Compact buffers only if commands are stored in buffer order (RenderDimmedBackgroundBehindWindow() moves a command at the front)
+        bool compact_buffers = true;
+        for (ImDrawCmd* cmd = cmd_begin; cmd < cmd_end && compact_buffers; cmd++)
+        {
+            compact_buffers = (cmd->IdxOffset >= idx_write && cmd->InstOffset >= inst_write);
+            idx_write = cmd->IdxOffset + cmd->ElemCount;
+            inst_write = cmd->InstOffset + cmd->InstCount;
+        }
+        idx_write = inst_write = 0;
+
+        for (ImDrawCmd* cmd = cmd_begin; cmd < cmd_end; cmd++)
+        {
+            if (cmd->UserCallback == NULL)
+            {
+                ImRect clip_rect(cmd->ClipRect);
+                clip_rect.ClipWithFull(viewport_rect);
+                for (const ImRect& occluder : builder->CullOccluders)
+                    ShrinkRectOutsideOccluder(&clip_rect, occluder);
+                if (clip_rect.Min.x >= clip_rect.Max.x || clip_rect.Min.y >= clip_rect.Max.y || (cmd->ElemCount == 0 && cmd->InstCount == 0))
+                {
+                    builder->CullCmdsCount++;
+                    continue;
+                }
+                cmd->ClipRect = clip_rect.ToVec4();
+            }
+            if (compact_buffers)
+            {
+                if (cmd->ElemCount > 0 && cmd->IdxOffset != idx_write)
+                    memmove(draw_list->IdxBuffer.Data + idx_write, draw_list->IdxBuffer.Data + cmd->IdxOffset, cmd->ElemCount * sizeof(ImDrawIdx));
+                if (cmd->InstCount > 0 && cmd->InstOffset != inst_write)
+                    memmove(draw_list->InstBuffer.Data + inst_write, draw_list->InstBuffer.Data + cmd->InstOffset, cmd->InstCount * sizeof(ImDrawRectInstance));
+                cmd->IdxOffset = idx_write;
+                cmd->InstOffset = inst_write;
+                idx_write += cmd->ElemCount;
+                inst_write += cmd->InstCount;
+            }
+
+            // Merge with previous command (which may now be identical and sequential after removing commands in-between)
+            ImDrawCmd* prev_cmd = (cmd_write > cmd_begin) ? cmd_write - 1 : NULL;
+            if (prev_cmd && prev_cmd->UserCallback == NULL && cmd->UserCallback == NULL && memcmp(&prev_cmd->ClipRect, &cmd->ClipRect, sizeof(ImVec4)) == 0 && prev_cmd->TextureId == cmd->TextureId && prev_cmd->VtxOffset == cmd->VtxOffset)
+                if (prev_cmd->IdxOffset + prev_cmd->ElemCount == cmd->IdxOffset && prev_cmd->InstOffset + prev_cmd->InstCount == cmd->InstOffset)
+                    if ((prev_cmd->ElemCount == 0 || cmd->InstCount == 0) && (prev_cmd->InstCount == 0 || cmd->ElemCount == 0)) // Never merge triangles with rectangle instances
+                    {
+                        prev_cmd->ElemCount += cmd->ElemCount;
+                        prev_cmd->InstCount += cmd->InstCount;
+                        continue;
+                    }
+            *cmd_write++ = *cmd;
+        }
+        draw_list->CmdBuffer.resize((int)(cmd_write - cmd_begin));
+        if (compact_buffers)
+        {
+            draw_data->TotalIdxCount -= draw_list->IdxBuffer.Size - (int)idx_write;
+            draw_data->TotalInstCount -= draw_list->InstBuffer.Size - (int)inst_write;
+            draw_list->IdxBuffer.resize((int)idx_write);
+            draw_list->InstBuffer.resize((int)inst_write);
+            draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+            draw_list->_InstWritePtr = draw_list->InstBuffer.Data + draw_list->InstBuffer.Size;
+        }
+        if (draw_list->CmdBuffer.Size == 0)
+        {
+            draw_data->TotalVtxCount -= draw_list->VtxBuffer.Size;
+            draw_data->CmdLists[list_n] = NULL;
+            culled_lists_count++;
+        }
+
+        // Windows below us are hidden by our opaque area. Draw lists are named after their window.
+        ImGuiWindow* window = draw_list->_OwnerName ? ImGui::FindWindowByName(draw_list->_OwnerName) : NULL;
+        if (window != NULL && window->DrawList == draw_list && window->OccludingRect.Min.x < window->OccludingRect.Max.x)
+            builder->CullOccluders.push_back(window->OccludingRect);
+    }
+
+    // Remove empty lists
+    if (culled_lists_count > 0)
+    {
+        int list_write = 0;
+        for (int list_n = 0; list_n < draw_data->CmdLists.Size; list_n++)
+            if (draw_data->CmdLists[list_n] != NULL)
+                draw_data->CmdLists[list_write++] = draw_data->CmdLists[list_n];
+        draw_data->CmdLists.resize(list_write);
+        draw_data->CmdListsCount = list_write;
+    }
+}
+
 static void InitViewportDrawData(ImGuiViewportP* viewport)
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -5481,11 +5704,12 @@ static void InitViewportDrawData(ImGuiViewportP* viewport)
 
     draw_data->Valid = true;
     draw_data->CmdListsCount = 0;
-    draw_data->TotalVtxCount = draw_data->TotalIdxCount = 0;
+    draw_data->TotalVtxCount = draw_data->TotalIdxCount = draw_data->TotalInstCount = 0;
     draw_data->DisplayPos = viewport->Pos;
     draw_data->DisplaySize = viewport->Size;
     draw_data->FramebufferScale = io.DisplayFramebufferScale;
     draw_data->OwnerViewport = viewport;
+    draw_data->ContentUnchanged = false;
 }
 
 // Push a clipping rectangle for both ImGui logic (hit-testing etc.) and low-level ImDrawList rendering.
@@ -5526,10 +5750,10 @@ static void ImGui::RenderDimmedBackgroundBehindWindow(ImGuiWindow* window, ImU32
         ImDrawList* draw_list = window->RootWindow->DrawList;
         if (draw_list->CmdBuffer.Size == 0)
             draw_list->AddDrawCmd();
-        draw_list->PushClipRect(viewport_rect.Min - ImVec2(1, 1), viewport_rect.Max + ImVec2(1, 1), false); // FIXME: Need to stricty ensure ImDrawCmd are not merged (ElemCount==6 checks below will verify that)
+        draw_list->PushClipRect(viewport_rect.Min - ImVec2(1, 1), viewport_rect.Max + ImVec2(1, 1), false); // FIXME: Need to stricty ensure ImDrawCmd are not merged (ElemCount==6/InstCount==1 checks below will verify that)
         draw_list->AddRectFilled(viewport_rect.Min, viewport_rect.Max, col);
         ImDrawCmd cmd = draw_list->CmdBuffer.back();
-        IM_ASSERT(cmd.ElemCount == 6);
+        IM_ASSERT(cmd.ElemCount == 6 || cmd.InstCount == 1);
         draw_list->CmdBuffer.pop_back();
         draw_list->CmdBuffer.push_front(cmd);
         draw_list->AddDrawCmd(); // We need to create a command as CmdBuffer.back().IdxOffset won't be correct if we append to same command.
@@ -5732,7 +5956,7 @@ void ImGui::Render()
         RenderMouseCursor(g.IO.MousePos, g.Style.MouseCursorScale, g.MouseCursor, IM_COL32_WHITE, IM_COL32_BLACK, IM_COL32(0, 0, 0, 48));
 
     // Setup ImDrawData structures for end-user
-    g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = 0;
+    g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = g.IO.MetricsRenderInstances = 0;
     for (ImGuiViewportP* viewport : g.Viewports)
     {
         FlattenDrawDataIntoSingleLayer(&viewport->DrawDataBuilder);
@@ -5743,14 +5967,42 @@ void ImGui::Render()
 
         // We call _PopUnusedDrawCmd() last thing, as RenderDimmedBackgrounds() rely on a valid command being there (especially in docking branch).
         ImDrawData* draw_data = &viewport->DrawDataP;
+        ImDrawDataBuilder* builder = &viewport->DrawDataBuilder;
         IM_ASSERT(draw_data->CmdLists.Size == draw_data->CmdListsCount);
         for (ImDrawList* draw_list : draw_data->CmdLists)
             draw_list->_PopUnusedDrawCmd();
 
+        // Remove hidden draw commands
+        builder->CullCmdsCount = 0;
+        if (g.IO.ConfigDrawDataCulling)
+            CullDrawDataCommands(viewport);
+
+        if (g.IO.ConfigDrawDataChangeDetection)
+            UpdateDrawDataContentHash(draw_data);
+        else
+            draw_data->ContentHash = 0;
+
+        // Merge all draw lists into a single one
+        builder->MergeCmdsCountBefore = builder->MergeCmdsCountAfter = 0;
+        if (g.IO.ConfigDrawDataMergeCommands)
+        {
+            if (builder->MergedList == NULL)
+            {
+                builder->MergedList = IM_NEW(ImDrawList)(&g.DrawListSharedData);
+                builder->MergedList->_OwnerName = "##MergedDrawList";
+            }
+            MergeDrawDataCommands(draw_data, builder, true, (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset) != 0);
+        }
+
         g.IO.MetricsRenderVertices += draw_data->TotalVtxCount;
         g.IO.MetricsRenderIndices += draw_data->TotalIdxCount;
+        g.IO.MetricsRenderInstances += draw_data->TotalInstCount;
     }
 
+    // Load glyphs missed while detached draw lists existed (ImFontAtlasFlags_DynamicGlyphs)
+    if (g.DrawListSharedData.GlyphRequests.Size > 0)
+        ImFontAtlasDynamicLoadRequests(g.IO.Fonts, &g.DrawListSharedData.GlyphRequests);
+
     CallContextHooks(&g, ImGuiContextHookType_RenderPost);
 }
 
@@ -5770,6 +6022,18 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
+
+    // Lookup sizes measured during previous frame (io.ConfigTextMeasureCache)
+    const bool use_cache = g.IO.ConfigTextMeasureCache;
+    ImGuiID cache_hash = 0;
+    if (use_cache)
+    {
+        if (text_display_end == NULL)
+            text_display_end = text + strlen(text);
+        if (const ImGuiTextMeasureCacheEntry* entry = g.TextMeasureCache.Find(font, font_size, wrap_width, text, (int)(text_display_end - text), &cache_hash))
+            return entry->Size;
+    }
+
     ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
@@ -5779,9 +6043,161 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     // - https://embarkstudios.github.io/rust-gpu/api/src/libm/math/ceilf.rs.html
     text_size.x = IM_TRUNC(text_size.x + 0.99999f);
 
+    // Don't store sizes measured while ImFontAtlasFlags_DynamicGlyphs can't load glyphs: missing glyphs were measured as fallback
+    if (use_cache && !(font->ContainerAtlas->DynamicData != NULL && font->ContainerAtlas->DynamicData->LoadingLocked))
+        g.TextMeasureCache.Add(font, font_size, wrap_width, text, (int)(text_display_end - text), cache_hash, text_size);
+
     return text_size;
 }
 
+//-----------------------------------------------------------------------------
+// ImGuiTextMeasureCache
+//-----------------------------------------------------------------------------
+
+static ImGuiID TextMeasureCacheHashKey(ImFont* font, float font_size, float wrap_width, const char* text, int text_len)
+{
+    const float font_params[2] = { font_size, wrap_width };
+    ImGuiID seed = ImHashData(&font, sizeof(font));
+    seed = ImHashData(font_params, sizeof(font_params), seed);
+    const ImGuiID hash = ImHashData(text, (size_t)text_len, seed);
+    return hash ? hash : 1; // 0 is reserved
+}
+
+static inline bool TextMeasureCacheMatchKey(const ImGuiTextMeasureCacheEntry* entry, const char* text_buf, ImFont* font, float font_size, float wrap_width, const char* text, int text_len)
+{
+    return entry->Font == font && entry->FontSize == font_size && entry->WrapWidth == wrap_width && entry->TextLen == text_len && memcmp(text_buf + entry->TextOffset, text, (size_t)text_len) == 0;
+}
+
+static void TextMeasureCacheInsertBucket(ImVector<int>& buckets, ImGuiID hash, int entry_n)
+{
+    int bucket_n = hash & (buckets.Size - 1);
+    while (buckets.Data[bucket_n] != 0)
+        bucket_n = (bucket_n + 1) & (buckets.Size - 1);
+    buckets.Data[bucket_n] = entry_n + 1;
+}
+
+void ImGuiTextMeasureCache::NewFrame(int frame_count, int font_atlas_build_count)
+{
+    LastFrameHitsCount = HitsCount;
+    LastFrameMissesCount = MissesCount;
+    HitsCount = MissesCount = 0;
+
+    // Fonts were rebuilt: sizes may have changed and font pointers may have been reused
+    if (FontAtlasBuildCount != font_atlas_build_count)
+    {
+        Clear();
+        FontAtlasBuildCount = font_atlas_build_count;
+    }
+
+    // Discard entries which were not used during last frame, once they make up more than half of entries.
+    // Entries keep their order and texts stay sorted by offset, so both can be compacted in place.
+    if ((Entries.Size - FrameUsedCount) * 2 > Entries.Size)
+    {
+        ImGuiTextMeasureCacheEntry* dst = Entries.Data;
+        int text_offset = 0;
+        for (ImGuiTextMeasureCacheEntry& src : Entries)
+        {
+            if (src.LastFrameUsed != FrameCount)
+                continue;
+            memmove(TextBuf.Data + text_offset, TextBuf.Data + src.TextOffset, (size_t)src.TextLen);
+            *dst = src;
+            dst->TextOffset = text_offset;
+            text_offset += src.TextLen;
+            dst++;
+        }
+        Entries.resize((int)(dst - Entries.Data));
+        TextBuf.resize(text_offset);
+        Buckets.resize(0);
+    }
+    FrameCount = frame_count;
+    FrameUsedCount = 0;
+    SeqIndex = 0;
+}
+
+void ImGuiTextMeasureCache::Clear()
+{
+    Entries.clear();
+    TextBuf.clear();
+    Buckets.clear();
+    SeqIndex = FrameUsedCount = 0;
+}
+
+const ImGuiTextMeasureCacheEntry* ImGuiTextMeasureCache::Find(ImFont* font, float font_size, float wrap_width, const char* text, int text_len, ImGuiID* out_hash)
+{
+    // Fast path: same order as previous frame
+    ImGuiTextMeasureCacheEntry* entry = NULL;
+    if (SeqIndex < Entries.Size && TextMeasureCacheMatchKey(&Entries.Data[SeqIndex], TextBuf.Data, font, font_size, wrap_width, text, text_len))
+        entry = &Entries.Data[SeqIndex];
+
+    // Slow path: hash table
+    if (entry == NULL && Entries.Size > 0)
+    {
+        if (Buckets.Size == 0)
+        {
+            int buckets_count = 64;
+            while (buckets_count < Entries.Size * 4)
+                buckets_count *= 2;
+            Buckets.resize(buckets_count, 0);
+            for (int entry_n = 0; entry_n < Entries.Size; entry_n++)
+            {
+                ImGuiTextMeasureCacheEntry* e = &Entries.Data[entry_n];
+                if (e->Hash == 0)
+                    e->Hash = TextMeasureCacheHashKey(e->Font, e->FontSize, e->WrapWidth, TextBuf.Data + e->TextOffset, e->TextLen);
+                TextMeasureCacheInsertBucket(Buckets, e->Hash, entry_n);
+            }
+        }
+        const ImGuiID hash = TextMeasureCacheHashKey(font, font_size, wrap_width, text, text_len);
+        *out_hash = hash;
+        for (int bucket_n = hash & (Buckets.Size - 1); Buckets.Data[bucket_n] != 0; bucket_n = (bucket_n + 1) & (Buckets.Size - 1))
+        {
+            ImGuiTextMeasureCacheEntry* e = &Entries.Data[Buckets.Data[bucket_n] - 1];
+            if (e->Hash == hash && TextMeasureCacheMatchKey(e, TextBuf.Data, font, font_size, wrap_width, text, text_len))
+            {
+                entry = e;
+                break;
+            }
+        }
+    }
+    if (entry == NULL)
+    {
+        MissesCount++;
+        return NULL;
+    }
+    HitsCount++;
+    SeqIndex = (int)(entry - Entries.Data) + 1;
+    if (entry->LastFrameUsed != FrameCount)
+    {
+        entry->LastFrameUsed = FrameCount;
+        FrameUsedCount++;
+    }
+    return entry;
+}
+
+void ImGuiTextMeasureCache::Add(ImFont* font, float font_size, float wrap_width, const char* text, int text_len, ImGuiID hash, const ImVec2& size)
+{
+    ImGuiTextMeasureCacheEntry entry;
+    entry.Font = font;
+    entry.FontSize = font_size;
+    entry.WrapWidth = wrap_width;
+    entry.TextOffset = TextBuf.Size;
+    entry.TextLen = text_len;
+    entry.Hash = hash;
+    entry.LastFrameUsed = FrameCount;
+    entry.Size = size;
+    Entries.push_back(entry);
+    TextBuf.resize(TextBuf.Size + text_len);
+    memcpy(TextBuf.Data + entry.TextOffset, text, (size_t)text_len);
+    FrameUsedCount++;
+
+    // Maintain hash table once built (rebuilt on next out-of-order lookup when too full)
+    if (Buckets.Size == 0)
+        return;
+    if (Entries.Size * 2 > Buckets.Size)
+        Buckets.resize(0);
+    else
+        TextMeasureCacheInsertBucket(Buckets, hash ? hash : (Entries.back().Hash = TextMeasureCacheHashKey(font, font_size, wrap_width, text, text_len)), Entries.Size - 1);
+}
+
 // Find window given position, search front-to-back
 // - Typically write output back to g.HoveredWindow and g.HoveredWindowUnderMovingWindow.
 // - FIXME: Note that we have an inconsequential lag here: OuterRectClipped is updated in Begin(), so windows moved programmatically
@@ -6748,6 +7164,17 @@ static void ImGui::RenderWindowOuterBorders(ImGuiWindow* window)
 
 // Draw background and borders
 // Draw and handle scrollbars
+// Area of 'rect' fully covered by opaque pixels, used by io.ConfigDrawDataCulling.
+// Rounded shapes have anti-aliased edges: exclude rounded corners and outer pixels.
+static ImRect CalcWindowOccludingRect(ImGuiWindow* window, ImRect rect, float rounding)
+{
+    if (rounding > 0.0f)
+        rect = ImRect(rect.Min.x + 1.0f, rect.Min.y + rounding + 1.0f, rect.Max.x - 1.0f, rect.Max.y - rounding - 1.0f);
+    rect.ClipWithFull(window->OuterRectClipped);
+    rect = ImRect(ImCeil(rect.Min.x), ImCeil(rect.Min.y), ImFloor(rect.Max.x), ImFloor(rect.Max.y));
+    return (rect.Min.x < rect.Max.x && rect.Min.y < rect.Max.y) ? rect : ImRect();
+}
+
 void ImGui::RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar_rect, bool title_bar_is_highlight, bool handle_borders_and_resize_grips, int resize_grip_count, const ImU32 resize_grip_col[4], float resize_grip_draw_size)
 {
     ImGuiContext& g = *GImGui;
@@ -6771,10 +7198,12 @@ void ImGui::RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar
         ImU32 title_bar_col = GetColorU32((title_bar_is_highlight && g.NavCursorVisible) ? ImGuiCol_TitleBgActive : ImGuiCol_TitleBgCollapsed);
         RenderFrame(title_bar_rect.Min, title_bar_rect.Max, title_bar_col, true, window_rounding);
         g.Style.FrameBorderSize = backup_border_size;
+        window->OccludingRect = ((title_bar_col & IM_COL32_A_MASK) == IM_COL32_A_MASK) ? CalcWindowOccludingRect(window, title_bar_rect, window_rounding) : ImRect();
     }
     else
     {
         // Window background
+        bool bg_is_opaque = false;
         if (!(flags & ImGuiWindowFlags_NoBackground))
         {
             ImU32 bg_col = GetColorU32(GetWindowBgColorIdx(window));
@@ -6788,13 +7217,26 @@ void ImGui::RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar
             if (override_alpha)
                 bg_col = (bg_col & ~IM_COL32_A_MASK) | (IM_F32_TO_INT8_SAT(alpha) << IM_COL32_A_SHIFT);
             window->DrawList->AddRectFilled(window->Pos + ImVec2(0, window->TitleBarHeight), window->Pos + window->Size, bg_col, window_rounding, (flags & ImGuiWindowFlags_NoTitleBar) ? 0 : ImDrawFlags_RoundCornersBottom);
+            bg_is_opaque = (bg_col & IM_COL32_A_MASK) == IM_COL32_A_MASK;
         }
 
         // Title bar
+        bool title_bar_is_opaque = false;
         if (!(flags & ImGuiWindowFlags_NoTitleBar))
         {
             ImU32 title_bar_col = GetColorU32(title_bar_is_highlight ? ImGuiCol_TitleBgActive : ImGuiCol_TitleBg);
             window->DrawList->AddRectFilled(title_bar_rect.Min, title_bar_rect.Max, title_bar_col, window_rounding, ImDrawFlags_RoundCornersTop);
+            title_bar_is_opaque = (title_bar_col & IM_COL32_A_MASK) == IM_COL32_A_MASK;
+        }
+
+        // Area hiding windows behind us
+        window->OccludingRect = ImRect();
+        if (bg_is_opaque)
+        {
+            ImRect occluding_rect = window->Rect();
+            if (!(flags & ImGuiWindowFlags_NoTitleBar) && !title_bar_is_opaque)
+                occluding_rect.Min.y += window->TitleBarHeight;
+            window->OccludingRect = CalcWindowOccludingRect(window, occluding_rect, window_rounding);
         }
 
         // Menu bar
@@ -7506,7 +7948,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         // DRAWING
 
         // Setup draw list and outer clipping rectangle
-        IM_ASSERT(window->DrawList->CmdBuffer.Size == 1 && window->DrawList->CmdBuffer[0].ElemCount == 0);
+        IM_ASSERT(window->DrawList->CmdBuffer.Size == 1 && window->DrawList->CmdBuffer[0].ElemCount == 0 && window->DrawList->CmdBuffer[0].InstCount == 0);
         window->DrawList->PushTextureID(g.Font->ContainerAtlas->TexID);
         PushClipRect(host_rect.Min, host_rect.Max, false);
 
@@ -7521,8 +7963,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
                 // - We disable this when the parent window has zero vertices, which is a common pattern leading to laying out multiple overlapping childs
                 ImGuiWindow* previous_child = parent_window->DC.ChildWindows.Size >= 2 ? parent_window->DC.ChildWindows[parent_window->DC.ChildWindows.Size - 2] : NULL;
                 bool previous_child_overlapping = previous_child ? previous_child->Rect().Overlaps(window->Rect()) : false;
-                bool parent_is_empty = (parent_window->DrawList->VtxBuffer.Size == 0);
-                if (window->DrawList->CmdBuffer.back().ElemCount == 0 && !parent_is_empty && !previous_child_overlapping)
+                bool parent_is_empty = (parent_window->DrawList->VtxBuffer.Size == 0 && parent_window->DrawList->InstBuffer.Size == 0);
+                if (window->DrawList->CmdBuffer.back().ElemCount == 0 && window->DrawList->CmdBuffer.back().InstCount == 0 && !parent_is_empty && !previous_child_overlapping)
                     render_decorations_in_parent = true;
             }
             if (render_decorations_in_parent)
@@ -7535,7 +7977,10 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
             RenderWindowDecorations(window, title_bar_rect, title_bar_is_highlight, handle_borders_and_resize_grips, resize_grip_count, resize_grip_col, resize_grip_draw_size);
 
             if (render_decorations_in_parent)
+            {
                 window->DrawList = &window->DrawListInst;
+                window->OccludingRect = ImRect(); // Parent contents submitted after our background may overlap it
+            }
         }
 
         // UPDATE RECTANGLES (2- THOSE AFFECTED BY SCROLLING)
@@ -10179,6 +10624,9 @@ static void ImGui::ErrorCheckNewFrameSanityChecks()
     IM_ASSERT((g.FrameCount == 0 || g.FrameCountEnded == g.FrameCount)  && "Forgot to call Render() or EndFrame() at the end of the previous frame?");
     IM_ASSERT(g.IO.DisplaySize.x >= 0.0f && g.IO.DisplaySize.y >= 0.0f  && "Invalid DisplaySize value!");
     IM_ASSERT(g.IO.Fonts->IsBuilt()                                     && "Font Atlas not built! Make sure you called ImGui_ImplXXXX_NewFrame() function for renderer backend, which should call io.Fonts->GetTexDataAsRGBA32() / GetTexDataAsAlpha8()");
+    IM_ASSERT((g.IO.Fonts->DynamicData == NULL || (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTexUpdates)) && "ImFontAtlasFlags_DynamicGlyphs requires a renderer backend with ImGuiBackendFlags_RendererHasTexUpdates!");
+    IM_ASSERT((g.IO.Fonts->IncrementalData == NULL || (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTexUpdates)) && "ImFontAtlasFlags_IncrementalBuild requires a renderer backend with ImGuiBackendFlags_RendererHasTexUpdates!");
+    IM_ASSERT((!(g.IO.Fonts->Flags & ImFontAtlasFlags_SignedDistanceField) || (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasSdfFonts)) && "ImFontAtlasFlags_SignedDistanceField requires a renderer backend with ImGuiBackendFlags_RendererHasSdfFonts!");
     IM_ASSERT(g.Style.CurveTessellationTol > 0.0f                       && "Invalid style setting!");
     IM_ASSERT(g.Style.CircleTessellationMaxError > 0.0f                 && "Invalid style setting!");
     IM_ASSERT(g.Style.Alpha >= 0.0f && g.Style.Alpha <= 1.0f            && "Invalid style setting!"); // Allows us to avoid a few clamps in color computations
@@ -15385,6 +15833,21 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
         DebugNodeFont(font);
         PopID();
     }
+    if (ImFontAtlasDynamicData* dyn = atlas->DynamicData)
+        if (TreeNode("Dynamic Glyphs", "Dynamic Glyphs (%d loaded, %d evicted)", dyn->GlyphsLoaded, dyn->GlyphsEvicted))
+        {
+            const int area_h = atlas->TexHeight - dyn->AreaY;
+            BulletText("Loaded: %d glyphs (%d requested by detached draw lists)", dyn->GlyphsLoaded, dyn->GlyphsRequested);
+            BulletText("Evicted: %d glyphs", dyn->GlyphsEvicted);
+            BulletText("Slots: %d in %d shelves", dyn->Slots.Size, dyn->Shelves.Size);
+            BulletText("Area: lines %d..%d, %.1f%% allocated", dyn->AreaY, atlas->TexHeight, (area_h > 0) ? (dyn->ShelvesY - dyn->AreaY) * 100.0f / area_h : 0.0f);
+            BulletText("Loading locked: %d (while detached draw lists exist)", dyn->LoadingLocked);
+            TreePop();
+        }
+    if (ImFontAtlasIncrementalData* inc = atlas->IncrementalData)
+        BulletText("Incremental builds: %d since last full build (%d sources, %d custom rects)", inc->BuildsCount, inc->ConfigDataBuilt, inc->CustomRectsBuilt);
+    if (atlas->CacheFilename != NULL)
+        BulletText("Cache: \"%s\" (%s)", atlas->CacheFilename, atlas->CacheLoaded ? "restored by last Build()" : "not used by last Build()");
     if (TreeNode("Font Atlas", "Font Atlas (%dx%d pixels)", atlas->TexWidth, atlas->TexHeight))
     {
         ImGuiContext& g = *GImGui;
@@ -15425,6 +15888,31 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     }
     Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
     Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
+    if (io.BackendFlags & ImGuiBackendFlags_RendererHasRectInstances)
+        Text("%d rectangle instances", io.MetricsRenderInstances);
+    if (io.ConfigDrawDataCulling)
+    {
+        int cmds_culled = 0;
+        for (ImGuiViewportP* viewport : g.Viewports)
+            cmds_culled += viewport->DrawDataBuilder.CullCmdsCount;
+        Text("%d draw commands culled", cmds_culled);
+    }
+    if (io.ConfigDrawDataMergeCommands)
+    {
+        int cmds_before = 0, cmds_after = 0;
+        for (ImGuiViewportP* viewport : g.Viewports)
+        {
+            cmds_before += viewport->DrawDataBuilder.MergeCmdsCountBefore;
+            cmds_after += viewport->DrawDataBuilder.MergeCmdsCountAfter;
+        }
+        Text("%d draw commands merged into %d", cmds_before, cmds_after);
+    }
+    if (io.ConfigTextMeasureCache)
+    {
+        const ImGuiTextMeasureCache* cache = &g.TextMeasureCache;
+        const int lookups_count = cache->LastFrameHitsCount + cache->LastFrameMissesCount;
+        Text("Text measure cache: %d entries, %d hits, %d misses (%.1f%%)", cache->Entries.Size, cache->LastFrameHitsCount, cache->LastFrameMissesCount, lookups_count > 0 ? cache->LastFrameHitsCount * 100.0f / lookups_count : 0.0f);
+    }
     Text("%d visible windows, %d current allocations", io.MetricsRenderWindows, g.DebugAllocInfo.TotalAllocCount - g.DebugAllocInfo.TotalFreeCount);
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
 
@@ -15767,6 +16255,8 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     {
         ImGuiDebugAllocInfo* info = &g.DebugAllocInfo;
         Text("%d current allocations", info->TotalAllocCount - info->TotalFreeCount);
+        if (g.DetachedDrawListsCount > 0)
+            TextDisabled("(only tracking this thread while %d detached draw lists exist)", g.DetachedDrawListsCount);
         if (SmallButton("GC now")) { g.GcCompactAll = true; }
         Text("Recent frames with allocations:");
         int buf_size = IM_ARRAYSIZE(info->LastEntriesBuf);
@@ -16058,9 +16548,13 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
     IM_UNUSED(viewport); // Used in docking branch
     ImGuiMetricsConfig* cfg = &g.DebugMetricsConfig;
     int cmd_count = draw_list->CmdBuffer.Size;
-    if (cmd_count > 0 && draw_list->CmdBuffer.back().ElemCount == 0 && draw_list->CmdBuffer.back().UserCallback == NULL)
+    if (cmd_count > 0 && draw_list->CmdBuffer.back().ElemCount == 0 && draw_list->CmdBuffer.back().InstCount == 0 && draw_list->CmdBuffer.back().UserCallback == NULL)
         cmd_count--;
-    bool node_open = TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, cmd_count);
+    bool node_open;
+    if (draw_list->InstBuffer.Size > 0)
+        node_open = TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d rects, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, draw_list->InstBuffer.Size, cmd_count);
+    else
+        node_open = TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, cmd_count);
     if (draw_list == GetWindowDrawList())
     {
         SameLine();
@@ -16078,6 +16572,8 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
 
     if (window && !window->WasActive)
         TextDisabled("Warning: owning Window is inactive. This DrawList is not being rendered!");
+    if (draw_list->ContentHash != 0)
+        TextDisabled("Content hash: %016" IM_PRIX64 "%s", draw_list->ContentHash, draw_list->ContentUnchanged ? " (unchanged)" : "");
 
     for (const ImDrawCmd* pcmd = draw_list->CmdBuffer.Data; pcmd < draw_list->CmdBuffer.Data + cmd_count; pcmd++)
     {
@@ -16090,14 +16586,33 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
         char texid_desc[20];
         FormatTextureIDForDebugDisplay(texid_desc, IM_ARRAYSIZE(texid_desc), pcmd->TextureId);
         char buf[300];
-        ImFormatString(buf, IM_ARRAYSIZE(buf), "DrawCmd:%5d tris, Tex %s, ClipRect (%4.0f,%4.0f)-(%4.0f,%4.0f)",
-            pcmd->ElemCount / 3, texid_desc, pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
+        ImFormatString(buf, IM_ARRAYSIZE(buf), "DrawCmd:%5d %s, Tex %s, ClipRect (%4.0f,%4.0f)-(%4.0f,%4.0f)",
+            pcmd->InstCount ? pcmd->InstCount : pcmd->ElemCount / 3, pcmd->InstCount ? "rects" : "tris", texid_desc, pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
         bool pcmd_node_open = TreeNode((void*)(pcmd - draw_list->CmdBuffer.begin()), "%s", buf);
         if (IsItemHovered() && (cfg->ShowDrawCmdMesh || cfg->ShowDrawCmdBoundingBoxes) && fg_draw_list)
             DebugNodeDrawCmdShowMeshAndBoundingBox(fg_draw_list, draw_list, pcmd, cfg->ShowDrawCmdMesh, cfg->ShowDrawCmdBoundingBoxes);
         if (!pcmd_node_open)
             continue;
 
+        // Display rectangle instances. Hover on to get the corresponding rectangle highlighted.
+        if (pcmd->InstCount > 0)
+        {
+            ImGuiListClipper clipper;
+            clipper.Begin(pcmd->InstCount);
+            while (clipper.Step())
+                for (int inst_i = pcmd->InstOffset + clipper.DisplayStart; inst_i < (int)pcmd->InstOffset + clipper.DisplayEnd; inst_i++)
+                {
+                    const ImDrawRectInstance& inst = draw_list->InstBuffer[inst_i];
+                    ImFormatString(buf, IM_ARRAYSIZE(buf), "%s %04d: pos (%8.2f,%8.2f)-(%8.2f,%8.2f), uv (%.6f,%.6f)-(%.6f,%.6f), col %08X, rounding %.1f (corners 0x%X), thickness %.1f",
+                        inst.Ellipse ? "Ellipse" : "Rect", inst_i, inst.PosMin.x, inst.PosMin.y, inst.PosMax.x, inst.PosMax.y, inst.UvMin.x, inst.UvMin.y, inst.UvMax.x, inst.UvMax.y, inst.Col, inst.Rounding, inst.RoundingCorners, inst.Thickness);
+                    Selectable(buf, false);
+                    if (fg_draw_list && IsItemHovered())
+                        fg_draw_list->AddRect(inst.PosMin, inst.PosMax, IM_COL32(255, 255, 0, 255));
+                }
+            TreePop();
+            continue;
+        }
+
         // Calculate approximate coverage area (touched pixel count)
         // This will be in pixels squared as long there's no post-scaling happening to the renderer output.
         const ImDrawIdx* idx_buffer = (draw_list->IdxBuffer.Size > 0) ? draw_list->IdxBuffer.Data : NULL;
@@ -16107,7 +16622,7 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
         {
             ImVec2 triangle[3];
             for (int n = 0; n < 3; n++, idx_n++)
-                triangle[n] = vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n].pos;
+                triangle[n] = ImDrawVert_GetPos(&vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n]);
             total_area += ImTriangleArea(triangle[0], triangle[1], triangle[2]);
         }
 
@@ -16128,9 +16643,10 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
                 for (int n = 0; n < 3; n++, idx_i++)
                 {
                     const ImDrawVert& v = vtx_buffer[idx_buffer ? idx_buffer[idx_i] : idx_i];
-                    triangle[n] = v.pos;
+                    const ImVec2 uv = ImDrawVert_GetUV(&v);
+                    triangle[n] = ImDrawVert_GetPos(&v);
                     buf_p += ImFormatString(buf_p, buf_end - buf_p, "%s %04d: pos (%8.2f,%8.2f), uv (%.6f,%.6f), col %08X\n",
-                        (n == 0) ? "Vert:" : "     ", idx_i, v.pos.x, v.pos.y, v.uv.x, v.uv.y, v.col);
+                        (n == 0) ? "Vert:" : "     ", idx_i, triangle[n].x, triangle[n].y, uv.x, uv.y, v.col);
                 }
 
                 Selectable(buf, false);
@@ -16157,6 +16673,13 @@ void ImGui::DebugNodeDrawCmdShowMeshAndBoundingBox(ImDrawList* out_draw_list, co
     ImRect vtxs_rect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
     ImDrawListFlags backup_flags = out_draw_list->Flags;
     out_draw_list->Flags &= ~ImDrawListFlags_AntiAliasedLines; // Disable AA on triangle outlines is more readable for very large and thin triangles.
+    for (unsigned int inst_n = draw_cmd->InstOffset, inst_end = draw_cmd->InstOffset + draw_cmd->InstCount; inst_n < inst_end; inst_n++)
+    {
+        ImDrawRectInstance inst = draw_list->InstBuffer[inst_n]; // Copy as ->AddRect() may invalidate pointers if out_draw_list==draw_list
+        vtxs_rect.Add(ImRect(inst.PosMin, inst.PosMax));
+        if (show_mesh)
+            out_draw_list->AddRect(inst.PosMin, inst.PosMax, IM_COL32(255, 255, 0, 255)); // In yellow: rectangle instances
+    }
     for (unsigned int idx_n = draw_cmd->IdxOffset, idx_end = draw_cmd->IdxOffset + draw_cmd->ElemCount; idx_n < idx_end; )
     {
         ImDrawIdx* idx_buffer = (draw_list->IdxBuffer.Size > 0) ? draw_list->IdxBuffer.Data : NULL; // We don't hold on those pointers past iterations as ->AddPolyline() may invalidate them if out_draw_list==draw_list
@@ -16164,7 +16687,7 @@ void ImGui::DebugNodeDrawCmdShowMeshAndBoundingBox(ImDrawList* out_draw_list, co
 
         ImVec2 triangle[3];
         for (int n = 0; n < 3; n++, idx_n++)
-            vtxs_rect.Add((triangle[n] = vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n].pos));
+            vtxs_rect.Add((triangle[n] = ImDrawVert_GetPos(&vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n])));
         if (show_mesh)
             out_draw_list->AddPolyline(triangle, 3, IM_COL32(255, 255, 0, 255), ImDrawFlags_Closed, 1.0f); // In yellow: mesh triangles
     }
@@ -16214,6 +16737,8 @@ void ImGui::DebugNodeFont(ImFont* font)
     Text("Ellipsis character: '%s' (U+%04X)", ImTextCharToUtf8(c_str, font->EllipsisChar), font->EllipsisChar);
     const int surface_sqrt = (int)ImSqrt((float)font->MetricsTotalSurface);
     Text("Texture Area: about %d px ~%dx%d px", font->MetricsTotalSurface, surface_sqrt, surface_sqrt);
+    Text("Lookup tables: %d/%d pages, %d bytes", font->IndexLookup.Size / IM_FONT_INDEX_PAGE_SIZE, font->IndexPages.Size,
+        font->IndexPages.size_in_bytes() + font->IndexAdvanceX.size_in_bytes() + font->IndexLookup.size_in_bytes());
     for (int config_i = 0; config_i < font->ConfigDataCount; config_i++)
         if (font->ConfigData)
         {
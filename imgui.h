@@ -46,7 +46,7 @@ Index of this file:
 // [SECTION] Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiPayload)
 // [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, Math Operators, ImColor)
 // [SECTION] Multi-Select API flags and structures (ImGuiMultiSelectFlags, ImGuiMultiSelectIO, ImGuiSelectionRequest, ImGuiSelectionBasicStorage, ImGuiSelectionExternalStorage)
-// [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData)
+// [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListFragment, ImDrawListCurveCache, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData)
 // [SECTION] Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImFontAtlasFlags, ImFontAtlas, ImFont)
 // [SECTION] Viewports (ImGuiViewportFlags, ImGuiViewport)
 // [SECTION] ImGuiPlatformIO + other Platform Dependent Interfaces (ImGuiPlatformImeData)
@@ -90,6 +90,11 @@ Index of this file:
 #include <assert.h>
 #define IM_ASSERT(_EXPR)            assert(_EXPR)                               // You can override the default assert handler by editing imconfig.h
 #endif
+#ifdef IMGUI_DEBUG_PARANOID
+#define IM_ASSERT_PARANOID(_EXPR)   IM_ASSERT(_EXPR)                            // Slower asserts, enabled by defining IMGUI_DEBUG_PARANOID in imconfig.h
+#else
+#define IM_ASSERT_PARANOID(_EXPR)
+#endif
 #define IM_ARRAYSIZE(_ARR)          ((int)(sizeof(_ARR) / sizeof(*(_ARR))))     // Size of a static C-style array. Don't use on pointers!
 #define IM_UNUSED(_VAR)             ((void)(_VAR))                              // Used to silence "unused variable warnings". Often useful as asserts may be stripped out from final builds.
 
@@ -163,12 +168,17 @@ struct ImDrawChannel;               // Temporary storage to output draw commands
 struct ImDrawCmd;                   // A single draw command within a parent ImDrawList (generally maps to 1 GPU draw call, unless it is a callback)
 struct ImDrawData;                  // All draw command lists required to render the frame + pos/size coordinates to use for the projection matrix.
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
+struct ImDrawListFragment;          // Retained copy of a range of ImDrawList output, which can be replayed in later frames with a translation
+struct ImDrawListCurveCache;        // Cache of tessellated cubic Bezier curves for AddBezierCubicBatch(), persistent across frames
+struct ImDrawRectInstance;          // A single axis-aligned rectangle instance (pos + uv + col + shape = 48 bytes), expanded by backends supporting ImGuiBackendFlags_RendererHasRectInstances
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
-struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default, 12 bytes with IMGUI_USE_COMPACT_DRAWVERT. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
+struct ImFontAtlasDynamicData;      // Opaque storage for glyphs loaded on demand (ImFontAtlasFlags_DynamicGlyphs).
+struct ImFontAtlasIncrementalData;  // Opaque packing state kept between builds (ImFontAtlasFlags_IncrementalBuild).
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
@@ -286,6 +296,8 @@ typedef int     (*ImGuiInputTextCallback)(ImGuiInputTextCallbackData* data);
 typedef void    (*ImGuiSizeCallback)(ImGuiSizeCallbackData* data);              // Callback function for ImGui::SetNextWindowSizeConstraints()
 typedef void*   (*ImGuiMemAllocFunc)(size_t sz, void* user_data);               // Function signature for ImGui::SetAllocatorFunctions()
 typedef void    (*ImGuiMemFreeFunc)(void* ptr, void* user_data);                // Function signature for ImGui::SetAllocatorFunctions()
+typedef void    (*ImFontAtlasJobFunc)(void* job_data, int job_index);           // Job function passed to ImFontAtlas::ParallelForFunc
+typedef void    (*ImFontAtlasParallelForFunc)(ImFontAtlasJobFunc job_func, void* job_data, int jobs_count, void* user_data); // Function signature for ImFontAtlas::ParallelForFunc
 
 // ImVec2: 2D vector used to store positions, sizes etc. [Compile-time configurable type]
 // - This is a frequently used type in the API. Consider using IM_VEC2_CLASS_EXTRA to create implicit cast from/to our preferred type.
@@ -946,6 +958,19 @@ namespace ImGui
     IMGUI_API ImDrawList*   GetBackgroundDrawList();                                            // this draw list will be the first rendered one. Useful to quickly draw shapes/text behind dear imgui contents.
     IMGUI_API ImDrawList*   GetForegroundDrawList();                                            // this draw list will be the last rendered one. Useful to quickly draw shapes/text over dear imgui contents.
 
+    // Detached Draw Lists (multi-threaded recording)
+    // - A detached draw list owns a snapshot of the context's ImDrawListSharedData (font, flags, tessellation settings, scratch buffer).
+    //   Recording into it with ImDrawList functions doesn't access the ImGui context or any other mutable shared state,
+    //   so each detached draw list may be recorded by a different thread, concurrently with the main thread running a frame.
+    // - Create/Sync/Destroy from the main thread, while no other thread is recording into that draw list.
+    //   Call SyncDetachedDrawList() every frame before recording: it refreshes the snapshot and resets the draw list.
+    // - Splice the output with ImDrawList::AddDrawList() (e.g. into GetWindowDrawList()) or with ImDrawData::AddDrawList().
+    // - Fonts are read-only while recording: don't modify the font atlas while other threads are recording.
+    // - While any detached draw list exists, the Metrics/Debugger window only tracks memory allocations made by the thread which created it, outside of Create/Sync/DestroyDetachedDrawList().
+    IMGUI_API ImDrawList*   CreateDetachedDrawList(const char* debug_name = NULL);             // 'debug_name' needs to be persistent.
+    IMGUI_API void          SyncDetachedDrawList(ImDrawList* draw_list);
+    IMGUI_API void          DestroyDetachedDrawList(ImDrawList* draw_list);
+
     // Miscellaneous Utilities
     IMGUI_API bool          IsRectVisible(const ImVec2& size);                                  // test if rectangle (of given size, starting from cursor position) is visible / not clipped.
     IMGUI_API bool          IsRectVisible(const ImVec2& rect_min, const ImVec2& rect_max);      // test if rectangle (in screen space) is visible / not clipped. to perform coarse clipping on user's side.
@@ -1610,6 +1635,10 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if io.ConfigNavMoveSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasRectInstances = 1 << 4, // Backend Renderer supports ImDrawCmd::InstCount/InstOffset. This enables output of rectangles and text glyphs as ImDrawRectInstance instead of 4 vertices + 6 indices each, when io.ConfigDrawRectInstances is set.
+    ImGuiBackendFlags_RendererHasSdfShapes  = 1 << 5,   // Backend Renderer supports all ImDrawRectInstance shape fields (per-corner rounding, stroke thickness, ellipses). This enables output of rounded rectangles, circles and ellipses as a single instance. Requires ImGuiBackendFlags_RendererHasRectInstances.
+    ImGuiBackendFlags_RendererHasTexUpdates = 1 << 6,   // Backend Renderer supports partial updates of the font texture (ImFontAtlas::GetTexDataUpdateRect()), and recreates it when its height changed. Required by ImFontAtlasFlags_DynamicGlyphs and ImFontAtlasFlags_IncrementalBuild.
+    ImGuiBackendFlags_RendererHasSdfFonts   = 1 << 7,   // Backend Renderer can sample the font texture as a signed distance field (alpha 0.5 on edges, anti-aliased over one screen pixel) when ImFontAtlasFlags_SignedDistanceField is set. Required by ImFontAtlasFlags_SignedDistanceField.
 };
 
 // Enumeration for PushStyleColor() / PopStyleColor()
@@ -2269,6 +2298,11 @@ struct ImGuiIO
     bool        ConfigWindowsCopyContentsWithCtrlC; // = false      // [EXPERIMENTAL] CTRL+C copy the contents of focused window into the clipboard. Experimental because: (1) has known issues with nested Begin/End pairs (2) text output quality varies (3) text output is in submission order rather than spatial order.
     bool        ConfigScrollbarScrollByPage;    // = true           // Enable scrolling page by page when clicking outside the scrollbar grab. When disabled, always scroll to clicked location. When enabled, Shift+Click scrolls to clicked location.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
+    bool        ConfigDrawRectInstances;        // = false          // [EXPERIMENTAL] Emit rectangles, images and text glyphs as ImDrawRectInstance when the renderer backend sets ImGuiBackendFlags_RendererHasRectInstances. Code post-processing vertices (e.g. ShadeVertsXXX functions, walking VtxBuffer) needs to clear ImDrawListFlags_AllowRectInstances around its drawing.
+    bool        ConfigDrawDataChangeDetection;  // = false          // [EXPERIMENTAL] Hash contents of each ImDrawList in Render() and set ImDrawList::ContentUnchanged, ImDrawData::ContentUnchanged. Renderers may skip uploading unchanged buffers, applications may skip presenting unchanged frames.
+    bool        ConfigDrawDataCulling;          // = false          // [EXPERIMENTAL] In Render(), remove draw commands whose clipping rectangle is outside of the viewport or hidden behind opaque windows above them, and trim clipping rectangles partially hidden. Reduces overdraw and index buffer size. Commands with user callbacks are never removed.
+    bool        ConfigDrawDataMergeCommands;    // = false          // [EXPERIMENTAL] In Render(), replace all ImDrawList of each ImDrawData with a single one, merging compatible commands across lists and moving commands over non-overlapping ones to batch them by texture and clipping rectangle. Reduces draw calls. User callbacks receive the merged list as 'parent_list'.
+    bool        ConfigTextMeasureCache;         // = false          // [EXPERIMENTAL] Cache sizes returned by CalcTextSize() (used by most widgets) per font, font size, wrap width and text contents. Entries unused for a frame are discarded. Cached sizes are reset when io.Fonts is rebuilt: call ImFontAtlas::Build() again after e.g. ImFont::AddRemapChar().
 
     // Inputs Behaviors
     // (other variables, ones which are expected to be tweaked within UI code, are exposed in ImGuiStyle)
@@ -2382,6 +2416,7 @@ struct ImGuiIO
     float       Framerate;                          // Estimate of application framerate (rolling average over 60 frames, based on io.DeltaTime), in frame per second. Solely for convenience. Slow applications may not want to use a moving average or may want to reset underlying buffers occasionally.
     int         MetricsRenderVertices;              // Vertices output during last call to Render()
     int         MetricsRenderIndices;               // Indices output during last call to Render() = number of triangles * 3
+    int         MetricsRenderInstances;             // Rectangle instances output during last call to Render() (ImGuiBackendFlags_RendererHasRectInstances)
     int         MetricsRenderWindows;               // Number of visible windows
     int         MetricsActiveWindows;               // Number of active windows
     ImVec2      MouseDelta;                         // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
@@ -2962,6 +2997,9 @@ typedef void (*ImDrawCallback)(const ImDrawList* parent_list, const ImDrawCmd* c
 // - VtxOffset: When 'io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset' is enabled,
 //   this fields allow us to render meshes larger than 64K vertices while keeping 16-bit indices.
 //   Backends made for <1.71. will typically ignore the VtxOffset fields.
+// - InstOffset/InstCount: When 'io.BackendFlags & ImGuiBackendFlags_RendererHasRectInstances' is enabled,
+//   a command may render 'InstCount' rectangles from the ImDrawList's InstBuffer[] instead of triangles.
+//   A command never uses both: it has either ElemCount > 0 or InstCount > 0 (or none, e.g. a callback).
 // - The ClipRect/TextureId/VtxOffset fields must be contiguous as we memcmp() them together (this is asserted for).
 struct ImDrawCmd
 {
@@ -2970,6 +3008,8 @@ struct ImDrawCmd
     unsigned int    VtxOffset;          // 4    // Start offset in vertex buffer. ImGuiBackendFlags_RendererHasVtxOffset: always 0, otherwise may be >0 to support meshes larger than 64K vertices with 16-bit indices.
     unsigned int    IdxOffset;          // 4    // Start offset in index buffer.
     unsigned int    ElemCount;          // 4    // Number of indices (multiple of 3) to be rendered as triangles. Vertices are stored in the callee ImDrawList's vtx_buffer[] array, indices in idx_buffer[].
+    unsigned int    InstOffset;         // 4    // Start offset in rectangle instance buffer. ImGuiBackendFlags_RendererHasRectInstances only.
+    unsigned int    InstCount;          // 4    // Number of rectangle instances to be rendered (each expanding to a 4 vertices quad). ImGuiBackendFlags_RendererHasRectInstances only, otherwise always 0.
     ImDrawCallback  UserCallback;       // 4-8  // If != NULL, call the function instead of rendering the vertices. clip_rect and texture_id will be set normally.
     void*           UserCallbackData;   // 4-8  // Callback user data (when UserCallback != NULL). If called AddCallback() with size == 0, this is a copy of the AddCallback() argument. If called AddCallback() with size > 0, this is pointing to a buffer where data is stored.
     int             UserCallbackDataSize;  // 4 // Size of callback user data when using storage, otherwise 0.
@@ -2982,7 +3022,28 @@ struct ImDrawCmd
 };
 
 // Vertex layout
-#ifndef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+#if defined(IMGUI_USE_COMPACT_DRAWVERT)
+// Compact vertex layout (12 bytes instead of 20), enabled by defining IMGUI_USE_COMPACT_DRAWVERT in imconfig.h.
+// - 'pos' is stored as signed fixed-point with IM_DRAWVERT_POS_FRAC_BITS fractional bits (default 3 = 1/8th of a pixel, positions within [-4096,+4096) = +/-IM_DRAWVERT_POS_MAX).
+//   Positions outside of this range are clamped to it: this is NOT clipping. Triangles with a vertex beyond the limit are distorted (e.g. a rectangle
+//   crossing x=4096 is squashed against it, a shape entirely beyond it collapses onto the edge), which is visible when the viewport or framebuffer is
+//   larger than the limit. Lower IM_DRAWVERT_POS_FRAC_BITS to extend the range (2 = +/-8192). IMGUI_DEBUG_PARANOID asserts on out-of-range positions.
+//   Renderer backends can use a 16-bit signed integer attribute and fold 1/IM_DRAWVERT_POS_SCALE into their projection matrix.
+// - 'uv' is stored as 16-bit unsigned normalized values, clamped to [0,1]. Textures coordinates outside of [0,1] (e.g. for texture wrapping) are not supported.
+// - Renderer backend needs to support it: the OpenGL3 and Vulkan backends do.
+// - Always use ImDrawVert_Write(), ImDrawVert_GetPos() etc. to access vertices.
+#ifndef IM_DRAWVERT_POS_FRAC_BITS
+#define IM_DRAWVERT_POS_FRAC_BITS   3
+#endif
+#define IM_DRAWVERT_POS_SCALE       ((float)(1 << IM_DRAWVERT_POS_FRAC_BITS))
+#define IM_DRAWVERT_POS_MAX         (32768.0f / IM_DRAWVERT_POS_SCALE)
+struct ImDrawVert
+{
+    ImS16   pos[2];
+    ImU16   uv[2];
+    ImU32   col;
+};
+#elif !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImDrawVert
 {
     ImVec2  pos;
@@ -2997,6 +3058,44 @@ struct ImDrawVert
 IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT;
 #endif
 
+// Vertex encoding/decoding helpers. All vertices written by ImDrawList go through ImDrawVert_Write().
+IM_MSVC_RUNTIME_CHECKS_OFF
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+static inline ImS16  ImDrawVert_EncodePos(float v)                      { IM_ASSERT_PARANOID(v >= -IM_DRAWVERT_POS_MAX && v < IM_DRAWVERT_POS_MAX && "Position out of IMGUI_USE_COMPACT_DRAWVERT range!"); v = v * IM_DRAWVERT_POS_SCALE + (v >= 0.0f ? 0.5f : -0.5f); return (ImS16)(v <= -32768.0f ? -32768.0f : v >= 32767.0f ? 32767.0f : v); }
+static inline ImU16  ImDrawVert_EncodeUV(float v)                       { v = v * 65535.0f + 0.5f; return (ImU16)(v <= 0.0f ? 0.0f : v >= 65535.0f ? 65535.0f : v); }
+static inline void   ImDrawVert_Write(ImDrawVert* vtx, float x, float y, float u, float v, ImU32 col) { vtx->pos[0] = ImDrawVert_EncodePos(x); vtx->pos[1] = ImDrawVert_EncodePos(y); vtx->uv[0] = ImDrawVert_EncodeUV(u); vtx->uv[1] = ImDrawVert_EncodeUV(v); vtx->col = col; }
+static inline void   ImDrawVert_SetPos(ImDrawVert* vtx, const ImVec2& pos)  { vtx->pos[0] = ImDrawVert_EncodePos(pos.x); vtx->pos[1] = ImDrawVert_EncodePos(pos.y); }
+static inline void   ImDrawVert_SetUV(ImDrawVert* vtx, const ImVec2& uv)    { vtx->uv[0] = ImDrawVert_EncodeUV(uv.x); vtx->uv[1] = ImDrawVert_EncodeUV(uv.y); }
+static inline ImVec2 ImDrawVert_GetPos(const ImDrawVert* vtx)           { return ImVec2(vtx->pos[0] * (1.0f / IM_DRAWVERT_POS_SCALE), vtx->pos[1] * (1.0f / IM_DRAWVERT_POS_SCALE)); }
+static inline ImVec2 ImDrawVert_GetUV(const ImDrawVert* vtx)            { return ImVec2(vtx->uv[0] * (1.0f / 65535.0f), vtx->uv[1] * (1.0f / 65535.0f)); }
+#else
+static inline void   ImDrawVert_Write(ImDrawVert* vtx, float x, float y, float u, float v, ImU32 col) { vtx->pos.x = x; vtx->pos.y = y; vtx->uv.x = u; vtx->uv.y = v; vtx->col = col; }
+static inline void   ImDrawVert_SetPos(ImDrawVert* vtx, const ImVec2& pos)  { vtx->pos = pos; }
+static inline void   ImDrawVert_SetUV(ImDrawVert* vtx, const ImVec2& uv)    { vtx->uv = uv; }
+static inline ImVec2 ImDrawVert_GetPos(const ImDrawVert* vtx)           { return vtx->pos; }
+static inline ImVec2 ImDrawVert_GetUV(const ImDrawVert* vtx)            { return vtx->uv; }
+#endif
+IM_MSVC_RUNTIME_CHECKS_RESTORE
+
+// Rectangle instance layout (ImGuiBackendFlags_RendererHasRectInstances)
+// Renders as an axis-aligned quad going from PosMin to PosMax, with texture coordinates interpolated from UvMin to UvMax.
+// - Rounding > 0.0f: corners are rounded using an anti-aliased signed distance, evaluated by the backend fragment shader.
+//   Rounding is always pre-clamped to half of the smallest side.
+// - Thickness, RoundingCorners and Ellipse are only set to non-default values with ImGuiBackendFlags_RendererHasSdfShapes.
+//   Those instances always have PosMin <= PosMax, and the backend needs to enlarge the quad by (Thickness * 0.5f + 1.0f)
+//   on each side to cover the stroke and anti-aliasing fringe (extrapolating texture coordinates).
+struct ImDrawRectInstance
+{
+    ImVec2  PosMin, PosMax;
+    ImVec2  UvMin, UvMax;
+    ImU32   Col;
+    float   Rounding;
+    float   Thickness;          // 0.0f: filled. >0.0f: stroke of this width, centered on the shape outline.
+    ImU8    RoundingCorners;    // Corners affected by Rounding: (ImDrawFlags_RoundCornersXXX >> 4), default to 0x0F (all corners).
+    ImU8    Ellipse;            // 1: shape is the ellipse inscribed in PosMin..PosMax. Rounding and RoundingCorners are ignored.
+    ImU16   _Pad0;
+};
+
 // [Internal] For use by ImDrawList
 struct ImDrawCmdHeader
 {
@@ -3010,6 +3109,7 @@ struct ImDrawChannel
 {
     ImVector<ImDrawCmd>         _CmdBuffer;
     ImVector<ImDrawIdx>         _IdxBuffer;
+    ImVector<ImDrawRectInstance> _InstBuffer;
 };
 
 // Split/Merge functions are used to split the draw list into different layers which can be drawn into out of order.
@@ -3029,6 +3129,73 @@ struct ImDrawListSplitter
     IMGUI_API void              SetCurrentChannel(ImDrawList* draw_list, int channel_idx);
 };
 
+// Retained draw list fragment: record a range of draw list output once, replay it in later frames without tessellating again.
+// - Record: call draw_list->BeginFragment(&fragment, id), draw as usual, then draw_list->EndFragment(&fragment).
+//   Output is still emitted into the draw list, and copied into the fragment.
+// - Replay: when fragment.IsValid(id), call draw_list->AddFragment(&fragment, offset, col_mul) instead of drawing.
+//   Vertices, indices and rectangle instances are bulk copied (indices are rebased), translated by 'offset' and their color multiplied by 'col_mul'.
+// - 'id' is provided by you: compute it from everything your content depends on (e.g. hash of your data, zoom level). A different id invalidates the fragment.
+// - Commands using the clipping rectangle which was current on BeginFragment() are replayed with the current clipping rectangle.
+//   Other clipping rectangles (pushed while recording) are translated by 'offset' and intersected with the current clipping rectangle.
+// - Callbacks cannot be recorded. Some functions are doing CPU-side clipping (e.g. text): record content fully visible if you intend to replay it elsewhere.
+// - Rectangle instances can only be replayed into a draw list using ImDrawListFlags_AllowRectInstances: invalidate your fragments if backend flags change.
+// - With ImFontAtlasFlags_DynamicGlyphs: glyphs rendered while recording are marked as used each time the fragment is replayed, so they are not evicted.
+//   If one of them got evicted anyway (e.g. fragment not replayed for a while), IsValid() returns false. Invalidate your fragments if you rebuild the atlas.
+struct ImDrawListFragmentGlyph
+{
+    ImFont*                     Font;
+    ImWchar                     Codepoint;
+    float                       U0, V0;         // Texture coordinates when recorded, to detect glyphs loaded again elsewhere after eviction
+};
+
+struct ImDrawListFragment
+{
+    ImGuiID                     ID;             // User provided key passed to BeginFragment(). 0 when empty.
+    ImVec4                      ClipRect;       // Clipping rectangle which was current on BeginFragment().
+    ImVector<ImDrawCmd>         CmdBuffer;      // Recorded commands. IdxOffset/InstOffset: offset into fragment buffers. VtxOffset: first vertex used by the command in VtxBuffer.
+    ImVector<ImDrawIdx>         IdxBuffer;      // Recorded indices, relative to the first vertex used by their command.
+    ImVector<ImDrawVert>        VtxBuffer;      // Recorded vertices.
+    ImVector<ImDrawRectInstance> InstBuffer;    // Recorded rectangle instances.
+    ImVector<ImDrawListFragmentGlyph> Glyphs;   // Glyphs rendered while recording (ImFontAtlasFlags_DynamicGlyphs only), sorted.
+    int                         _CmdStart;      // [Internal] Recording state (-1 when not recording)
+    int                         _IdxStart;
+    int                         _InstStart;
+    int                         _Channel;
+    ImDrawListFragment*         _Parent;        // [Internal] Fragment being recorded into the same draw list when BeginFragment() was called
+
+    ImDrawListFragment()                    { ID = 0; ClipRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f); _CmdStart = _IdxStart = _InstStart = _Channel = -1; _Parent = NULL; }
+    IMGUI_API bool  IsValid(ImGuiID id) const;
+    void            Invalidate()            { ID = 0; }
+    void            Clear()                 { ID = 0; CmdBuffer.clear(); IdxBuffer.clear(); VtxBuffer.clear(); InstBuffer.clear(); Glyphs.clear(); }
+};
+
+// Cache of tessellated cubic Bezier curves for AddBezierCubicBatch(), e.g. links of a node editor.
+// - Owned by you, keep it alive across frames. Call NewFrame() once per frame: curves which were not used during the previous frame are discarded.
+// - Curves are identified by their shape (control points relative to the first one) and tessellation settings: translated curves are reused too.
+// - Not thread-safe: use one cache per draw list when recording draw lists from multiple threads.
+struct ImDrawListCurveCacheEntry
+{
+    ImVec2                      Ctrl[3];        // Control points 2..4, relative to control point 1
+    float                       TessTol;
+    int                         NumSegments;
+    int                         PointsOffset;   // Tessellated points (excluding control point 1), relative to control point 1
+    int                         PointsCount;
+};
+
+struct ImDrawListCurveCache
+{
+    ImVector<ImDrawListCurveCacheEntry> Entries[2]; // [0]: previous frame (used for lookups), [1]: current frame
+    ImVector<ImVec2>                    Points[2];
+    ImVector<int>                       Buckets;    // Open addressing hash table, index+1 in Entries[0] or 0 when empty. Only built when curves are not submitted in the same order as during the previous frame.
+    int                                 SeqIndex;   // Index in Entries[0] expected for next lookup
+
+    ImDrawListCurveCache()              { SeqIndex = 0; }
+    IMGUI_API void                              NewFrame();
+    IMGUI_API void                              Clear();
+    IMGUI_API const ImDrawListCurveCacheEntry*  Find(const ImDrawListCurveCacheEntry& key);
+    IMGUI_API ImDrawListCurveCacheEntry*        Add(const ImDrawListCurveCacheEntry& entry, const ImVec2* points);
+};
+
 // Flags for ImDrawList functions
 // (Legacy: bit 0 must always correspond to ImDrawFlags_Closed to be backward compatible with old API using a bool. Bits 1..3 must be unused)
 enum ImDrawFlags_
@@ -3040,6 +3207,7 @@ enum ImDrawFlags_
     ImDrawFlags_RoundCornersBottomLeft      = 1 << 6, // AddRect(), AddRectFilled(), PathRect(): enable rounding bottom-left corner only (when rounding > 0.0f, we default to all corners). Was 0x04.
     ImDrawFlags_RoundCornersBottomRight     = 1 << 7, // AddRect(), AddRectFilled(), PathRect(): enable rounding bottom-right corner only (when rounding > 0.0f, we default to all corners). Wax 0x08.
     ImDrawFlags_RoundCornersNone            = 1 << 8, // AddRect(), AddRectFilled(), PathRect(): disable rounding on all corners (when rounding > 0.0f). This is NOT zero, NOT an implicit flag!
+    ImDrawFlags_FillRuleEvenOdd             = 1 << 9, // AddConcavePolyFilled() with multiple contours: use even-odd fill rule instead of non-zero (contours orientation doesn't matter).
     ImDrawFlags_RoundCornersTop             = ImDrawFlags_RoundCornersTopLeft | ImDrawFlags_RoundCornersTopRight,
     ImDrawFlags_RoundCornersBottom          = ImDrawFlags_RoundCornersBottomLeft | ImDrawFlags_RoundCornersBottomRight,
     ImDrawFlags_RoundCornersLeft            = ImDrawFlags_RoundCornersBottomLeft | ImDrawFlags_RoundCornersTopLeft,
@@ -3058,6 +3226,8 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering (NOT point/nearest filtering).
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
     ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_AllowRectInstances      = 1 << 4,  // Can emit 'InstCount > 0' for rectangles, images and text glyphs. Set when 'io.ConfigDrawRectInstances' is set and 'ImGuiBackendFlags_RendererHasRectInstances' is enabled. Clear around drawing whose vertices you post-process.
+    ImDrawListFlags_AllowSdfShapes          = 1 << 5,  // Can emit rounded rectangles, circles and ellipses as a single ImDrawRectInstance evaluated as a signed distance by the renderer. Vertex count doesn't depend on radius or tessellation settings. Set when 'io.ConfigDrawRectInstances' is set and both 'ImGuiBackendFlags_RendererHasRectInstances' and 'ImGuiBackendFlags_RendererHasSdfShapes' are enabled.
 };
 
 // Draw command list
@@ -3075,13 +3245,17 @@ struct ImDrawList
     ImVector<ImDrawCmd>     CmdBuffer;          // Draw commands. Typically 1 command = 1 GPU draw call, unless the command is a callback.
     ImVector<ImDrawIdx>     IdxBuffer;          // Index buffer. Each command consume ImDrawCmd::ElemCount of those
     ImVector<ImDrawVert>    VtxBuffer;          // Vertex buffer.
+    ImVector<ImDrawRectInstance> InstBuffer;    // Rectangle instance buffer. Each command consume ImDrawCmd::InstCount of those. Only used with ImDrawListFlags_AllowRectInstances.
     ImDrawListFlags         Flags;              // Flags, you may poke into these to adjust anti-aliasing settings per-primitive.
+    ImU64                   ContentHash;        // Hash of commands, vertices, indices and instances, computed by Render() when io.ConfigDrawDataChangeDetection is set. 0 when not computed.
+    bool                    ContentUnchanged;   // Set by Render() when ContentHash is the same as the last time this draw list was rendered. Never set for draw lists containing user callbacks.
 
     // [Internal, used while building lists]
     unsigned int            _VtxCurrentIdx;     // [Internal] generally == VtxBuffer.Size unless we are past 64K vertices, in which case this gets reset to 0.
     ImDrawListSharedData*   _Data;              // Pointer to shared draw data (you can use ImGui::GetDrawListSharedData() to get the one from current ImGui context)
     ImDrawVert*             _VtxWritePtr;       // [Internal] point within VtxBuffer.Data after each add command (to avoid using the ImVector<> operators too much)
     ImDrawIdx*              _IdxWritePtr;       // [Internal] point within IdxBuffer.Data after each add command (to avoid using the ImVector<> operators too much)
+    ImDrawRectInstance*     _InstWritePtr;      // [Internal] point within InstBuffer.Data after each add command
     ImVector<ImVec2>        _Path;              // [Internal] current path building
     ImDrawCmdHeader         _CmdHeader;         // [Internal] template of active commands. Fields should match those of CmdBuffer.back().
     ImDrawListSplitter      _Splitter;          // [Internal] for channels api (note: prefer using your own persistent instance of ImDrawListSplitter!)
@@ -3089,6 +3263,7 @@ struct ImDrawList
     ImVector<ImTextureID>   _TextureIdStack;    // [Internal]
     ImVector<ImU8>          _CallbacksDataBuf;  // [Internal]
     float                   _FringeScale;       // [Internal] anti-alias fringe is scaled by this value, this helps to keep things sharp while zooming at vertex buffer content
+    ImDrawListFragment*     _Fragment;          // [Internal] fragment being recorded (see BeginFragment())
     const char*             _OwnerName;         // Pointer to owner window's name for debugging
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData().
@@ -3129,13 +3304,16 @@ struct ImDrawList
     IMGUI_API void  AddText(ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end = NULL, float wrap_width = 0.0f, const ImVec4* cpu_fine_clip_rect = NULL);
     IMGUI_API void  AddBezierCubic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments = 0); // Cubic Bezier (4 control points)
     IMGUI_API void  AddBezierQuadratic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, ImU32 col, float thickness, int num_segments = 0);               // Quadratic Bezier (3 control points)
+    IMGUI_API void  AddBezierCubicBatch(const ImVec2* points, int curves_count, ImU32 col, float thickness, int num_segments = 0, ImDrawListCurveCache* cache = NULL); // Multiple cubic Bezier (4 control points per curve), optional tessellation cache
 
     // General polygon
-    // - Only simple polygons are supported by filling functions (no self-intersections, no holes).
-    // - Concave polygon fill is more expensive than convex one: it has O(N^2) complexity. Provided as a convenience for the user but not used by the main library.
+    // - Only simple polygons are supported by AddConvexPolyFilled() and single contour AddConcavePolyFilled() (no self-intersections, no holes).
+    // - Concave polygon fill is more expensive than convex one: O(N^2) ear clipping for small polygons, O(N log N) sweep line for large ones. Provided as a convenience for the user but not used by the main library.
+    // - Use AddConcavePolyFilled() with multiple contours for shapes with holes. The anti-aliasing fringe follows the fill rule, so contours orientation doesn't matter.
     IMGUI_API void  AddPolyline(const ImVec2* points, int num_points, ImU32 col, ImDrawFlags flags, float thickness);
     IMGUI_API void  AddConvexPolyFilled(const ImVec2* points, int num_points, ImU32 col);
     IMGUI_API void  AddConcavePolyFilled(const ImVec2* points, int num_points, ImU32 col);
+    IMGUI_API void  AddConcavePolyFilled(const ImVec2* points, const int* contours_num_points, int contours_count, ImU32 col, ImDrawFlags flags = 0); // Contours stored one after another in 'points'. Non-zero fill rule, or ImDrawFlags_FillRuleEvenOdd.
 
     // Image primitives
     // - Read FAQ to understand what ImTextureID is.
@@ -3174,7 +3352,7 @@ struct ImDrawList
 
     // Advanced: Miscellaneous
     IMGUI_API void  AddDrawCmd();                                               // This is useful if you need to forcefully create a new draw call (to allow for dependent rendering / blending). Otherwise primitives are merged into the same draw-call as much as possible
-    IMGUI_API ImDrawList* CloneOutput() const;                                  // Create a clone of the CmdBuffer/IdxBuffer/VtxBuffer.
+    IMGUI_API ImDrawList* CloneOutput() const;                                  // Create a clone of the CmdBuffer/IdxBuffer/VtxBuffer/InstBuffer.
 
     // Advanced: Channels
     // - Use to split render into layers. By switching channels to can render out-of-order (e.g. submit FG primitives before BG primitives)
@@ -3186,6 +3364,13 @@ struct ImDrawList
     inline void     ChannelsMerge()             { _Splitter.Merge(this); }
     inline void     ChannelsSetCurrent(int n)   { _Splitter.SetCurrentChannel(this, n); }
 
+    // Advanced: Retained fragments
+    // - Record a range of output once, then replay it in later frames with a translation and optional color multiply. See ImDrawListFragment.
+    IMGUI_API void  BeginFragment(ImDrawListFragment* fragment, ImGuiID id);
+    IMGUI_API void  EndFragment(ImDrawListFragment* fragment);
+    IMGUI_API void  AddFragment(const ImDrawListFragment* fragment, const ImVec2& offset = ImVec2(0.0f, 0.0f), ImU32 col_mul = IM_COL32_WHITE);
+    IMGUI_API void  AddDrawList(const ImDrawList* draw_list);                   // Append output of another draw list (e.g. a detached draw list recorded by another thread). Clipping rectangles are intersected with current one.
+
     // Advanced: Primitives allocations
     // - We render triangles (three vertices)
     // - All primitives needs to be reserved via PrimReserve() beforehand.
@@ -3194,10 +3379,17 @@ struct ImDrawList
     IMGUI_API void  PrimRect(const ImVec2& a, const ImVec2& b, ImU32 col);      // Axis aligned rectangle (composed of two triangles)
     IMGUI_API void  PrimRectUV(const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, ImU32 col);
     IMGUI_API void  PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, const ImVec2& d, const ImVec2& uv_a, const ImVec2& uv_b, const ImVec2& uv_c, const ImVec2& uv_d, ImU32 col);
-    inline    void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)    { _VtxWritePtr->pos = pos; _VtxWritePtr->uv = uv; _VtxWritePtr->col = col; _VtxWritePtr++; _VtxCurrentIdx++; }
+    inline    void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)    { ImDrawVert_Write(_VtxWritePtr, pos.x, pos.y, uv.x, uv.y, col); _VtxWritePtr++; _VtxCurrentIdx++; }
     inline    void  PrimWriteIdx(ImDrawIdx idx)                                     { *_IdxWritePtr = idx; _IdxWritePtr++; }
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)         { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); } // Write vertex with unique index
 
+    // Advanced: Rectangle instances allocations
+    // - Only valid when (Flags & ImDrawListFlags_AllowRectInstances). A command stores either triangles or instances, never both.
+    // - All instances needs to be reserved via PrimReserveInstances() beforehand.
+    IMGUI_API void  PrimReserveInstances(int inst_count);
+    IMGUI_API void  PrimUnreserveInstances(int inst_count);
+    inline    void  PrimRectInstance(const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, ImU32 col, float rounding = 0.0f) { ImDrawRectInstance* i = _InstWritePtr; i->PosMin = a; i->PosMax = b; i->UvMin = uv_a; i->UvMax = uv_b; i->Col = col; i->Rounding = rounding; i->Thickness = 0.0f; i->RoundingCorners = 0x0F; i->Ellipse = 0; i->_Pad0 = 0; _InstWritePtr++; }
+
     // Obsolete names
     //inline  void  AddEllipse(const ImVec2& center, float radius_x, float radius_y, ImU32 col, float rot = 0.0f, int num_segments = 0, float thickness = 1.0f) { AddEllipse(center, ImVec2(radius_x, radius_y), col, rot, num_segments, thickness); } // OBSOLETED in 1.90.5 (Mar 2024)
     //inline  void  AddEllipseFilled(const ImVec2& center, float radius_x, float radius_y, ImU32 col, float rot = 0.0f, int num_segments = 0) { AddEllipseFilled(center, ImVec2(radius_x, radius_y), col, rot, num_segments); }                        // OBSOLETED in 1.90.5 (Mar 2024)
@@ -3210,6 +3402,9 @@ struct ImDrawList
     IMGUI_API void  _ClearFreeMemory();
     IMGUI_API void  _PopUnusedDrawCmd();
     IMGUI_API void  _TryMergeDrawCmds();
+    IMGUI_API void  _UpdateContentHash();
+    IMGUI_API void  _AddSdfShape(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding, ImDrawFlags flags, float thickness, bool ellipse);
+    IMGUI_API void  _AddCircleFilledN(const ImVec2& center, float radius, ImU32 col, int num_segments);
     IMGUI_API void  _OnChangedClipRect();
     IMGUI_API void  _OnChangedTextureID();
     IMGUI_API void  _OnChangedVtxOffset();
@@ -3228,11 +3423,14 @@ struct ImDrawData
     int                 CmdListsCount;      // Number of ImDrawList* to render (should always be == CmdLists.size)
     int                 TotalIdxCount;      // For convenience, sum of all ImDrawList's IdxBuffer.Size
     int                 TotalVtxCount;      // For convenience, sum of all ImDrawList's VtxBuffer.Size
+    int                 TotalInstCount;     // For convenience, sum of all ImDrawList's InstBuffer.Size
     ImVector<ImDrawList*> CmdLists;         // Array of ImDrawList* to render. The ImDrawLists are owned by ImGuiContext and only pointed to from here.
     ImVec2              DisplayPos;         // Top-left position of the viewport to render (== top-left of the orthogonal projection matrix to use) (== GetMainViewport()->Pos for the main viewport, == (0.0) in most single-viewport applications)
     ImVec2              DisplaySize;        // Size of the viewport to render (== GetMainViewport()->Size for the main viewport, == io.DisplaySize in most single-viewport applications)
     ImVec2              FramebufferScale;   // Amount of pixels for each unit of DisplaySize. Based on io.DisplayFramebufferScale. Generally (1,1) on normal display, (2,2) on OSX with Retina display.
     ImGuiViewport*      OwnerViewport;      // Viewport carrying the ImDrawData instance, might be of use to the renderer (generally not).
+    ImU64               ContentHash;        // Hash of all ImDrawList::ContentHash + display settings, computed by Render() when io.ConfigDrawDataChangeDetection is set. 0 when not computed.
+    bool                ContentUnchanged;   // Set by Render() when all draw lists and display settings are the same as in previous Render(). Application may skip rendering and presenting the frame. Doesn't track changes in texture contents!
 
     // Functions
     ImDrawData()    { Clear(); }
@@ -3327,6 +3525,10 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_DynamicGlyphs      = 1 << 3,   // [EXPERIMENTAL] Only bake ASCII glyphs in Build(), load other glyphs from the requested ranges on demand when looked up. Least recently used glyphs are evicted when the texture is full. ImFontGlyph pointers only stay valid until the next glyph lookup. Requires renderer backend support for ImGuiBackendFlags_RendererHasTexUpdates.
+    ImFontAtlasFlags_SignedDistanceField = 1 << 4,  // [EXPERIMENTAL] Store glyphs as signed distance fields, so text stays sharp when scaled up (e.g. SetWindowFontScale(), zoomed canvases). Requires renderer backend support for ImGuiBackendFlags_RendererHasSdfFonts (OpenGL3 with GLSL 1.30+/ES 3.00+ only, other backends assert). stb_truetype builder only. Implies ImFontAtlasFlags_NoBakedLines. See TexSdfSpread.
+                                                    // The threshold applies to the whole texture: custom rectangles (including colored icons) and the software mouse cursor (io.MouseDrawCursor) are thresholded too.
+    ImFontAtlasFlags_IncrementalBuild   = 1 << 5,   // [EXPERIMENTAL] Keep packing state after Build(), so that the next Build() only packs and rasterizes fonts and custom rectangles added since, into remaining texture space. Requires renderer backend support for ImGuiBackendFlags_RendererHasTexUpdates. stb_truetype builder only. Ignored with ImFontAtlasFlags_DynamicGlyphs.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -3372,6 +3574,32 @@ struct ImFontAtlas
     bool                        IsBuilt() const             { return Fonts.Size > 0 && TexReady; } // Bit ambiguous: used to detect when user didn't build texture but effectively we should check TexID != 0 except that would be backend dependent...
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
+    // [EXPERIMENTAL] Glyphs loaded on demand (ImFontAtlasFlags_DynamicGlyphs)
+    // - Build() only bakes ASCII glyphs (plus fallback/ellipsis candidates). Other glyphs of the requested ranges are rasterized into free texture space when first looked up.
+    // - Texture size is fixed: TexDesiredWidth (default to 1024) * at least as much height. When the texture is full, glyphs not used during the current frame are evicted.
+    // - Pixels are written into TexPixelsAlpha8/TexPixelsRGBA32 after the texture was created: don't call ClearTexData() after uploading.
+    //   Renderer backends (with ImGuiBackendFlags_RendererHasTexUpdates) call GetTexDataUpdateRect() before rendering and upload the modified area.
+    // - ImFontGlyph pointers (e.g. returned by ImFont::FindGlyph()) are only valid until the next glyph lookup on any font of the atlas (FindGlyph(), CalcTextSize(), rendering text...):
+    //   loading a glyph may reallocate ImFont::Glyphs[], and eviction removes a glyph by moving the last one of Glyphs[] into its place. Copy the ImFontGlyph, or look it up again.
+    // - While detached draw lists exist (see ImGui::CreateDetachedDrawList()) lookups never modify the atlas: missing glyphs are rendered with the fallback glyph,
+    //   then loaded into free texture space by ImGui::Render(). Recording threads need to be idle during ImGui::Render().
+    IMGUI_API bool              GetTexDataUpdateRect(int* out_x, int* out_y, int* out_w, int* out_h); // Retrieve area of pixels modified since last call and clear it. Return false if nothing changed.
+
+    // [EXPERIMENTAL] Signed distance field glyphs (ImFontAtlasFlags_SignedDistanceField)
+    // - Glyphs are rasterized once, as distances to their outline: 128 on the edge, saturating TexSdfSpread texels away from it. Oversampling and RasterizerMultiply are ignored.
+    // - Renderer backends (with ImGuiBackendFlags_RendererHasSdfFonts) threshold the alpha channel of the font texture, so a single baked size renders crisply at larger scales.
+    //   The whole texture is sampled this way: pixels of custom rectangles need to be distance fields too, including colored icons (their alpha gets thresholded,
+    //   with hard edges at 0.5). The white pixel is fully opaque so it is unaffected. Software mouse cursor shapes (io.MouseDrawCursor) get hard edges.
+    // - Backends: OpenGL3 with GLSL 1.30+ or GLSL ES 3.00+. With GLSL 1.20/ES 1.00 shaders, the backend doesn't set ImGuiBackendFlags_RendererHasSdfFonts
+    //   and ImGui::NewFrame() asserts. Vulkan asserts when creating the font texture. Other backends don't support it yet.
+
+    // [EXPERIMENTAL] Incremental builds (ImFontAtlasFlags_IncrementalBuild)
+    // - After a first Build(), calling AddFont***() or AddCustomRect***() keeps texture data. Call Build() again before next NewFrame(): it packs the new rectangles
+    //   around existing ones, growing TexHeight if needed, and only rasterizes glyphs of the new fonts. Existing glyphs and custom rectangles keep their position.
+    // - Renderer backends (with ImGuiBackendFlags_RendererHasTexUpdates) upload the modified area reported by GetTexDataUpdateRect(), or the whole texture when TexHeight changed.
+    //   TexID is preserved. Pixels of new custom rectangles written after Build() are uploaded too, as long as they are written before next rendering, in the format used by the backend.
+    // - Fonts and custom rectangles which were already built are not updated: modifying their settings, or changing atlas Flags/TexGlyphPadding, requires a full build (clear the flag before calling Build()).
+
     //-------------------------------------------
     // Glyph Ranges
     //-------------------------------------------
@@ -3418,13 +3646,19 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // FIXME: Should be called "TexPackPadding". Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0 (will also need to set AntiAliasedLinesUseTex = false).
+    int                         TexSdfSpread;       // = 4      // With ImFontAtlasFlags_SignedDistanceField: distance range in texels on each side of glyph edges, also added as margin around each glyph. Larger values allow drawing text much smaller than its baked size, at the cost of texture space.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
+    ImFontAtlasParallelForFunc  ParallelForFunc;    // [EXPERIMENTAL] Optional: let Build() rasterize glyphs using your thread pool/job system. Call job_func(job_data, n) once for each n in [0, jobs_count), from any thread and in any order, and return once all are done. Allocations made by jobs use the functions from SetAllocatorFunctions(), which then need to be thread-safe. Currently only used by the stb_truetype builder.
+    void*                       ParallelForUserData;// Passed to ParallelForFunc().
+    const char*                 CacheFilename;      // [EXPERIMENTAL] Optional: path to a file where Build() saves its output, restored on next runs instead of building if fonts, settings and font builder version are unchanged (skipping TTF parsing and rasterization). Not used with ImFontAtlasFlags_DynamicGlyphs. Stored in native format: don't share across platforms.
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
     bool                        TexReady;           // Set when texture was built matching current font input
     bool                        TexPixelsUseColors; // Tell whether our texture data is known to use colors (rather than just alpha channel), in order to help backend select a format.
+    bool                        CacheLoaded;        // Set by Build() when output was restored from CacheFilename.
+    int                         BuildCount;         // Incremented by Build(). Lets users of measured text sizes detect changes (e.g. io.ConfigTextMeasureCache).
     unsigned char*              TexPixelsAlpha8;    // 1 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight
     unsigned int*               TexPixelsRGBA32;    // 4 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight * 4
     int                         TexWidth;           // Texture width calculated during Build().
@@ -3435,6 +3669,7 @@ struct ImFontAtlas
     ImVector<ImFontAtlasCustomRect> CustomRects;    // Rectangles for packing custom texture data into the atlas.
     ImVector<ImFontConfig>      ConfigData;         // Configuration data
     ImVec4                      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];  // UVs for baked anti-aliased lines
+    int                         TexUpdateRect[4];   // Area modified since last GetTexDataUpdateRect() (x0, y0, x1, y1)
 
     // [Internal] Font builder
     const ImFontBuilderIO*      FontBuilderIO;      // Opaque interface to a font builder (default to stb_truetype, can be changed to use FreeType by defining IMGUI_ENABLE_FREETYPE).
@@ -3444,22 +3679,33 @@ struct ImFontAtlas
     int                         PackIdMouseCursors; // Custom texture rectangle ID for white pixel and mouse cursors
     int                         PackIdLines;        // Custom texture rectangle ID for baked anti-aliased lines
 
+    // [Internal] Glyphs loaded on demand
+    ImFontAtlasDynamicData*     DynamicData;        // Created by Build() with ImFontAtlasFlags_DynamicGlyphs, if the font builder supports it.
+
+    // [Internal] Incremental builds
+    ImFontAtlasIncrementalData* IncrementalData;    // Created by Build() with ImFontAtlasFlags_IncrementalBuild, if the font builder supports it.
+
     // [Obsolete]
     //typedef ImFontAtlasCustomRect    CustomRect;              // OBSOLETED in 1.72+
     //typedef ImFontGlyphRangesBuilder GlyphRangesBuilder;      // OBSOLETED in 1.67+
 };
 
+// Lookup tables of ImFont are split in pages of 256 codepoints, only allocated for ranges containing glyphs.
+#define IM_FONT_INDEX_PAGE_SHIFT    8
+#define IM_FONT_INDEX_PAGE_SIZE     (1 << IM_FONT_INDEX_PAGE_SHIFT)
+
 // Font runtime data and rendering
 // ImFontAtlas automatically loads a default embedded font for you when you call GetTexDataAsAlpha8() or GetTexDataAsRGBA32().
 struct ImFont
 {
-    // [Internal] Members: Hot ~20/24 bytes (for CalcTextSize)
-    ImVector<float>             IndexAdvanceX;      // 12-16 // out // Sparse. Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this info, and are often bottleneck in large UI).
+    // [Internal] Members: Hot ~32/40 bytes (for CalcTextSize)
+    ImVector<ImU16>             IndexPages;         // 12-16 // out // Sparse. Page number in IndexAdvanceX[]/IndexLookup[] for each block of IM_FONT_INDEX_PAGE_SIZE codepoints. Page 0 is shared by all blocks without glyphs.
+    ImVector<float>             IndexAdvanceX;      // 12-16 // out // Paged. Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this info, and are often bottleneck in large UI).
     float                       FallbackAdvanceX;   // 4     // out // = FallbackGlyph->AdvanceX
     float                       FontSize;           // 4     // in  // Height of characters/line, set during loading (don't change after loading)
 
     // [Internal] Members: Hot ~28/40 bytes (for RenderText loop)
-    ImVector<ImU16>             IndexLookup;        // 12-16 // out // Sparse. Index glyphs by Unicode code-point.
+    ImVector<ImU16>             IndexLookup;        // 12-16 // out // Paged. Index glyphs by Unicode code-point.
     ImVector<ImFontGlyph>       Glyphs;             // 12-16 // out // All glyphs.
     ImFontGlyph*                FallbackGlyph;      // 4-8   // out // = FindGlyph(FontFallbackChar)
 
@@ -3477,14 +3723,16 @@ struct ImFont
     float                       Ascent, Descent;    // 4+4   // out // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize] (unscaled)
     int                         MetricsTotalSurface;// 4     // out // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
     bool                        DirtyLookupTables;  // 1     // out //
+    ImVector<int>               GlyphsLastUsedFrame;// 12-16 // out // ImFontAtlasFlags_DynamicGlyphs only: frame count when each glyph of Glyphs[] was last rendered, for eviction.
     ImU8                        Used8kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/8192/8]; // 1 bytes if ImWchar=ImWchar16, 16 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
 
     // Methods
     IMGUI_API ImFont();
     IMGUI_API ~ImFont();
-    IMGUI_API ImFontGlyph*      FindGlyph(ImWchar c);
-    IMGUI_API ImFontGlyph*      FindGlyphNoFallback(ImWchar c);
-    float                       GetCharAdvance(ImWchar c)       { return ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : FallbackAdvanceX; }
+    IMGUI_API ImFontGlyph*      FindGlyph(ImWchar c);                       // With ImFontAtlasFlags_DynamicGlyphs: load glyph if needed. Pointer is then only valid until the next glyph lookup (see ImFontAtlas).
+    IMGUI_API ImFontGlyph*      FindGlyphNoFallback(ImWchar c);             // Never load glyphs.
+    float                       GetCharAdvance(ImWchar c)       { const int slot = GetIndexSlot(c); return (slot >= 0 && IndexAdvanceX.Data[slot] >= 0.0f) ? IndexAdvanceX.Data[slot] : GetCharAdvanceSlow(c); }
+    int                         GetIndexSlot(ImWchar c) const   { const unsigned int page_n = (unsigned int)c >> IM_FONT_INDEX_PAGE_SHIFT; return (page_n < (unsigned int)IndexPages.Size) ? ((int)IndexPages.Data[page_n] << IM_FONT_INDEX_PAGE_SHIFT) | (int)(c & (IM_FONT_INDEX_PAGE_SIZE - 1)) : -1; } // Offset of 'c' in IndexAdvanceX[]/IndexLookup[], or -1 if beyond last page.
     bool                        IsLoaded() const                { return ContainerAtlas != NULL; }
     const char*                 GetDebugName() const            { return ConfigData ? ConfigData->Name : "<unknown>"; }
 
@@ -3499,7 +3747,8 @@ struct ImFont
     // [Internal] Don't use!
     IMGUI_API void              BuildLookupTable();
     IMGUI_API void              ClearOutputData();
-    IMGUI_API void              GrowIndex(int new_size);
+    IMGUI_API int               AllocIndexSlot(ImWchar c);      // Same as GetIndexSlot(), allocating a page for 'c' if needed (initialized from shared page 0). May reallocate IndexAdvanceX[]/IndexLookup[].
+    IMGUI_API float             GetCharAdvanceSlow(ImWchar c);  // GetCharAdvance() for codepoints not in IndexAdvanceX[]: load glyph with ImFontAtlasFlags_DynamicGlyphs, else return FallbackAdvanceX.
     IMGUI_API void              AddGlyph(const ImFontConfig* src_cfg, ImWchar c, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x);
     IMGUI_API void              AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst = true); // Makes 'dst' character/glyph points to 'src' character/glyph. Currently needs to be called AFTER fonts have been built.
     IMGUI_API bool              IsGlyphRangeUnused(unsigned int c_begin, unsigned int c_last);
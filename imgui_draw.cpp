@@ -10,10 +10,14 @@ Index of this file:
 // [SECTION] ImDrawList
 // [SECTION] ImTriangulator, ImDrawList concave polygon fill
 // [SECTION] ImDrawListSplitter
+// [SECTION] ImDrawListFragment
+// [SECTION] ImDrawListCurveCache
 // [SECTION] ImDrawData
 // [SECTION] Helpers ShadeVertsXXX functions
 // [SECTION] ImFontConfig
 // [SECTION] ImFontAtlas
+// [SECTION] ImFontAtlas: glyphs loaded on demand
+// [SECTION] ImFontAtlas: cache of built data
 // [SECTION] ImFontAtlas: glyph ranges helpers
 // [SECTION] ImFontGlyphRangesBuilder
 // [SECTION] ImFont
@@ -134,8 +138,11 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+// Glyphs rendered by ImFontAtlas::ParallelForFunc jobs use a non-NULL stbtt_fontinfo::userdata: bypass ImGui::MemAlloc() debug hooks, which are not thread-safe.
+static void* ImStbTrueTypeAllocFromJob(size_t size)   { ImGuiMemAllocFunc alloc_func; ImGuiMemFreeFunc free_func; void* user_data; ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data); return alloc_func(size, user_data); }
+static void  ImStbTrueTypeFreeFromJob(void* ptr)      { ImGuiMemAllocFunc alloc_func; ImGuiMemFreeFunc free_func; void* user_data; ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data); free_func(ptr, user_data); }
+#define STBTT_malloc(x,u)   ((u) ? ImStbTrueTypeAllocFromJob(x) : IM_ALLOC(x))
+#define STBTT_free(x,u)     ((u) ? ImStbTrueTypeFreeFromJob(x) : IM_FREE(x))
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -380,6 +387,22 @@ ImDrawListSharedData::ImDrawListSharedData()
         ArcFastVtx[i] = ImVec2(ImCos(a), ImSin(a));
     }
     ArcFastRadiusCutoff = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC_R(IM_DRAWLIST_ARCFAST_SAMPLE_MAX, CircleSegmentMaxError);
+    for (int n = 3; n <= IM_DRAWLIST_CIRCLE_VTX_CACHE_MAX; n++)
+    {
+        ImVec2* unit_vtx = &CircleVtxCache[IM_DRAWLIST_CIRCLE_VTX_CACHE_OFFSET(n)];
+        for (int i = 0; i < n; i++)
+        {
+            const float a = ((float)i * 2 * IM_PI) / (float)n;
+            unit_vtx[i] = ImVec2(ImCos(a), ImSin(a));
+        }
+        CircleFringeScale[n] = 1.0f / ImCos(IM_PI / (float)n);
+    }
+}
+
+ImDrawListSharedData::~ImDrawListSharedData()
+{
+    if (TempSweepTriangulator)
+        IM_DELETE(TempSweepTriangulator);
 }
 
 void ImDrawListSharedData::SetCircleTessellationMaxError(float max_error)
@@ -422,11 +445,13 @@ void ImDrawList::_ResetForNewFrame()
     CmdBuffer.resize(0);
     IdxBuffer.resize(0);
     VtxBuffer.resize(0);
+    InstBuffer.resize(0);
     Flags = _Data->InitialFlags;
     memset(&_CmdHeader, 0, sizeof(_CmdHeader));
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
+    _InstWritePtr = NULL;
     _ClipRectStack.resize(0);
     _TextureIdStack.resize(0);
     _CallbacksDataBuf.resize(0);
@@ -441,15 +466,19 @@ void ImDrawList::_ClearFreeMemory()
     CmdBuffer.clear();
     IdxBuffer.clear();
     VtxBuffer.clear();
+    InstBuffer.clear();
     Flags = ImDrawListFlags_None;
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
+    _InstWritePtr = NULL;
     _ClipRectStack.clear();
     _TextureIdStack.clear();
     _CallbacksDataBuf.clear();
     _Path.clear();
     _Splitter.ClearFreeMemory();
+    ContentHash = 0;
+    ContentUnchanged = false;
 }
 
 ImDrawList* ImDrawList::CloneOutput() const
@@ -458,6 +487,7 @@ ImDrawList* ImDrawList::CloneOutput() const
     dst->CmdBuffer = CmdBuffer;
     dst->IdxBuffer = IdxBuffer;
     dst->VtxBuffer = VtxBuffer;
+    dst->InstBuffer = InstBuffer;
     dst->Flags = Flags;
     return dst;
 }
@@ -469,6 +499,7 @@ void ImDrawList::AddDrawCmd()
     draw_cmd.TextureId = _CmdHeader.TextureId;
     draw_cmd.VtxOffset = _CmdHeader.VtxOffset;
     draw_cmd.IdxOffset = IdxBuffer.Size;
+    draw_cmd.InstOffset = InstBuffer.Size;
 
     IM_ASSERT(draw_cmd.ClipRect.x <= draw_cmd.ClipRect.z && draw_cmd.ClipRect.y <= draw_cmd.ClipRect.w);
     CmdBuffer.push_back(draw_cmd);
@@ -481,18 +512,87 @@ void ImDrawList::_PopUnusedDrawCmd()
     while (CmdBuffer.Size > 0)
     {
         ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-        if (curr_cmd->ElemCount != 0 || curr_cmd->UserCallback != NULL)
+        if (curr_cmd->ElemCount != 0 || curr_cmd->InstCount != 0 || curr_cmd->UserCallback != NULL)
             return;// break;
         CmdBuffer.pop_back();
     }
 }
 
+// Fast 64-bit hash of a buffer, used for change detection (see io.ConfigDrawDataChangeDetection).
+// Processes 4 independent lanes of 64-bit words: roughly an order of magnitude faster than ImHashData() on large vertex buffers.
+static inline ImU64 ImHashContentRotl(ImU64 v, int r) { return (v << r) | (v >> (64 - r)); }
+static inline ImU64 ImHashContentMix(ImU64 h, ImU64 v) { return ImHashContentRotl(h ^ (v * 0xC2B2AE3D27D4EB4FULL), 31) * 0x9E3779B185EBCA87ULL; }
+static ImU64 ImHashContent(const void* data_p, size_t data_size, ImU64 seed)
+{
+    const unsigned char* data = (const unsigned char*)data_p;
+    const unsigned char* data_end = data + data_size;
+    ImU64 h0 = seed + 0x9E3779B185EBCA87ULL, h1 = seed ^ data_size, h2 = seed - 0x9E3779B185EBCA87ULL, h3 = ~seed;
+    ImU64 w[4];
+    for (; data + 32 <= data_end; data += 32)
+    {
+        memcpy(w, data, 32);
+        h0 = ImHashContentMix(h0, w[0]);
+        h1 = ImHashContentMix(h1, w[1]);
+        h2 = ImHashContentMix(h2, w[2]);
+        h3 = ImHashContentMix(h3, w[3]);
+    }
+    ImU64 h = ImHashContentRotl(h0, 1) + ImHashContentRotl(h1, 7) + ImHashContentRotl(h2, 12) + ImHashContentRotl(h3, 18);
+    for (; data + 8 <= data_end; data += 8)
+    {
+        memcpy(w, data, 8);
+        h = ImHashContentMix(h, w[0]);
+    }
+    if (data < data_end)
+    {
+        w[0] = 0;
+        memcpy(w, data, (size_t)(data_end - data));
+        h = ImHashContentMix(h, w[0]);
+    }
+    h ^= h >> 33; h *= 0xFF51AFD7ED558CCDULL; h ^= h >> 33; // Final avalanche
+    return h;
+}
+
+// Hash output of the draw list and compare it with last hash (called by Render() when io.ConfigDrawDataChangeDetection is set)
+// Commands are hashed field by field (not as raw memory) as ImDrawCmd::UserCallbackData may point inside _CallbacksDataBuf.
+void ImDrawList::_UpdateContentHash()
+{
+    const ImU64 prev_hash = ContentHash;
+    bool has_user_callbacks = false;
+    ImU64 hash = ImHashContent(VtxBuffer.Data, (size_t)VtxBuffer.size_in_bytes(), CmdBuffer.Size);
+    hash = ImHashContent(IdxBuffer.Data, (size_t)IdxBuffer.size_in_bytes(), hash);
+    hash = ImHashContent(InstBuffer.Data, (size_t)InstBuffer.size_in_bytes(), hash);
+    hash = ImHashContent(_CallbacksDataBuf.Data, (size_t)_CallbacksDataBuf.size_in_bytes(), hash);
+    for (const ImDrawCmd& cmd : CmdBuffer)
+    {
+        ImU64 fields[7];
+        memcpy(&fields[0], &cmd.ClipRect, sizeof(ImVec4));
+        fields[2] = (ImU64)cmd.TextureId;
+        fields[3] = ((ImU64)cmd.VtxOffset << 32) | cmd.IdxOffset;
+        fields[4] = ((ImU64)cmd.ElemCount << 32) | cmd.InstCount;
+        fields[5] = cmd.InstOffset;
+        fields[6] = 0;
+        if (cmd.UserCallback != NULL)
+        {
+            // User callbacks may render anything, so never report draw lists containing them as unchanged.
+            if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                has_user_callbacks = true;
+            fields[5] ^= (ImU64)(size_t)cmd.UserCallback;
+            fields[6] = (cmd.UserCallbackDataOffset != -1) ? ((ImU64)cmd.UserCallbackDataOffset << 32) | (ImU32)cmd.UserCallbackDataSize : (ImU64)(size_t)cmd.UserCallbackData;
+        }
+        hash = ImHashContent(fields, sizeof(fields), hash);
+    }
+    if (hash == 0)
+        hash = 1; // 0 is reserved for "not computed"
+    ContentHash = hash;
+    ContentUnchanged = (hash == prev_hash && !has_user_callbacks);
+}
+
 void ImDrawList::AddCallback(ImDrawCallback callback, void* userdata, size_t userdata_size)
 {
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     IM_ASSERT(curr_cmd->UserCallback == NULL);
-    if (curr_cmd->ElemCount != 0)
+    if (curr_cmd->ElemCount != 0 || curr_cmd->InstCount != 0)
     {
         AddDrawCmd();
         curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
@@ -525,7 +625,9 @@ void ImDrawList::AddCallback(ImDrawCallback callback, void* userdata, size_t use
 #define ImDrawCmd_HeaderSize                            (offsetof(ImDrawCmd, VtxOffset) + sizeof(unsigned int))
 #define ImDrawCmd_HeaderCompare(CMD_LHS, CMD_RHS)       (memcmp(CMD_LHS, CMD_RHS, ImDrawCmd_HeaderSize))    // Compare ClipRect, TextureId, VtxOffset
 #define ImDrawCmd_HeaderCopy(CMD_DST, CMD_SRC)          (memcpy(CMD_DST, CMD_SRC, ImDrawCmd_HeaderSize))    // Copy ClipRect, TextureId, VtxOffset
-#define ImDrawCmd_AreSequentialIdxOffset(CMD_0, CMD_1)  (CMD_0->IdxOffset + CMD_0->ElemCount == CMD_1->IdxOffset)
+#define ImDrawCmd_AreSequentialIdxOffset(CMD_0, CMD_1)  (CMD_0->IdxOffset + CMD_0->ElemCount == CMD_1->IdxOffset && ImDrawCmd_AreSequentialInstOffset(CMD_0, CMD_1))
+#define ImDrawCmd_AreSequentialInstOffset(CMD_0, CMD_1) (CMD_0->InstOffset + CMD_0->InstCount == CMD_1->InstOffset && ImDrawCmd_AreSameKind(CMD_0, CMD_1))
+#define ImDrawCmd_AreSameKind(CMD_0, CMD_1)             ((CMD_0->ElemCount == 0 || CMD_1->InstCount == 0) && (CMD_0->InstCount == 0 || CMD_1->ElemCount == 0)) // Never merge triangles with rectangle instances
 
 // Try to merge two last draw commands
 void ImDrawList::_TryMergeDrawCmds()
@@ -536,6 +638,7 @@ void ImDrawList::_TryMergeDrawCmds()
     if (ImDrawCmd_HeaderCompare(curr_cmd, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && curr_cmd->UserCallback == NULL && prev_cmd->UserCallback == NULL)
     {
         prev_cmd->ElemCount += curr_cmd->ElemCount;
+        prev_cmd->InstCount += curr_cmd->InstCount;
         CmdBuffer.pop_back();
     }
 }
@@ -547,7 +650,7 @@ void ImDrawList::_OnChangedClipRect()
     // If current command is used with different settings we need to add a new command
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-    if (curr_cmd->ElemCount != 0 && memcmp(&curr_cmd->ClipRect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
+    if ((curr_cmd->ElemCount != 0 || curr_cmd->InstCount != 0) && memcmp(&curr_cmd->ClipRect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
     {
         AddDrawCmd();
         return;
@@ -556,7 +659,7 @@ void ImDrawList::_OnChangedClipRect()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && curr_cmd->InstCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
     {
         CmdBuffer.pop_back();
         return;
@@ -569,7 +672,7 @@ void ImDrawList::_OnChangedTextureID()
     // If current command is used with different settings we need to add a new command
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-    if (curr_cmd->ElemCount != 0 && curr_cmd->TextureId != _CmdHeader.TextureId)
+    if ((curr_cmd->ElemCount != 0 || curr_cmd->InstCount != 0) && curr_cmd->TextureId != _CmdHeader.TextureId)
     {
         AddDrawCmd();
         return;
@@ -578,7 +681,7 @@ void ImDrawList::_OnChangedTextureID()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && curr_cmd->InstCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
     {
         CmdBuffer.pop_back();
         return;
@@ -593,7 +696,7 @@ void ImDrawList::_OnChangedVtxOffset()
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     //IM_ASSERT(curr_cmd->VtxOffset != _CmdHeader.VtxOffset); // See #3349
-    if (curr_cmd->ElemCount != 0)
+    if (curr_cmd->ElemCount != 0 || curr_cmd->InstCount != 0)
     {
         AddDrawCmd();
         return;
@@ -684,6 +787,12 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
     }
 
     ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    if (draw_cmd->InstCount != 0)
+    {
+        // Previous command is rendering rectangle instances: we need a new command for triangles.
+        AddDrawCmd();
+        draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    }
     draw_cmd->ElemCount += idx_count;
 
     int vtx_buffer_old_size = VtxBuffer.Size;
@@ -706,6 +815,42 @@ void ImDrawList::PrimUnreserve(int idx_count, int vtx_count)
     IdxBuffer.shrink(IdxBuffer.Size - idx_count);
 }
 
+// Reserve space for a number of rectangle instances (only when using ImDrawListFlags_AllowRectInstances).
+// Same rules as PrimReserve(): you must finish filling your reserved data before calling PrimReserveInstances() again.
+void ImDrawList::PrimReserveInstances(int inst_count)
+{
+    IM_ASSERT_PARANOID(inst_count >= 0);
+    IM_ASSERT_PARANOID(Flags & ImDrawListFlags_AllowRectInstances);
+
+    // A command either render triangles or a contiguous range of instances.
+    ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    if (draw_cmd->ElemCount == 0 && draw_cmd->InstCount == 0)
+    {
+        draw_cmd->InstOffset = InstBuffer.Size;
+    }
+    else if (draw_cmd->ElemCount != 0 || draw_cmd->InstOffset + draw_cmd->InstCount != (unsigned int)InstBuffer.Size)
+    {
+        AddDrawCmd();
+        draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    }
+    draw_cmd->InstCount += inst_count;
+
+    int inst_buffer_old_size = InstBuffer.Size;
+    InstBuffer.resize(inst_buffer_old_size + inst_count);
+    _InstWritePtr = InstBuffer.Data + inst_buffer_old_size;
+}
+
+// Release the number of reserved instances from the end of the last reservation made with PrimReserveInstances().
+void ImDrawList::PrimUnreserveInstances(int inst_count)
+{
+    IM_ASSERT_PARANOID(inst_count >= 0);
+
+    ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    draw_cmd->InstCount -= inst_count;
+    InstBuffer.shrink(InstBuffer.Size - inst_count);
+    _InstWritePtr = InstBuffer.Data + InstBuffer.Size;
+}
+
 // Fully unrolled with inline call to keep our debug builds decently fast.
 void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 {
@@ -713,10 +858,10 @@ void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+    ImDrawVert_Write(&_VtxWritePtr[0], a.x, a.y, uv.x, uv.y, col);
+    ImDrawVert_Write(&_VtxWritePtr[1], b.x, b.y, uv.x, uv.y, col);
+    ImDrawVert_Write(&_VtxWritePtr[2], c.x, c.y, uv.x, uv.y, col);
+    ImDrawVert_Write(&_VtxWritePtr[3], d.x, d.y, uv.x, uv.y, col);
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -728,10 +873,10 @@ void ImDrawList::PrimRectUV(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv_a; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv_b; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv_c; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv_d; _VtxWritePtr[3].col = col;
+    ImDrawVert_Write(&_VtxWritePtr[0], a.x, a.y, uv_a.x, uv_a.y, col);
+    ImDrawVert_Write(&_VtxWritePtr[1], b.x, b.y, uv_b.x, uv_b.y, col);
+    ImDrawVert_Write(&_VtxWritePtr[2], c.x, c.y, uv_c.x, uv_c.y, col);
+    ImDrawVert_Write(&_VtxWritePtr[3], d.x, d.y, uv_d.x, uv_d.y, col);
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -742,10 +887,10 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv_a; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv_b; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv_c; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv_d; _VtxWritePtr[3].col = col;
+    ImDrawVert_Write(&_VtxWritePtr[0], a.x, a.y, uv_a.x, uv_a.y, col);
+    ImDrawVert_Write(&_VtxWritePtr[1], b.x, b.y, uv_b.x, uv_b.y, col);
+    ImDrawVert_Write(&_VtxWritePtr[2], c.x, c.y, uv_c.x, uv_c.y, col);
+    ImDrawVert_Write(&_VtxWritePtr[3], d.x, d.y, uv_d.x, uv_d.y, col);
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -756,8 +901,156 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 // - Those macros are intentionally not surrounded by the 'do {} while (0)' idiom because even that translates to runtime with debug compilers.
 #define IM_NORMALIZE2F_OVER_ZERO(VX,VY)     { float d2 = VX*VX + VY*VY; if (d2 > 0.0f) { float inv_len = ImRsqrt(d2); VX *= inv_len; VY *= inv_len; } } (void)0
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
+#define IM_POLYLINE_MITER_LIMIT             2.0f   // Non anti-aliased lines: bevel joins where the miter would extend further than this multiple of half the thickness
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+// Compute one normal per line segment for AddPolyline(): out_normals[i1] = perpendicular of normalized (points[i2] - points[i1])
+// With IMGUI_ENABLE_SSE, 4 segments are processed at a time (2 per register, kept interleaved as x/y pairs).
+// The output is bit-identical to the scalar loop: _mm_rsqrt_ps() matches the _mm_rsqrt_ss() used by ImRsqrt() on each lane.
+// With IMGUI_ENABLE_NEON on AArch64, same as SSE using a division by the square root, as ImRsqrt() does without SSE.
+// (compilers contracting the scalar multiply-adds into FMA, e.g. GCC default on AArch64, may round differently in the last bit)
+#if defined(IMGUI_ENABLE_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#define IM_POLYLINE_ENABLE_NEON // vsqrtq_f32(), vdivq_f32() are not available on 32-bit ARM
+#endif
+static void PolylineCalcSegmentNormals(const ImVec2* points, const int points_count, const int count, ImVec2* out_normals)
+{
+    int i1 = 0;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 neg_y = _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+    for (; i1 + 4 < points_count; i1 += 4) // Don't need to handle wrap-around here: i2 == i1 + 1 for all 4 segments
+    {
+        __m128 d[2];
+        d[0] = _mm_sub_ps(_mm_loadu_ps(&points[i1 + 1].x), _mm_loadu_ps(&points[i1 + 0].x)); // dx0 dy0 dx1 dy1
+        d[1] = _mm_sub_ps(_mm_loadu_ps(&points[i1 + 3].x), _mm_loadu_ps(&points[i1 + 2].x)); // dx2 dy2 dx3 dy3
+        for (int n = 0; n < 2; n++)
+        {
+            // Same as IM_NORMALIZE2F_OVER_ZERO()
+            __m128 sq = _mm_mul_ps(d[n], d[n]);
+            __m128 d2 = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1)));
+            __m128 mask = _mm_cmpgt_ps(d2, zero);
+            __m128 dn = _mm_mul_ps(d[n], _mm_rsqrt_ps(d2));
+            dn = _mm_or_ps(_mm_and_ps(mask, dn), _mm_andnot_ps(mask, d[n]));
+            // (dx, dy) -> (dy, -dx)
+            dn = _mm_xor_ps(_mm_shuffle_ps(dn, dn, _MM_SHUFFLE(2, 3, 0, 1)), neg_y);
+            _mm_storeu_ps(&out_normals[i1 + n * 2].x, dn);
+        }
+    }
+#elif defined(IM_POLYLINE_ENABLE_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const uint32_t neg_y_data[4] = { 0, 0x80000000, 0, 0x80000000 };
+    const uint32x4_t neg_y = vld1q_u32(neg_y_data);
+    for (; i1 + 4 < points_count; i1 += 4) // Don't need to handle wrap-around here: i2 == i1 + 1 for all 4 segments
+    {
+        float32x4_t d[2];
+        d[0] = vsubq_f32(vld1q_f32(&points[i1 + 1].x), vld1q_f32(&points[i1 + 0].x)); // dx0 dy0 dx1 dy1
+        d[1] = vsubq_f32(vld1q_f32(&points[i1 + 3].x), vld1q_f32(&points[i1 + 2].x)); // dx2 dy2 dx3 dy3
+        for (int n = 0; n < 2; n++)
+        {
+            // Same as IM_NORMALIZE2F_OVER_ZERO()
+            float32x4_t sq = vmulq_f32(d[n], d[n]);
+            float32x4_t d2 = vaddq_f32(sq, vrev64q_f32(sq));
+            uint32x4_t mask = vcgtq_f32(d2, zero);
+            float32x4_t dn = vbslq_f32(mask, vmulq_f32(d[n], vdivq_f32(one, vsqrtq_f32(d2))), d[n]);
+            // (dx, dy) -> (dy, -dx)
+            dn = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vrev64q_f32(dn)), neg_y));
+            vst1q_f32(&out_normals[i1 + n * 2].x, dn);
+        }
+    }
+#endif
+    for (; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        out_normals[i1].x = dy;
+        out_normals[i1].y = -dx;
+    }
+}
+
+// Compute averaged normal at the end point of each segment for AddPolyline(): out_normals[i2] = FixNormal((normals[i1] + normals[i2]) * 0.5f)
+// The result is the offset to apply for an outer edge at distance 1.0f from the line center (miter).
+static void PolylineCalcPointNormals(const ImVec2* normals, const int points_count, const int count, ImVec2* out_normals)
+{
+    int i1 = 0;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 d2_min = _mm_set1_ps(0.000001f);
+    const __m128 inv_len2_max = _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2);
+    for (; i1 + 4 < points_count; i1 += 4)
+    {
+        for (int n = 0; n < 4; n += 2)
+        {
+            // Same as IM_FIXNORMAL2F()
+            __m128 dm = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&normals[i1 + n].x), _mm_loadu_ps(&normals[i1 + n + 1].x)), half);
+            __m128 sq = _mm_mul_ps(dm, dm);
+            __m128 d2 = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1)));
+            __m128 mask = _mm_cmpgt_ps(d2, d2_min);
+            __m128 inv_len2 = _mm_div_ps(one, d2);
+            inv_len2 = _mm_min_ps(inv_len2, inv_len2_max);
+            dm = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(dm, inv_len2)), _mm_andnot_ps(mask, dm));
+            _mm_storeu_ps(&out_normals[i1 + n + 1].x, dm);
+        }
+    }
+#elif defined(IM_POLYLINE_ENABLE_NEON)
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t d2_min = vdupq_n_f32(0.000001f);
+    const float32x4_t inv_len2_max = vdupq_n_f32(IM_FIXNORMAL2F_MAX_INVLEN2);
+    for (; i1 + 4 < points_count; i1 += 4)
+    {
+        for (int n = 0; n < 4; n += 2)
+        {
+            // Same as IM_FIXNORMAL2F()
+            float32x4_t dm = vmulq_f32(vaddq_f32(vld1q_f32(&normals[i1 + n].x), vld1q_f32(&normals[i1 + n + 1].x)), half);
+            float32x4_t sq = vmulq_f32(dm, dm);
+            float32x4_t d2 = vaddq_f32(sq, vrev64q_f32(sq));
+            uint32x4_t mask = vcgtq_f32(d2, d2_min);
+            float32x4_t inv_len2 = vminq_f32(vdivq_f32(one, d2), inv_len2_max);
+            dm = vbslq_f32(mask, vmulq_f32(dm, inv_len2), dm);
+            vst1q_f32(&out_normals[i1 + n + 1].x, dm);
+        }
+    }
+#endif
+    for (; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        float dm_x = (normals[i1].x + normals[i2].x) * 0.5f;
+        float dm_y = (normals[i1].y + normals[i2].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        out_normals[i2].x = dm_x;
+        out_normals[i2].y = dm_y;
+    }
+}
+
+// Calculate the offset of a non anti-aliased polyline join (at distance 1.0f from the line center) from the normals of its incoming and outgoing segments.
+// Returns false when the join is too sharp for a miter (miter longer than IM_POLYLINE_MITER_LIMIT), in which case the caller needs to emit a bevel.
+static inline bool PolylineCalcJoinMiter(ImVec2 n0, ImVec2 n1, ImVec2* out_miter)
+{
+    // Zero-length segments have no normal: use the normal of the other segment
+    if (n0.x == 0.0f && n0.y == 0.0f)
+        n0 = n1;
+    if (n1.x == 0.0f && n1.y == 0.0f)
+        n1 = n0;
+    if (n0.x == 0.0f && n0.y == 0.0f)
+    {
+        *out_miter = n0;
+        return true;
+    }
+    float dm_x = (n0.x + n1.x) * 0.5f;
+    float dm_y = (n0.y + n1.y) * 0.5f;
+    float d2 = dm_x * dm_x + dm_y * dm_y;
+    if (d2 * (IM_POLYLINE_MITER_LIMIT * IM_POLYLINE_MITER_LIMIT) < 1.0f)
+        return false;
+    float inv_len2 = 1.0f / d2;
+    out_miter->x = dm_x * inv_len2;
+    out_miter->y = dm_y * inv_len2;
+    return true;
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
@@ -787,32 +1080,30 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         const bool use_texture = (Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f) && (AA_SIZE == 1.0f);
 
         // We should never hit this, because NewFrame() doesn't set ImDrawListFlags_AntiAliasedLinesUseTex unless ImFontAtlasFlags_NoBakedLines is off
-        IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & ImFontAtlasFlags_NoBakedLines));
+        IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SignedDistanceField)));
 
         const int idx_count = use_texture ? (count * 6) : (thick_line ? count * 18 : count * 12);
         const int vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
         PrimReserve(idx_count, vtx_count);
 
         // Temporary buffer
-        // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
-        _Data->TempBuffer.reserve_discard(points_count * ((use_texture || !thick_line) ? 3 : 5));
+        // The first <points_count> items are normals at each line segment, the next <points_count> items are averaged normals at each line point
+        _Data->TempBuffer.reserve_discard(points_count * 2);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        ImVec2* temp_points = temp_normals + points_count;
+        ImVec2* temp_point_normals = temp_normals + points_count;
 
-        // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
-        }
+        // Calculate normals (tangents) for each line segment, then average them for each line point
+        // If line is not closed, the first point needs to be generated differently as there are no normals to blend
+        PolylineCalcSegmentNormals(points, points_count, count, temp_normals);
         if (!closed)
             temp_normals[points_count - 1] = temp_normals[points_count - 2];
+        PolylineCalcPointNormals(temp_normals, points_count, count, temp_point_normals);
+        if (!closed)
+            temp_point_normals[0] = temp_normals[0];
 
-        // If we are drawing a one-pixel-wide line without a texture, or a textured line of any width, we only need 2 or 3 vertices per point
+        // Generate the vertices for each point and the indices to form a number of triangles for each line segment, in a single pass.
+        // Segment n joins point n and n+1, with the last segment of a closed line joining back to the first point.
+        const unsigned int idx_base = _VtxCurrentIdx;
         if (use_texture || !thick_line)
         {
             // [PATH 1] Texture-based lines (thick or non-thick)
@@ -825,59 +1116,6 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             //   allow scaling geometry while preserving one-screen-pixel AA fringe).
             const float half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : AA_SIZE;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
-            {
-                temp_points[0] = points[0] + temp_normals[0] * half_draw_size;
-                temp_points[1] = points[0] - temp_normals[0] * half_draw_size;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * half_draw_size;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
-            }
-
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
-            {
-                const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
-                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
-
-                // Add temporary vertexes for the outer edges
-                ImVec2* out_vtx = &temp_points[i2 * 2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
-
-                if (use_texture)
-                {
-                    // Add indices for two triangles
-                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 1); // Right tri
-                    _IdxWritePtr[3] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[4] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Left tri
-                    _IdxWritePtr += 6;
-                }
-                else
-                {
-                    // Add indexes for four triangles
-                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 2); // Right tri 1
-                    _IdxWritePtr[3] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Right tri 2
-                    _IdxWritePtr[6] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8] = (ImDrawIdx)(idx1 + 0); // Left tri 1
-                    _IdxWritePtr[9] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1); // Left tri 2
-                    _IdxWritePtr += 12;
-                }
-
-                idx1 = idx2;
-            }
-
-            // Add vertexes for each point on the line
             if (use_texture)
             {
                 // If we're using textures we only need to emit the left/right edge vertices
@@ -892,22 +1130,49 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 }*/
                 ImVec2 tex_uv0(tex_uvs.x, tex_uvs.y);
                 ImVec2 tex_uv1(tex_uvs.z, tex_uvs.w);
-                for (int i = 0; i < points_count; i++)
+                for (int i1 = 0; i1 < points_count; i1++)
                 {
-                    _VtxWritePtr[0].pos = temp_points[i * 2 + 0]; _VtxWritePtr[0].uv = tex_uv0; _VtxWritePtr[0].col = col; // Left-side outer edge
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 1]; _VtxWritePtr[1].uv = tex_uv1; _VtxWritePtr[1].col = col; // Right-side outer edge
+                    // dm_x, dm_y are offset to the outer edge of the AA area
+                    const float dm_x = temp_point_normals[i1].x * half_draw_size;
+                    const float dm_y = temp_point_normals[i1].y * half_draw_size;
+                    ImDrawVert_Write(&_VtxWritePtr[0], points[i1].x + dm_x, points[i1].y + dm_y, tex_uv0.x, tex_uv0.y, col); // Left-side outer edge
+                    ImDrawVert_Write(&_VtxWritePtr[1], points[i1].x - dm_x, points[i1].y - dm_y, tex_uv1.x, tex_uv1.y, col); // Right-side outer edge
                     _VtxWritePtr += 2;
+
+                    if (i1 == count)
+                        break;
+                    const unsigned int idx1 = idx_base + i1 * 2; // Vertex index for start of line segment
+                    const unsigned int idx2 = ((i1 + 1) == points_count) ? idx_base : (idx1 + 2); // Vertex index for end of segment
+
+                    // Add indices for two triangles
+                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 1); // Right tri
+                    _IdxWritePtr[3] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[4] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Left tri
+                    _IdxWritePtr += 6;
                 }
             }
             else
             {
                 // If we're not using a texture, we need the center vertex as well
-                for (int i = 0; i < points_count; i++)
+                for (int i1 = 0; i1 < points_count; i1++)
                 {
-                    _VtxWritePtr[0].pos = points[i];              _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;       // Center of line
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 0]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col_trans; // Left-side outer edge
-                    _VtxWritePtr[2].pos = temp_points[i * 2 + 1]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col_trans; // Right-side outer edge
+                    const float dm_x = temp_point_normals[i1].x * half_draw_size;
+                    const float dm_y = temp_point_normals[i1].y * half_draw_size;
+                    ImDrawVert_Write(&_VtxWritePtr[0], points[i1].x, points[i1].y, opaque_uv.x, opaque_uv.y, col);           // Center of line
+                    ImDrawVert_Write(&_VtxWritePtr[1], points[i1].x + dm_x, points[i1].y + dm_y, opaque_uv.x, opaque_uv.y, col_trans); // Left-side outer edge
+                    ImDrawVert_Write(&_VtxWritePtr[2], points[i1].x - dm_x, points[i1].y - dm_y, opaque_uv.x, opaque_uv.y, col_trans); // Right-side outer edge
                     _VtxWritePtr += 3;
+
+                    if (i1 == count)
+                        break;
+                    const unsigned int idx1 = idx_base + i1 * 3;
+                    const unsigned int idx2 = ((i1 + 1) == points_count) ? idx_base : (idx1 + 3);
+
+                    // Add indexes for four triangles
+                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 2); // Right tri 1
+                    _IdxWritePtr[3] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Right tri 2
+                    _IdxWritePtr[6] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8] = (ImDrawIdx)(idx1 + 0); // Left tri 1
+                    _IdxWritePtr[9] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1); // Left tri 2
+                    _IdxWritePtr += 12;
                 }
             }
         }
@@ -915,49 +1180,24 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         {
             // [PATH 2] Non texture-based lines (thick): we need to draw the solid line core and thus require four vertices per point
             const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
+            const float half_outer_thickness = half_inner_thickness + AA_SIZE;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
-            {
-                const int points_last = points_count - 1;
-                temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
-                temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
-                temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 0] = points[points_last] + temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 1] = points[points_last] + temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 2] = points[points_last] - temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-            }
-
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            for (int i1 = 0; i1 < points_count; i1++)
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
-                const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
+                const float dm_out_x = temp_point_normals[i1].x * half_outer_thickness;
+                const float dm_out_y = temp_point_normals[i1].y * half_outer_thickness;
+                const float dm_in_x = temp_point_normals[i1].x * half_inner_thickness;
+                const float dm_in_y = temp_point_normals[i1].y * half_inner_thickness;
+                ImDrawVert_Write(&_VtxWritePtr[0], points[i1].x + dm_out_x, points[i1].y + dm_out_y, opaque_uv.x, opaque_uv.y, col_trans);
+                ImDrawVert_Write(&_VtxWritePtr[1], points[i1].x + dm_in_x, points[i1].y + dm_in_y, opaque_uv.x, opaque_uv.y, col);
+                ImDrawVert_Write(&_VtxWritePtr[2], points[i1].x - dm_in_x, points[i1].y - dm_in_y, opaque_uv.x, opaque_uv.y, col);
+                ImDrawVert_Write(&_VtxWritePtr[3], points[i1].x - dm_out_x, points[i1].y - dm_out_y, opaque_uv.x, opaque_uv.y, col_trans);
+                _VtxWritePtr += 4;
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertices
-                ImVec2* out_vtx = &temp_points[i2 * 4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
+                if (i1 == count)
+                    break;
+                const unsigned int idx1 = idx_base + i1 * 4;
+                const unsigned int idx2 = ((i1 + 1) == points_count) ? idx_base : (idx1 + 4);
 
                 // Add indexes
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
@@ -967,18 +1207,6 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 _IdxWritePtr[12] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[13] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[14] = (ImDrawIdx)(idx1 + 3);
                 _IdxWritePtr[15] = (ImDrawIdx)(idx1 + 3); _IdxWritePtr[16] = (ImDrawIdx)(idx2 + 3); _IdxWritePtr[17] = (ImDrawIdx)(idx2 + 2);
                 _IdxWritePtr += 18;
-
-                idx1 = idx2;
-            }
-
-            // Add vertices
-            for (int i = 0; i < points_count; i++)
-            {
-                _VtxWritePtr[0].pos = temp_points[i * 4 + 0]; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col_trans;
-                _VtxWritePtr[1].pos = temp_points[i * 4 + 1]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-                _VtxWritePtr[2].pos = temp_points[i * 4 + 2]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-                _VtxWritePtr[3].pos = temp_points[i * 4 + 3]; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col_trans;
-                _VtxWritePtr += 4;
             }
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
@@ -986,32 +1214,80 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
     else
     {
         // [PATH 4] Non texture-based, Non anti-aliased lines
-        const int idx_count = count * 6;
-        const int vtx_count = count * 4;    // FIXME-OPT: Not sharing edges
+        // Consecutive segments share the two vertices at their join (mitered), so we need two vertices per point.
+        // Joins too sharp for a miter are beveled: two more vertices for that point and two triangles to fill the gap.
+        const float half_thickness = thickness * 0.5f;
+        _Data->TempBuffer.reserve_discard(points_count);
+        ImVec2* temp_normals = _Data->TempBuffer.Data;
+        PolylineCalcSegmentNormals(points, points_count, count, temp_normals);
+
+        // Count bevels so we can reserve the exact amount
+        int bevel_count = 0;
+        ImVec2 miter;
+        for (int i1 = closed ? 0 : 1; i1 < count; i1++)
+            if (!PolylineCalcJoinMiter(temp_normals[i1 == 0 ? count - 1 : i1 - 1], temp_normals[i1], &miter))
+                bevel_count++;
+        const int idx_count = (count + bevel_count) * 6;
+        const int vtx_count = (points_count + bevel_count) * 2;
         PrimReserve(idx_count, vtx_count);
 
-        for (int i1 = 0; i1 < count; i1++)
+        const unsigned int idx_base = _VtxCurrentIdx;
+        unsigned int idx_prev_out = 0; // Vertex index for start of the line segment ending at current point
+        for (int i1 = 0; i1 < points_count; i1++)
         {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            const ImVec2& p1 = points[i1];
-            const ImVec2& p2 = points[i2];
+            // Open lines have square caps: use the normal of the only segment touching first/last points
+            const ImVec2& p = points[i1];
+            const ImVec2& n_in = temp_normals[(i1 == 0) ? count - 1 : i1 - 1];
+            const ImVec2& n_out = temp_normals[(i1 == count) ? count - 1 : i1];
+            bool bevel = false;
+            if (!closed && i1 == 0)
+                miter = n_out;
+            else if (!closed && i1 == count)
+                miter = n_in;
+            else
+                bevel = !PolylineCalcJoinMiter(n_in, n_out, &miter);
 
-            float dx = p2.x - p1.x;
-            float dy = p2.y - p1.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            dx *= (thickness * 0.5f);
-            dy *= (thickness * 0.5f);
+            const unsigned int idx_in = _VtxCurrentIdx;
+            if (bevel)
+            {
+                const float dm_in_x = n_in.x * half_thickness, dm_in_y = n_in.y * half_thickness;
+                const float dm_out_x = n_out.x * half_thickness, dm_out_y = n_out.y * half_thickness;
+                ImDrawVert_Write(&_VtxWritePtr[0], p.x + dm_in_x, p.y + dm_in_y, opaque_uv.x, opaque_uv.y, col);
+                ImDrawVert_Write(&_VtxWritePtr[1], p.x - dm_in_x, p.y - dm_in_y, opaque_uv.x, opaque_uv.y, col);
+                ImDrawVert_Write(&_VtxWritePtr[2], p.x + dm_out_x, p.y + dm_out_y, opaque_uv.x, opaque_uv.y, col);
+                ImDrawVert_Write(&_VtxWritePtr[3], p.x - dm_out_x, p.y - dm_out_y, opaque_uv.x, opaque_uv.y, col);
+                _VtxWritePtr += 4;
+                _VtxCurrentIdx += 4;
 
-            _VtxWritePtr[0].pos.x = p1.x + dy; _VtxWritePtr[0].pos.y = p1.y - dx; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr[1].pos.x = p2.x + dy; _VtxWritePtr[1].pos.y = p2.y - dx; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-            _VtxWritePtr[2].pos.x = p2.x - dy; _VtxWritePtr[2].pos.y = p2.y + dx; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-            _VtxWritePtr[3].pos.x = p1.x - dy; _VtxWritePtr[3].pos.y = p1.y + dx; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col;
-            _VtxWritePtr += 4;
+                // Fill the join with the parallelogram formed by the four vertices (split along its diagonal 0-1 going through 'p')
+                _IdxWritePtr[0] = (ImDrawIdx)(idx_in + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx_in + 1); _IdxWritePtr[2] = (ImDrawIdx)(idx_in + 2);
+                _IdxWritePtr[3] = (ImDrawIdx)(idx_in + 0); _IdxWritePtr[4] = (ImDrawIdx)(idx_in + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx_in + 3);
+                _IdxWritePtr += 6;
+            }
+            else
+            {
+                const float dm_x = miter.x * half_thickness;
+                const float dm_y = miter.y * half_thickness;
+                ImDrawVert_Write(&_VtxWritePtr[0], p.x + dm_x, p.y + dm_y, opaque_uv.x, opaque_uv.y, col);
+                ImDrawVert_Write(&_VtxWritePtr[1], p.x - dm_x, p.y - dm_y, opaque_uv.x, opaque_uv.y, col);
+                _VtxWritePtr += 2;
+                _VtxCurrentIdx += 2;
+            }
 
-            _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + 1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + 2);
-            _IdxWritePtr[3] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[4] = (ImDrawIdx)(_VtxCurrentIdx + 2); _IdxWritePtr[5] = (ImDrawIdx)(_VtxCurrentIdx + 3);
+            // Add indexes for the segment ending at this point, and for the closing segment if any
+            if (i1 > 0)
+            {
+                _IdxWritePtr[0] = (ImDrawIdx)(idx_prev_out); _IdxWritePtr[1] = (ImDrawIdx)(idx_in); _IdxWritePtr[2] = (ImDrawIdx)(idx_in + 1);
+                _IdxWritePtr[3] = (ImDrawIdx)(idx_prev_out); _IdxWritePtr[4] = (ImDrawIdx)(idx_in + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx_prev_out + 1);
+                _IdxWritePtr += 6;
+            }
+            idx_prev_out = bevel ? idx_in + 2 : idx_in;
+        }
+        if (closed)
+        {
+            _IdxWritePtr[0] = (ImDrawIdx)(idx_prev_out); _IdxWritePtr[1] = (ImDrawIdx)(idx_base); _IdxWritePtr[2] = (ImDrawIdx)(idx_base + 1);
+            _IdxWritePtr[3] = (ImDrawIdx)(idx_prev_out); _IdxWritePtr[4] = (ImDrawIdx)(idx_base + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx_prev_out + 1);
             _IdxWritePtr += 6;
-            _VtxCurrentIdx += 4;
         }
     }
 }
@@ -1069,8 +1345,8 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             dm_y *= AA_SIZE * 0.5f;
 
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            ImDrawVert_Write(&_VtxWritePtr[0], points[i1].x - dm_x, points[i1].y - dm_y, uv.x, uv.y, col);        // Inner
+            ImDrawVert_Write(&_VtxWritePtr[1], points[i1].x + dm_x, points[i1].y + dm_y, uv.x, uv.y, col_trans);  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -1088,7 +1364,7 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         PrimReserve(idx_count, vtx_count);
         for (int i = 0; i < vtx_count; i++)
         {
-            _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            ImDrawVert_Write(&_VtxWritePtr[0], points[i].x, points[i].y, uv.x, uv.y, col);
             _VtxWritePtr++;
         }
         for (int i = 2; i < points_count; i++)
@@ -1386,6 +1662,55 @@ void ImDrawList::PathBezierQuadraticCurveTo(const ImVec2& p2, const ImVec2& p3,
     }
 }
 
+// Uniform segment count for a cubic Bezier curve, so the polyline stays within a distance derived from 'tess_tol' (Wang's formula).
+// Slightly more points than PathBezierCubicCurveToCasteljau() on curves with flat parts, but we don't need to recurse.
+static int ImBezierCubicCalcSegmentCount(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, float tess_tol)
+{
+    const float ddx0 = p1.x - 2.0f * p2.x + p3.x, ddy0 = p1.y - 2.0f * p2.y + p3.y;
+    const float ddx1 = p2.x - 2.0f * p3.x + p4.x, ddy1 = p2.y - 2.0f * p3.y + p4.y;
+    const float dd = ImSqrt(ImMax(ddx0 * ddx0 + ddy0 * ddy0, ddx1 * ddx1 + ddy1 * ddy1));
+    const float max_dist = ImSqrt(tess_tol) * 0.70f; // Roughly matches the maximum distance obtained with PathBezierCubicCurveToCasteljau()
+    return ImClamp((int)ImCeil(ImSqrt(dd * 0.75f / max_dist)), 1, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+}
+
+// Write 'num_segments' points at t = 1/num_segments .. 1 using forward differences: 3 additions per point.
+// With IMGUI_ENABLE_SSE, x and y are processed in the same register.
+static void ImBezierCubicForwardDifferences(ImVec2* out, const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, int num_segments)
+{
+    const float h = 1.0f / (float)num_segments;
+    const float h2 = h * h;
+    const float h3 = h2 * h;
+    const ImVec2 a(-p1.x + 3.0f * p2.x - 3.0f * p3.x + p4.x, -p1.y + 3.0f * p2.y - 3.0f * p3.y + p4.y);
+    const ImVec2 b(3.0f * p1.x - 6.0f * p2.x + 3.0f * p3.x, 3.0f * p1.y - 6.0f * p2.y + 3.0f * p3.y);
+    const ImVec2 c(3.0f * (p2.x - p1.x), 3.0f * (p2.y - p1.y));
+#ifdef IMGUI_ENABLE_SSE
+    __m128 f   = _mm_setr_ps(p1.x, p1.y, 0.0f, 0.0f);
+    __m128 df1 = _mm_setr_ps(a.x * h3 + b.x * h2 + c.x * h, a.y * h3 + b.y * h2 + c.y * h, 0.0f, 0.0f);
+    __m128 df2 = _mm_setr_ps(6.0f * a.x * h3 + 2.0f * b.x * h2, 6.0f * a.y * h3 + 2.0f * b.y * h2, 0.0f, 0.0f);
+    const __m128 df3 = _mm_setr_ps(6.0f * a.x * h3, 6.0f * a.y * h3, 0.0f, 0.0f);
+    for (int i = 0; i < num_segments - 1; i++)
+    {
+        f = _mm_add_ps(f, df1);
+        df1 = _mm_add_ps(df1, df2);
+        df2 = _mm_add_ps(df2, df3);
+        _mm_storel_pi((__m64*)(void*)&out[i], f);
+    }
+#else
+    float fx = p1.x, fy = p1.y;
+    float df1x = a.x * h3 + b.x * h2 + c.x * h, df1y = a.y * h3 + b.y * h2 + c.y * h;
+    float df2x = 6.0f * a.x * h3 + 2.0f * b.x * h2, df2y = 6.0f * a.y * h3 + 2.0f * b.y * h2;
+    const float df3x = 6.0f * a.x * h3, df3y = 6.0f * a.y * h3;
+    for (int i = 0; i < num_segments - 1; i++)
+    {
+        fx += df1x; fy += df1y;
+        df1x += df2x; df1y += df2y;
+        df2x += df3x; df2y += df3y;
+        out[i] = ImVec2(fx, fy);
+    }
+#endif
+    out[num_segments - 1] = p4; // Avoid accumulated error on last point
+}
+
 static inline ImDrawFlags FixRectCornerFlags(ImDrawFlags flags)
 {
     /*
@@ -1410,13 +1735,20 @@ static inline ImDrawFlags FixRectCornerFlags(ImDrawFlags flags)
     return flags;
 }
 
+// Clamp rounding so that two rounded corners sharing a side don't overlap. Expect fixed up flags.
+static inline float ClampRectRounding(const ImVec2& a, const ImVec2& b, float rounding, ImDrawFlags flags)
+{
+    rounding = ImMin(rounding, ImFabs(b.x - a.x) * (((flags & ImDrawFlags_RoundCornersTop) == ImDrawFlags_RoundCornersTop) || ((flags & ImDrawFlags_RoundCornersBottom) == ImDrawFlags_RoundCornersBottom) ? 0.5f : 1.0f) - 1.0f);
+    rounding = ImMin(rounding, ImFabs(b.y - a.y) * (((flags & ImDrawFlags_RoundCornersLeft) == ImDrawFlags_RoundCornersLeft) || ((flags & ImDrawFlags_RoundCornersRight) == ImDrawFlags_RoundCornersRight) ? 0.5f : 1.0f) - 1.0f);
+    return rounding;
+}
+
 void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, ImDrawFlags flags)
 {
     if (rounding >= 0.5f)
     {
         flags = FixRectCornerFlags(flags);
-        rounding = ImMin(rounding, ImFabs(b.x - a.x) * (((flags & ImDrawFlags_RoundCornersTop) == ImDrawFlags_RoundCornersTop) || ((flags & ImDrawFlags_RoundCornersBottom) == ImDrawFlags_RoundCornersBottom) ? 0.5f : 1.0f) - 1.0f);
-        rounding = ImMin(rounding, ImFabs(b.y - a.y) * (((flags & ImDrawFlags_RoundCornersLeft) == ImDrawFlags_RoundCornersLeft) || ((flags & ImDrawFlags_RoundCornersRight) == ImDrawFlags_RoundCornersRight) ? 0.5f : 1.0f) - 1.0f);
+        rounding = ClampRectRounding(a, b, rounding, flags);
     }
     if (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
     {
@@ -1438,10 +1770,49 @@ void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, ImDr
     }
 }
 
+// Output a rounded rectangle or an ellipse as a single instance, evaluated as a signed distance by the renderer.
+// - Only valid when (Flags & ImDrawListFlags_AllowSdfShapes).
+// - Rounding is clamped the same way as PathRect(). Use thickness == 0.0f for filled shapes.
+void ImDrawList::_AddSdfShape(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding, ImDrawFlags flags, float thickness, bool ellipse)
+{
+    IM_ASSERT_PARANOID(Flags & ImDrawListFlags_AllowSdfShapes);
+    const ImVec2 a(ImMin(p_min.x, p_max.x), ImMin(p_min.y, p_max.y));
+    const ImVec2 b(ImMax(p_min.x, p_max.x), ImMax(p_min.y, p_max.y));
+    ImU8 rounding_corners = 0x0F;
+    if (ellipse)
+    {
+        rounding = 0.0f;
+    }
+    else
+    {
+        flags = FixRectCornerFlags(flags);
+        rounding = ImMax(ClampRectRounding(a, b, rounding, flags), 0.0f);
+        rounding_corners = (ImU8)((flags & ImDrawFlags_RoundCornersAll) >> 4);
+    }
+    PrimReserveInstances(1);
+    PrimRectInstance(a, b, _Data->TexUvWhitePixel, _Data->TexUvWhitePixel, col, rounding);
+    ImDrawRectInstance* inst = _InstWritePtr - 1;
+    inst->Thickness = thickness;
+    inst->RoundingCorners = rounding_corners;
+    inst->Ellipse = ellipse ? 1 : 0;
+}
+
 void ImDrawList::AddLine(const ImVec2& p1, const ImVec2& p2, ImU32 col, float thickness)
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if ((Flags & ImDrawListFlags_AllowRectInstances) && !(Flags & ImDrawListFlags_AntiAliasedLines) && (p1.x == p2.x || p1.y == p2.y))
+    {
+        // Axis-aligned line: emit the footprint of the stroked path as a single rectangle instance (anti-aliased lines keep their fringe on the vertex path)
+        const float half_thickness = thickness * 0.5f;
+        ImVec2 a(ImMin(p1.x, p2.x) + 0.5f, ImMin(p1.y, p2.y) + 0.5f);
+        ImVec2 b(ImMax(p1.x, p2.x) + 0.5f, ImMax(p1.y, p2.y) + 0.5f);
+        if (p1.y == p2.y) { a.y -= half_thickness; b.y += half_thickness; }
+        else              { a.x -= half_thickness; b.x += half_thickness; }
+        PrimReserveInstances(1);
+        PrimRectInstance(a, b, _Data->TexUvWhitePixel, _Data->TexUvWhitePixel, col);
+        return;
+    }
     PathLineTo(p1 + ImVec2(0.5f, 0.5f));
     PathLineTo(p2 + ImVec2(0.5f, 0.5f));
     PathStroke(col, 0, thickness);
@@ -1453,6 +1824,31 @@ void ImDrawList::AddRect(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, fl
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if ((Flags & ImDrawListFlags_AllowRectInstances) && !(Flags & ImDrawListFlags_AntiAliasedLines) && (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone))
+    {
+        // Emit the footprint of the stroked path as four non-overlapping rectangle instances (top, bottom, left, right)
+        const float half_thickness = thickness * 0.5f;
+        const ImVec2 outer_min(p_min.x + 0.5f - half_thickness, p_min.y + 0.5f - half_thickness), outer_max(p_max.x - 0.5f + half_thickness, p_max.y - 0.5f + half_thickness);
+        const ImVec2 inner_min(p_min.x + 0.5f + half_thickness, p_min.y + 0.5f + half_thickness), inner_max(p_max.x - 0.5f - half_thickness, p_max.y - 0.5f - half_thickness);
+        const ImVec2 uv = _Data->TexUvWhitePixel;
+        if (inner_min.x >= inner_max.x || inner_min.y >= inner_max.y)
+        {
+            PrimReserveInstances(1);
+            PrimRectInstance(outer_min, outer_max, uv, uv, col);
+            return;
+        }
+        PrimReserveInstances(4);
+        PrimRectInstance(outer_min, ImVec2(outer_max.x, inner_min.y), uv, uv, col);
+        PrimRectInstance(ImVec2(outer_min.x, inner_max.y), outer_max, uv, uv, col);
+        PrimRectInstance(ImVec2(outer_min.x, inner_min.y), ImVec2(inner_min.x, inner_max.y), uv, uv, col);
+        PrimRectInstance(ImVec2(inner_max.x, inner_min.y), ImVec2(outer_max.x, inner_max.y), uv, uv, col);
+        return;
+    }
+    if ((Flags & ImDrawListFlags_AllowSdfShapes) && (Flags & ImDrawListFlags_AntiAliasedLines))
+    {
+        _AddSdfShape(p_min + ImVec2(0.50f, 0.50f), p_max - ImVec2(0.50f, 0.50f), col, rounding, flags, thickness, false);
+        return;
+    }
     if (Flags & ImDrawListFlags_AntiAliasedLines)
         PathRect(p_min + ImVec2(0.50f, 0.50f), p_max - ImVec2(0.50f, 0.50f), rounding, flags);
     else
@@ -1466,9 +1862,25 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
         return;
     if (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
     {
+        if (Flags & ImDrawListFlags_AllowRectInstances)
+        {
+            PrimReserveInstances(1);
+            PrimRectInstance(p_min, p_max, _Data->TexUvWhitePixel, _Data->TexUvWhitePixel, col);
+            return;
+        }
         PrimReserve(6, 4);
         PrimRect(p_min, p_max, col);
     }
+    else if ((Flags & ImDrawListFlags_AllowSdfShapes) && (Flags & ImDrawListFlags_AntiAliasedFill))
+    {
+        _AddSdfShape(p_min, p_max, col, rounding, flags, 0.0f, false);
+    }
+    else if ((Flags & ImDrawListFlags_AllowRectInstances) && (FixRectCornerFlags(flags) & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersAll)
+    {
+        rounding = ClampRectRounding(p_min, p_max, rounding, ImDrawFlags_RoundCornersAll);
+        PrimReserveInstances(1);
+        PrimRectInstance(p_min, p_max, _Data->TexUvWhitePixel, _Data->TexUvWhitePixel, col, ImMax(rounding, 0.0f));
+    }
     else
     {
         PathRect(p_min, p_max, rounding, flags);
@@ -1543,6 +1955,12 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
     if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
         return;
 
+    if (num_segments <= 0 && (Flags & ImDrawListFlags_AllowSdfShapes) && (Flags & ImDrawListFlags_AntiAliasedLines))
+    {
+        _AddSdfShape(center - ImVec2(radius - 0.5f, radius - 0.5f), center + ImVec2(radius - 0.5f, radius - 0.5f), col, 0.0f, 0, thickness, true);
+        return;
+    }
+
     if (num_segments <= 0)
     {
         // Use arc with automatic segment count
@@ -1562,21 +1980,106 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
     PathStroke(col, ImDrawFlags_Closed, thickness);
 }
 
+// Filled regular polygon using precomputed unit circle from ImDrawListSharedData::CircleVtxCache[].
+// Same output as building a path and calling AddConvexPolyFilled(), but normals of a regular polygon don't need to be computed.
+void ImDrawList::_AddCircleFilledN(const ImVec2& center, float radius, ImU32 col, int num_segments)
+{
+    IM_ASSERT(num_segments >= 3 && num_segments <= IM_DRAWLIST_CIRCLE_VTX_CACHE_MAX);
+    const ImVec2* unit_vtx = &_Data->CircleVtxCache[IM_DRAWLIST_CIRCLE_VTX_CACHE_OFFSET(num_segments)];
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    const float cx = center.x;
+    const float cy = center.y;
+
+    if (Flags & ImDrawListFlags_AntiAliasedFill)
+    {
+        // Anti-aliased Fill
+        const float fringe = _FringeScale * 0.5f * _Data->CircleFringeScale[num_segments];
+        const float r_inner = radius - fringe;
+        const float r_outer = radius + fringe;
+        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+        const int idx_count = (num_segments - 2) * 3 + num_segments * 6;
+        const int vtx_count = (num_segments * 2);
+        PrimReserve(idx_count, vtx_count);
+
+        // Add vertices
+        ImDrawVert* vtx_write = _VtxWritePtr;
+        for (int i = 0; i < num_segments; i++)
+        {
+            const float nx = unit_vtx[i].x;
+            const float ny = unit_vtx[i].y;
+            ImDrawVert_Write(&vtx_write[i * 2 + 0], cx + nx * r_inner, cy + ny * r_inner, uv.x, uv.y, col);        // Inner
+            ImDrawVert_Write(&vtx_write[i * 2 + 1], cx + nx * r_outer, cy + ny * r_outer, uv.x, uv.y, col_trans);  // Outer
+        }
+        _VtxWritePtr += vtx_count;
+
+        // Add indexes for fill
+        const unsigned int vtx_inner_idx = _VtxCurrentIdx;
+        const unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
+        ImDrawIdx* idx_write = _IdxWritePtr;
+        for (int i = 2; i < num_segments; i++, idx_write += 3)
+        {
+            idx_write[0] = (ImDrawIdx)(vtx_inner_idx); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + ((i - 1) << 1)); idx_write[2] = (ImDrawIdx)(vtx_inner_idx + (i << 1));
+        }
+
+        // Add indexes for fringes
+        for (int i0 = num_segments - 1, i1 = 0; i1 < num_segments; i0 = i1++, idx_write += 6)
+        {
+            idx_write[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); idx_write[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
+            idx_write[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); idx_write[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); idx_write[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
+        }
+        _IdxWritePtr = idx_write;
+        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+    }
+    else
+    {
+        // Non Anti-aliased Fill
+        const int idx_count = (num_segments - 2) * 3;
+        const int vtx_count = num_segments;
+        PrimReserve(idx_count, vtx_count);
+        for (int i = 0; i < vtx_count; i++)
+            ImDrawVert_Write(&_VtxWritePtr[i], cx + unit_vtx[i].x * radius, cy + unit_vtx[i].y * radius, uv.x, uv.y, col);
+        _VtxWritePtr += vtx_count;
+        for (int i = 2; i < num_segments; i++)
+        {
+            _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + i - 1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + i);
+            _IdxWritePtr += 3;
+        }
+        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+    }
+}
+
 void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col, int num_segments)
 {
     if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
         return;
 
+    if (num_segments <= 0 && (Flags & ImDrawListFlags_AllowSdfShapes) && (Flags & ImDrawListFlags_AntiAliasedFill))
+    {
+        _AddSdfShape(center - ImVec2(radius, radius), center + ImVec2(radius, radius), col, 0.0f, 0, 0.0f, true);
+        return;
+    }
+
     if (num_segments <= 0)
     {
-        // Use arc with automatic segment count
-        _PathArcToFastEx(center, radius, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
+        // Use arc with automatic segment count (same sampling as _PathArcToFastEx())
+        const int a_step = ImClamp(IM_DRAWLIST_ARCFAST_SAMPLE_MAX / _CalcCircleAutoSegmentCount(radius), 1, IM_DRAWLIST_ARCFAST_TABLE_SIZE / 4);
+        if ((IM_DRAWLIST_ARCFAST_SAMPLE_MAX % a_step) == 0 && IM_DRAWLIST_ARCFAST_SAMPLE_MAX / a_step <= IM_DRAWLIST_CIRCLE_VTX_CACHE_MAX)
+        {
+            _AddCircleFilledN(center, radius, col, IM_DRAWLIST_ARCFAST_SAMPLE_MAX / a_step);
+            return;
+        }
+        _PathArcToFastEx(center, radius, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, a_step);
         _Path.Size--;
     }
     else
     {
         // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
         num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+        if (num_segments <= IM_DRAWLIST_CIRCLE_VTX_CACHE_MAX)
+        {
+            _AddCircleFilledN(center, radius, col, num_segments);
+            return;
+        }
 
         // Because we are filling a closed shape we remove 1 from the count of segments/points
         const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
@@ -1604,6 +2107,12 @@ void ImDrawList::AddNgonFilled(const ImVec2& center, float radius, ImU32 col, in
     if ((col & IM_COL32_A_MASK) == 0 || num_segments <= 2)
         return;
 
+    if (num_segments <= IM_DRAWLIST_CIRCLE_VTX_CACHE_MAX)
+    {
+        _AddCircleFilledN(center, radius, col, num_segments);
+        return;
+    }
+
     // Because we are filling a closed shape we remove 1 from the count of segments/points
     const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
     PathArcTo(center, radius, 0.0f, a_max, num_segments - 1);
@@ -1616,6 +2125,12 @@ void ImDrawList::AddEllipse(const ImVec2& center, const ImVec2& radius, ImU32 co
     if ((col & IM_COL32_A_MASK) == 0)
         return;
 
+    if (num_segments <= 0 && rot == 0.0f && (Flags & ImDrawListFlags_AllowSdfShapes) && (Flags & ImDrawListFlags_AntiAliasedLines))
+    {
+        _AddSdfShape(center - radius, center + radius, col, 0.0f, 0, thickness, true);
+        return;
+    }
+
     if (num_segments <= 0)
         num_segments = _CalcCircleAutoSegmentCount(ImMax(radius.x, radius.y)); // A bit pessimistic, maybe there's a better computation to do here.
 
@@ -1630,6 +2145,12 @@ void ImDrawList::AddEllipseFilled(const ImVec2& center, const ImVec2& radius, Im
     if ((col & IM_COL32_A_MASK) == 0)
         return;
 
+    if (num_segments <= 0 && rot == 0.0f && (Flags & ImDrawListFlags_AllowSdfShapes) && (Flags & ImDrawListFlags_AntiAliasedFill))
+    {
+        _AddSdfShape(center - radius, center + radius, col, 0.0f, 0, 0.0f, true);
+        return;
+    }
+
     if (num_segments <= 0)
         num_segments = _CalcCircleAutoSegmentCount(ImMax(radius.x, radius.y)); // A bit pessimistic, maybe there's a better computation to do here.
 
@@ -1661,21 +2182,78 @@ void ImDrawList::AddBezierQuadratic(const ImVec2& p1, const ImVec2& p2, const Im
     PathStroke(col, 0, thickness);
 }
 
-void ImDrawList::AddText(ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end, float wrap_width, const ImVec4* cpu_fine_clip_rect)
+// Multiple cubic Bezier curves, 4 control points per curve.
+// - Curves are tessellated with forward differences instead of recursive subdivision.
+// - With a cache, tessellation of curves having the same shape as during the previous frame is reused (see ImDrawListCurveCache).
+void ImDrawList::AddBezierCubicBatch(const ImVec2* points, int curves_count, ImU32 col, float thickness, int num_segments, ImDrawListCurveCache* cache)
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
 
-    // Accept null ranges
-    if (text_begin == text_end || text_begin[0] == 0)
-        return;
-    // No need to strlen() here: font->RenderText() will do it and may early out.
+    const float tess_tol = _Data->CurveTessellationTol;
+    IM_ASSERT(num_segments > 0 || tess_tol > 0.0f);
+    for (int curve_n = 0; curve_n < curves_count; curve_n++)
+    {
+        const ImVec2* ctrl = &points[curve_n * 4];
+        const ImVec2 p1 = ctrl[0];
+        PathLineTo(p1);
 
-    // Pull default font/size from the shared ImDrawListSharedData instance
-    if (font == NULL)
-        font = _Data->Font;
-    if (font_size == 0.0f)
-        font_size = _Data->FontSize;
+        ImDrawListCurveCacheEntry key;
+        if (cache != NULL)
+        {
+            // Lookup curve with same shape, translate its points
+            memset(&key, 0, sizeof(key));
+            key.Ctrl[0] = ctrl[1] - p1;
+            key.Ctrl[1] = ctrl[2] - p1;
+            key.Ctrl[2] = ctrl[3] - p1;
+            key.TessTol = tess_tol;
+            key.NumSegments = num_segments;
+            if (const ImDrawListCurveCacheEntry* entry = cache->Find(key))
+            {
+                const ImVec2* cached_points = &cache->Points[0].Data[entry->PointsOffset];
+                const int points_count = cache->Add(*entry, cached_points)->PointsCount;
+                _Path.resize(_Path.Size + points_count);
+                ImVec2* out = _Path.Data + _Path.Size - points_count;
+                for (int n = 0; n < points_count; n++)
+                    out[n] = ImVec2(p1.x + cached_points[n].x, p1.y + cached_points[n].y);
+                PathStroke(col, 0, thickness);
+                continue;
+            }
+        }
+
+        // Tessellate
+        const int curve_segments = (num_segments > 0) ? num_segments : ImBezierCubicCalcSegmentCount(ctrl[0], ctrl[1], ctrl[2], ctrl[3], tess_tol);
+        _Path.reserve(_Path.Size + curve_segments);
+        ImVec2* out = _Path.Data + _Path.Size;
+        ImBezierCubicForwardDifferences(out, ctrl[0], ctrl[1], ctrl[2], ctrl[3], curve_segments);
+        _Path.Size += curve_segments;
+        if (cache != NULL)
+        {
+            key.PointsCount = curve_segments;
+            ImDrawListCurveCacheEntry* new_entry = cache->Add(key, NULL);
+            ImVec2* cached_points = &cache->Points[1].Data[new_entry->PointsOffset];
+            for (int n = 0; n < curve_segments; n++)
+                cached_points[n] = ImVec2(out[n].x - p1.x, out[n].y - p1.y);
+        }
+        PathStroke(col, 0, thickness);
+    }
+}
+
+void ImDrawList::AddText(ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end, float wrap_width, const ImVec4* cpu_fine_clip_rect)
+{
+    if ((col & IM_COL32_A_MASK) == 0)
+        return;
+
+    // Accept null ranges
+    if (text_begin == text_end || text_begin[0] == 0)
+        return;
+    // No need to strlen() here: font->RenderText() will do it and may early out.
+
+    // Pull default font/size from the shared ImDrawListSharedData instance
+    if (font == NULL)
+        font = _Data->Font;
+    if (font_size == 0.0f)
+        font_size = _Data->FontSize;
 
     IM_ASSERT(font->ContainerAtlas->TexID == _CmdHeader.TextureId);  // Use high-level ImGui::PushFont() or low-level ImDrawList::PushTextureId() to change font.
 
@@ -1704,8 +2282,16 @@ void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& p_min, cons
     if (push_texture_id)
         PushTextureID(user_texture_id);
 
-    PrimReserve(6, 4);
-    PrimRectUV(p_min, p_max, uv_min, uv_max, col);
+    if (Flags & ImDrawListFlags_AllowRectInstances)
+    {
+        PrimReserveInstances(1);
+        PrimRectInstance(p_min, p_max, uv_min, uv_max, col);
+    }
+    else
+    {
+        PrimReserve(6, 4);
+        PrimRectUV(p_min, p_max, uv_min, uv_max, col);
+    }
 
     if (push_texture_id)
         PopTextureID();
@@ -1756,12 +2342,16 @@ void ImDrawList::AddImageRounded(ImTextureID user_texture_id, const ImVec2& p_mi
 //-----------------------------------------------------------------------------
 // [SECTION] ImTriangulator, ImDrawList concave polygon fill
 //-----------------------------------------------------------------------------
-// Triangulate concave polygons. Based on "Triangulation by Ear Clipping" paper, O(N^2) complexity.
-// Reference: https://www.geometrictools.com/Documentation/TriangulationByEarClipping.pdf
+// Triangulate concave polygons.
+// - Small simple polygons: based on "Triangulation by Ear Clipping" paper, O(N^2) complexity.
+//   Reference: https://www.geometrictools.com/Documentation/TriangulationByEarClipping.pdf
+// - Large polygons and multiple contours (holes): sweep line, O(N log N) complexity for typical shapes.
 // Provided as a convenience for user but not used by main library.
 //-----------------------------------------------------------------------------
 // - ImTriangulator [Internal]
 // - AddConcavePolyFilled()
+// - ImSweepTriangulator [Internal]
+// - AddConcavePolyFilled() with multiple contours
 //-----------------------------------------------------------------------------
 
 enum ImTriangulatorNodeType
@@ -1970,6 +2560,7 @@ void ImTriangulator::ReclassifyNode(ImTriangulatorNode* n1)
 }
 
 // Use ear-clipping algorithm to triangulate a simple polygon (no self-interaction, no holes).
+// Polygons with more than IM_DRAWLIST_CONCAVE_EARCLIP_MAX points use the sweep line triangulator, which scales better.
 // (Reminder: we don't perform any coarse clipping/culling in ImDrawList layer!
 // It is up to caller to ensure not making costly calls that will be outside of visible area.
 // As concave fill is noticeably more expensive than other primitives, be mindful of this...
@@ -1978,6 +2569,11 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
 {
     if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
         return;
+    if (points_count > IM_DRAWLIST_CONCAVE_EARCLIP_MAX)
+    {
+        AddConcavePolyFilled(points, &points_count, 1, col, ImDrawFlags_None);
+        return;
+    }
 
     const ImVec2 uv = _Data->TexUvWhitePixel;
     ImTriangulator triangulator;
@@ -2030,8 +2626,8 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
             dm_y *= AA_SIZE * 0.5f;
 
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            ImDrawVert_Write(&_VtxWritePtr[0], points[i1].x - dm_x, points[i1].y - dm_y, uv.x, uv.y, col);        // Inner
+            ImDrawVert_Write(&_VtxWritePtr[1], points[i1].x + dm_x, points[i1].y + dm_y, uv.x, uv.y, col_trans);  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -2049,7 +2645,7 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
         PrimReserve(idx_count, vtx_count);
         for (int i = 0; i < vtx_count; i++)
         {
-            _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            ImDrawVert_Write(&_VtxWritePtr[0], points[i].x, points[i].y, uv.x, uv.y, col);
             _VtxWritePtr++;
         }
         _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
@@ -2064,6 +2660,771 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
     }
 }
 
+//-----------------------------------------------------------------------------
+// ImSweepTriangulator [Internal]
+//-----------------------------------------------------------------------------
+// Triangulate multiple contours (outlines and holes, possibly overlapping or self-intersecting) using a sweep line.
+// - The sweep line stops at every point y coordinate and at every intersection between two edges.
+// - Active edges are kept in x order in a linked list, indexed by a treap (randomized balanced binary tree) to insert new edges.
+//   A stop only visits edges starting, ending or crossing there, their neighbors, and the spans they bound.
+// - The fill rule tells which spans are inside the shape. A span is kept open as a trapezoid for as long as it is bounded
+//   by the same two edges, so the output stays O(N) for typical shapes.
+// - A closed trapezoid is triangulated between its top and bottom chains. Chains include all points lying on the same
+//   horizontal line within the span (e.g. the apex of a hole), which avoids T-junctions.
+// - O((N + K) log N) where K is the number of intersections. Intersections are only searched between neighbor edges.
+// - Steiner points are stored as a position along a source edge, so the caller can interpolate after offsetting source points.
+// - Instance is owned by ImDrawListSharedData, so its buffers are reused between calls.
+//-----------------------------------------------------------------------------
+
+struct ImSweepTriangulatorEdge
+{
+    float   X0, Y0, X1, Y1;         // Top and bottom points (Y0 < Y1)
+    float   DxDy;
+    int     PointA, PointB;         // Source points in contour order
+    int     Winding;                // +1 when going down in contour order, -1 when going up, 0 for horizontal edges (never active)
+    int     Contour;
+    int     WindingAfter;           // Winding number on the right side of the edge, while active
+    int     Node;                   // Index in Nodes[] while active, -1 otherwise
+    int     TrapL, TrapR;           // Open trapezoid with this edge as its left/right side, -1 if none
+    int     DirtyStamp;             // Last line where edges around this one changed
+    int     TouchStamp;             // Last line where WindingAfter was updated
+    int     SpanStamp;              // Last line where the span starting with this edge was updated
+
+    float   XAt(float y) const      { return (y <= Y0) ? X0 : (y >= Y1) ? X1 : X0 + (y - Y0) * DxDy; }
+};
+
+struct ImSweepTriangulatorNode      // Active edge: node of treap sorted by x, also linked to its neighbors
+{
+    int     Edge;
+    int     Parent, Left, Right;
+    int     Prev, Next;
+    ImU32   Priority;
+};
+
+struct ImSweepTriangulatorEvent     // Source point, sorted by y
+{
+    float   Y;
+    int     Point;
+    int     NextPoint;              // Next point in contour. Edges[Point] ends at this point, Edges[NextPoint] starts from it.
+};
+
+struct ImSweepTriangulatorCrossing  // Intersection between two neighbor edges, stored in a min-heap
+{
+    float   Y;
+    int     EdgeL, EdgeR;
+};
+
+struct ImSweepTriangulatorTrap
+{
+    int     EdgeL, EdgeR;
+    int     TopChainOffset;         // Offset in Chains[], -1 until the chain is known
+    int     TopChainCount;
+    int     LineStamp;              // Last line where this trapezoid was open
+    int     CloseStamp;             // Last line where this trapezoid was checked for closing
+};
+
+struct ImSweepTriangulatorPoint     // Point on the current sweep line, or chain entry
+{
+    float   X;
+    int     PointA, PointB;         // PointA == PointB for a source point, otherwise a Steiner point on edge PointA->PointB
+    float   T;
+    int     Vtx;                    // Index in Vertices[], -1 until used
+};
+
+struct ImSweepTriangulatorVtx
+{
+    int     PointA, PointB;
+    float   T;
+};
+
+struct ImSweepTriangulator
+{
+    ImVector<ImSweepTriangulatorEdge>       Edges;          // Edges[n] goes from previous point in contour to point n
+    ImVector<ImSweepTriangulatorEvent>      Events;
+    ImVector<ImSweepTriangulatorCrossing>   Crossings;
+    ImVector<ImSweepTriangulatorNode>       Nodes;
+    int                                     NodeRoot;
+    int                                     NodeFirst;
+    bool                                    EvenOdd;
+    ImVector<int>                           DirtyEdges;     // Edges whose left side changed on current line
+    ImVector<int>                           TouchedEdges;   // Edges whose WindingAfter was updated on current line
+    ImVector<ImSweepTriangulatorTrap>       Traps;
+    ImVector<int>                           ClosingTraps;
+    ImVector<int>                           OpeningTraps;
+    ImVector<ImSweepTriangulatorPoint>      LinePoints;
+    ImVector<ImSweepTriangulatorPoint>      Chains;         // Top chains of open trapezoids
+    ImVector<ImSweepTriangulatorPoint>      BottomChain;
+    ImVector<ImSweepTriangulatorVtx>        Vertices;       // Output vertices
+    ImVector<int>                           Indices;        // Output triangles, indexing Vertices[]
+    ImVector<int>                           ContourFlip;    // Output: 1 when the filled side of a contour is on its left (i.e. counter-clockwise outline, or clockwise hole)
+
+    void    Triangulate(const ImVec2* points, const int* contours_num_points, int contours_count, bool even_odd);
+    bool    IsInside(int winding) const { return EvenOdd ? (winding & 1) != 0 : (winding != 0); }
+    int     GetWindingBefore(int node_n) const { return (Nodes[node_n].Prev != -1) ? Edges[Nodes[Nodes[node_n].Prev].Edge].WindingAfter : 0; }
+    int     FindSpanStart(int node_n) const { while (IsInside(GetWindingBefore(node_n))) node_n = Nodes[node_n].Prev; return node_n; }
+    void    InsertActiveEdge(int edge_n, float y);
+    void    RemoveActiveEdge(int edge_n);
+    void    RotateNodeUp(int node_n);
+    void    MarkDirty(int node_n, int line_stamp);
+    void    AddClosingTrap(int trap_n, int line_stamp);
+    void    UpdateSpan(int node_l, int line_stamp);
+    void    AddCrossing(int edge_l, int edge_r, float y);
+    void    AddLinePoint(const ImVec2* points, int edge_n, float y);
+    void    GetChain(int edge_l, int edge_r, float y, ImVector<ImSweepTriangulatorPoint>* out_chain);
+};
+
+static int IMGUI_CDECL ImSweepTriangulatorEventComparer(const void* lhs, const void* rhs)
+{
+    const ImSweepTriangulatorEvent* a = (const ImSweepTriangulatorEvent*)lhs;
+    const ImSweepTriangulatorEvent* b = (const ImSweepTriangulatorEvent*)rhs;
+    return (a->Y < b->Y) ? -1 : (a->Y > b->Y) ? +1 : 0;
+}
+
+// Sort by x, source points first so they are kept when removing duplicates
+static int IMGUI_CDECL ImSweepTriangulatorPointComparer(const void* lhs, const void* rhs)
+{
+    const ImSweepTriangulatorPoint* a = (const ImSweepTriangulatorPoint*)lhs;
+    const ImSweepTriangulatorPoint* b = (const ImSweepTriangulatorPoint*)rhs;
+    if (a->X != b->X)
+        return (a->X < b->X) ? -1 : +1;
+    return (a->PointA != a->PointB) - (b->PointA != b->PointB);
+}
+
+// Randomized priority for treap nodes (integer hash of the node index)
+static inline ImU32 ImSweepTriangulatorNodePriority(int node_n)
+{
+    ImU32 x = (ImU32)node_n + 1;
+    x ^= x >> 16; x *= 0x7FEB352Du;
+    x ^= x >> 15; x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+void ImSweepTriangulator::RotateNodeUp(int node_n)
+{
+    ImSweepTriangulatorNode& node = Nodes[node_n];
+    const int parent_n = node.Parent;
+    ImSweepTriangulatorNode& parent = Nodes[parent_n];
+    const int grand_parent_n = parent.Parent;
+    if (parent.Left == node_n)
+    {
+        parent.Left = node.Right;
+        if (node.Right != -1)
+            Nodes[node.Right].Parent = parent_n;
+        node.Right = parent_n;
+    }
+    else
+    {
+        parent.Right = node.Left;
+        if (node.Left != -1)
+            Nodes[node.Left].Parent = parent_n;
+        node.Left = parent_n;
+    }
+    parent.Parent = node_n;
+    node.Parent = grand_parent_n;
+    if (grand_parent_n == -1)
+        NodeRoot = node_n;
+    else if (Nodes[grand_parent_n].Left == parent_n)
+        Nodes[grand_parent_n].Left = node_n;
+    else
+        Nodes[grand_parent_n].Right = node_n;
+}
+
+// Insert an edge starting on line 'y'. Ties are sorted by slope, i.e. by position below the line.
+void ImSweepTriangulator::InsertActiveEdge(int edge_n, float y)
+{
+    const ImSweepTriangulatorEdge& edge = Edges[edge_n];
+    int prev_n = -1;
+    for (int node_n = NodeRoot; node_n != -1; )
+    {
+        const int other_edge_n = Nodes[node_n].Edge;
+        const ImSweepTriangulatorEdge& other_edge = Edges[other_edge_n];
+        const float other_x = other_edge.XAt(y);
+        const bool before = (edge.X0 != other_x) ? (edge.X0 < other_x) : (edge.DxDy != other_edge.DxDy) ? (edge.DxDy < other_edge.DxDy) : (edge_n < other_edge_n);
+        if (before)
+        {
+            node_n = Nodes[node_n].Left;
+        }
+        else
+        {
+            prev_n = node_n;
+            node_n = Nodes[node_n].Right;
+        }
+    }
+
+    // Attach as a leaf: right child of previous node, or left child of next node (which is free when the former isn't)
+    const int node_n = Nodes.Size;
+    ImSweepTriangulatorNode node;
+    node.Edge = edge_n;
+    node.Left = node.Right = -1;
+    node.Prev = prev_n;
+    node.Next = (prev_n != -1) ? Nodes[prev_n].Next : NodeFirst;
+    node.Priority = ImSweepTriangulatorNodePriority(node_n);
+    node.Parent = (prev_n != -1 && Nodes[prev_n].Right == -1) ? prev_n : node.Next;
+    Nodes.push_back(node);
+    if (node.Parent == -1)
+        NodeRoot = node_n;
+    else if (node.Parent == prev_n)
+        Nodes[prev_n].Right = node_n;
+    else
+        Nodes[node.Parent].Left = node_n;
+    if (node.Prev != -1)
+        Nodes[node.Prev].Next = node_n;
+    else
+        NodeFirst = node_n;
+    if (node.Next != -1)
+        Nodes[node.Next].Prev = node_n;
+    while (Nodes[node_n].Parent != -1 && Nodes[Nodes[node_n].Parent].Priority < Nodes[node_n].Priority)
+        RotateNodeUp(node_n);
+    Edges[edge_n].Node = node_n;
+}
+
+void ImSweepTriangulator::RemoveActiveEdge(int edge_n)
+{
+    // Rotate down to a leaf, then detach
+    const int node_n = Edges[edge_n].Node;
+    for (;;)
+    {
+        const ImSweepTriangulatorNode& node = Nodes[node_n];
+        if (node.Left == -1 && node.Right == -1)
+            break;
+        if (node.Left == -1 || (node.Right != -1 && Nodes[node.Right].Priority > Nodes[node.Left].Priority))
+            RotateNodeUp(node.Right);
+        else
+            RotateNodeUp(node.Left);
+    }
+    const ImSweepTriangulatorNode& node = Nodes[node_n];
+    if (node.Parent == -1)
+        NodeRoot = -1;
+    else if (Nodes[node.Parent].Left == node_n)
+        Nodes[node.Parent].Left = -1;
+    else
+        Nodes[node.Parent].Right = -1;
+    if (node.Prev != -1)
+        Nodes[node.Prev].Next = node.Next;
+    else
+        NodeFirst = node.Next;
+    if (node.Next != -1)
+        Nodes[node.Next].Prev = node.Prev;
+    Edges[edge_n].Node = -1;
+}
+
+void ImSweepTriangulator::MarkDirty(int node_n, int line_stamp)
+{
+    if (node_n == -1)
+        return;
+    ImSweepTriangulatorEdge& edge = Edges[Nodes[node_n].Edge];
+    if (edge.DirtyStamp == line_stamp)
+        return;
+    edge.DirtyStamp = line_stamp;
+    DirtyEdges.push_back(Nodes[node_n].Edge);
+}
+
+void ImSweepTriangulator::AddClosingTrap(int trap_n, int line_stamp)
+{
+    if (trap_n == -1 || Traps[trap_n].CloseStamp == line_stamp)
+        return;
+    Traps[trap_n].CloseStamp = line_stamp;
+    ClosingTraps.push_back(trap_n);
+}
+
+// Find right side of the span starting with given edge. Keep its trapezoid open, or open a new one.
+// Previous trapezoids using either side are candidates for closing.
+void ImSweepTriangulator::UpdateSpan(int node_l, int line_stamp)
+{
+    const int edge_l = Nodes[node_l].Edge;
+    if (Edges[edge_l].SpanStamp == line_stamp)
+        return;
+    Edges[edge_l].SpanStamp = line_stamp;
+    int node_r = Nodes[node_l].Next;
+    while (IsInside(Edges[Nodes[node_r].Edge].WindingAfter))
+        node_r = Nodes[node_r].Next;
+    const int edge_r = Nodes[node_r].Edge;
+
+    const int trap_n = Edges[edge_l].TrapL;
+    AddClosingTrap(trap_n, line_stamp);
+    AddClosingTrap(Edges[edge_r].TrapR, line_stamp);
+    if (trap_n != -1 && Traps[trap_n].EdgeR == edge_r)
+    {
+        Traps[trap_n].LineStamp = line_stamp;
+        return;
+    }
+    ImSweepTriangulatorTrap trap = { edge_l, edge_r, -1, 0, line_stamp, 0 };
+    Edges[edge_l].TrapL = Edges[edge_r].TrapR = Traps.Size;
+    OpeningTraps.push_back(Traps.Size);
+    Traps.push_back(trap);
+}
+
+// Check two neighbor edges on line 'y', add their intersection below the line if any.
+// Edges are compared where the first one ends, as positions on the line itself may be off by rounding errors after a crossing.
+void ImSweepTriangulator::AddCrossing(int edge_l, int edge_r, float y)
+{
+    const ImSweepTriangulatorEdge& a = Edges[edge_l];
+    const ImSweepTriangulatorEdge& b = Edges[edge_r];
+    const float y_end = ImMin(a.Y1, b.Y1);
+    if (a.XAt(y_end) <= b.XAt(y_end))
+        return;
+    float y_cross = y; // Not converging: order is already wrong, swap on a new line right away
+    if (a.DxDy > b.DxDy)
+        y_cross = ImClamp(y + (b.XAt(y) - a.XAt(y)) / (a.DxDy - b.DxDy), y, y_end);
+    if (y_cross >= y_end)
+        return;
+
+    // Push to min-heap
+    ImSweepTriangulatorCrossing crossing = { y_cross, edge_l, edge_r };
+    int n = Crossings.Size;
+    Crossings.push_back(crossing);
+    for (int parent_n = (n - 1) >> 1; n > 0 && Crossings[parent_n].Y > y_cross; n = parent_n, parent_n = (n - 1) >> 1)
+        Crossings[n] = Crossings[parent_n];
+    Crossings[n] = crossing;
+}
+
+void ImSweepTriangulator::AddLinePoint(const ImVec2* points, int edge_n, float y)
+{
+    const ImSweepTriangulatorEdge& edge = Edges[edge_n];
+    ImSweepTriangulatorPoint p;
+    p.X = edge.XAt(y);
+    p.Vtx = -1;
+    if (y <= edge.Y0 || y >= edge.Y1)
+    {
+        // Edge end point: reference the source point
+        const bool top = (y <= edge.Y0);
+        p.PointA = p.PointB = (top == (edge.Winding > 0)) ? edge.PointA : edge.PointB;
+        p.T = 0.0f;
+    }
+    else
+    {
+        p.PointA = edge.PointA;
+        p.PointB = edge.PointB;
+        p.T = (y - points[edge.PointA].y) / (points[edge.PointB].y - points[edge.PointA].y);
+    }
+    LinePoints.push_back(p);
+}
+
+// Gather points on current line between two edges. Allocate output vertices for them.
+void ImSweepTriangulator::GetChain(int edge_l, int edge_r, float y, ImVector<ImSweepTriangulatorPoint>* out_chain)
+{
+    float x_min = Edges[edge_l].XAt(y);
+    float x_max = Edges[edge_r].XAt(y);
+    if (x_min > x_max)
+        ImSwap(x_min, x_max);
+
+    // Binary search first point
+    int lo = 0, hi = LinePoints.Size;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        if (LinePoints[mid].X < x_min)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    for (int n = lo; n < LinePoints.Size && LinePoints[n].X <= x_max; n++)
+    {
+        ImSweepTriangulatorPoint& p = LinePoints[n];
+        if (p.Vtx == -1)
+        {
+            ImSweepTriangulatorVtx vtx = { p.PointA, p.PointB, p.T };
+            p.Vtx = Vertices.Size;
+            Vertices.push_back(vtx);
+        }
+        out_chain->push_back(p);
+    }
+}
+
+void ImSweepTriangulator::Triangulate(const ImVec2* points, const int* contours_num_points, int contours_count, bool even_odd)
+{
+    int points_count = 0;
+    for (int contour_n = 0; contour_n < contours_count; contour_n++)
+        points_count += contours_num_points[contour_n];
+    Edges.resize(points_count);
+    Events.resize(0);
+    Crossings.resize(0);
+    Nodes.resize(0);
+    NodeRoot = NodeFirst = -1;
+    EvenOdd = even_odd;
+    Traps.resize(0);
+    Chains.resize(0);
+    Vertices.resize(0);
+    Indices.resize(0);
+    ContourFlip.resize(contours_count);
+
+    // Build edges. Horizontal edges don't contribute to winding, but their end points are still added to lines.
+    for (int contour_n = 0, contour_start = 0; contour_n < contours_count; contour_start += contours_num_points[contour_n], contour_n++)
+    {
+        const int contour_size = contours_num_points[contour_n];
+        ContourFlip[contour_n] = -1;
+        if (contour_size < 3)
+            continue;
+        for (int i0 = contour_size - 1, i1 = 0; i1 < contour_size; i0 = i1++)
+        {
+            const int point_a = contour_start + i0;
+            const int point_b = contour_start + i1;
+            const ImVec2& pa = points[point_a];
+            const ImVec2& pb = points[point_b];
+            ImSweepTriangulatorEvent event = { pb.y, point_b, (i1 + 1 < contour_size) ? point_b + 1 : contour_start };
+            Events.push_back(event);
+            const bool down = (pa.y < pb.y);
+            const ImVec2& p0 = down ? pa : pb;
+            const ImVec2& p1 = down ? pb : pa;
+            ImSweepTriangulatorEdge& edge = Edges[point_b];
+            edge.X0 = p0.x; edge.Y0 = p0.y;
+            edge.X1 = p1.x; edge.Y1 = p1.y;
+            edge.DxDy = (pa.y != pb.y) ? (p1.x - p0.x) / (p1.y - p0.y) : 0.0f;
+            edge.PointA = point_a;
+            edge.PointB = point_b;
+            edge.Winding = (pa.y == pb.y) ? 0 : down ? +1 : -1;
+            edge.Contour = contour_n;
+            edge.WindingAfter = 0;
+            edge.Node = edge.TrapL = edge.TrapR = -1;
+            edge.DirtyStamp = edge.TouchStamp = edge.SpanStamp = 0;
+        }
+    }
+    ImQsort(Events.Data, (size_t)Events.Size, sizeof(ImSweepTriangulatorEvent), ImSweepTriangulatorEventComparer);
+
+    int event_n = 0;
+    int line_stamp = 0;
+    while (event_n < Events.Size || Crossings.Size > 0)
+    {
+        // Next stop: next point, or first intersection between two neighbor edges
+        float y = (event_n < Events.Size) ? Events[event_n].Y : FLT_MAX;
+        if (Crossings.Size > 0 && Crossings[0].Y < y)
+            y = Crossings[0].Y;
+        line_stamp++;
+        LinePoints.resize(0);
+        DirtyEdges.resize(0);
+        TouchedEdges.resize(0);
+        ClosingTraps.resize(0);
+        OpeningTraps.resize(0);
+
+        // Add source points lying on this line, remove edges ending on them
+        const int event_begin = event_n;
+        for (; event_n < Events.Size && Events[event_n].Y <= y; event_n++)
+        {
+            const ImSweepTriangulatorEvent& event = Events[event_n];
+            ImSweepTriangulatorPoint p = { points[event.Point].x, event.Point, event.Point, 0.0f, -1 };
+            LinePoints.push_back(p);
+            for (int side = 0; side < 2; side++)
+            {
+                const int edge_n = side ? event.NextPoint : event.Point;
+                const ImSweepTriangulatorEdge& edge = Edges[edge_n];
+                if (edge.Node == -1)
+                    continue;
+                AddClosingTrap(edge.TrapL, line_stamp);
+                AddClosingTrap(edge.TrapR, line_stamp);
+                MarkDirty(Nodes[edge.Node].Prev, line_stamp);
+                MarkDirty(Nodes[edge.Node].Next, line_stamp);
+                RemoveActiveEdge(edge_n);
+            }
+        }
+
+        // Swap neighbor edges crossing on this line
+        while (Crossings.Size > 0 && Crossings[0].Y <= y)
+        {
+            const ImSweepTriangulatorCrossing crossing = Crossings[0];
+            const ImSweepTriangulatorCrossing last = Crossings.back();
+            Crossings.pop_back();
+            int n = 0;
+            for (int child_n = 1; child_n < Crossings.Size; n = child_n, child_n = n * 2 + 1)
+            {
+                if (child_n + 1 < Crossings.Size && Crossings[child_n + 1].Y < Crossings[child_n].Y)
+                    child_n++;
+                if (last.Y <= Crossings[child_n].Y)
+                    break;
+                Crossings[n] = Crossings[child_n];
+            }
+            if (Crossings.Size > 0)
+                Crossings[n] = last;
+
+            const int node_l = Edges[crossing.EdgeL].Node;
+            const int node_r = Edges[crossing.EdgeR].Node;
+            if (node_l == -1 || node_r == -1 || Nodes[node_l].Next != node_r)
+                continue; // Outdated: edges have been separated, or one of them ended
+            Nodes[node_l].Edge = crossing.EdgeR;
+            Nodes[node_r].Edge = crossing.EdgeL;
+            Edges[crossing.EdgeL].Node = node_r;
+            Edges[crossing.EdgeR].Node = node_l;
+            MarkDirty(node_l, line_stamp);
+            MarkDirty(node_r, line_stamp);
+        }
+
+        // Add edges starting from points on this line
+        for (int n = event_begin; n < event_n; n++)
+            for (int side = 0; side < 2; side++)
+            {
+                const int edge_n = side ? Events[n].NextPoint : Events[n].Point;
+                const ImSweepTriangulatorEdge& edge = Edges[edge_n];
+                if (edge.Winding == 0 || edge.Node != -1 || edge.Y0 != y)
+                    continue;
+                InsertActiveEdge(edge_n, y);
+                MarkDirty(edge.Node, line_stamp);
+            }
+
+        // Update winding numbers, starting from the left of each run of modified edges, until they don't change anymore
+        for (int dirty_n = 0; dirty_n < DirtyEdges.Size; dirty_n++)
+        {
+            int node_n = Edges[DirtyEdges[dirty_n]].Node;
+            if (node_n == -1 || Edges[DirtyEdges[dirty_n]].TouchStamp == line_stamp)
+                continue;
+            while (Nodes[node_n].Prev != -1 && Edges[Nodes[Nodes[node_n].Prev].Edge].DirtyStamp == line_stamp)
+                node_n = Nodes[node_n].Prev;
+            int winding = GetWindingBefore(node_n);
+            for (; node_n != -1; node_n = Nodes[node_n].Next)
+            {
+                ImSweepTriangulatorEdge& edge = Edges[Nodes[node_n].Edge];
+                winding += edge.Winding;
+                const bool changed = (edge.WindingAfter != winding);
+                edge.WindingAfter = winding;
+                if (edge.TouchStamp != line_stamp)
+                {
+                    edge.TouchStamp = line_stamp;
+                    TouchedEdges.push_back(Nodes[node_n].Edge);
+                }
+                if (!changed && edge.DirtyStamp != line_stamp)
+                    break;
+            }
+        }
+
+        // Find spans inside the shape around updated edges, according to fill rule.
+        // Keep trapezoids bounded by the same edges open, open new ones. Other trapezoids using these edges are closed.
+        for (int touched_n = 0; touched_n < TouchedEdges.Size; touched_n++)
+        {
+            const ImSweepTriangulatorEdge& edge = Edges[TouchedEdges[touched_n]];
+            AddClosingTrap(edge.TrapL, line_stamp);
+            AddClosingTrap(edge.TrapR, line_stamp);
+            const bool inside_before = IsInside(GetWindingBefore(edge.Node));
+            const bool inside_after = IsInside(edge.WindingAfter);
+            if (inside_before != inside_after && ContourFlip[edge.Contour] == -1)
+                ContourFlip[edge.Contour] = ((edge.Winding > 0) == inside_after) ? 1 : 0;
+            if (inside_after)
+                UpdateSpan(FindSpanStart(edge.Node), line_stamp);
+            if (inside_before)
+                UpdateSpan(FindSpanStart(Nodes[edge.Node].Prev), line_stamp);
+        }
+        int closing_write = 0;
+        for (int n = 0; n < ClosingTraps.Size; n++)
+        {
+            const int trap_n = ClosingTraps[n];
+            ImSweepTriangulatorTrap& trap = Traps[trap_n];
+            if (trap.LineStamp == line_stamp)
+                continue;
+            if (Edges[trap.EdgeL].TrapL == trap_n)
+                Edges[trap.EdgeL].TrapL = -1;
+            if (Edges[trap.EdgeR].TrapR == trap_n)
+                Edges[trap.EdgeR].TrapR = -1;
+            ClosingTraps[closing_write++] = trap_n;
+        }
+        ClosingTraps.resize(closing_write);
+
+        // Add points of closing and opening trapezoid sides to the line, sort them and remove duplicates
+        for (int trap_n : ClosingTraps)
+        {
+            AddLinePoint(points, Traps[trap_n].EdgeL, y);
+            AddLinePoint(points, Traps[trap_n].EdgeR, y);
+        }
+        for (int trap_n : OpeningTraps)
+        {
+            AddLinePoint(points, Traps[trap_n].EdgeL, y);
+            AddLinePoint(points, Traps[trap_n].EdgeR, y);
+        }
+        ImQsort(LinePoints.Data, (size_t)LinePoints.Size, sizeof(ImSweepTriangulatorPoint), ImSweepTriangulatorPointComparer);
+        int line_points_write = 0;
+        for (int n = 0; n < LinePoints.Size; n++)
+            if (line_points_write == 0 || LinePoints[n].X != LinePoints[line_points_write - 1].X)
+                LinePoints[line_points_write++] = LinePoints[n];
+        LinePoints.resize(line_points_write);
+
+        // Close trapezoids: triangulate between top and bottom chains
+        for (int trap_n : ClosingTraps)
+        {
+            const ImSweepTriangulatorTrap& trap = Traps[trap_n];
+            BottomChain.resize(0);
+            GetChain(trap.EdgeL, trap.EdgeR, y, &BottomChain);
+            const ImSweepTriangulatorPoint* top = &Chains[trap.TopChainOffset];
+            const ImSweepTriangulatorPoint* bottom = BottomChain.Data;
+            const int top_count = trap.TopChainCount;
+            const int bottom_count = BottomChain.Size;
+            for (int i = 0, j = 0; i < top_count - 1 || j < bottom_count - 1; )
+            {
+                const bool advance_top = (j == bottom_count - 1) || (i < top_count - 1 && top[i + 1].X <= bottom[j + 1].X);
+                Indices.push_back(top[i].Vtx);
+                Indices.push_back(advance_top ? top[i + 1].Vtx : bottom[j + 1].Vtx);
+                Indices.push_back(bottom[j].Vtx);
+                if (advance_top)
+                    i++;
+                else
+                    j++;
+            }
+        }
+
+        // Open trapezoids: store top chains
+        for (int trap_n : OpeningTraps)
+        {
+            ImSweepTriangulatorTrap& trap = Traps[trap_n];
+            trap.TopChainOffset = Chains.Size;
+            GetChain(trap.EdgeL, trap.EdgeR, y, &Chains);
+            trap.TopChainCount = Chains.Size - trap.TopChainOffset;
+        }
+
+        // Look for intersections between new neighbors
+        for (int edge_n : TouchedEdges)
+        {
+            const ImSweepTriangulatorNode& node = Nodes[Edges[edge_n].Node];
+            if (node.Prev != -1 && Edges[Nodes[node.Prev].Edge].TouchStamp != line_stamp)
+                AddCrossing(Nodes[node.Prev].Edge, edge_n, y);
+            if (node.Next != -1)
+                AddCrossing(edge_n, Nodes[node.Next].Edge, y);
+        }
+    }
+}
+
+// Fill multiple contours, e.g. an outline and its holes, using a non-zero (default) or even-odd (ImDrawFlags_FillRuleEvenOdd) fill rule.
+// - Contours are stored one after another in 'points'. Their orientation doesn't matter with the even-odd rule.
+// - Contours may overlap or self-intersect. Anti-aliasing fringes are however only correct for contours which don't intersect.
+// (Same reminder as AddConcavePolyFilled(): we don't perform any coarse clipping/culling here.)
+void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int* contours_num_points, int contours_count, ImU32 col, ImDrawFlags flags)
+{
+    if (contours_count <= 0 || (col & IM_COL32_A_MASK) == 0)
+        return;
+
+    if (_Data->TempSweepTriangulator == NULL)
+        _Data->TempSweepTriangulator = IM_NEW(ImSweepTriangulator)();
+    ImSweepTriangulator& triangulator = *_Data->TempSweepTriangulator;
+    triangulator.Triangulate(points, contours_num_points, contours_count, (flags & ImDrawFlags_FillRuleEvenOdd) != 0);
+    if (triangulator.Indices.Size == 0)
+        return;
+
+    int points_count = 0;
+    int fringe_points_count = 0;
+    for (int contour_n = 0; contour_n < contours_count; contour_n++)
+    {
+        points_count += contours_num_points[contour_n];
+        if (contours_num_points[contour_n] >= 3)
+            fringe_points_count += contours_num_points[contour_n];
+    }
+    int steiner_vtx_count = 0;
+    for (const ImSweepTriangulatorVtx& vtx : triangulator.Vertices)
+        if (vtx.PointA != vtx.PointB)
+            steiner_vtx_count++;
+
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    if (Flags & ImDrawListFlags_AntiAliasedFill)
+    {
+        // Anti-aliased Fill: source points are moved inward like in AddConvexPolyFilled(), Steiner points are interpolated along moved edges.
+        const float AA_SIZE = _FringeScale;
+        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+        const int idx_count = triangulator.Indices.Size + fringe_points_count * 6;
+        const int vtx_count = points_count * 2 + steiner_vtx_count;
+        PrimReserve(idx_count, vtx_count);
+
+        // Compute normals and source points vertices
+        _Data->TempBuffer.reserve_discard(points_count * 2);
+        ImVec2* temp_normals = _Data->TempBuffer.Data;
+        ImVec2* temp_inner = _Data->TempBuffer.Data + points_count;
+        const unsigned int vtx_inner_idx = _VtxCurrentIdx;
+        const unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
+        for (int contour_n = 0, contour_start = 0; contour_n < contours_count; contour_start += contours_num_points[contour_n], contour_n++)
+        {
+            const int contour_size = contours_num_points[contour_n];
+            const ImVec2* contour_points = points + contour_start;
+            ImVec2* contour_normals = temp_normals + contour_start;
+            if (contour_size < 3)
+            {
+                for (int i = 0; i < contour_size; i++)
+                {
+                    temp_inner[contour_start + i] = contour_points[i];
+                    ImDrawVert_Write(&_VtxWritePtr[0], contour_points[i].x, contour_points[i].y, uv.x, uv.y, col_trans);
+                    ImDrawVert_Write(&_VtxWritePtr[1], contour_points[i].x, contour_points[i].y, uv.x, uv.y, col_trans);
+                    _VtxWritePtr += 2;
+                }
+                continue;
+            }
+
+            const float normal_scale = (triangulator.ContourFlip[contour_n] == 1) ? -1.0f : 1.0f;
+            for (int i0 = contour_size - 1, i1 = 0; i1 < contour_size; i0 = i1++)
+            {
+                const ImVec2& p0 = contour_points[i0];
+                const ImVec2& p1 = contour_points[i1];
+                float dx = p1.x - p0.x;
+                float dy = p1.y - p0.y;
+                IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+                contour_normals[i0].x = dy * normal_scale;
+                contour_normals[i0].y = -dx * normal_scale;
+            }
+            for (int i0 = contour_size - 1, i1 = 0; i1 < contour_size; i0 = i1++)
+            {
+                // Average normals
+                const ImVec2& n0 = contour_normals[i0];
+                const ImVec2& n1 = contour_normals[i1];
+                float dm_x = (n0.x + n1.x) * 0.5f;
+                float dm_y = (n0.y + n1.y) * 0.5f;
+                IM_FIXNORMAL2F(dm_x, dm_y);
+                dm_x *= AA_SIZE * 0.5f;
+                dm_y *= AA_SIZE * 0.5f;
+
+                // Add vertices
+                temp_inner[contour_start + i1] = ImVec2(contour_points[i1].x - dm_x, contour_points[i1].y - dm_y);
+                ImDrawVert_Write(&_VtxWritePtr[0], contour_points[i1].x - dm_x, contour_points[i1].y - dm_y, uv.x, uv.y, col);        // Inner
+                ImDrawVert_Write(&_VtxWritePtr[1], contour_points[i1].x + dm_x, contour_points[i1].y + dm_y, uv.x, uv.y, col_trans);  // Outer
+                _VtxWritePtr += 2;
+
+                // Add indexes for fringes
+                const unsigned int p0_idx = (unsigned int)(contour_start + i0) << 1;
+                const unsigned int p1_idx = (unsigned int)(contour_start + i1) << 1;
+                _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + p1_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + p0_idx); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + p0_idx);
+                _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + p0_idx); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx + p1_idx); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx + p1_idx);
+                _IdxWritePtr += 6;
+            }
+        }
+
+        // Add Steiner points vertices, remap fill indexes
+        unsigned int vtx_steiner_idx = vtx_inner_idx + points_count * 2;
+        for (ImSweepTriangulatorVtx& vtx : triangulator.Vertices)
+        {
+            if (vtx.PointA == vtx.PointB)
+            {
+                vtx.PointB = (int)(vtx_inner_idx + (vtx.PointA << 1)); // Reuse field to store output index
+                continue;
+            }
+            const ImVec2 pos = ImLerp(temp_inner[vtx.PointA], temp_inner[vtx.PointB], vtx.T);
+            ImDrawVert_Write(&_VtxWritePtr[0], pos.x, pos.y, uv.x, uv.y, col);
+            _VtxWritePtr++;
+            vtx.PointB = (int)(vtx_steiner_idx++);
+        }
+        for (int idx : triangulator.Indices)
+            *_IdxWritePtr++ = (ImDrawIdx)triangulator.Vertices[idx].PointB;
+        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+    }
+    else
+    {
+        // Non Anti-aliased Fill
+        const int idx_count = triangulator.Indices.Size;
+        const int vtx_count = points_count + steiner_vtx_count;
+        PrimReserve(idx_count, vtx_count);
+        for (int i = 0; i < points_count; i++)
+        {
+            ImDrawVert_Write(&_VtxWritePtr[0], points[i].x, points[i].y, uv.x, uv.y, col);
+            _VtxWritePtr++;
+        }
+        unsigned int vtx_steiner_idx = _VtxCurrentIdx + points_count;
+        for (ImSweepTriangulatorVtx& vtx : triangulator.Vertices)
+        {
+            if (vtx.PointA == vtx.PointB)
+            {
+                vtx.PointB = (int)(_VtxCurrentIdx + vtx.PointA); // Reuse field to store output index
+                continue;
+            }
+            const ImVec2 pos = ImLerp(points[vtx.PointA], points[vtx.PointB], vtx.T);
+            ImDrawVert_Write(&_VtxWritePtr[0], pos.x, pos.y, uv.x, uv.y, col);
+            _VtxWritePtr++;
+            vtx.PointB = (int)(vtx_steiner_idx++);
+        }
+        for (int idx : triangulator.Indices)
+            *_IdxWritePtr++ = (ImDrawIdx)triangulator.Vertices[idx].PointB;
+        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+    }
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawListSplitter
 //-----------------------------------------------------------------------------
@@ -2075,9 +3436,10 @@ void ImDrawListSplitter::ClearFreeMemory()
     for (int i = 0; i < _Channels.Size; i++)
     {
         if (i == _Current)
-            memset(&_Channels[i], 0, sizeof(_Channels[i]));  // Current channel is a copy of CmdBuffer/IdxBuffer, don't destruct again
+            memset(&_Channels[i], 0, sizeof(_Channels[i]));  // Current channel is a copy of CmdBuffer/IdxBuffer/InstBuffer, don't destruct again
         _Channels[i]._CmdBuffer.clear();
         _Channels[i]._IdxBuffer.clear();
+        _Channels[i]._InstBuffer.clear();
     }
     _Current = 0;
     _Count = 1;
@@ -2096,7 +3458,7 @@ void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
     }
     _Count = channels_count;
 
-    // Channels[] (24/32 bytes each) hold storage that we'll swap with draw_list->_CmdBuffer/_IdxBuffer
+    // Channels[] (36/48 bytes each) hold storage that we'll swap with draw_list->_CmdBuffer/_IdxBuffer/_InstBuffer
     // The content of Channels[0] at this point doesn't matter. We clear it to make state tidy in a debugger but we don't strictly need to.
     // When we switch to the next channel, we'll copy draw_list->_CmdBuffer/_IdxBuffer into Channels[0] and then Channels[1] into draw_list->CmdBuffer/_IdxBuffer
     memset(&_Channels[0], 0, sizeof(ImDrawChannel));
@@ -2110,6 +3472,7 @@ void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
         {
             _Channels[i]._CmdBuffer.resize(0);
             _Channels[i]._IdxBuffer.resize(0);
+            _Channels[i]._InstBuffer.resize(0);
         }
     }
 }
@@ -2123,53 +3486,92 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
     SetCurrentChannel(draw_list, 0);
     draw_list->_PopUnusedDrawCmd();
 
-    // Calculate our final buffer sizes. Also fix the incorrect IdxOffset values in each command.
+    // Calculate our final buffer sizes (commands count is an upper bound, as some commands may be merged below).
     int new_cmd_buffer_count = 0;
     int new_idx_buffer_count = 0;
-    ImDrawCmd* last_cmd = (_Count > 0 && draw_list->CmdBuffer.Size > 0) ? &draw_list->CmdBuffer.back() : NULL;
-    int idx_offset = last_cmd ? last_cmd->IdxOffset + last_cmd->ElemCount : 0;
+    int new_inst_buffer_count = 0;
     for (int i = 1; i < _Count; i++)
     {
         ImDrawChannel& ch = _Channels[i];
-        if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 && ch._CmdBuffer.back().UserCallback == NULL) // Equivalent of PopUnusedDrawCmd()
+        if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 && ch._CmdBuffer.back().InstCount == 0 && ch._CmdBuffer.back().UserCallback == NULL) // Equivalent of PopUnusedDrawCmd()
             ch._CmdBuffer.pop_back();
-
-        if (ch._CmdBuffer.Size > 0 && last_cmd != NULL)
-        {
-            // Do not include ImDrawCmd_AreSequentialIdxOffset() in the compare as we rebuild IdxOffset values ourselves.
-            // Manipulating IdxOffset (e.g. by reordering draw commands like done by RenderDimmedBackgroundBehindWindow()) is not supported within a splitter.
-            ImDrawCmd* next_cmd = &ch._CmdBuffer[0];
-            if (ImDrawCmd_HeaderCompare(last_cmd, next_cmd) == 0 && last_cmd->UserCallback == NULL && next_cmd->UserCallback == NULL)
-            {
-                // Merge previous channel last draw command with current channel first draw command if matching.
-                last_cmd->ElemCount += next_cmd->ElemCount;
-                idx_offset += next_cmd->ElemCount;
-                ch._CmdBuffer.erase(ch._CmdBuffer.Data); // FIXME-OPT: Improve for multiple merges.
-            }
-        }
-        if (ch._CmdBuffer.Size > 0)
-            last_cmd = &ch._CmdBuffer.back();
         new_cmd_buffer_count += ch._CmdBuffer.Size;
         new_idx_buffer_count += ch._IdxBuffer.Size;
-        for (int cmd_n = 0; cmd_n < ch._CmdBuffer.Size; cmd_n++)
+        new_inst_buffer_count += ch._InstBuffer.Size;
+    }
+
+    // Nothing was submitted to channel 0: swap storage with the first non-empty channel instead of copying it.
+    // Its IdxOffset/InstOffset values are already relative to the start of its own buffers, so they stay valid.
+    // This only saves copying one channel. Tables always submit to channel 0 (background, borders) so they don't take this path.
+    int ch_first = 1;
+    if (draw_list->CmdBuffer.Size == 0 && draw_list->IdxBuffer.Size == 0 && draw_list->InstBuffer.Size == 0)
+    {
+        while (ch_first < _Count && _Channels[ch_first]._CmdBuffer.Size == 0 && _Channels[ch_first]._IdxBuffer.Size == 0 && _Channels[ch_first]._InstBuffer.Size == 0)
+            ch_first++;
+        if (ch_first < _Count)
         {
-            ch._CmdBuffer.Data[cmd_n].IdxOffset = idx_offset;
-            idx_offset += ch._CmdBuffer.Data[cmd_n].ElemCount;
+            // Our old (empty) buffers are handed to the channel so their allocations are reused next frame.
+            ImDrawChannel& ch = _Channels[ch_first];
+            new_cmd_buffer_count -= ch._CmdBuffer.Size;
+            new_idx_buffer_count -= ch._IdxBuffer.Size;
+            new_inst_buffer_count -= ch._InstBuffer.Size;
+            draw_list->CmdBuffer.swap(ch._CmdBuffer);
+            draw_list->IdxBuffer.swap(ch._IdxBuffer);
+            draw_list->InstBuffer.swap(ch._InstBuffer);
+            ch_first++;
         }
     }
-    draw_list->CmdBuffer.resize(draw_list->CmdBuffer.Size + new_cmd_buffer_count);
+
+    int inst_offset = draw_list->InstBuffer.Size;
+    draw_list->CmdBuffer.reserve(draw_list->CmdBuffer.Size + new_cmd_buffer_count);
     draw_list->IdxBuffer.resize(draw_list->IdxBuffer.Size + new_idx_buffer_count);
+    draw_list->InstBuffer.resize(draw_list->InstBuffer.Size + new_inst_buffer_count);
+    ImDrawCmd* last_cmd = (draw_list->CmdBuffer.Size > 0) ? &draw_list->CmdBuffer.back() : NULL;
+    int idx_offset = last_cmd ? last_cmd->IdxOffset + last_cmd->ElemCount : 0;
 
     // Write commands and indices in order (they are fairly small structures, we don't copy vertices only indices)
-    ImDrawCmd* cmd_write = draw_list->CmdBuffer.Data + draw_list->CmdBuffer.Size - new_cmd_buffer_count;
+    // Commands are written in a single pass, fixing their IdxOffset/InstOffset values and merging matching commands at channel boundaries.
     ImDrawIdx* idx_write = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size - new_idx_buffer_count;
-    for (int i = 1; i < _Count; i++)
+    ImDrawRectInstance* inst_write = draw_list->InstBuffer.Data + draw_list->InstBuffer.Size - new_inst_buffer_count;
+    for (int i = ch_first; i < _Count; i++)
     {
         ImDrawChannel& ch = _Channels[i];
-        if (int sz = ch._CmdBuffer.Size) { memcpy(cmd_write, ch._CmdBuffer.Data, sz * sizeof(ImDrawCmd)); cmd_write += sz; }
+        const ImDrawCmd* cmd_read = ch._CmdBuffer.Data;
+        int cmd_count = ch._CmdBuffer.Size;
+        if (cmd_count > 0 && last_cmd != NULL)
+        {
+            // Do not include ImDrawCmd_AreSequentialIdxOffset() in the compare as we rebuild IdxOffset/InstOffset values ourselves.
+            // Manipulating IdxOffset (e.g. by reordering draw commands like done by RenderDimmedBackgroundBehindWindow()) is not supported within a splitter.
+            if (ImDrawCmd_HeaderCompare(last_cmd, cmd_read) == 0 && ImDrawCmd_AreSameKind(last_cmd, cmd_read) && last_cmd->UserCallback == NULL && cmd_read->UserCallback == NULL)
+            {
+                // Merge previous channel last draw command with current channel first draw command if matching.
+                last_cmd->ElemCount += cmd_read->ElemCount;
+                last_cmd->InstCount += cmd_read->InstCount;
+                idx_offset += cmd_read->ElemCount;
+                inst_offset += cmd_read->InstCount;
+                cmd_read++;
+                cmd_count--;
+            }
+        }
+        if (cmd_count > 0)
+        {
+            ImDrawCmd* cmd_write = draw_list->CmdBuffer.Data + draw_list->CmdBuffer.Size;
+            memcpy(cmd_write, cmd_read, cmd_count * sizeof(ImDrawCmd));
+            draw_list->CmdBuffer.Size += cmd_count;
+            for (int cmd_n = 0; cmd_n < cmd_count; cmd_n++)
+            {
+                cmd_write[cmd_n].IdxOffset = idx_offset;
+                cmd_write[cmd_n].InstOffset = inst_offset;
+                idx_offset += cmd_write[cmd_n].ElemCount;
+                inst_offset += cmd_write[cmd_n].InstCount;
+            }
+            last_cmd = &cmd_write[cmd_count - 1];
+        }
         if (int sz = ch._IdxBuffer.Size) { memcpy(idx_write, ch._IdxBuffer.Data, sz * sizeof(ImDrawIdx)); idx_write += sz; }
+        if (int sz = ch._InstBuffer.Size) { memcpy(inst_write, ch._InstBuffer.Data, sz * sizeof(ImDrawRectInstance)); inst_write += sz; }
     }
     draw_list->_IdxWritePtr = idx_write;
+    draw_list->_InstWritePtr = inst_write;
 
     // Ensure there's always a non-callback draw command trailing the command-buffer
     if (draw_list->CmdBuffer.Size == 0 || draw_list->CmdBuffer.back().UserCallback != NULL)
@@ -2177,7 +3579,7 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
 
     // If current command is used with different settings we need to add a new command
     ImDrawCmd* curr_cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
-    if (curr_cmd->ElemCount == 0)
+    if (curr_cmd->ElemCount == 0 && curr_cmd->InstCount == 0)
         ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TextureId, VtxOffset
     else if (ImDrawCmd_HeaderCompare(curr_cmd, &draw_list->_CmdHeader) != 0)
         draw_list->AddDrawCmd();
@@ -2191,24 +3593,445 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
     if (_Current == idx)
         return;
 
-    // Overwrite ImVector (12/16 bytes), four times. This is merely a silly optimization instead of doing .swap()
+    // Overwrite ImVector (12/16 bytes), six times. This is merely a silly optimization instead of doing .swap()
     memcpy(&_Channels.Data[_Current]._CmdBuffer, &draw_list->CmdBuffer, sizeof(draw_list->CmdBuffer));
     memcpy(&_Channels.Data[_Current]._IdxBuffer, &draw_list->IdxBuffer, sizeof(draw_list->IdxBuffer));
+    memcpy(&_Channels.Data[_Current]._InstBuffer, &draw_list->InstBuffer, sizeof(draw_list->InstBuffer));
     _Current = idx;
     memcpy(&draw_list->CmdBuffer, &_Channels.Data[idx]._CmdBuffer, sizeof(draw_list->CmdBuffer));
     memcpy(&draw_list->IdxBuffer, &_Channels.Data[idx]._IdxBuffer, sizeof(draw_list->IdxBuffer));
+    memcpy(&draw_list->InstBuffer, &_Channels.Data[idx]._InstBuffer, sizeof(draw_list->InstBuffer));
     draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+    draw_list->_InstWritePtr = draw_list->InstBuffer.Data + draw_list->InstBuffer.Size;
 
     // If current command is used with different settings we need to add a new command
     ImDrawCmd* curr_cmd = (draw_list->CmdBuffer.Size == 0) ? NULL : &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
     if (curr_cmd == NULL)
         draw_list->AddDrawCmd();
-    else if (curr_cmd->ElemCount == 0)
+    else if (curr_cmd->ElemCount == 0 && curr_cmd->InstCount == 0)
         ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader); // Copy ClipRect, TextureId, VtxOffset
     else if (ImDrawCmd_HeaderCompare(curr_cmd, &draw_list->_CmdHeader) != 0)
         draw_list->AddDrawCmd();
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImDrawListFragment
+//-----------------------------------------------------------------------------
+
+// Multiply two 8-bit values, rounded: same as (a * b + 127) / 255 without the division
+static inline ImU32 ImMulU8(ImU32 a, ImU32 b)
+{
+    const ImU32 t = a * b + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+// Component-wise multiply of two packed colors
+static inline ImU32 ImMulColorsU32(ImU32 col_a, ImU32 col_b)
+{
+    return (ImMulU8(col_a & 0xFF, col_b & 0xFF)) | (ImMulU8((col_a >> 8) & 0xFF, (col_b >> 8) & 0xFF) << 8) | (ImMulU8((col_a >> 16) & 0xFF, (col_b >> 16) & 0xFF) << 16) | (ImMulU8(col_a >> 24, col_b >> 24) << 24);
+}
+
+static int IMGUI_CDECL ImDrawListFragmentGlyphComparer(const void* lhs, const void* rhs)
+{
+    const ImDrawListFragmentGlyph* a = (const ImDrawListFragmentGlyph*)lhs;
+    const ImDrawListFragmentGlyph* b = (const ImDrawListFragmentGlyph*)rhs;
+    if (a->Font != b->Font)
+        return (a->Font < b->Font) ? -1 : +1;
+    return (int)a->Codepoint - (int)b->Codepoint;
+}
+
+// Return glyph currently loaded for a glyph recorded in a fragment, or NULL if it was evicted since
+static ImFontGlyph* ImDrawListFragmentFindGlyph(const ImDrawListFragmentGlyph& fragment_glyph)
+{
+    ImFontGlyph* glyph = fragment_glyph.Font->FindGlyphNoFallback(fragment_glyph.Codepoint);
+    if (glyph == NULL || glyph->U0 != fragment_glyph.U0 || glyph->V0 != fragment_glyph.V0)
+        return NULL;
+    return glyph;
+}
+
+bool ImDrawListFragment::IsValid(ImGuiID id) const
+{
+    if (ID == 0 || ID != id || _CmdStart != -1)
+        return false;
+    for (const ImDrawListFragmentGlyph& fragment_glyph : Glyphs)
+        if (ImDrawListFragmentFindGlyph(fragment_glyph) == NULL)
+            return false;
+    return true;
+}
+
+void ImDrawList::BeginFragment(ImDrawListFragment* fragment, ImGuiID id)
+{
+    IM_ASSERT(fragment->_CmdStart == -1 && "Mismatched BeginFragment()/EndFragment() calls!");
+    fragment->ID = id;
+    fragment->ClipRect = _CmdHeader.ClipRect;
+    fragment->Glyphs.resize(0);
+    fragment->_CmdStart = CmdBuffer.Size - 1;
+    fragment->_IdxStart = IdxBuffer.Size;
+    fragment->_InstStart = InstBuffer.Size;
+    fragment->_Channel = _Splitter._Current;
+    fragment->_Parent = _Fragment;
+    _Fragment = fragment;
+}
+
+void ImDrawList::EndFragment(ImDrawListFragment* fragment)
+{
+    IM_ASSERT(fragment->_CmdStart != -1 && "Mismatched BeginFragment()/EndFragment() calls!");
+    IM_ASSERT(fragment->_Channel == _Splitter._Current && "Cannot change channel while recording a fragment!");
+    IM_ASSERT(_Fragment == fragment && "Mismatched BeginFragment()/EndFragment() calls!");
+    _Fragment = fragment->_Parent;
+
+    // Sort and remove duplicates from glyphs added by ImFont::RenderText(), pass them to the enclosing fragment if any
+    if (fragment->Glyphs.Size > 1)
+    {
+        ImQsort(fragment->Glyphs.Data, (size_t)fragment->Glyphs.Size, sizeof(ImDrawListFragmentGlyph), ImDrawListFragmentGlyphComparer);
+        int unique_count = 1;
+        for (int n = 1; n < fragment->Glyphs.Size; n++)
+            if (ImDrawListFragmentGlyphComparer(&fragment->Glyphs.Data[n], &fragment->Glyphs.Data[unique_count - 1]) != 0)
+                fragment->Glyphs.Data[unique_count++] = fragment->Glyphs.Data[n];
+        fragment->Glyphs.resize(unique_count);
+    }
+    if (_Fragment != NULL)
+        for (const ImDrawListFragmentGlyph& fragment_glyph : fragment->Glyphs)
+            _Fragment->Glyphs.push_back(fragment_glyph);
+    fragment->CmdBuffer.resize(0);
+    fragment->IdxBuffer.resize(0);
+    fragment->VtxBuffer.resize(0);
+    fragment->InstBuffer.resize(0);
+
+    // Start from the command preceding the one that was current on BeginFragment(), as _TryMergeDrawCmds() may have merged it back into its predecessor.
+    // Content emitted before BeginFragment() is excluded by clamping to the buffer positions captured in BeginFragment().
+    for (int cmd_n = ImMax(fragment->_CmdStart - 1, 0); cmd_n < CmdBuffer.Size; cmd_n++)
+    {
+        const ImDrawCmd* src_cmd = &CmdBuffer.Data[cmd_n];
+        IM_ASSERT(src_cmd->UserCallback == NULL && "Callbacks cannot be recorded in a fragment!");
+        ImDrawCmd dst_cmd = *src_cmd; // Copy ClipRect, TextureId
+        dst_cmd.VtxOffset = fragment->VtxBuffer.Size;
+        if (src_cmd->InstCount > 0)
+        {
+            const unsigned int inst_begin = ImMax(src_cmd->InstOffset, (unsigned int)fragment->_InstStart);
+            const unsigned int inst_end = src_cmd->InstOffset + src_cmd->InstCount;
+            if (inst_begin >= inst_end)
+                continue;
+            dst_cmd.InstOffset = fragment->InstBuffer.Size;
+            dst_cmd.InstCount = inst_end - inst_begin;
+            dst_cmd.IdxOffset = dst_cmd.ElemCount = 0;
+            fragment->InstBuffer.resize(fragment->InstBuffer.Size + (int)dst_cmd.InstCount);
+            memcpy(fragment->InstBuffer.Data + dst_cmd.InstOffset, InstBuffer.Data + inst_begin, dst_cmd.InstCount * sizeof(ImDrawRectInstance));
+        }
+        else
+        {
+            const unsigned int idx_begin = ImMax(src_cmd->IdxOffset, (unsigned int)fragment->_IdxStart);
+            const unsigned int idx_end = src_cmd->IdxOffset + src_cmd->ElemCount;
+            if (idx_begin >= idx_end)
+                continue;
+
+            // Only copy the range of vertices referenced by this command, so indices can be rebased on replay
+            const ImDrawIdx* src_idx = IdxBuffer.Data + idx_begin;
+            const int idx_count = (int)(idx_end - idx_begin);
+            unsigned int vtx_min = (unsigned int)-1, vtx_max = 0;
+            for (int n = 0; n < idx_count; n++)
+            {
+                vtx_min = ImMin(vtx_min, (unsigned int)src_idx[n]);
+                vtx_max = ImMax(vtx_max, (unsigned int)src_idx[n]);
+            }
+            const int vtx_count = (int)(vtx_max - vtx_min + 1);
+            fragment->VtxBuffer.resize(fragment->VtxBuffer.Size + vtx_count);
+            memcpy(fragment->VtxBuffer.Data + dst_cmd.VtxOffset, VtxBuffer.Data + src_cmd->VtxOffset + vtx_min, vtx_count * sizeof(ImDrawVert));
+
+            dst_cmd.IdxOffset = fragment->IdxBuffer.Size;
+            dst_cmd.ElemCount = (unsigned int)idx_count;
+            dst_cmd.InstOffset = dst_cmd.InstCount = 0;
+            fragment->IdxBuffer.resize(fragment->IdxBuffer.Size + idx_count);
+            ImDrawIdx* dst_idx = fragment->IdxBuffer.Data + dst_cmd.IdxOffset;
+            for (int n = 0; n < idx_count; n++)
+                dst_idx[n] = (ImDrawIdx)(src_idx[n] - vtx_min);
+        }
+        fragment->CmdBuffer.push_back(dst_cmd);
+    }
+    fragment->_CmdStart = fragment->_IdxStart = fragment->_InstStart = fragment->_Channel = -1;
+    fragment->_Parent = NULL;
+}
+
+void ImDrawList::AddFragment(const ImDrawListFragment* fragment, const ImVec2& offset, ImU32 col_mul)
+{
+    IM_ASSERT(fragment->_CmdStart == -1 && "Cannot replay a fragment while recording it!");
+    const ImVec4 backup_clip_rect = _CmdHeader.ClipRect;
+    const ImTextureID backup_texture_id = _CmdHeader.TextureId;
+    const bool translate = (offset.x != 0.0f || offset.y != 0.0f);
+    const bool tint = (col_mul != IM_COL32_WHITE);
+
+    // With ImFontAtlasFlags_DynamicGlyphs: glyphs are used as if the content was rendered again, keep them loaded
+    for (const ImDrawListFragmentGlyph& fragment_glyph : fragment->Glyphs)
+    {
+        ImFont* font = fragment_glyph.Font;
+        ImFontAtlasDynamicData* dyn = font->ContainerAtlas ? font->ContainerAtlas->DynamicData : NULL;
+        if (dyn == NULL || dyn->LoadingLocked || font->GlyphsLastUsedFrame.Size == 0)
+            continue;
+        if (ImFontGlyph* glyph = ImDrawListFragmentFindGlyph(fragment_glyph))
+            font->GlyphsLastUsedFrame.Data[glyph - font->Glyphs.Data] = dyn->FrameCount;
+    }
+    if (_Fragment != NULL)
+        for (const ImDrawListFragmentGlyph& fragment_glyph : fragment->Glyphs)
+            _Fragment->Glyphs.push_back(fragment_glyph);
+
+    for (int cmd_n = 0; cmd_n < fragment->CmdBuffer.Size; cmd_n++)
+    {
+        const ImDrawCmd* src_cmd = &fragment->CmdBuffer.Data[cmd_n];
+
+        // Use current clipping rectangle in place of the one current on BeginFragment(), otherwise translate and intersect with current one
+        ImVec4 clip_rect = backup_clip_rect;
+        if (memcmp(&src_cmd->ClipRect, &fragment->ClipRect, sizeof(ImVec4)) != 0)
+        {
+            clip_rect.x = ImMax(src_cmd->ClipRect.x + offset.x, backup_clip_rect.x);
+            clip_rect.y = ImMax(src_cmd->ClipRect.y + offset.y, backup_clip_rect.y);
+            clip_rect.z = ImMin(src_cmd->ClipRect.z + offset.x, backup_clip_rect.z);
+            clip_rect.w = ImMin(src_cmd->ClipRect.w + offset.y, backup_clip_rect.w);
+            if (clip_rect.x >= clip_rect.z || clip_rect.y >= clip_rect.w)
+                continue;
+        }
+        if (memcmp(&clip_rect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
+        {
+            _CmdHeader.ClipRect = clip_rect;
+            _OnChangedClipRect();
+        }
+        if (src_cmd->TextureId != _CmdHeader.TextureId)
+        {
+            _CmdHeader.TextureId = src_cmd->TextureId;
+            _OnChangedTextureID();
+        }
+
+        if (src_cmd->InstCount > 0)
+        {
+            IM_ASSERT((Flags & ImDrawListFlags_AllowRectInstances) && "Fragment was recorded with rectangle instances, which are not supported by this draw list!");
+            const int inst_count = (int)src_cmd->InstCount;
+            PrimReserveInstances(inst_count);
+            ImDrawRectInstance* dst_inst = _InstWritePtr;
+            memcpy(dst_inst, fragment->InstBuffer.Data + src_cmd->InstOffset, inst_count * sizeof(ImDrawRectInstance));
+            if (translate || tint)
+                for (int n = 0; n < inst_count; n++)
+                {
+                    dst_inst[n].PosMin += offset;
+                    dst_inst[n].PosMax += offset;
+                    if (tint)
+                        dst_inst[n].Col = ImMulColorsU32(dst_inst[n].Col, col_mul);
+                }
+            _InstWritePtr += inst_count;
+        }
+        else
+        {
+            const int idx_count = (int)src_cmd->ElemCount;
+            const int vtx_count = ((cmd_n + 1 < fragment->CmdBuffer.Size) ? (int)fragment->CmdBuffer.Data[cmd_n + 1].VtxOffset : fragment->VtxBuffer.Size) - (int)src_cmd->VtxOffset;
+            PrimReserve(idx_count, vtx_count);
+
+            ImDrawVert* dst_vtx = _VtxWritePtr;
+            memcpy(dst_vtx, fragment->VtxBuffer.Data + src_cmd->VtxOffset, vtx_count * sizeof(ImDrawVert));
+            if (translate || tint)
+                for (int n = 0; n < vtx_count; n++)
+                {
+                    ImDrawVert_SetPos(&dst_vtx[n], ImDrawVert_GetPos(&dst_vtx[n]) + offset);
+                    if (tint)
+                        dst_vtx[n].col = ImMulColorsU32(dst_vtx[n].col, col_mul);
+                }
+
+            const ImDrawIdx* src_idx = fragment->IdxBuffer.Data + src_cmd->IdxOffset;
+            ImDrawIdx* dst_idx = _IdxWritePtr;
+            const ImDrawIdx idx_base = (ImDrawIdx)_VtxCurrentIdx;
+            for (int n = 0; n < idx_count; n++)
+                dst_idx[n] = (ImDrawIdx)(src_idx[n] + idx_base);
+
+            _VtxWritePtr += vtx_count;
+            _IdxWritePtr += idx_count;
+            _VtxCurrentIdx += vtx_count;
+        }
+    }
+
+    // Restore state
+    if (memcmp(&backup_clip_rect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
+    {
+        _CmdHeader.ClipRect = backup_clip_rect;
+        _OnChangedClipRect();
+    }
+    if (backup_texture_id != _CmdHeader.TextureId)
+    {
+        _CmdHeader.TextureId = backup_texture_id;
+        _OnChangedTextureID();
+    }
+}
+
+// Append output of another draw list, e.g. a detached draw list recorded by another thread (see ImGui::CreateDetachedDrawList()).
+// The source draw list is only read from, so multiple draw lists may be spliced from the same source.
+void ImDrawList::AddDrawList(const ImDrawList* src_list)
+{
+    IM_ASSERT(src_list != this);
+    IM_ASSERT(src_list->_Splitter._Count <= 1 && "Call ChannelsMerge() on source draw list before splicing it!");
+    const ImVec4 backup_clip_rect = _CmdHeader.ClipRect;
+    const ImTextureID backup_texture_id = _CmdHeader.TextureId;
+
+    for (int cmd_n = 0; cmd_n < src_list->CmdBuffer.Size; cmd_n++)
+    {
+        const ImDrawCmd* src_cmd = &src_list->CmdBuffer.Data[cmd_n];
+        if (src_cmd->UserCallback == NULL && src_cmd->ElemCount == 0 && src_cmd->InstCount == 0)
+            continue;
+
+        // Intersect with current clipping rectangle. Empty result is clamped like in PushClipRect(), callbacks may read it.
+        ImVec4 clip_rect;
+        clip_rect.x = ImMax(src_cmd->ClipRect.x, backup_clip_rect.x);
+        clip_rect.y = ImMax(src_cmd->ClipRect.y, backup_clip_rect.y);
+        clip_rect.z = ImMax(clip_rect.x, ImMin(src_cmd->ClipRect.z, backup_clip_rect.z));
+        clip_rect.w = ImMax(clip_rect.y, ImMin(src_cmd->ClipRect.w, backup_clip_rect.w));
+        if (src_cmd->UserCallback == NULL && (clip_rect.x >= clip_rect.z || clip_rect.y >= clip_rect.w))
+            continue;
+        if (memcmp(&clip_rect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
+        {
+            _CmdHeader.ClipRect = clip_rect;
+            _OnChangedClipRect();
+        }
+        if (src_cmd->TextureId != _CmdHeader.TextureId)
+        {
+            _CmdHeader.TextureId = src_cmd->TextureId;
+            _OnChangedTextureID();
+        }
+
+        if (src_cmd->UserCallback != NULL)
+        {
+            if (src_cmd->UserCallbackDataOffset != -1)
+                AddCallback(src_cmd->UserCallback, src_list->_CallbacksDataBuf.Data + src_cmd->UserCallbackDataOffset, (size_t)src_cmd->UserCallbackDataSize);
+            else
+                AddCallback(src_cmd->UserCallback, src_cmd->UserCallbackData);
+        }
+        else if (src_cmd->InstCount > 0)
+        {
+            IM_ASSERT((Flags & ImDrawListFlags_AllowRectInstances) && "Source draw list uses rectangle instances, which are not supported by this draw list!");
+            const int inst_count = (int)src_cmd->InstCount;
+            PrimReserveInstances(inst_count);
+            memcpy(_InstWritePtr, src_list->InstBuffer.Data + src_cmd->InstOffset, inst_count * sizeof(ImDrawRectInstance));
+            _InstWritePtr += inst_count;
+        }
+        else
+        {
+            // Only copy the range of vertices referenced by this command, and rebase indices
+            const ImDrawIdx* src_idx = src_list->IdxBuffer.Data + src_cmd->IdxOffset;
+            const int idx_count = (int)src_cmd->ElemCount;
+            unsigned int vtx_min = (unsigned int)-1, vtx_max = 0;
+            for (int n = 0; n < idx_count; n++)
+            {
+                vtx_min = ImMin(vtx_min, (unsigned int)src_idx[n]);
+                vtx_max = ImMax(vtx_max, (unsigned int)src_idx[n]);
+            }
+            const int vtx_count = (int)(vtx_max - vtx_min + 1);
+            PrimReserve(idx_count, vtx_count);
+            memcpy(_VtxWritePtr, src_list->VtxBuffer.Data + src_cmd->VtxOffset + vtx_min, vtx_count * sizeof(ImDrawVert));
+
+            ImDrawIdx* dst_idx = _IdxWritePtr;
+            const unsigned int idx_base = _VtxCurrentIdx - vtx_min;
+            for (int n = 0; n < idx_count; n++)
+                dst_idx[n] = (ImDrawIdx)(src_idx[n] + idx_base);
+
+            _VtxWritePtr += vtx_count;
+            _IdxWritePtr += idx_count;
+            _VtxCurrentIdx += vtx_count;
+        }
+    }
+
+    // Restore state
+    if (memcmp(&backup_clip_rect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
+    {
+        _CmdHeader.ClipRect = backup_clip_rect;
+        _OnChangedClipRect();
+    }
+    if (backup_texture_id != _CmdHeader.TextureId)
+    {
+        _CmdHeader.TextureId = backup_texture_id;
+        _OnChangedTextureID();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImDrawListCurveCache
+//-----------------------------------------------------------------------------
+
+// Key is made of the first members of ImDrawListCurveCacheEntry (Ctrl[], TessTol, NumSegments)
+static inline ImGuiID ImDrawListCurveCacheHashKey(const ImDrawListCurveCacheEntry& entry)
+{
+    return ImHashData(&entry, offsetof(ImDrawListCurveCacheEntry, PointsOffset));
+}
+
+static inline bool ImDrawListCurveCacheMatchKey(const ImDrawListCurveCacheEntry& a, const ImDrawListCurveCacheEntry& b)
+{
+    return memcmp(&a, &b, offsetof(ImDrawListCurveCacheEntry, PointsOffset)) == 0;
+}
+
+void ImDrawListCurveCache::NewFrame()
+{
+    // Curves used during the last frame become the lookup set, older ones are discarded
+    Entries[0].swap(Entries[1]);
+    Points[0].swap(Points[1]);
+    Entries[1].resize(0);
+    Points[1].resize(0);
+    Buckets.resize(0);
+    SeqIndex = 0;
+}
+
+void ImDrawListCurveCache::Clear()
+{
+    for (int n = 0; n < 2; n++)
+    {
+        Entries[n].clear();
+        Points[n].clear();
+    }
+    Buckets.clear();
+    SeqIndex = 0;
+}
+
+const ImDrawListCurveCacheEntry* ImDrawListCurveCache::Find(const ImDrawListCurveCacheEntry& key)
+{
+    // Fast path: curves are generally submitted in the same order every frame.
+    // After a miss we still advance, assuming the curve in that slot was modified.
+    const int seq_n = SeqIndex++;
+    if (seq_n < Entries[0].Size && ImDrawListCurveCacheMatchKey(Entries[0].Data[seq_n], key))
+        return &Entries[0].Data[seq_n];
+    if (Entries[0].Size == 0)
+        return NULL;
+
+    // Build hash table on first out of order lookup
+    if (Buckets.Size == 0)
+    {
+        int buckets_count = 16;
+        while (buckets_count < Entries[0].Size * 2)
+            buckets_count *= 2;
+        Buckets.resize(buckets_count, 0);
+        for (int entry_n = 0; entry_n < Entries[0].Size; entry_n++)
+        {
+            int bucket_n = ImDrawListCurveCacheHashKey(Entries[0].Data[entry_n]) & (buckets_count - 1);
+            while (Buckets.Data[bucket_n] != 0)
+                bucket_n = (bucket_n + 1) & (buckets_count - 1);
+            Buckets.Data[bucket_n] = entry_n + 1;
+        }
+    }
+    for (int bucket_n = ImDrawListCurveCacheHashKey(key) & (Buckets.Size - 1); Buckets.Data[bucket_n] != 0; bucket_n = (bucket_n + 1) & (Buckets.Size - 1))
+    {
+        const int entry_n = Buckets.Data[bucket_n] - 1;
+        if (ImDrawListCurveCacheMatchKey(Entries[0].Data[entry_n], key))
+        {
+            SeqIndex = entry_n + 1; // Resynchronize fast path, e.g. after curves were inserted or removed
+            return &Entries[0].Data[entry_n];
+        }
+    }
+    return NULL;
+}
+
+// Add entry to current frame. Copy 'points' if provided, otherwise caller needs to write them.
+ImDrawListCurveCacheEntry* ImDrawListCurveCache::Add(const ImDrawListCurveCacheEntry& entry, const ImVec2* points)
+{
+    Entries[1].push_back(entry);
+    ImDrawListCurveCacheEntry* new_entry = &Entries[1].back();
+    new_entry->PointsOffset = Points[1].Size;
+    Points[1].resize(Points[1].Size + entry.PointsCount);
+    if (points != NULL)
+        memcpy(&Points[1].Data[new_entry->PointsOffset], points, entry.PointsCount * sizeof(ImVec2));
+    return new_entry;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawData
 //-----------------------------------------------------------------------------
@@ -2216,10 +4039,12 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
 void ImDrawData::Clear()
 {
     Valid = false;
-    CmdListsCount = TotalIdxCount = TotalVtxCount = 0;
+    CmdListsCount = TotalIdxCount = TotalVtxCount = TotalInstCount = 0;
     CmdLists.resize(0); // The ImDrawList are NOT owned by ImDrawData but e.g. by ImGuiContext, so we don't clear them.
     DisplayPos = DisplaySize = FramebufferScale = ImVec2(0.0f, 0.0f);
     OwnerViewport = NULL;
+    ContentHash = 0;
+    ContentUnchanged = false;
 }
 
 // Important: 'out_list' is generally going to be draw_data->CmdLists, but may be another temporary list
@@ -2228,13 +4053,14 @@ void ImGui::AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>
 {
     if (draw_list->CmdBuffer.Size == 0)
         return;
-    if (draw_list->CmdBuffer.Size == 1 && draw_list->CmdBuffer[0].ElemCount == 0 && draw_list->CmdBuffer[0].UserCallback == NULL)
+    if (draw_list->CmdBuffer.Size == 1 && draw_list->CmdBuffer[0].ElemCount == 0 && draw_list->CmdBuffer[0].InstCount == 0 && draw_list->CmdBuffer[0].UserCallback == NULL)
         return;
 
     // Draw list sanity check. Detect mismatch between PrimReserve() calls and incrementing _VtxCurrentIdx, _VtxWritePtr etc.
     // May trigger for you if you are using PrimXXX functions incorrectly.
     IM_ASSERT(draw_list->VtxBuffer.Size == 0 || draw_list->_VtxWritePtr == draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size);
     IM_ASSERT(draw_list->IdxBuffer.Size == 0 || draw_list->_IdxWritePtr == draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size);
+    IM_ASSERT(draw_list->InstBuffer.Size == 0 || draw_list->_InstWritePtr == draw_list->InstBuffer.Data + draw_list->InstBuffer.Size);
     if (!(draw_list->Flags & ImDrawListFlags_AllowVtxOffset))
         IM_ASSERT((int)draw_list->_VtxCurrentIdx == draw_list->VtxBuffer.Size);
 
@@ -2267,6 +4093,206 @@ void ImGui::AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>
     draw_data->CmdListsCount++;
     draw_data->TotalVtxCount += draw_list->VtxBuffer.Size;
     draw_data->TotalIdxCount += draw_list->IdxBuffer.Size;
+    draw_data->TotalInstCount += draw_list->InstBuffer.Size;
+}
+
+// Hash all draw lists of a ImDrawData, in order, along with display settings (called by Render() when io.ConfigDrawDataChangeDetection is set)
+void ImGui::UpdateDrawDataContentHash(ImDrawData* draw_data)
+{
+    const ImU64 prev_hash = draw_data->ContentHash;
+    bool all_lists_unchanged = true;
+    const ImVec2 display_settings[3] = { draw_data->DisplayPos, draw_data->DisplaySize, draw_data->FramebufferScale };
+    ImU64 hash = ImHashContent(display_settings, sizeof(display_settings), draw_data->CmdListsCount);
+    for (ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        draw_list->_UpdateContentHash();
+        all_lists_unchanged &= draw_list->ContentUnchanged;
+        hash = ImHashContent(&draw_list->ContentHash, sizeof(ImU64), hash);
+    }
+    if (hash == 0)
+        hash = 1; // 0 is reserved for "not computed"
+    draw_data->ContentHash = hash;
+    draw_data->ContentUnchanged = (hash == prev_hash && all_lists_unchanged);
+}
+
+// Concatenate all draw lists of a ImDrawData into builder->MergedList, then make it the only list (called by Render() when io.ConfigDrawDataMergeCommands is set)
+// - Compatible commands (same clipping rectangle, texture, vertex offset and kind) are merged across list boundaries.
+// - With 'allow_reorder': a command may be moved backward to join an earlier compatible command, as long as it doesn't overlap
+//   any command it is moved over. Bounds are computed from vertices/instances, intersected with the clipping rectangle.
+// - Callbacks are kept in place and act as barriers. They receive MergedList as 'parent_list'.
+// - Returns false and leaves ImDrawData untouched if vertices cannot be indexed (16-bit indices without 'allow_vtx_offset').
+bool ImGui::MergeDrawDataCommands(ImDrawData* draw_data, ImDrawDataBuilder* builder, bool allow_reorder, bool allow_vtx_offset)
+{
+    ImDrawList* dst = builder->MergedList;
+    IM_ASSERT(dst != NULL);
+    if (draw_data->CmdListsCount == 0)
+        return false;
+    if (sizeof(ImDrawIdx) == 2 && !allow_vtx_offset && draw_data->TotalVtxCount > (1 << 16))
+        return false;
+
+    dst->CmdBuffer.resize(0);
+    dst->IdxBuffer.resize(0);
+    dst->VtxBuffer.resize(0);
+    dst->InstBuffer.resize(0);
+    dst->Flags = draw_data->CmdLists[0]->Flags;
+    dst->VtxBuffer.reserve(draw_data->TotalVtxCount);
+    dst->IdxBuffer.reserve(draw_data->TotalIdxCount);
+    dst->InstBuffer.reserve(draw_data->TotalInstCount);
+
+    // Gather commands and copy vertices, assigning each command to a batch
+    ImVector<ImDrawDataMergeCmd>& cmds = builder->MergeCmds;
+    ImVector<ImDrawDataMergeBatch>& batches = builder->MergeBatches;
+    cmds.resize(0);
+    batches.resize(0);
+    const int reorder_max_batches = allow_reorder ? 32 : 1; // Amount of batches we may walk back over
+    unsigned int vtx_offset = 0; // Current VtxOffset in merged list
+    for (const ImDrawList* src_list : draw_data->CmdLists)
+    {
+        const unsigned int vtx_base = (unsigned int)dst->VtxBuffer.Size;
+        if (src_list->VtxBuffer.Size > 0)
+        {
+            dst->VtxBuffer.resize(dst->VtxBuffer.Size + src_list->VtxBuffer.Size);
+            memcpy(dst->VtxBuffer.Data + vtx_base, src_list->VtxBuffer.Data, (size_t)src_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        }
+        for (const ImDrawCmd& src_cmd : src_list->CmdBuffer)
+        {
+            if (src_cmd.UserCallback == NULL && src_cmd.ElemCount == 0 && src_cmd.InstCount == 0)
+                continue;
+
+            ImDrawDataMergeBatch batch;
+            memset(&batch, 0, sizeof(batch));
+            batch.Header.ClipRect = src_cmd.ClipRect;
+            batch.Header.TextureId = src_cmd.TextureId;
+            batch.IsCallback = (src_cmd.UserCallback != NULL);
+            batch.IsInstances = (src_cmd.InstCount > 0);
+
+            // With 16-bit indices, start a new VtxOffset range when indices could overflow
+            const unsigned int vtx_start = vtx_base + src_cmd.VtxOffset;
+            if (sizeof(ImDrawIdx) == 2 && ImMin(vtx_base + (unsigned int)src_list->VtxBuffer.Size, vtx_start + (1 << 16)) - vtx_offset > (1 << 16))
+                vtx_offset = vtx_start;
+            batch.Header.VtxOffset = vtx_offset;
+
+            ImDrawDataMergeCmd cmd;
+            cmd.SrcList = src_list;
+            cmd.SrcCmd = &src_cmd;
+            cmd.IdxDelta = vtx_start - vtx_offset;
+            cmd.NextInBatch = -1;
+            const int cmd_n = cmds.Size;
+            cmds.push_back(cmd);
+
+            // Compute bounds
+            ImRect clip_rect(src_cmd.ClipRect);
+            if (allow_reorder && !batch.IsCallback)
+            {
+                ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+                if (batch.IsInstances)
+                {
+                    for (const ImDrawRectInstance* inst = src_list->InstBuffer.Data + src_cmd.InstOffset, *inst_end = inst + src_cmd.InstCount; inst < inst_end; inst++)
+                    {
+                        const float half_thickness = inst->Thickness * 0.5f + 1.0f; // Include stroke and anti-aliasing
+                        bounds.Add(ImRect(inst->PosMin.x - half_thickness, inst->PosMin.y - half_thickness, inst->PosMax.x + half_thickness, inst->PosMax.y + half_thickness));
+                    }
+                }
+                else
+                {
+                    const ImDrawVert* vtx = src_list->VtxBuffer.Data + src_cmd.VtxOffset;
+                    for (const ImDrawIdx* idx = src_list->IdxBuffer.Data + src_cmd.IdxOffset, *idx_end = idx + src_cmd.ElemCount; idx < idx_end; idx++)
+                        bounds.Add(ImDrawVert_GetPos(&vtx[*idx]));
+                }
+                clip_rect.ClipWithFull(bounds);
+            }
+            batch.Bounds = clip_rect;
+
+            // Find a compatible batch to join, walking back over batches we don't overlap with
+            int dst_batch_n = -1;
+            if (!batch.IsCallback)
+                for (int batch_n = batches.Size - 1; batch_n >= 0 && batch_n >= batches.Size - reorder_max_batches; batch_n--)
+                {
+                    ImDrawDataMergeBatch& prev_batch = batches.Data[batch_n];
+                    if (prev_batch.IsCallback)
+                        break;
+                    if (prev_batch.IsInstances == batch.IsInstances && ImDrawCmd_HeaderCompare(&prev_batch.Header, &batch.Header) == 0)
+                    {
+                        dst_batch_n = batch_n;
+                        break;
+                    }
+                    if (prev_batch.Bounds.Overlaps(batch.Bounds))
+                        break;
+                }
+            if (dst_batch_n != -1)
+            {
+                ImDrawDataMergeBatch& dst_batch = batches.Data[dst_batch_n];
+                cmds.Data[dst_batch.CmdLast].NextInBatch = cmd_n;
+                dst_batch.CmdLast = cmd_n;
+                dst_batch.Bounds.Add(batch.Bounds);
+            }
+            else
+            {
+                batch.CmdFirst = batch.CmdLast = cmd_n;
+                batches.push_back(batch);
+            }
+        }
+    }
+
+    // Output one command per batch
+    dst->CmdBuffer.resize(batches.Size);
+    for (int batch_n = 0; batch_n < batches.Size; batch_n++)
+    {
+        const ImDrawDataMergeBatch& batch = batches.Data[batch_n];
+        ImDrawCmd* dst_cmd = &dst->CmdBuffer.Data[batch_n];
+        if (batch.IsCallback)
+        {
+            *dst_cmd = *cmds.Data[batch.CmdFirst].SrcCmd;
+            dst_cmd->VtxOffset = batch.Header.VtxOffset;
+            dst_cmd->IdxOffset = (unsigned int)dst->IdxBuffer.Size;
+            dst_cmd->InstOffset = (unsigned int)dst->InstBuffer.Size;
+            dst_cmd->ElemCount = dst_cmd->InstCount = 0;
+            continue;
+        }
+        memset(dst_cmd, 0, sizeof(*dst_cmd));
+        dst_cmd->ClipRect = batch.Header.ClipRect;
+        dst_cmd->TextureId = batch.Header.TextureId;
+        dst_cmd->VtxOffset = batch.Header.VtxOffset;
+        dst_cmd->IdxOffset = (unsigned int)dst->IdxBuffer.Size;
+        dst_cmd->InstOffset = (unsigned int)dst->InstBuffer.Size;
+        dst_cmd->UserCallbackDataOffset = -1;
+        for (int cmd_n = batch.CmdFirst; cmd_n != -1; cmd_n = cmds.Data[cmd_n].NextInBatch)
+        {
+            const ImDrawDataMergeCmd& cmd = cmds.Data[cmd_n];
+            const ImDrawCmd* src_cmd = cmd.SrcCmd;
+            if (src_cmd->InstCount > 0)
+            {
+                dst->InstBuffer.resize(dst->InstBuffer.Size + (int)src_cmd->InstCount);
+                memcpy(dst->InstBuffer.Data + dst->InstBuffer.Size - src_cmd->InstCount, cmd.SrcList->InstBuffer.Data + src_cmd->InstOffset, src_cmd->InstCount * sizeof(ImDrawRectInstance));
+                dst_cmd->InstCount += src_cmd->InstCount;
+            }
+            if (src_cmd->ElemCount > 0)
+            {
+                dst->IdxBuffer.resize(dst->IdxBuffer.Size + (int)src_cmd->ElemCount);
+                ImDrawIdx* idx_write = dst->IdxBuffer.Data + dst->IdxBuffer.Size - src_cmd->ElemCount;
+                const ImDrawIdx* idx_read = cmd.SrcList->IdxBuffer.Data + src_cmd->IdxOffset;
+                if (cmd.IdxDelta == 0)
+                    memcpy(idx_write, idx_read, src_cmd->ElemCount * sizeof(ImDrawIdx));
+                else
+                    for (unsigned int n = 0; n < src_cmd->ElemCount; n++)
+                        idx_write[n] = (ImDrawIdx)(idx_read[n] + cmd.IdxDelta);
+                dst_cmd->ElemCount += src_cmd->ElemCount;
+            }
+        }
+    }
+    dst->_VtxCurrentIdx = (unsigned int)dst->VtxBuffer.Size - vtx_offset;
+    dst->_VtxWritePtr = dst->VtxBuffer.Data + dst->VtxBuffer.Size;
+    dst->_IdxWritePtr = dst->IdxBuffer.Data + dst->IdxBuffer.Size;
+    dst->_InstWritePtr = dst->InstBuffer.Data + dst->InstBuffer.Size;
+    dst->ContentHash = draw_data->ContentHash;
+    dst->ContentUnchanged = draw_data->ContentUnchanged;
+
+    builder->MergeCmdsCountBefore = cmds.Size;
+    builder->MergeCmdsCountAfter = dst->CmdBuffer.Size;
+    draw_data->CmdLists.resize(0);
+    draw_data->CmdLists.push_back(dst);
+    draw_data->CmdListsCount = 1;
+    return true;
 }
 
 void ImDrawData::AddDrawList(ImDrawList* draw_list)
@@ -2274,6 +4300,12 @@ void ImDrawData::AddDrawList(ImDrawList* draw_list)
     IM_ASSERT(CmdLists.Size == CmdListsCount);
     draw_list->_PopUnusedDrawCmd();
     ImGui::AddDrawListToDrawDataEx(this, &CmdLists, draw_list);
+
+    // Contents of externally added draw lists are not hashed: invalidate change detection for this frame
+    draw_list->ContentHash = 0;
+    draw_list->ContentUnchanged = false;
+    ContentHash = 0;
+    ContentUnchanged = false;
 }
 
 // For backward compatibility: convert all buffers from indexed to de-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
@@ -2287,8 +4319,11 @@ void ImDrawData::DeIndexAllBuffers()
         if (cmd_list->IdxBuffer.empty())
             continue;
         new_vtx_buffer.resize(cmd_list->IdxBuffer.Size);
+        const ImDrawVert* src = cmd_list->VtxBuffer.Data;
+        const ImDrawIdx* idx = cmd_list->IdxBuffer.Data;
+        ImDrawVert* dst = new_vtx_buffer.Data;
         for (int j = 0; j < cmd_list->IdxBuffer.Size; j++)
-            new_vtx_buffer[j] = cmd_list->VtxBuffer[cmd_list->IdxBuffer[j]];
+            dst[j] = src[idx[j]];
         cmd_list->VtxBuffer.swap(new_vtx_buffer);
         cmd_list->IdxBuffer.resize(0);
         TotalVtxCount += cmd_list->VtxBuffer.Size;
@@ -2308,6 +4343,22 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
 //-----------------------------------------------------------------------------
 // [SECTION] Helpers ShadeVertsXXX functions
 //-----------------------------------------------------------------------------
+// With IMGUI_ENABLE_SSE or IMGUI_ENABLE_NEON and the default vertex layout, vertices are processed 4 (gradient) or 2 (clamped uv, transform) at a time.
+// The non-clamped ShadeVertsLinearUV() loop and ImDrawData::ScaleClipRects() stay scalar: SIMD versions measured no faster.
+// Output is bit-identical to the scalar loops: same operations in the same order, and min/max operands
+// are ordered so that NaN values propagate the same way as ImClamp() (NEON uses compare+select for this).
+// Compilers allowed to contract multiply-adds into FMA (e.g. GCC default -ffp-contract=fast on AArch64)
+// may do so differently in both paths: results may then differ in the last bit.
+// See misc/benchmarks/bench_shade_verts.cpp.
+//-----------------------------------------------------------------------------
+
+#if !defined(IMGUI_USE_COMPACT_DRAWVERT) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#if defined(IMGUI_ENABLE_SSE)
+#define IM_DRAWVERT_ENABLE_SSE
+#elif defined(IMGUI_ENABLE_NEON)
+#define IM_DRAWVERT_ENABLE_NEON
+#endif
+#endif
 
 // Generic linear color gradient, write to RGB fields, leave A untouched.
 void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1)
@@ -2322,9 +4373,65 @@ void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int ve
     const int col_delta_r = ((int)(col1 >> IM_COL32_R_SHIFT) & 0xFF) - col0_r;
     const int col_delta_g = ((int)(col1 >> IM_COL32_G_SHIFT) & 0xFF) - col0_g;
     const int col_delta_b = ((int)(col1 >> IM_COL32_B_SHIFT) & 0xFF) - col0_b;
-    for (ImDrawVert* vert = vert_start; vert < vert_end; vert++)
+    ImDrawVert* vert = vert_start;
+#ifdef IM_DRAWVERT_ENABLE_SSE
+    const __m128 p0_x = _mm_set1_ps(gradient_p0.x), p0_y = _mm_set1_ps(gradient_p0.y);
+    const __m128 extent_x = _mm_set1_ps(gradient_extent.x), extent_y = _mm_set1_ps(gradient_extent.y);
+    const __m128 inv_length2 = _mm_set1_ps(gradient_inv_length2);
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+    const __m128 c0_r = _mm_set1_ps((float)col0_r), c0_g = _mm_set1_ps((float)col0_g), c0_b = _mm_set1_ps((float)col0_b);
+    const __m128 delta_r = _mm_set1_ps((float)col_delta_r), delta_g = _mm_set1_ps((float)col_delta_g), delta_b = _mm_set1_ps((float)col_delta_b);
+    const __m128i alpha_mask = _mm_set1_epi32((int)IM_COL32_A_MASK);
+    for (; vert + 4 <= vert_end; vert += 4)
+    {
+        __m128 p01 = _mm_loadh_pi(_mm_loadl_pi(zero, (const __m64*)(const void*)&vert[0].pos), (const __m64*)(const void*)&vert[1].pos);
+        __m128 p23 = _mm_loadh_pi(_mm_loadl_pi(zero, (const __m64*)(const void*)&vert[2].pos), (const __m64*)(const void*)&vert[3].pos);
+        __m128 px = _mm_sub_ps(_mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0)), p0_x);
+        __m128 py = _mm_sub_ps(_mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1)), p0_y);
+        __m128 d = _mm_add_ps(_mm_mul_ps(px, extent_x), _mm_mul_ps(py, extent_y));
+        __m128 t = _mm_max_ps(zero, _mm_min_ps(one, _mm_mul_ps(d, inv_length2)));
+        __m128i r = _mm_cvttps_epi32(_mm_add_ps(c0_r, _mm_mul_ps(delta_r, t)));
+        __m128i g = _mm_cvttps_epi32(_mm_add_ps(c0_g, _mm_mul_ps(delta_g, t)));
+        __m128i b = _mm_cvttps_epi32(_mm_add_ps(c0_b, _mm_mul_ps(delta_b, t)));
+        __m128i a = _mm_and_si128(_mm_setr_epi32((int)vert[0].col, (int)vert[1].col, (int)vert[2].col, (int)vert[3].col), alpha_mask);
+        __m128i col = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r, IM_COL32_R_SHIFT), _mm_slli_epi32(g, IM_COL32_G_SHIFT)), _mm_or_si128(_mm_slli_epi32(b, IM_COL32_B_SHIFT), a));
+        vert[0].col = (ImU32)_mm_cvtsi128_si32(col);
+        vert[1].col = (ImU32)_mm_cvtsi128_si32(_mm_shuffle_epi32(col, _MM_SHUFFLE(1, 1, 1, 1)));
+        vert[2].col = (ImU32)_mm_cvtsi128_si32(_mm_shuffle_epi32(col, _MM_SHUFFLE(2, 2, 2, 2)));
+        vert[3].col = (ImU32)_mm_cvtsi128_si32(_mm_shuffle_epi32(col, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+#elif defined(IM_DRAWVERT_ENABLE_NEON)
+    const float32x4_t p0_x = vdupq_n_f32(gradient_p0.x), p0_y = vdupq_n_f32(gradient_p0.y);
+    const float32x4_t extent_x = vdupq_n_f32(gradient_extent.x), extent_y = vdupq_n_f32(gradient_extent.y);
+    const float32x4_t inv_length2 = vdupq_n_f32(gradient_inv_length2);
+    const float32x4_t zero = vdupq_n_f32(0.0f), one = vdupq_n_f32(1.0f);
+    const float32x4_t c0_r = vdupq_n_f32((float)col0_r), c0_g = vdupq_n_f32((float)col0_g), c0_b = vdupq_n_f32((float)col0_b);
+    const float32x4_t delta_r = vdupq_n_f32((float)col_delta_r), delta_g = vdupq_n_f32((float)col_delta_g), delta_b = vdupq_n_f32((float)col_delta_b);
+    const uint32x4_t alpha_mask = vdupq_n_u32(IM_COL32_A_MASK);
+    for (; vert + 4 <= vert_end; vert += 4)
+    {
+        float32x4x2_t p = vuzpq_f32(vcombine_f32(vld1_f32(&vert[0].pos.x), vld1_f32(&vert[1].pos.x)), vcombine_f32(vld1_f32(&vert[2].pos.x), vld1_f32(&vert[3].pos.x)));
+        float32x4_t px = vsubq_f32(p.val[0], p0_x);
+        float32x4_t py = vsubq_f32(p.val[1], p0_y);
+        float32x4_t d = vaddq_f32(vmulq_f32(px, extent_x), vmulq_f32(py, extent_y));
+        float32x4_t t = vmulq_f32(d, inv_length2);
+        t = vbslq_f32(vcltq_f32(t, zero), zero, vbslq_f32(vcgtq_f32(t, one), one, t));
+        uint32x4_t r = vreinterpretq_u32_s32(vcvtq_s32_f32(vaddq_f32(c0_r, vmulq_f32(delta_r, t))));
+        uint32x4_t g = vreinterpretq_u32_s32(vcvtq_s32_f32(vaddq_f32(c0_g, vmulq_f32(delta_g, t))));
+        uint32x4_t b = vreinterpretq_u32_s32(vcvtq_s32_f32(vaddq_f32(c0_b, vmulq_f32(delta_b, t))));
+        const uint32_t src_col[4] = { vert[0].col, vert[1].col, vert[2].col, vert[3].col };
+        uint32x4_t a = vandq_u32(vld1q_u32(src_col), alpha_mask);
+        uint32_t dst_col[4];
+        vst1q_u32(dst_col, vorrq_u32(vorrq_u32(vshlq_n_u32(r, IM_COL32_R_SHIFT), vshlq_n_u32(g, IM_COL32_G_SHIFT)), vorrq_u32(vshlq_n_u32(b, IM_COL32_B_SHIFT), a)));
+        vert[0].col = (ImU32)dst_col[0];
+        vert[1].col = (ImU32)dst_col[1];
+        vert[2].col = (ImU32)dst_col[2];
+        vert[3].col = (ImU32)dst_col[3];
+    }
+#endif
+    for (; vert < vert_end; vert++)
     {
-        float d = ImDot(vert->pos - gradient_p0, gradient_extent);
+        float d = ImDot(ImDrawVert_GetPos(vert) - gradient_p0, gradient_extent);
         float t = ImClamp(d * gradient_inv_length2, 0.0f, 1.0f);
         int r = (int)(col0_r + col_delta_r * t);
         int g = (int)(col0_g + col_delta_g * t);
@@ -2344,17 +4451,47 @@ void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int ve
 
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
     ImDrawVert* vert_end = draw_list->VtxBuffer.Data + vert_end_idx;
+    ImDrawVert* vertex = vert_start;
+    const ImVec2 min = ImMin(uv_a, uv_b);
+    const ImVec2 max = ImMax(uv_a, uv_b);
     if (clamp)
     {
-        const ImVec2 min = ImMin(uv_a, uv_b);
-        const ImVec2 max = ImMax(uv_a, uv_b);
-        for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = ImClamp(uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale), min, max);
+#ifdef IM_DRAWVERT_ENABLE_SSE
+        const __m128 a_xy = _mm_setr_ps(a.x, a.y, a.x, a.y);
+        const __m128 uv_a_xy = _mm_setr_ps(uv_a.x, uv_a.y, uv_a.x, uv_a.y);
+        const __m128 scale_xy = _mm_setr_ps(scale.x, scale.y, scale.x, scale.y);
+        const __m128 min_xy = _mm_setr_ps(min.x, min.y, min.x, min.y);
+        const __m128 max_xy = _mm_setr_ps(max.x, max.y, max.x, max.y);
+        for (; vertex + 2 <= vert_end; vertex += 2)
+        {
+            __m128 pos = _mm_loadh_pi(_mm_loadl_pi(a_xy, (const __m64*)(const void*)&vertex[0].pos), (const __m64*)(const void*)&vertex[1].pos);
+            __m128 uv = _mm_add_ps(uv_a_xy, _mm_mul_ps(_mm_sub_ps(pos, a_xy), scale_xy));
+            uv = _mm_min_ps(max_xy, _mm_max_ps(min_xy, uv));
+            _mm_storel_pi((__m64*)(void*)&vertex[0].uv, uv);
+            _mm_storeh_pi((__m64*)(void*)&vertex[1].uv, uv);
+        }
+#elif defined(IM_DRAWVERT_ENABLE_NEON)
+        const float32x4_t a_xy = vcombine_f32(vld1_f32(&a.x), vld1_f32(&a.x));
+        const float32x4_t uv_a_xy = vcombine_f32(vld1_f32(&uv_a.x), vld1_f32(&uv_a.x));
+        const float32x4_t scale_xy = vcombine_f32(vld1_f32(&scale.x), vld1_f32(&scale.x));
+        const float32x4_t min_xy = vcombine_f32(vld1_f32(&min.x), vld1_f32(&min.x));
+        const float32x4_t max_xy = vcombine_f32(vld1_f32(&max.x), vld1_f32(&max.x));
+        for (; vertex + 2 <= vert_end; vertex += 2)
+        {
+            float32x4_t pos = vcombine_f32(vld1_f32(&vertex[0].pos.x), vld1_f32(&vertex[1].pos.x));
+            float32x4_t uv = vaddq_f32(uv_a_xy, vmulq_f32(vsubq_f32(pos, a_xy), scale_xy));
+            uv = vbslq_f32(vcltq_f32(uv, min_xy), min_xy, vbslq_f32(vcgtq_f32(uv, max_xy), max_xy, uv));
+            vst1_f32(&vertex[0].uv.x, vget_low_f32(uv));
+            vst1_f32(&vertex[1].uv.x, vget_high_f32(uv));
+        }
+#endif
+        for (; vertex < vert_end; ++vertex)
+            ImDrawVert_SetUV(vertex, ImClamp(uv_a + ImMul(ImDrawVert_GetPos(vertex) - a, scale), min, max));
     }
     else
     {
-        for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale);
+        for (; vertex < vert_end; ++vertex)
+            ImDrawVert_SetUV(vertex, uv_a + ImMul(ImDrawVert_GetPos(vertex) - a, scale));
     }
 }
 
@@ -2362,8 +4499,39 @@ void ImGui::ShadeVertsTransformPos(ImDrawList* draw_list, int vert_start_idx, in
 {
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
     ImDrawVert* vert_end = draw_list->VtxBuffer.Data + vert_end_idx;
-    for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-        vertex->pos = ImRotate(vertex->pos- pivot_in, cos_a, sin_a) + pivot_out;
+    ImDrawVert* vertex = vert_start;
+#ifdef IM_DRAWVERT_ENABLE_SSE
+    // (x, y) -> (x * cos - y * sin, y * cos + x * sin): adding the negated product is exact so this matches ImRotate()
+    const __m128 pivot_in_xy = _mm_setr_ps(pivot_in.x, pivot_in.y, pivot_in.x, pivot_in.y);
+    const __m128 pivot_out_xy = _mm_setr_ps(pivot_out.x, pivot_out.y, pivot_out.x, pivot_out.y);
+    const __m128 cos_xy = _mm_set1_ps(cos_a);
+    const __m128 sin_xy = _mm_setr_ps(-sin_a, sin_a, -sin_a, sin_a);
+    for (; vertex + 2 <= vert_end; vertex += 2)
+    {
+        __m128 d = _mm_loadh_pi(_mm_loadl_pi(pivot_in_xy, (const __m64*)(const void*)&vertex[0].pos), (const __m64*)(const void*)&vertex[1].pos);
+        d = _mm_sub_ps(d, pivot_in_xy);
+        __m128 d_yx = _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128 pos = _mm_add_ps(_mm_add_ps(_mm_mul_ps(d, cos_xy), _mm_mul_ps(d_yx, sin_xy)), pivot_out_xy);
+        _mm_storel_pi((__m64*)(void*)&vertex[0].pos, pos);
+        _mm_storeh_pi((__m64*)(void*)&vertex[1].pos, pos);
+    }
+#elif defined(IM_DRAWVERT_ENABLE_NEON)
+    const float sin_data[4] = { -sin_a, sin_a, -sin_a, sin_a };
+    const float32x4_t pivot_in_xy = vcombine_f32(vld1_f32(&pivot_in.x), vld1_f32(&pivot_in.x));
+    const float32x4_t pivot_out_xy = vcombine_f32(vld1_f32(&pivot_out.x), vld1_f32(&pivot_out.x));
+    const float32x4_t cos_xy = vdupq_n_f32(cos_a);
+    const float32x4_t sin_xy = vld1q_f32(sin_data);
+    for (; vertex + 2 <= vert_end; vertex += 2)
+    {
+        float32x4_t d = vsubq_f32(vcombine_f32(vld1_f32(&vertex[0].pos.x), vld1_f32(&vertex[1].pos.x)), pivot_in_xy);
+        float32x4_t d_yx = vrev64q_f32(d);
+        float32x4_t pos = vaddq_f32(vaddq_f32(vmulq_f32(d, cos_xy), vmulq_f32(d_yx, sin_xy)), pivot_out_xy);
+        vst1_f32(&vertex[0].pos.x, vget_low_f32(pos));
+        vst1_f32(&vertex[1].pos.x, vget_high_f32(pos));
+    }
+#endif
+    for (; vertex < vert_end; ++vertex)
+        ImDrawVert_SetPos(vertex, ImRotate(ImDrawVert_GetPos(vertex) - pivot_in, cos_a, sin_a) + pivot_out);
 }
 
 //-----------------------------------------------------------------------------
@@ -2392,6 +4560,7 @@ ImFontConfig::ImFontConfig()
 // - ImFontAtlas::Clear()
 // - ImFontAtlas::GetTexDataAsAlpha8()
 // - ImFontAtlas::GetTexDataAsRGBA32()
+// - ImFontAtlas::GetTexDataUpdateRect()
 // - ImFontAtlas::AddFont()
 // - ImFontAtlas::AddFontDefault()
 // - ImFontAtlas::AddFontFromFileTTF()
@@ -2416,6 +4585,9 @@ ImFontConfig::ImFontConfig()
 // - ImFontAtlasBuildRenderLinesTexData()
 // - ImFontAtlasBuildInit()
 // - ImFontAtlasBuildFinish()
+// - ImFontAtlasBuildGrowTexHeight()
+// - ImFontAtlasBuildUpdateTexRect()
+// - ImFontAtlasIncrementalDestroy()
 //-----------------------------------------------------------------------------
 
 // A work of art lies ahead! (. = white layer, X = black layer, others are blank)
@@ -2472,6 +4644,7 @@ ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
     TexGlyphPadding = 1;
+    TexSdfSpread = 4;
     PackIdMouseCursors = PackIdLines = -1;
 }
 
@@ -2498,6 +4671,8 @@ void    ImFontAtlas::ClearInputData()
             font->ConfigData = NULL;
             font->ConfigDataCount = 0;
         }
+    ImFontAtlasDynamicDestroy(this); // Glyphs can't be loaded without input data
+    ImFontAtlasIncrementalDestroy(this); // Built sources can't be told apart from new ones anymore
     ConfigData.clear();
     CustomRects.clear();
     PackIdMouseCursors = PackIdLines = -1;
@@ -2514,6 +4689,7 @@ void    ImFontAtlas::ClearTexData()
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
     TexPixelsUseColors = false;
+    TexUpdateRect[0] = TexUpdateRect[1] = TexUpdateRect[2] = TexUpdateRect[3] = 0;
     // Important: we leave TexReady untouched
 }
 
@@ -2534,8 +4710,8 @@ void    ImFontAtlas::Clear()
 
 void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
-    // Build atlas on demand
-    if (TexPixelsAlpha8 == NULL)
+    // Build atlas on demand (incremental builds keep texture data of previous build)
+    if (TexPixelsAlpha8 == NULL || (IncrementalData != NULL && !TexReady))
         Build();
 
     *out_pixels = TexPixelsAlpha8;
@@ -2568,6 +4744,18 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
     if (out_bytes_per_pixel) *out_bytes_per_pixel = 4;
 }
 
+bool    ImFontAtlas::GetTexDataUpdateRect(int* out_x, int* out_y, int* out_w, int* out_h)
+{
+    if (TexUpdateRect[2] <= TexUpdateRect[0])
+        return false;
+    *out_x = TexUpdateRect[0];
+    *out_y = TexUpdateRect[1];
+    *out_w = TexUpdateRect[2] - TexUpdateRect[0];
+    *out_h = TexUpdateRect[3] - TexUpdateRect[1];
+    TexUpdateRect[0] = TexUpdateRect[1] = TexUpdateRect[2] = TexUpdateRect[3] = 0;
+    return true;
+}
+
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
@@ -2601,9 +4789,10 @@ ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
     // Pointers to ConfigData and BuilderData are otherwise dangling
     ImFontAtlasUpdateConfigDataPointers(this);
 
-    // Invalidate texture
+    // Invalidate texture (an incremental build will add to existing texture data)
     TexReady = false;
-    ClearTexData();
+    if (IncrementalData == NULL)
+        ClearTexData();
     return new_font_cfg.DstFont;
 }
 
@@ -2775,6 +4964,7 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
 bool    ImFontAtlas::Build()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    BuildCount++;
 
     // Default font is none are specified
     if (ConfigData.Size == 0)
@@ -2797,8 +4987,60 @@ bool    ImFontAtlas::Build()
 #endif
     }
 
+    // Incremental build: add sources and custom rectangles registered since last build to existing texture data.
+    // Settings used by last full build need to be unchanged, otherwise fallback to a full build.
+    if (ImFontAtlasIncrementalData* inc = IncrementalData)
+    {
+        const bool can_build_incremental = (Flags & ImFontAtlasFlags_IncrementalBuild) && inc->BuilderIO == builder_io && inc->Flags == Flags
+            && inc->TexGlyphPadding == TexGlyphPadding && inc->TexSdfSpread == TexSdfSpread && TexPixelsAlpha8 != NULL;
+        if (can_build_incremental && builder_io->FontBuilder_BuildIncremental(this))
+        {
+            inc->BuildsCount++;
+            return true;
+        }
+        ImFontAtlasIncrementalDestroy(this);
+    }
+
+    // Setup storage for glyphs loaded on demand (builder will fill it)
+    ImFontAtlasDynamicDestroy(this);
+    if ((Flags & ImFontAtlasFlags_DynamicGlyphs) && builder_io->FontBuilder_LoadGlyph != NULL)
+    {
+        DynamicData = IM_NEW(ImFontAtlasDynamicData)();
+        DynamicData->BuilderIO = builder_io;
+        DynamicData->FullFrame = -1;
+    }
+
+    // Restore from cache file when inputs didn't change (not possible with glyphs loaded on demand, which need the builder)
+    CacheLoaded = false;
+    const bool use_cache = (CacheFilename != NULL && CacheFilename[0] != 0 && DynamicData == NULL && builder_io->FontBuilder_Name != NULL);
+    ImU64 cache_inputs_hash = 0;
+    if (use_cache)
+    {
+        ImFontAtlasBuildInit(this); // Register default custom rectangles, which are part of inputs
+        cache_inputs_hash = ImFontAtlasBuildCacheHashInputs(this, builder_io);
+        if (ImFontAtlasBuildCacheLoadFromFile(this, cache_inputs_hash, CacheFilename))
+            return CacheLoaded = true;
+    }
+
+    // Setup packing state kept for next incremental build (builder will fill it)
+    if ((Flags & ImFontAtlasFlags_IncrementalBuild) && DynamicData == NULL && builder_io->FontBuilder_BuildIncremental != NULL)
+    {
+        IncrementalData = IM_NEW(ImFontAtlasIncrementalData)();
+        IncrementalData->BuilderIO = builder_io;
+        IncrementalData->Flags = Flags;
+        IncrementalData->TexGlyphPadding = TexGlyphPadding;
+        IncrementalData->TexSdfSpread = TexSdfSpread;
+    }
+
     // Build
-    return builder_io->FontBuilder_Build(this);
+    if (!builder_io->FontBuilder_Build(this))
+    {
+        ImFontAtlasIncrementalDestroy(this);
+        return false;
+    }
+    if (use_cache)
+        ImFontAtlasBuildCacheSaveToFile(this, cache_inputs_hash, CacheFilename);
+    return true;
 }
 
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
@@ -2826,6 +5068,16 @@ void ImFontAtlasBuildGetOversampleFactors(const ImFontConfig* cfg, int* out_over
     *out_oversample_v = (cfg->OversampleV != 0) ? cfg->OversampleV : 1;
 }
 
+// Remove glyph synthesized for TAB by ImFont::BuildLookupTable() from the end of a built font, so glyphs added by an incremental build are not appended after it.
+static void ImFontAtlasBuildRemoveTabGlyph(ImFont* font)
+{
+    if (!font->Glyphs.empty() && font->Glyphs.back().Codepoint == '\t')
+    {
+        font->Glyphs.pop_back();
+        font->DirtyLookupTables = true;
+    }
+}
+
 #ifdef IMGUI_ENABLE_STB_TRUETYPE
 // Temporary data for one source font (multiple source fonts can be merged into one destination ImFont)
 // (C++03 doesn't allow instancing ImVector<> with function-local types so we declare the type here.)
@@ -2852,6 +5104,23 @@ struct ImFontBuildDstData
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// Temporary data for rendering a range of glyphs of one source font (possibly on another thread, see ImFontAtlas::ParallelForFunc)
+struct ImFontBuildRenderJob
+{
+    int                 SrcIndex;           // Index into src_tmp_array[]
+    int                 GlyphsBegin;        // Range of glyphs in src_tmp_array[SrcIndex].GlyphsList[]
+    int                 GlyphsEnd;
+};
+
+// Shared data for all ImFontBuildRenderJob
+struct ImFontBuildRenderJobsData
+{
+    ImFontAtlas*                    Atlas;
+    const stbtt_pack_context*       PackContext;
+    ImVector<ImFontBuildSrcData>*   SrcTmpArray;
+    ImVector<ImFontBuildRenderJob>  Jobs;
+};
+
 static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>* out)
 {
     IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
@@ -2864,18 +5133,93 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
-static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
+// Render a glyph as a signed distance field (ImFontAtlasFlags_SignedDistanceField) into its packed rectangle, and fill 'pc' like stbtt_PackFontRangesRenderIntoRects() does.
+// stbtt_GetGlyphSDF() adds a margin of TexSdfSpread texels around the glyph box (except for empty glyphs), which rectangle sizes account for.
+static void ImFontAtlasBuildRenderGlyphSdfWithStbTruetype(ImFontAtlas* atlas, const stbtt_fontinfo* font_info, float font_size, int codepoint, const stbrp_rect* r, stbtt_packedchar* pc)
+{
+    const float scale = (font_size > 0.0f) ? stbtt_ScaleForPixelHeight(font_info, font_size) : stbtt_ScaleForMappingEmToPixels(font_info, -font_size);
+    const int glyph_index = stbtt_FindGlyphIndex(font_info, codepoint);
+    const int spread = atlas->TexSdfSpread;
+    int advance, lsb, w = 0, h = 0, x_off = 0, y_off = 0;
+    stbtt_GetGlyphHMetrics(font_info, glyph_index, &advance, &lsb);
+    if (unsigned char* sdf_pixels = stbtt_GetGlyphSDF(font_info, scale, glyph_index, spread, 128, 128.0f / spread, &w, &h, &x_off, &y_off))
+    {
+        IM_ASSERT(w <= r->w && h <= r->h);
+        for (int y = 0; y < h; y++)
+            memcpy(atlas->TexPixelsAlpha8 + (size_t)(r->y + y) * atlas->TexWidth + r->x, sdf_pixels + (size_t)y * w, (size_t)w);
+        stbtt_FreeSDF(sdf_pixels, font_info->userdata);
+    }
+    pc->x0 = (unsigned short)r->x;
+    pc->y0 = (unsigned short)r->y;
+    pc->x1 = (unsigned short)(r->x + w);
+    pc->y1 = (unsigned short)(r->y + h);
+    pc->xoff = (float)x_off;
+    pc->yoff = (float)y_off;
+    pc->xoff2 = (float)(x_off + w);
+    pc->yoff2 = (float)(y_off + h);
+    pc->xadvance = scale * advance;
+}
+
+// Render a range of glyphs into their packed rectangles. Jobs write into disjoint areas of the texture, and don't modify any shared data.
+static void ImFontAtlasBuildRenderJobWithStbTruetype(void* job_data, int job_index)
+{
+    ImFontBuildRenderJobsData* jobs_data = (ImFontBuildRenderJobsData*)job_data;
+    const ImFontBuildRenderJob& job = jobs_data->Jobs[job_index];
+    ImFontAtlas* atlas = jobs_data->Atlas;
+    ImFontConfig& cfg = atlas->ConfigData[job.SrcIndex];
+    ImFontBuildSrcData& src_tmp = (*jobs_data->SrcTmpArray)[job.SrcIndex];
+
+    // stbtt_PackFontRangesRenderIntoRects() temporarily writes into the pack context and uses stbtt_fontinfo::userdata for allocations: use copies
+    stbtt_pack_context spc = *jobs_data->PackContext;
+    stbtt_fontinfo font_info = src_tmp.FontInfo;
+    if (atlas->ParallelForFunc != NULL)
+        font_info.userdata = &font_info;
+    stbtt_pack_range pack_range = src_tmp.PackRange;
+    pack_range.array_of_unicode_codepoints = src_tmp.GlyphsList.Data + job.GlyphsBegin;
+    pack_range.chardata_for_range = src_tmp.PackedChars + job.GlyphsBegin;
+    pack_range.num_chars = job.GlyphsEnd - job.GlyphsBegin;
+    stbrp_rect* rects = src_tmp.Rects + job.GlyphsBegin;
+    if (atlas->Flags & ImFontAtlasFlags_SignedDistanceField)
+    {
+        for (int glyph_i = 0; glyph_i < pack_range.num_chars; glyph_i++)
+            if (rects[glyph_i].was_packed)
+                ImFontAtlasBuildRenderGlyphSdfWithStbTruetype(atlas, &font_info, pack_range.font_size, pack_range.array_of_unicode_codepoints[glyph_i], &rects[glyph_i], &pack_range.chardata_for_range[glyph_i]);
+        return;
+    }
+    stbtt_PackFontRangesRenderIntoRects(&spc, &font_info, &pack_range, 1, rects);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = rects;
+        for (int glyph_i = job.GlyphsBegin; glyph_i < job.GlyphsEnd; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+    }
+}
+
+// With 'incremental' (ImFontAtlasFlags_IncrementalBuild), only sources and custom rectangles added since last build are packed, around existing ones,
+// and rasterized into existing texture data. Packer state is kept in atlas->IncrementalData between builds.
+static bool ImFontAtlasBuildWithStbTruetypeEx(ImFontAtlas* atlas, bool incremental)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
+    ImFontAtlasIncrementalData* inc = atlas->IncrementalData;
+    IM_ASSERT(!incremental || (inc != NULL && inc->PackContext != NULL && atlas->TexPixelsAlpha8 != NULL));
+    const int src_begin = incremental ? inc->ConfigDataBuilt : 0;
 
     ImFontAtlasBuildInit(atlas);
 
-    // Clear atlas
-    atlas->TexID = (ImTextureID)NULL;
-    atlas->TexWidth = atlas->TexHeight = 0;
-    atlas->TexUvScale = ImVec2(0.0f, 0.0f);
-    atlas->TexUvWhitePixel = ImVec2(0.0f, 0.0f);
-    atlas->ClearTexData();
+    // Clear atlas (unless adding to existing texture data)
+    if (!incremental)
+    {
+        atlas->TexID = (ImTextureID)NULL;
+        atlas->TexWidth = atlas->TexHeight = 0;
+        atlas->TexUvScale = ImVec2(0.0f, 0.0f);
+        atlas->TexUvWhitePixel = ImVec2(0.0f, 0.0f);
+        atlas->ClearTexData();
+    }
 
     // Temporary storage for building
     ImVector<ImFontBuildSrcData> src_tmp_array;
@@ -2886,7 +5230,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     memset(dst_tmp_array.Data, 0, (size_t)dst_tmp_array.size_in_bytes());
 
     // 1. Initialize font loading structure, check font data validity
-    for (int src_i = 0; src_i < atlas->ConfigData.Size; src_i++)
+    for (int src_i = src_begin; src_i < atlas->ConfigData.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
         ImFontConfig& cfg = atlas->ConfigData[src_i];
@@ -2928,19 +5272,35 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 
     // 2. For every requested codepoint, check for their presence in the font data, and handle redundancy or overlaps between source fonts to avoid unused glyphs.
     int total_glyphs_count = 0;
-    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+    for (int src_i = src_begin; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
         ImFontBuildDstData& dst_tmp = dst_tmp_array[src_tmp.DstIndex];
         src_tmp.GlyphsSet.Create(src_tmp.GlyphsHighest + 1);
         if (dst_tmp.GlyphsSet.Storage.empty())
-            dst_tmp.GlyphsSet.Create(dst_tmp.GlyphsHighest + 1);
+        {
+            // Merging into a font built previously: its existing glyphs take precedence, same as glyphs of earlier sources
+            ImFont* dst_font = atlas->ConfigData[src_i].DstFont;
+            if (incremental)
+                ImFontAtlasBuildRemoveTabGlyph(dst_font);
+            int glyphs_highest = dst_tmp.GlyphsHighest;
+            if (incremental)
+                for (const ImFontGlyph& glyph : dst_font->Glyphs)
+                    glyphs_highest = ImMax(glyphs_highest, (int)glyph.Codepoint);
+            dst_tmp.GlyphsSet.Create(glyphs_highest + 1);
+            if (incremental)
+                for (const ImFontGlyph& glyph : dst_font->Glyphs)
+                    dst_tmp.GlyphsSet.SetBit(glyph.Codepoint);
+        }
 
+        const ImFontConfig& cfg = atlas->ConfigData[src_i];
         for (const ImWchar* src_range = src_tmp.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
             for (unsigned int codepoint = src_range[0]; codepoint <= src_range[1]; codepoint++)
             {
                 if (dst_tmp.GlyphsSet.TestBit(codepoint))    // Don't overwrite existing glyphs. We could make this an option for MergeMode (e.g. MergeOverwrite==true)
                     continue;
+                if (atlas->DynamicData != NULL && !ImFontAtlasBuildIsPreloadedGlyph(&cfg, codepoint)) // Will be loaded on demand
+                    continue;
                 if (!stbtt_FindGlyphIndex(&src_tmp.FontInfo, codepoint))    // It is actually in the font?
                     continue;
 
@@ -2972,8 +5332,11 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     ImVector<stbtt_packedchar> buf_packedchars;
     buf_rects.resize(total_glyphs_count);
     buf_packedchars.resize(total_glyphs_count);
-    memset(buf_rects.Data, 0, (size_t)buf_rects.size_in_bytes());
-    memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
+    if (total_glyphs_count > 0) // (An incremental build may have no new glyph)
+    {
+        memset(buf_rects.Data, 0, (size_t)buf_rects.size_in_bytes());
+        memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
+    }
 
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
     int total_surface = 0;
@@ -2995,6 +5358,8 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         ImFontConfig& cfg = atlas->ConfigData[src_i];
         int oversample_h, oversample_v;
         ImFontAtlasBuildGetOversampleFactors(&cfg, &oversample_h, &oversample_v);
+        if (atlas->Flags & ImFontAtlasFlags_SignedDistanceField)
+            oversample_h = oversample_v = 1; // Distance fields are interpolated by the renderer
 
         // Convert our ranges in the format stb_truetype wants
         src_tmp.PackRange.font_size = cfg.SizePixels * cfg.RasterizerDensity;
@@ -3013,8 +5378,9 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
             const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
             IM_ASSERT(glyph_index_in_font != 0);
             stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * oversample_h, scale * oversample_v, 0, 0, &x0, &y0, &x1, &y1);
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + pack_padding + oversample_h - 1);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + pack_padding + oversample_v - 1);
+            const int sdf_margin = ((atlas->Flags & ImFontAtlasFlags_SignedDistanceField) && x0 != x1 && y0 != y1) ? atlas->TexSdfSpread * 2 : 0;
+            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + sdf_margin + pack_padding + oversample_h - 1);
+            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + sdf_margin + pack_padding + oversample_v - 1);
             total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
         }
     }
@@ -3024,20 +5390,41 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
     // User can override TexDesiredWidth and TexGlyphPadding if they wish, otherwise we use a simple heuristic to select the width based on expected surface.
+    // (An incremental build keeps the width of existing texture data)
     const int surface_sqrt = (int)ImSqrt((float)total_surface) + 1;
-    atlas->TexHeight = 0;
-    if (atlas->TexDesiredWidth > 0)
-        atlas->TexWidth = atlas->TexDesiredWidth;
-    else
-        atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
+    const int tex_height_prev = atlas->TexHeight;
+    if (!incremental)
+    {
+        atlas->TexHeight = 0;
+        if (atlas->TexDesiredWidth > 0)
+            atlas->TexWidth = atlas->TexDesiredWidth;
+        else if (atlas->DynamicData != NULL)
+            atlas->TexWidth = 1024; // Leave room for glyphs loaded on demand
+        else
+            atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
+    }
 
     // 5. Start packing
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
+    // An incremental build resumes packing from the state of previous build, around existing rectangles.
     const int TEX_HEIGHT_MAX = 1024 * 32;
     stbtt_pack_context spc = {};
-    stbtt_PackBegin(&spc, NULL, atlas->TexWidth, TEX_HEIGHT_MAX, 0, 0, NULL);
+    if (!incremental)
+    {
+        stbtt_PackBegin(&spc, NULL, atlas->TexWidth, TEX_HEIGHT_MAX, 0, 0, NULL);
+    }
+    else
+    {
+        spc.pack_info = inc->PackContext;
+        spc.nodes = inc->PackNodes;
+        spc.width = atlas->TexWidth;
+        spc.height = TEX_HEIGHT_MAX;
+        spc.stride_in_bytes = atlas->TexWidth;
+        spc.h_oversample = spc.v_oversample = 1;
+    }
     spc.padding = atlas->TexGlyphPadding; // Because we mixup stbtt_PackXXX and stbrp_PackXXX there's a bit of a hack here, not passing the value to stbtt_PackBegin() allows us to still pack a TexWidth-1 wide item. (#8107)
-    ImFontAtlasBuildPackCustomRects(atlas, spc.pack_info);
+    const int custom_rects_begin = incremental ? inc->CustomRectsBuilt : 0;
+    ImFontAtlasBuildPackCustomRects(atlas, spc.pack_info, custom_rects_begin);
 
     // 6. Pack each source font. No rendering yet, we are working with rectangles in an infinitely tall texture at this point.
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
@@ -3055,43 +5442,70 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
                 atlas->TexHeight = ImMax(atlas->TexHeight, src_tmp.Rects[glyph_i].y + src_tmp.Rects[glyph_i].h);
     }
 
-    // 7. Allocate texture
-    atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
-    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
-    atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
-    memset(atlas->TexPixelsAlpha8, 0, atlas->TexWidth * atlas->TexHeight);
+    // 7. Allocate texture (or grow existing texture data, if new rectangles went past its height)
+    if (!incremental)
+    {
+        atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
+        if (atlas->DynamicData != NULL)
+            atlas->TexHeight = ImMax(atlas->TexHeight, atlas->TexWidth);
+        atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+        atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
+        memset(atlas->TexPixelsAlpha8, 0, atlas->TexWidth * atlas->TexHeight);
+    }
+    else
+    {
+        const int tex_height_used = atlas->TexHeight;
+        atlas->TexHeight = tex_height_prev;
+        if (tex_height_used > tex_height_prev)
+            ImFontAtlasBuildGrowTexHeight(atlas, (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (tex_height_used + 1) : ImUpperPowerOfTwo(tex_height_used));
+        for (int i = custom_rects_begin; i < atlas->CustomRects.Size; i++)
+            if (atlas->CustomRects[i].IsPacked())
+                ImFontAtlasBuildUpdateTexRect(atlas, atlas->CustomRects[i].X, atlas->CustomRects[i].Y, atlas->CustomRects[i].Width, atlas->CustomRects[i].Height);
+    }
     spc.pixels = atlas->TexPixelsAlpha8;
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // Glyphs are split into jobs which may run in parallel with ImFontAtlas::ParallelForFunc. Output doesn't depend on how jobs are run.
+    ImFontBuildRenderJobsData jobs_data;
+    jobs_data.Atlas = atlas;
+    jobs_data.PackContext = &spc;
+    jobs_data.SrcTmpArray = &src_tmp_array;
+    const int glyphs_per_job = (atlas->ParallelForFunc != NULL) ? 64 : INT_MAX;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        for (int glyph_i = 0; glyph_i < src_tmp_array[src_i].GlyphsCount; glyph_i += glyphs_per_job)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            ImFontBuildRenderJob job;
+            job.SrcIndex = src_i;
+            job.GlyphsBegin = glyph_i;
+            job.GlyphsEnd = ImMin(src_tmp_array[src_i].GlyphsCount, glyph_i + glyphs_per_job);
+            jobs_data.Jobs.push_back(job);
         }
+    if (atlas->ParallelForFunc != NULL && jobs_data.Jobs.Size > 1)
+        atlas->ParallelForFunc(ImFontAtlasBuildRenderJobWithStbTruetype, &jobs_data, jobs_data.Jobs.Size, atlas->ParallelForUserData);
+    else
+        for (int job_n = 0; job_n < jobs_data.Jobs.Size; job_n++)
+            ImFontAtlasBuildRenderJobWithStbTruetype(&jobs_data, job_n);
+    if (incremental)
+        for (const stbrp_rect& r : buf_rects)
+            if (r.was_packed)
+                ImFontAtlasBuildUpdateTexRect(atlas, r.x, r.y, r.w, r.h);
+    for (ImFontBuildSrcData& src_tmp : src_tmp_array)
         src_tmp.Rects = NULL;
-    }
 
-    // End packing
+    // End packing (or keep packer state for next incremental build)
+    if (inc != NULL)
+    {
+        inc->PackContext = spc.pack_info;
+        inc->PackNodes = spc.nodes;
+        spc.pack_info = NULL;
+        spc.nodes = NULL;
+    }
     stbtt_PackEnd(&spc);
     buf_rects.clear();
 
     // 9. Setup ImFont and glyphs for runtime
-    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+    for (int src_i = src_begin; src_i < src_tmp_array.Size; src_i++)
     {
         // When merging fonts with MergeMode=true:
         // - We can have multiple input fonts writing into a same destination font.
@@ -3128,6 +5542,16 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         }
     }
 
+    // Keep parsed font data for glyphs loaded on demand (indexed like atlas->ConfigData[])
+    if (atlas->DynamicData != NULL)
+    {
+        ImVector<stbtt_fontinfo>* fonts_info = IM_NEW(ImVector<stbtt_fontinfo>)();
+        fonts_info->resize(src_tmp_array.Size);
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+            (*fonts_info)[src_i] = src_tmp_array[src_i].FontInfo;
+        atlas->DynamicData->BuilderData = fonts_info;
+    }
+
     // Cleanup
     src_tmp_array.clear_destruct();
 
@@ -3135,10 +5559,120 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     return true;
 }
 
+static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
+{
+    return ImFontAtlasBuildWithStbTruetypeEx(atlas, false);
+}
+
+static bool ImFontAtlasBuildIncrementalWithStbTruetype(ImFontAtlas* atlas)
+{
+    return ImFontAtlasBuildWithStbTruetypeEx(atlas, true);
+}
+
+// Rasterize a single glyph into free texture space (ImFontAtlasFlags_DynamicGlyphs).
+// Same as steps 4-9 of ImFontAtlasBuildWithStbTruetype(), so glyphs are identical to baked ones.
+static bool ImFontAtlasLoadGlyphWithStbTruetype(ImFontAtlas* atlas, ImFont* font, ImWchar codepoint)
+{
+    ImVector<stbtt_fontinfo>* fonts_info = (ImVector<stbtt_fontinfo>*)atlas->DynamicData->BuilderData;
+    for (int cfg_n = 0; cfg_n < font->ConfigDataCount; cfg_n++)
+    {
+        // First source providing the glyph wins (same as merging rules in ImFontAtlasBuildWithStbTruetype())
+        const ImFontConfig& cfg = font->ConfigData[cfg_n];
+        stbtt_fontinfo* font_info = &(*fonts_info)[(int)(&cfg - atlas->ConfigData.Data)];
+        if (!ImFontAtlasBuildIsInGlyphRanges(atlas, &cfg, codepoint))
+            continue;
+        const int glyph_index_in_font = stbtt_FindGlyphIndex(font_info, codepoint);
+        if (glyph_index_in_font == 0)
+            continue;
+
+        // Measure
+        const bool sdf = (atlas->Flags & ImFontAtlasFlags_SignedDistanceField) != 0;
+        int oversample_h, oversample_v;
+        ImFontAtlasBuildGetOversampleFactors(&cfg, &oversample_h, &oversample_v);
+        if (sdf)
+            oversample_h = oversample_v = 1;
+        const float scale = (cfg.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(font_info, cfg.SizePixels * cfg.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(font_info, -cfg.SizePixels * cfg.RasterizerDensity);
+        int x0, y0, x1, y1;
+        stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index_in_font, scale * oversample_h, scale * oversample_v, 0, 0, &x0, &y0, &x1, &y1);
+        const int pack_padding = atlas->TexGlyphPadding;
+        const int sdf_margin = (sdf && x0 != x1 && y0 != y1) ? atlas->TexSdfSpread * 2 : 0;
+        stbrp_rect r = {};
+        r.w = (stbrp_coord)(x1 - x0 + sdf_margin + pack_padding + oversample_h - 1);
+        r.h = (stbrp_coord)(y1 - y0 + sdf_margin + pack_padding + oversample_v - 1);
+        r.was_packed = 1;
+
+        // Allocate texture space (empty glyphs don't need any)
+        int slot_n = -1;
+        if (r.w > 0 && r.h > 0)
+        {
+            slot_n = ImFontAtlasDynamicAllocRect(atlas, r.w, r.h);
+            if (slot_n == -1)
+                return false;
+            r.x = atlas->DynamicData->Slots[slot_n].X;
+            r.y = atlas->DynamicData->Slots[slot_n].Y;
+        }
+
+        // Render
+        int codepoint_i = (int)codepoint;
+        stbtt_packedchar pc = {};
+        stbtt_pack_range range = {};
+        range.font_size = cfg.SizePixels * cfg.RasterizerDensity;
+        range.array_of_unicode_codepoints = &codepoint_i;
+        range.num_chars = 1;
+        range.chardata_for_range = &pc;
+        range.h_oversample = (unsigned char)oversample_h;
+        range.v_oversample = (unsigned char)oversample_v;
+        stbtt_pack_context spc = {};
+        spc.width = atlas->TexWidth;
+        spc.height = atlas->TexHeight;
+        spc.stride_in_bytes = atlas->TexWidth;
+        spc.padding = pack_padding;
+        spc.pixels = atlas->TexPixelsAlpha8;
+        if (sdf)
+            ImFontAtlasBuildRenderGlyphSdfWithStbTruetype(atlas, font_info, range.font_size, codepoint_i, &r, &pc);
+        else
+            stbtt_PackFontRangesRenderIntoRects(&spc, font_info, &range, 1, &r);
+        if (cfg.RasterizerMultiply != 1.0f && slot_n != -1 && !sdf)
+        {
+            unsigned char multiply_table[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+            ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r.x, r.y, r.w, r.h, atlas->TexWidth * 1);
+        }
+
+        // Register glyph
+        const float font_off_x = cfg.GlyphOffset.x;
+        const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(font->Ascent);
+        const float inv_rasterization_scale = 1.0f / cfg.RasterizerDensity;
+        stbtt_aligned_quad q;
+        float unused_x = 0.0f, unused_y = 0.0f;
+        stbtt_GetPackedQuad(&pc, atlas->TexWidth, atlas->TexHeight, 0, &unused_x, &unused_y, &q, 0);
+        ImFontAtlasDynamicAddGlyph(atlas, slot_n, font, &cfg, codepoint,
+            q.x0 * inv_rasterization_scale + font_off_x, q.y0 * inv_rasterization_scale + font_off_y, q.x1 * inv_rasterization_scale + font_off_x, q.y1 * inv_rasterization_scale + font_off_y,
+            q.s0, q.t0, q.s1, q.t1, pc.xadvance * inv_rasterization_scale);
+        return true;
+    }
+    return false;
+}
+
+static void ImFontAtlasDestroyDataWithStbTruetype(ImFontAtlas* atlas)
+{
+    ImVector<stbtt_fontinfo>* fonts_info = (ImVector<stbtt_fontinfo>*)atlas->DynamicData->BuilderData;
+    IM_DELETE(fonts_info);
+}
+
 const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
 {
     static ImFontBuilderIO io;
     io.FontBuilder_Build = ImFontAtlasBuildWithStbTruetype;
+    io.FontBuilder_Name = "stb_truetype";
+#ifdef IMGUI_STB_TRUETYPE_FILENAME
+    io.FontBuilder_Version = IMGUI_STB_TRUETYPE_FILENAME;
+#else
+    io.FontBuilder_Version = "1.26"; // Our modified copy of stb_truetype.h (imstb_truetype.h)
+#endif
+    io.FontBuilder_LoadGlyph = ImFontAtlasLoadGlyphWithStbTruetype;
+    io.FontBuilder_DestroyData = ImFontAtlasDestroyDataWithStbTruetype;
+    io.FontBuilder_BuildIncremental = ImFontAtlasBuildIncrementalWithStbTruetype;
     return &io;
 }
 
@@ -3171,7 +5705,8 @@ void ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* f
     }
 }
 
-void ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opaque)
+// Pack atlas->CustomRects[rects_begin..] (an incremental build only packs rectangles added since last build)
+void ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opaque, int rects_begin)
 {
     stbrp_context* pack_context = (stbrp_context*)stbrp_context_opaque;
     IM_ASSERT(pack_context != NULL);
@@ -3182,22 +5717,28 @@ void ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opa
     if (user_rects.Size < 1) { __builtin_unreachable(); } // Workaround for GCC bug if IM_ASSERT() is defined to conditionally throw (see #5343)
 #endif
 
+    IM_ASSERT(rects_begin >= 0 && rects_begin <= user_rects.Size);
+    const int rects_count = user_rects.Size - rects_begin;
+    if (rects_count <= 0)
+        return;
+
     const int pack_padding = atlas->TexGlyphPadding;
     ImVector<stbrp_rect> pack_rects;
-    pack_rects.resize(user_rects.Size);
+    pack_rects.resize(rects_count);
     memset(pack_rects.Data, 0, (size_t)pack_rects.size_in_bytes());
-    for (int i = 0; i < user_rects.Size; i++)
+    for (int i = 0; i < pack_rects.Size; i++)
     {
-        pack_rects[i].w = user_rects[i].Width + pack_padding;
-        pack_rects[i].h = user_rects[i].Height + pack_padding;
+        pack_rects[i].w = user_rects[rects_begin + i].Width + pack_padding;
+        pack_rects[i].h = user_rects[rects_begin + i].Height + pack_padding;
     }
     stbrp_pack_rects(pack_context, &pack_rects[0], pack_rects.Size);
     for (int i = 0; i < pack_rects.Size; i++)
         if (pack_rects[i].was_packed)
         {
-            user_rects[i].X = (unsigned short)pack_rects[i].x;
-            user_rects[i].Y = (unsigned short)pack_rects[i].y;
-            IM_ASSERT(pack_rects[i].w == user_rects[i].Width + pack_padding && pack_rects[i].h == user_rects[i].Height + pack_padding);
+            ImFontAtlasCustomRect& user_rect = user_rects[rects_begin + i];
+            user_rect.X = (unsigned short)pack_rects[i].x;
+            user_rect.Y = (unsigned short)pack_rects[i].y;
+            IM_ASSERT(pack_rects[i].w == user_rect.Width + pack_padding && pack_rects[i].h == user_rect.Height + pack_padding);
             atlas->TexHeight = ImMax(atlas->TexHeight, pack_rects[i].y + pack_rects[i].h);
         }
 }
@@ -3255,115 +5796,902 @@ static void ImFontAtlasBuildRenderDefaultTexData(ImFontAtlas* atlas)
         }
         else
         {
-            ImFontAtlasBuildRender32bppRectFromString(atlas, x_for_white, r->Y, FONT_ATLAS_DEFAULT_TEX_DATA_W, FONT_ATLAS_DEFAULT_TEX_DATA_H, FONT_ATLAS_DEFAULT_TEX_DATA_PIXELS, '.', IM_COL32_WHITE);
-            ImFontAtlasBuildRender32bppRectFromString(atlas, x_for_black, r->Y, FONT_ATLAS_DEFAULT_TEX_DATA_W, FONT_ATLAS_DEFAULT_TEX_DATA_H, FONT_ATLAS_DEFAULT_TEX_DATA_PIXELS, 'X', IM_COL32_WHITE);
+            ImFontAtlasBuildRender32bppRectFromString(atlas, x_for_white, r->Y, FONT_ATLAS_DEFAULT_TEX_DATA_W, FONT_ATLAS_DEFAULT_TEX_DATA_H, FONT_ATLAS_DEFAULT_TEX_DATA_PIXELS, '.', IM_COL32_WHITE);
+            ImFontAtlasBuildRender32bppRectFromString(atlas, x_for_black, r->Y, FONT_ATLAS_DEFAULT_TEX_DATA_W, FONT_ATLAS_DEFAULT_TEX_DATA_H, FONT_ATLAS_DEFAULT_TEX_DATA_PIXELS, 'X', IM_COL32_WHITE);
+        }
+    }
+    atlas->TexUvWhitePixel = ImVec2((r->X + 0.5f) * atlas->TexUvScale.x, (r->Y + 0.5f) * atlas->TexUvScale.y);
+}
+
+static void ImFontAtlasBuildRenderLinesTexData(ImFontAtlas* atlas)
+{
+    if (atlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SignedDistanceField))
+        return;
+
+    // This generates a triangular shape in the texture, with the various line widths stacked on top of each other to allow interpolation between them
+    ImFontAtlasCustomRect* r = atlas->GetCustomRectByIndex(atlas->PackIdLines);
+    IM_ASSERT(r->IsPacked());
+    for (int n = 0; n < IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1; n++) // +1 because of the zero-width row
+    {
+        // Each line consists of at least two empty pixels at the ends, with a line of solid pixels in the middle
+        int y = n;
+        int line_width = n;
+        int pad_left = (r->Width - line_width) / 2;
+        int pad_right = r->Width - (pad_left + line_width);
+
+        // Write each slice
+        IM_ASSERT(pad_left + line_width + pad_right == r->Width && y < r->Height); // Make sure we're inside the texture bounds before we start writing pixels
+        if (atlas->TexPixelsAlpha8 != NULL)
+        {
+            unsigned char* write_ptr = &atlas->TexPixelsAlpha8[r->X + ((r->Y + y) * atlas->TexWidth)];
+            for (int i = 0; i < pad_left; i++)
+                *(write_ptr + i) = 0x00;
+
+            for (int i = 0; i < line_width; i++)
+                *(write_ptr + pad_left + i) = 0xFF;
+
+            for (int i = 0; i < pad_right; i++)
+                *(write_ptr + pad_left + line_width + i) = 0x00;
+        }
+        else
+        {
+            unsigned int* write_ptr = &atlas->TexPixelsRGBA32[r->X + ((r->Y + y) * atlas->TexWidth)];
+            for (int i = 0; i < pad_left; i++)
+                *(write_ptr + i) = IM_COL32(255, 255, 255, 0);
+
+            for (int i = 0; i < line_width; i++)
+                *(write_ptr + pad_left + i) = IM_COL32_WHITE;
+
+            for (int i = 0; i < pad_right; i++)
+                *(write_ptr + pad_left + line_width + i) = IM_COL32(255, 255, 255, 0);
+        }
+
+        // Calculate UVs for this line
+        ImVec2 uv0 = ImVec2((float)(r->X + pad_left - 1), (float)(r->Y + y)) * atlas->TexUvScale;
+        ImVec2 uv1 = ImVec2((float)(r->X + pad_left + line_width + 1), (float)(r->Y + y + 1)) * atlas->TexUvScale;
+        float half_v = (uv0.y + uv1.y) * 0.5f; // Calculate a constant V in the middle of the row to avoid sampling artifacts
+        atlas->TexUvLines[n] = ImVec4(uv0.x, half_v, uv1.x, half_v);
+    }
+}
+
+// Note: this is called / shared by both the stb_truetype and the FreeType builder
+void ImFontAtlasBuildInit(ImFontAtlas* atlas)
+{
+    // Register texture region for mouse cursors or standard white pixels
+    if (atlas->PackIdMouseCursors < 0)
+    {
+        if (!(atlas->Flags & ImFontAtlasFlags_NoMouseCursors))
+            atlas->PackIdMouseCursors = atlas->AddCustomRectRegular(FONT_ATLAS_DEFAULT_TEX_DATA_W * 2 + 1, FONT_ATLAS_DEFAULT_TEX_DATA_H);
+        else
+            atlas->PackIdMouseCursors = atlas->AddCustomRectRegular(2, 2);
+    }
+
+    // Register texture region for thick lines
+    // The +2 here is to give space for the end caps, whilst height +1 is to accommodate the fact we have a zero-width row
+    // (Not with signed distance fields: lines would be sampled as distances by the renderer)
+    if (atlas->PackIdLines < 0)
+    {
+        if (!(atlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SignedDistanceField)))
+            atlas->PackIdLines = atlas->AddCustomRectRegular(IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 2, IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1);
+    }
+}
+
+// This is called/shared by both the stb_truetype and the FreeType builder.
+void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
+{
+    // Render into our custom data blocks
+    IM_ASSERT(atlas->TexPixelsAlpha8 != NULL || atlas->TexPixelsRGBA32 != NULL);
+    ImFontAtlasBuildRenderDefaultTexData(atlas);
+    ImFontAtlasBuildRenderLinesTexData(atlas);
+
+    // Register custom rectangle glyphs (an incremental build only registers rectangles added since last build)
+    ImFontAtlasIncrementalData* inc = atlas->IncrementalData;
+    for (int i = inc ? inc->CustomRectsBuilt : 0; i < atlas->CustomRects.Size; i++)
+    {
+        const ImFontAtlasCustomRect* r = &atlas->CustomRects[i];
+        if (r->Font == NULL || r->GlyphID == 0)
+            continue;
+
+        // Will ignore ImFontConfig settings: GlyphMinAdvanceX, GlyphMinAdvanceY, PixelSnapH
+        IM_ASSERT(r->Font->ContainerAtlas == atlas);
+        if (inc != NULL)
+            ImFontAtlasBuildRemoveTabGlyph(r->Font);
+        ImVec2 uv0, uv1;
+        atlas->CalcCustomRectUV(r, &uv0, &uv1);
+        r->Font->AddGlyph(NULL, (ImWchar)r->GlyphID, r->GlyphOffset.x, r->GlyphOffset.y, r->GlyphOffset.x + r->Width, r->GlyphOffset.y + r->Height, uv0.x, uv0.y, uv1.x, uv1.y, r->GlyphAdvanceX);
+        if (r->GlyphColored)
+            r->Font->Glyphs.back().Colored = 1;
+    }
+
+    // Build all fonts lookup tables
+    for (ImFont* font : atlas->Fonts)
+        if (font->DirtyLookupTables)
+            font->BuildLookupTable();
+
+    // Glyphs loaded on demand use texture space below baked data
+    if (ImFontAtlasDynamicData* dyn = atlas->DynamicData)
+    {
+        int area_y = 0;
+        for (const ImFontAtlasCustomRect& r : atlas->CustomRects)
+            if (r.IsPacked())
+                area_y = ImMax(area_y, r.Y + r.Height);
+        for (ImFont* font : atlas->Fonts)
+        {
+            for (const ImFontGlyph& glyph : font->Glyphs)
+                area_y = ImMax(area_y, (int)ImCeil(glyph.V1 * atlas->TexHeight));
+            font->GlyphsLastUsedFrame.resize(font->Glyphs.Size, 0);
+        }
+        dyn->AreaY = dyn->ShelvesY = ImMin(area_y + atlas->TexGlyphPadding, atlas->TexHeight);
+        dyn->Ready = true; // Only now, as building lookup tables above may call FindGlyph()
+    }
+
+    // Next incremental build will start from here
+    if (inc != NULL)
+    {
+        inc->ConfigDataBuilt = atlas->ConfigData.Size;
+        inc->CustomRectsBuilt = atlas->CustomRects.Size;
+    }
+
+    atlas->TexReady = true;
+}
+
+// Grow texture data of an incremental build. Existing pixels keep their position: V coordinates of existing glyphs are rescaled.
+// (TexUvWhitePixel and TexUvLines[] are updated by ImFontAtlasBuildFinish())
+void ImFontAtlasBuildGrowTexHeight(ImFontAtlas* atlas, int new_height)
+{
+    const int old_height = atlas->TexHeight;
+    IM_ASSERT(atlas->TexPixelsAlpha8 != NULL && new_height > old_height);
+    const size_t old_size = (size_t)atlas->TexWidth * old_height;
+    const size_t new_size = (size_t)atlas->TexWidth * new_height;
+    unsigned char* pixels_alpha8 = (unsigned char*)IM_ALLOC(new_size);
+    memcpy(pixels_alpha8, atlas->TexPixelsAlpha8, old_size);
+    memset(pixels_alpha8 + old_size, 0, new_size - old_size);
+    IM_FREE(atlas->TexPixelsAlpha8);
+    atlas->TexPixelsAlpha8 = pixels_alpha8;
+    if (atlas->TexPixelsRGBA32 != NULL)
+    {
+        // Don't convert existing pixels again from Alpha8: user may have written colored pixels into custom rectangles
+        unsigned int* pixels_rgba32 = (unsigned int*)IM_ALLOC(new_size * 4);
+        memcpy(pixels_rgba32, atlas->TexPixelsRGBA32, old_size * 4);
+        for (size_t n = old_size; n < new_size; n++)
+            pixels_rgba32[n] = IM_COL32(255, 255, 255, 0);
+        IM_FREE(atlas->TexPixelsRGBA32);
+        atlas->TexPixelsRGBA32 = pixels_rgba32;
+    }
+
+    atlas->TexHeight = new_height;
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+    for (ImFont* font : atlas->Fonts)
+        for (ImFontGlyph& glyph : font->Glyphs)
+        {
+            glyph.V0 = ImFloor(glyph.V0 * old_height + 0.5f) * atlas->TexUvScale.y;
+            glyph.V1 = ImFloor(glyph.V1 * old_height + 0.5f) * atlas->TexUvScale.y;
+        }
+
+    // Whole texture needs to be uploaded again
+    int* r = atlas->TexUpdateRect;
+    r[0] = 0; r[1] = 0; r[2] = atlas->TexWidth; r[3] = atlas->TexHeight;
+}
+
+// Mark area as modified for GetTexDataUpdateRect(), and update RGBA32 pixels if they were converted from Alpha8.
+void ImFontAtlasBuildUpdateTexRect(ImFontAtlas* atlas, int x, int y, int w, int h)
+{
+    int* r = atlas->TexUpdateRect;
+    if (r[2] <= r[0])
+    {
+        r[0] = x; r[1] = y; r[2] = x + w; r[3] = y + h;
+    }
+    else
+    {
+        r[0] = ImMin(r[0], x); r[1] = ImMin(r[1], y); r[2] = ImMax(r[2], x + w); r[3] = ImMax(r[3], y + h);
+    }
+    if (atlas->TexPixelsAlpha8 != NULL && atlas->TexPixelsRGBA32 != NULL)
+        for (int j = y; j < y + h; j++)
+        {
+            const unsigned char* src = atlas->TexPixelsAlpha8 + (size_t)j * atlas->TexWidth + x;
+            unsigned int* dst = atlas->TexPixelsRGBA32 + (size_t)j * atlas->TexWidth + x;
+            for (int i = w; i > 0; i--)
+                *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+        }
+}
+
+void ImFontAtlasIncrementalDestroy(ImFontAtlas* atlas)
+{
+    ImFontAtlasIncrementalData* inc = atlas->IncrementalData;
+    if (inc == NULL)
+        return;
+    IM_FREE(inc->PackContext);
+    IM_FREE(inc->PackNodes);
+    IM_DELETE(inc);
+    atlas->IncrementalData = NULL;
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] ImFontAtlas: glyphs loaded on demand
+//-------------------------------------------------------------------------
+// With ImFontAtlasFlags_DynamicGlyphs, Build() only bakes a few glyphs (see ImFontAtlasBuildIsPreloadedGlyph()).
+// The other glyphs are rasterized by the font builder into free texture space when first looked up by ImFont::FindGlyph()
+// or ImFont::GetCharAdvance(). Free space is organized as shelves (horizontal bands filled from left to right) below baked data.
+// When the texture is full, the least recently rendered glyph with a large enough rectangle is evicted, as long as it wasn't
+// rendered during the current frame. Evicted glyphs are removed from Glyphs[] and lookup tables, and will be loaded again when needed.
+// Glyphs used by a replayed ImDrawListFragment count as rendered (see ImDrawList::AddFragment()).
+//-------------------------------------------------------------------------
+// - ImFontAtlasBuildIsPreloadedGlyph()
+// - ImFontAtlasBuildIsInGlyphRanges()
+// - ImFontAtlasDynamicAllocRect()
+// - ImFontAtlasDynamicAddGlyph()
+// - ImFontAtlasDynamicLoadGlyph()
+// - ImFontAtlasDynamicUpdateState()
+// - ImFontAtlasDynamicLoadRequests()
+// - ImFontAtlasDynamicDestroy()
+//-------------------------------------------------------------------------
+
+// Glyphs baked by Build(): ASCII, and candidates used by ImFont::BuildLookupTable() for fallback/ellipsis.
+bool ImFontAtlasBuildIsPreloadedGlyph(const ImFontConfig* cfg, unsigned int codepoint)
+{
+    if (codepoint < 0x80 || codepoint == IM_UNICODE_CODEPOINT_INVALID || codepoint == 0x2026 || codepoint == 0x0085 || codepoint == 0xFF0E)
+        return true;
+    if (cfg->EllipsisChar != 0 && codepoint == cfg->EllipsisChar)
+        return true;
+    if (cfg->DstFont != NULL && cfg->DstFont->FallbackChar != 0 && codepoint == cfg->DstFont->FallbackChar)
+        return true;
+    return false;
+}
+
+bool ImFontAtlasBuildIsInGlyphRanges(ImFontAtlas* atlas, const ImFontConfig* cfg, unsigned int codepoint)
+{
+    for (const ImWchar* range = cfg->GlyphRanges ? cfg->GlyphRanges : atlas->GetGlyphRangesDefault(); range[0] && range[1]; range += 2)
+        if (codepoint >= range[0] && codepoint <= range[1])
+            return true;
+    return false;
+}
+
+static void ImFontAtlasDynamicEvictSlot(ImFontAtlas* atlas, ImFontAtlasDynamicSlot* slot)
+{
+    ImFontAtlasDynamicData* dyn = atlas->DynamicData;
+    if (ImFont* font = slot->Font)
+    {
+        // Remove from lookup tables: next lookup will load the glyph again
+        const int index_slot = font->GetIndexSlot(slot->Codepoint);
+        font->IndexLookup[index_slot] = (ImU16)-1;
+        font->IndexAdvanceX[index_slot] = -1.0f;
+
+        // Remove from Glyphs[], moving last glyph into its place
+        const int glyph_idx = slot->GlyphIndex;
+        const int last_idx = font->Glyphs.Size - 1;
+        if (glyph_idx != last_idx)
+        {
+            ImFontGlyph* last_glyph = &font->Glyphs.Data[last_idx];
+            font->Glyphs.Data[glyph_idx] = *last_glyph;
+            font->GlyphsLastUsedFrame.Data[glyph_idx] = font->GlyphsLastUsedFrame.Data[last_idx];
+            const int last_index_slot = font->GetIndexSlot((ImWchar)last_glyph->Codepoint);
+            if (last_index_slot >= 0 && font->IndexLookup.Data[last_index_slot] == (ImU16)last_idx)
+                font->IndexLookup.Data[last_index_slot] = (ImU16)glyph_idx;
+            if (font->FallbackGlyph == last_glyph)
+                font->FallbackGlyph = &font->Glyphs.Data[glyph_idx];
+            for (ImFontAtlasDynamicSlot& other_slot : dyn->Slots)
+                if (other_slot.Font == font && other_slot.GlyphIndex == last_idx)
+                    other_slot.GlyphIndex = glyph_idx;
+        }
+        font->Glyphs.pop_back();
+        font->GlyphsLastUsedFrame.pop_back();
+        slot->Font = NULL;
+        dyn->GlyphsEvicted++;
+    }
+
+    // Clear pixels
+    for (int j = slot->Y; j < slot->Y + slot->H; j++)
+    {
+        if (atlas->TexPixelsAlpha8 != NULL)
+            memset(atlas->TexPixelsAlpha8 + (size_t)j * atlas->TexWidth + slot->X, 0, slot->W);
+        else if (atlas->TexPixelsRGBA32 != NULL)
+            memset(atlas->TexPixelsRGBA32 + (size_t)j * atlas->TexWidth + slot->X, 0, (size_t)slot->W * 4);
+    }
+    ImFontAtlasBuildUpdateTexRect(atlas, slot->X, slot->Y, slot->W, slot->H);
+}
+
+// Return index into DynamicData->Slots[] of a free rectangle of at least w*h pixels (including padding), or -1 if the texture is full.
+int ImFontAtlasDynamicAllocRect(ImFontAtlas* atlas, int w, int h)
+{
+    ImFontAtlasDynamicData* dyn = atlas->DynamicData;
+    IM_ASSERT(dyn != NULL && w > 0 && h > 0);
+    if (dyn->FullFrame == dyn->FrameCount && w >= dyn->FullW && h >= dyn->FullH)
+    {
+        dyn->AllocFailed = true;
+        return -1;
+    }
+
+    // Find the lowest shelf with enough room, or open a new one
+    ImFontAtlasDynamicShelf* shelf = NULL;
+    for (ImFontAtlasDynamicShelf& it : dyn->Shelves)
+        if (it.H >= h && it.X + w <= atlas->TexWidth && (shelf == NULL || it.H < shelf->H))
+            shelf = &it;
+    if (shelf == NULL && w <= atlas->TexWidth && dyn->ShelvesY + h <= atlas->TexHeight)
+    {
+        ImFontAtlasDynamicShelf new_shelf;
+        new_shelf.X = 0;
+        new_shelf.Y = dyn->ShelvesY;
+        new_shelf.H = ImMin((h + 7) & ~7, atlas->TexHeight - dyn->ShelvesY); // Round height so glyphs of similar sizes can share a shelf
+        dyn->ShelvesY += new_shelf.H;
+        dyn->Shelves.push_back(new_shelf);
+        shelf = &dyn->Shelves.back();
+    }
+    if (shelf != NULL)
+    {
+        ImFontAtlasDynamicSlot slot = {};
+        slot.X = (unsigned short)shelf->X;
+        slot.Y = (unsigned short)shelf->Y;
+        slot.W = (unsigned short)w;
+        slot.H = (unsigned short)shelf->H;
+        shelf->X += w;
+        dyn->Slots.push_back(slot);
+        return dyn->Slots.Size - 1;
+    }
+
+    // Texture is full: evict least recently used glyph with a large enough rectangle, preferring smaller rectangles.
+    // Glyphs rendered during the current frame are never evicted. Nothing is evicted while loading is locked,
+    // as a detached draw list may have recorded vertices using any glyph.
+    if (!dyn->LoadingLocked)
+    {
+        int best_n = -1;
+        int best_frame = INT_MAX;
+        int best_area = INT_MAX;
+        for (int slot_n = 0; slot_n < dyn->Slots.Size; slot_n++)
+        {
+            const ImFontAtlasDynamicSlot& slot = dyn->Slots[slot_n];
+            if (slot.W < w || slot.H < h)
+                continue;
+            const int last_used_frame = slot.Font ? slot.Font->GlyphsLastUsedFrame[slot.GlyphIndex] : -1;
+            const int area = slot.W * slot.H;
+            if (last_used_frame >= dyn->FrameCount || last_used_frame > best_frame || (last_used_frame == best_frame && area >= best_area))
+                continue;
+            best_n = slot_n;
+            best_frame = last_used_frame;
+            best_area = area;
+        }
+        if (best_n != -1)
+        {
+            ImFontAtlasDynamicEvictSlot(atlas, &dyn->Slots[best_n]);
+            return best_n;
+        }
+
+        // No single rectangle is large enough (e.g. a wide glyph among narrow ones): evict a whole shelf and reuse it from the left.
+        int best_shelf_n = -1;
+        best_frame = INT_MAX;
+        for (int shelf_n = 0; shelf_n < dyn->Shelves.Size; shelf_n++)
+        {
+            const ImFontAtlasDynamicShelf& it = dyn->Shelves[shelf_n];
+            if (it.H < h || w > atlas->TexWidth)
+                continue;
+            int shelf_last_used_frame = -1;
+            for (const ImFontAtlasDynamicSlot& slot : dyn->Slots)
+                if (slot.Y == it.Y && slot.Font != NULL)
+                    shelf_last_used_frame = ImMax(shelf_last_used_frame, slot.Font->GlyphsLastUsedFrame[slot.GlyphIndex]);
+            if (shelf_last_used_frame >= dyn->FrameCount || shelf_last_used_frame >= best_frame)
+                continue;
+            best_shelf_n = shelf_n;
+            best_frame = shelf_last_used_frame;
+        }
+        if (best_shelf_n != -1)
+        {
+            shelf = &dyn->Shelves[best_shelf_n];
+            for (int slot_n = 0; slot_n < dyn->Slots.Size; slot_n++)
+                if (dyn->Slots[slot_n].Y == shelf->Y)
+                {
+                    ImFontAtlasDynamicEvictSlot(atlas, &dyn->Slots[slot_n]);
+                    dyn->Slots.erase(&dyn->Slots[slot_n--]);
+                }
+            ImFontAtlasDynamicSlot slot = {};
+            slot.X = 0;
+            slot.Y = (unsigned short)shelf->Y;
+            slot.W = (unsigned short)w;
+            slot.H = (unsigned short)shelf->H;
+            shelf->X = w;
+            dyn->Slots.push_back(slot);
+            return dyn->Slots.Size - 1;
+        }
+    }
+
+    dyn->AllocFailed = true;
+    if (dyn->FullFrame != dyn->FrameCount || (w <= dyn->FullW && h <= dyn->FullH))
+    {
+        dyn->FullFrame = dyn->FrameCount;
+        dyn->FullW = w;
+        dyn->FullH = h;
+    }
+    return -1;
+}
+
+// Register glyph rendered by the font builder into a slot from ImFontAtlasDynamicAllocRect() (slot_n == -1 for empty glyphs)
+ImFontGlyph* ImFontAtlasDynamicAddGlyph(ImFontAtlas* atlas, int slot_n, ImFont* font, const ImFontConfig* src_cfg, ImWchar codepoint, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x)
+{
+    ImFontAtlasDynamicData* dyn = atlas->DynamicData;
+
+    // Add glyph. Adding may reallocate Glyphs[].
+    const int fallback_glyph_idx = font->FallbackGlyph ? (int)(font->FallbackGlyph - font->Glyphs.Data) : -1;
+    font->AddGlyph(src_cfg, codepoint, x0, y0, x1, y1, u0, v0, u1, v1, advance_x);
+    font->DirtyLookupTables = false; // Lookup tables are updated below
+    const int glyph_idx = font->Glyphs.Size - 1;
+    if (fallback_glyph_idx != -1)
+        font->FallbackGlyph = &font->Glyphs.Data[fallback_glyph_idx];
+    font->GlyphsLastUsedFrame.resize(font->Glyphs.Size, 0);
+    font->GlyphsLastUsedFrame[glyph_idx] = dyn->FrameCount;
+
+    // Update lookup tables
+    const int index_slot = font->AllocIndexSlot(codepoint);
+    font->IndexAdvanceX[index_slot] = font->Glyphs[glyph_idx].AdvanceX;
+    font->IndexLookup[index_slot] = (ImU16)glyph_idx;
+    const int page_n = codepoint / 8192;
+    font->Used8kPagesMap[page_n >> 3] |= 1 << (page_n & 7);
+
+    if (slot_n != -1)
+    {
+        ImFontAtlasDynamicSlot& slot = dyn->Slots[slot_n];
+        slot.Font = font;
+        slot.Codepoint = codepoint;
+        slot.GlyphIndex = glyph_idx;
+        ImFontAtlasBuildUpdateTexRect(atlas, slot.X, slot.Y, slot.W, slot.H);
+    }
+    dyn->GlyphsLoaded++;
+    return &font->Glyphs[glyph_idx];
+}
+
+static ImFontGlyph* ImFontAtlasDynamicLoadGlyphEx(ImFontAtlas* atlas, ImFont* font, ImWchar codepoint)
+{
+    ImFontAtlasDynamicData* dyn = atlas->DynamicData;
+    if (atlas->TexPixelsAlpha8 == NULL && atlas->TexPixelsRGBA32 == NULL) // ClearTexData() was called
+        return NULL;
+
+    dyn->AllocFailed = false;
+    if (dyn->BuilderIO->FontBuilder_LoadGlyph(atlas, font, codepoint))
+        return font->FindGlyphNoFallback(codepoint);
+    if (dyn->AllocFailed)
+        return NULL;
+
+    // Not provided by any source: remember it so we don't search again.
+    // Don't allocate lookup pages for codepoints outside of requested ranges (e.g. random data), they will be searched again.
+    const int index_slot = font->GetIndexSlot(codepoint);
+    bool in_ranges = (index_slot >= IM_FONT_INDEX_PAGE_SIZE); // Page already allocated
+    for (int cfg_n = 0; cfg_n < font->ConfigDataCount && !in_ranges; cfg_n++)
+        in_ranges = ImFontAtlasBuildIsInGlyphRanges(atlas, &font->ConfigData[cfg_n], codepoint);
+    if (in_ranges)
+        font->IndexAdvanceX[font->AllocIndexSlot(codepoint)] = font->FallbackAdvanceX;
+    return NULL;
+}
+
+// Called on lookup misses: return NULL if glyph is known to be missing or can't be loaded now.
+ImFontGlyph* ImFontAtlasDynamicLoadGlyph(ImFontAtlas* atlas, ImFont* font, ImWchar codepoint)
+{
+    ImFontAtlasDynamicData* dyn = atlas->DynamicData;
+    if (dyn == NULL || !dyn->Ready || dyn->LoadingLocked || font->ConfigDataCount == 0)
+        return NULL;
+    const int index_slot = font->GetIndexSlot(codepoint);
+    if (index_slot >= 0 && font->IndexAdvanceX.Data[index_slot] >= 0.0f) // Known to be missing
+        return NULL;
+    return ImFontAtlasDynamicLoadGlyphEx(atlas, font, codepoint);
+}
+
+void ImFontAtlasDynamicUpdateState(ImFontAtlas* atlas, int frame_count, bool loading_locked)
+{
+    // Detached draw lists may be reading those while recording: only write on change.
+    if (ImFontAtlasDynamicData* dyn = atlas->DynamicData)
+    {
+        if (dyn->FrameCount != frame_count)
+            dyn->FrameCount = frame_count;
+        if (dyn->LoadingLocked != loading_locked)
+            dyn->LoadingLocked = loading_locked;
+    }
+}
+
+// Load glyphs missed while loading was locked. This only uses free texture space when loading is still locked.
+void ImFontAtlasDynamicLoadRequests(ImFontAtlas* atlas, ImVector<ImFontGlyphRequest>* requests)
+{
+    ImFontAtlasDynamicData* dyn = atlas->DynamicData;
+    if (dyn != NULL && dyn->Ready)
+        for (const ImFontGlyphRequest& req : *requests)
+        {
+            // Fonts may have been destroyed since the request was recorded
+            if (!atlas->Fonts.contains(req.Font) || req.Font->ConfigDataCount == 0)
+                continue;
+            ImFont* font = req.Font;
+            const int index_slot = font->GetIndexSlot(req.Codepoint);
+            if (index_slot >= 0 && font->IndexAdvanceX.Data[index_slot] >= 0.0f) // Loaded or known to be missing
+                continue;
+            if (ImFontAtlasDynamicLoadGlyphEx(atlas, font, req.Codepoint) != NULL)
+                dyn->GlyphsRequested++;
         }
-    }
-    atlas->TexUvWhitePixel = ImVec2((r->X + 0.5f) * atlas->TexUvScale.x, (r->Y + 0.5f) * atlas->TexUvScale.y);
+    requests->resize(0);
 }
 
-static void ImFontAtlasBuildRenderLinesTexData(ImFontAtlas* atlas)
+void ImFontAtlasDynamicDestroy(ImFontAtlas* atlas)
 {
-    if (atlas->Flags & ImFontAtlasFlags_NoBakedLines)
+    ImFontAtlasDynamicData* dyn = atlas->DynamicData;
+    if (dyn == NULL)
         return;
+    if (dyn->BuilderData != NULL && dyn->BuilderIO->FontBuilder_DestroyData != NULL)
+        dyn->BuilderIO->FontBuilder_DestroyData(atlas);
+    for (ImFont* font : atlas->Fonts)
+        font->GlyphsLastUsedFrame.clear();
+    IM_DELETE(dyn);
+    atlas->DynamicData = NULL;
+}
 
-    // This generates a triangular shape in the texture, with the various line widths stacked on top of each other to allow interpolation between them
-    ImFontAtlasCustomRect* r = atlas->GetCustomRectByIndex(atlas->PackIdLines);
-    IM_ASSERT(r->IsPacked());
-    for (int n = 0; n < IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1; n++) // +1 because of the zero-width row
-    {
-        // Each line consists of at least two empty pixels at the ends, with a line of solid pixels in the middle
-        int y = n;
-        int line_width = n;
-        int pad_left = (r->Width - line_width) / 2;
-        int pad_right = r->Width - (pad_left + line_width);
+//-------------------------------------------------------------------------
+// [SECTION] ImFontAtlas: cache of built data
+//-------------------------------------------------------------------------
+// When ImFontAtlas::CacheFilename is set, Build() stores the builder output (texture, glyphs, lookup tables, custom rectangles
+// positions) into a file, and restores it instead of building when the 64-bit hash of all inputs matches (font data, ImFontConfig
+// settings, glyph ranges, custom rectangles, atlas settings, builder name and version, Dear ImGui version).
+// Data is stored in native endianness and layout: a cache file is not meant to be shared across platforms.
+//-------------------------------------------------------------------------
+// - ImFontAtlasBuildCacheHashInputs()
+// - ImFontAtlasBuildCacheSaveToMemory()
+// - ImFontAtlasBuildCacheLoadFromMemory()
+// - ImFontAtlasBuildCacheSaveToFile()
+// - ImFontAtlasBuildCacheLoadFromFile()
+//-------------------------------------------------------------------------
 
-        // Write each slice
-        IM_ASSERT(pad_left + line_width + pad_right == r->Width && y < r->Height); // Make sure we're inside the texture bounds before we start writing pixels
-        if (atlas->TexPixelsAlpha8 != NULL)
-        {
-            unsigned char* write_ptr = &atlas->TexPixelsAlpha8[r->X + ((r->Y + y) * atlas->TexWidth)];
-            for (int i = 0; i < pad_left; i++)
-                *(write_ptr + i) = 0x00;
+#define IM_FONT_ATLAS_CACHE_VERSION 3
 
-            for (int i = 0; i < line_width; i++)
-                *(write_ptr + pad_left + i) = 0xFF;
+struct ImFontAtlasCacheHeader
+{
+    char        Magic[4];           // "IMFC"
+    int         Version;            // IM_FONT_ATLAS_CACHE_VERSION
+    int         SizeofGlyph;        // sizeof(ImFontGlyph)
+    int         SizeofWchar;        // sizeof(ImWchar)
+    ImU64       InputsHash;         // ImFontAtlasBuildCacheHashInputs()
+    ImU64       DataHash;           // Checksum of all data following the header
+    ImU64       DataSize;
+};
 
-            for (int i = 0; i < pad_right; i++)
-                *(write_ptr + pad_left + line_width + i) = 0x00;
-        }
-        else
-        {
-            unsigned int* write_ptr = &atlas->TexPixelsRGBA32[r->X + ((r->Y + y) * atlas->TexWidth)];
-            for (int i = 0; i < pad_left; i++)
-                *(write_ptr + i) = IM_COL32(255, 255, 255, 0);
+struct ImFontAtlasCacheAtlasData
+{
+    int         TexWidth, TexHeight;
+    int         TexBytesPerPixel;   // 1: TexPixelsAlpha8, 4: TexPixelsRGBA32
+    int         TexPixelsUseColors;
+    ImVec2      TexUvWhitePixel;
+    ImVec4      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+    int         CustomRectsCount;
+    int         FontsCount;
+};
 
-            for (int i = 0; i < line_width; i++)
-                *(write_ptr + pad_left + i) = IM_COL32_WHITE;
+struct ImFontAtlasCacheFontData
+{
+    float       FontSize;
+    float       Ascent, Descent;
+    float       FallbackAdvanceX;
+    float       EllipsisWidth;
+    float       EllipsisCharStep;
+    int         EllipsisCharCount;
+    ImU32       EllipsisChar;
+    ImU32       FallbackChar;
+    int         FallbackGlyphIndex; // -1 when no fallback glyph
+    int         MetricsTotalSurface;
+    int         GlyphsCount;        // Followed by GlyphsCount * ImFontGlyph
+    int         IndexPagesCount;    // Followed by IndexPagesCount * ImU16 (IndexPages)
+    int         IndexCount;         // Followed by IndexCount * float (IndexAdvanceX), IndexCount * ImU16 (IndexLookup)
+    ImU8        Used8kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/8192/8];
+};
 
-            for (int i = 0; i < pad_right; i++)
-                *(write_ptr + pad_left + line_width + i) = IM_COL32(255, 255, 255, 0);
-        }
+// Settings of ImFontConfig affecting builder output (copied so padding bytes are zero)
+struct ImFontAtlasCacheConfigData
+{
+    int         FontDataSize;
+    int         FontNo;
+    int         MergeMode, PixelSnapH;
+    int         OversampleH, OversampleV;
+    float       SizePixels;
+    ImVec2      GlyphOffset;
+    float       GlyphMinAdvanceX, GlyphMaxAdvanceX, GlyphExtraAdvanceX;
+    unsigned int FontBuilderFlags;
+    float       RasterizerMultiply, RasterizerDensity;
+    ImU32       EllipsisChar;
+    int         DstFontIndex;
+};
 
-        // Calculate UVs for this line
-        ImVec2 uv0 = ImVec2((float)(r->X + pad_left - 1), (float)(r->Y + y)) * atlas->TexUvScale;
-        ImVec2 uv1 = ImVec2((float)(r->X + pad_left + line_width + 1), (float)(r->Y + y + 1)) * atlas->TexUvScale;
-        float half_v = (uv0.y + uv1.y) * 0.5f; // Calculate a constant V in the middle of the row to avoid sampling artifacts
-        atlas->TexUvLines[n] = ImVec4(uv0.x, half_v, uv1.x, half_v);
+struct ImFontAtlasCacheCustomRectData
+{
+    int         Width, Height;
+    ImU32       GlyphID;
+    int         GlyphColored;
+    float       GlyphAdvanceX;
+    ImVec2      GlyphOffset;
+    int         FontIndex;
+};
+
+// Strings are hashed with their zero terminator, so e.g. builder name and version can't be confused
+ImU64 ImFontAtlasBuildCacheHashInputs(ImFontAtlas* atlas, const ImFontBuilderIO* builder_io)
+{
+    IM_ASSERT(builder_io->FontBuilder_Name != NULL);
+    const char* builder_version = builder_io->FontBuilder_Version ? builder_io->FontBuilder_Version : "";
+    ImU64 hash = ImHashContent(IMGUI_VERSION, strlen(IMGUI_VERSION) + 1, 0);
+    hash = ImHashContent(builder_io->FontBuilder_Name, strlen(builder_io->FontBuilder_Name) + 1, hash);
+    hash = ImHashContent(builder_version, strlen(builder_version) + 1, hash);
+    int atlas_settings[6] = { (int)atlas->Flags, atlas->TexDesiredWidth, atlas->TexGlyphPadding, atlas->TexSdfSpread, (int)atlas->FontBuilderFlags, atlas->Fonts.Size };
+    hash = ImHashContent(atlas_settings, sizeof(atlas_settings), hash);
+    for (const ImFontConfig& cfg : atlas->ConfigData)
+    {
+        ImFontAtlasCacheConfigData data;
+        memset(&data, 0, sizeof(data));
+        data.FontDataSize = cfg.FontDataSize;
+        data.FontNo = cfg.FontNo;
+        data.MergeMode = cfg.MergeMode;
+        data.PixelSnapH = cfg.PixelSnapH;
+        data.OversampleH = cfg.OversampleH;
+        data.OversampleV = cfg.OversampleV;
+        data.SizePixels = cfg.SizePixels;
+        data.GlyphOffset = cfg.GlyphOffset;
+        data.GlyphMinAdvanceX = cfg.GlyphMinAdvanceX;
+        data.GlyphMaxAdvanceX = cfg.GlyphMaxAdvanceX;
+        data.GlyphExtraAdvanceX = cfg.GlyphExtraAdvanceX;
+        data.FontBuilderFlags = cfg.FontBuilderFlags;
+        data.RasterizerMultiply = cfg.RasterizerMultiply;
+        data.RasterizerDensity = cfg.RasterizerDensity;
+        data.EllipsisChar = cfg.EllipsisChar;
+        data.DstFontIndex = atlas->Fonts.index_from_ptr(atlas->Fonts.find(cfg.DstFont));
+        hash = ImHashContent(&data, sizeof(data), hash);
+        hash = ImHashContent(cfg.FontData, (size_t)cfg.FontDataSize, hash);
+        const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
+        int ranges_count = 0;
+        while (ranges[ranges_count] != 0)
+            ranges_count++;
+        hash = ImHashContent(ranges, sizeof(ImWchar) * ranges_count, hash);
     }
+    for (const ImFontAtlasCustomRect& r : atlas->CustomRects)
+    {
+        ImFontAtlasCacheCustomRectData data;
+        memset(&data, 0, sizeof(data));
+        data.Width = r.Width;
+        data.Height = r.Height;
+        data.GlyphID = r.GlyphID;
+        data.GlyphColored = r.GlyphColored;
+        data.GlyphAdvanceX = r.GlyphAdvanceX;
+        data.GlyphOffset = r.GlyphOffset;
+        data.FontIndex = r.Font ? atlas->Fonts.index_from_ptr(atlas->Fonts.find(r.Font)) : -1;
+        hash = ImHashContent(&data, sizeof(data), hash);
+    }
+    return hash;
 }
 
-// Note: this is called / shared by both the stb_truetype and the FreeType builder
-void ImFontAtlasBuildInit(ImFontAtlas* atlas)
+static void ImFontAtlasCacheWrite(ImVector<char>* buf, const void* data, size_t size)
 {
-    // Register texture region for mouse cursors or standard white pixels
-    if (atlas->PackIdMouseCursors < 0)
+    const int offset = buf->Size;
+    buf->resize(buf->Size + (int)size);
+    memcpy(buf->Data + offset, data, size);
+}
+
+static bool ImFontAtlasCacheRead(const char** p, const char* p_end, void* dst, size_t size)
+{
+    if ((size_t)(p_end - *p) < size)
+        return false;
+    memcpy(dst, *p, size);
+    *p += size;
+    return true;
+}
+
+// Return pointer to 'count' elements of 'size' bytes and advance, or NULL if data is truncated.
+static const char* ImFontAtlasCacheSkip(const char** p, const char* p_end, int count, size_t size)
+{
+    if (count < 0 || (size_t)(p_end - *p) / size < (size_t)count)
+        return NULL;
+    const char* data = *p;
+    *p += (size_t)count * size;
+    return data;
+}
+
+// Serialize output of a successful Build()
+void ImFontAtlasBuildCacheSaveToMemory(ImFontAtlas* atlas, ImU64 inputs_hash, ImVector<char>* out_buf)
+{
+    IM_ASSERT(atlas->TexReady && (atlas->TexPixelsAlpha8 != NULL || atlas->TexPixelsRGBA32 != NULL));
+    out_buf->resize(0);
+
+    ImFontAtlasCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, "IMFC", 4);
+    header.Version = IM_FONT_ATLAS_CACHE_VERSION;
+    header.SizeofGlyph = (int)sizeof(ImFontGlyph);
+    header.SizeofWchar = (int)sizeof(ImWchar);
+    header.InputsHash = inputs_hash;
+    ImFontAtlasCacheWrite(out_buf, &header, sizeof(header));
+
+    ImFontAtlasCacheAtlasData atlas_data;
+    memset(&atlas_data, 0, sizeof(atlas_data));
+    atlas_data.TexWidth = atlas->TexWidth;
+    atlas_data.TexHeight = atlas->TexHeight;
+    atlas_data.TexBytesPerPixel = atlas->TexPixelsAlpha8 ? 1 : 4;
+    atlas_data.TexPixelsUseColors = atlas->TexPixelsUseColors;
+    atlas_data.TexUvWhitePixel = atlas->TexUvWhitePixel;
+    memcpy(atlas_data.TexUvLines, atlas->TexUvLines, sizeof(atlas_data.TexUvLines));
+    atlas_data.CustomRectsCount = atlas->CustomRects.Size;
+    atlas_data.FontsCount = atlas->Fonts.Size;
+    ImFontAtlasCacheWrite(out_buf, &atlas_data, sizeof(atlas_data));
+    for (const ImFontAtlasCustomRect& r : atlas->CustomRects)
     {
-        if (!(atlas->Flags & ImFontAtlasFlags_NoMouseCursors))
-            atlas->PackIdMouseCursors = atlas->AddCustomRectRegular(FONT_ATLAS_DEFAULT_TEX_DATA_W * 2 + 1, FONT_ATLAS_DEFAULT_TEX_DATA_H);
-        else
-            atlas->PackIdMouseCursors = atlas->AddCustomRectRegular(2, 2);
+        const unsigned short pos[2] = { r.X, r.Y };
+        ImFontAtlasCacheWrite(out_buf, pos, sizeof(pos));
     }
 
-    // Register texture region for thick lines
-    // The +2 here is to give space for the end caps, whilst height +1 is to accommodate the fact we have a zero-width row
-    if (atlas->PackIdLines < 0)
+    for (ImFont* font : atlas->Fonts)
     {
-        if (!(atlas->Flags & ImFontAtlasFlags_NoBakedLines))
-            atlas->PackIdLines = atlas->AddCustomRectRegular(IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 2, IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1);
+        ImFontAtlasCacheFontData font_data;
+        memset(&font_data, 0, sizeof(font_data));
+        font_data.FontSize = font->FontSize;
+        font_data.Ascent = font->Ascent;
+        font_data.Descent = font->Descent;
+        font_data.FallbackAdvanceX = font->FallbackAdvanceX;
+        font_data.EllipsisWidth = font->EllipsisWidth;
+        font_data.EllipsisCharStep = font->EllipsisCharStep;
+        font_data.EllipsisCharCount = font->EllipsisCharCount;
+        font_data.EllipsisChar = font->EllipsisChar;
+        font_data.FallbackChar = font->FallbackChar;
+        font_data.FallbackGlyphIndex = font->FallbackGlyph ? font->Glyphs.index_from_ptr(font->FallbackGlyph) : -1;
+        font_data.MetricsTotalSurface = font->MetricsTotalSurface;
+        font_data.GlyphsCount = font->Glyphs.Size;
+        font_data.IndexPagesCount = font->IndexPages.Size;
+        font_data.IndexCount = font->IndexLookup.Size;
+        IM_ASSERT(font->IndexAdvanceX.Size == font->IndexLookup.Size);
+        memcpy(font_data.Used8kPagesMap, font->Used8kPagesMap, sizeof(font_data.Used8kPagesMap));
+        ImFontAtlasCacheWrite(out_buf, &font_data, sizeof(font_data));
+        ImFontAtlasCacheWrite(out_buf, font->Glyphs.Data, (size_t)font->Glyphs.size_in_bytes());
+        ImFontAtlasCacheWrite(out_buf, font->IndexPages.Data, (size_t)font->IndexPages.size_in_bytes());
+        ImFontAtlasCacheWrite(out_buf, font->IndexAdvanceX.Data, (size_t)font->IndexAdvanceX.size_in_bytes());
+        ImFontAtlasCacheWrite(out_buf, font->IndexLookup.Data, (size_t)font->IndexLookup.size_in_bytes());
     }
+
+    if (atlas->TexPixelsAlpha8 != NULL)
+        ImFontAtlasCacheWrite(out_buf, atlas->TexPixelsAlpha8, (size_t)atlas->TexWidth * atlas->TexHeight);
+    else
+        ImFontAtlasCacheWrite(out_buf, atlas->TexPixelsRGBA32, (size_t)atlas->TexWidth * atlas->TexHeight * 4);
+
+    // Finalize header
+    ImFontAtlasCacheHeader* out_header = (ImFontAtlasCacheHeader*)(void*)out_buf->Data;
+    out_header->DataSize = (ImU64)(out_buf->Size - (int)sizeof(header));
+    out_header->DataHash = ImHashContent(out_buf->Data + sizeof(header), (size_t)out_header->DataSize, 0);
 }
 
-// This is called/shared by both the stb_truetype and the FreeType builder.
-void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
+// Restore output of Build() if 'data' is valid and was created with same inputs. Atlas is left untouched on failure.
+bool ImFontAtlasBuildCacheLoadFromMemory(ImFontAtlas* atlas, ImU64 inputs_hash, const void* data, size_t data_size)
 {
-    // Render into our custom data blocks
-    IM_ASSERT(atlas->TexPixelsAlpha8 != NULL || atlas->TexPixelsRGBA32 != NULL);
-    ImFontAtlasBuildRenderDefaultTexData(atlas);
-    ImFontAtlasBuildRenderLinesTexData(atlas);
+    const char* p = (const char*)data;
+    const char* p_end = p + data_size;
 
-    // Register custom rectangle glyphs
-    for (int i = 0; i < atlas->CustomRects.Size; i++)
-    {
-        const ImFontAtlasCustomRect* r = &atlas->CustomRects[i];
-        if (r->Font == NULL || r->GlyphID == 0)
-            continue;
+    // Validate header and checksum
+    ImFontAtlasCacheHeader header;
+    if (!ImFontAtlasCacheRead(&p, p_end, &header, sizeof(header)))
+        return false;
+    if (memcmp(header.Magic, "IMFC", 4) != 0 || header.Version != IM_FONT_ATLAS_CACHE_VERSION || header.SizeofGlyph != (int)sizeof(ImFontGlyph) || header.SizeofWchar != (int)sizeof(ImWchar))
+        return false;
+    if (header.InputsHash != inputs_hash || header.DataSize != (ImU64)(p_end - p) || header.DataHash != ImHashContent(p, (size_t)header.DataSize, 0))
+        return false;
 
-        // Will ignore ImFontConfig settings: GlyphMinAdvanceX, GlyphMinAdvanceY, PixelSnapH
-        IM_ASSERT(r->Font->ContainerAtlas == atlas);
-        ImVec2 uv0, uv1;
-        atlas->CalcCustomRectUV(r, &uv0, &uv1);
-        r->Font->AddGlyph(NULL, (ImWchar)r->GlyphID, r->GlyphOffset.x, r->GlyphOffset.y, r->GlyphOffset.x + r->Width, r->GlyphOffset.y + r->Height, uv0.x, uv0.y, uv1.x, uv1.y, r->GlyphAdvanceX);
-        if (r->GlyphColored)
-            r->Font->Glyphs.back().Colored = 1;
+    // Validate contents before modifying anything
+    ImFontAtlasCacheAtlasData atlas_data;
+    if (!ImFontAtlasCacheRead(&p, p_end, &atlas_data, sizeof(atlas_data)))
+        return false;
+    if (atlas_data.CustomRectsCount != atlas->CustomRects.Size || atlas_data.FontsCount != atlas->Fonts.Size)
+        return false;
+    if (atlas_data.TexWidth <= 0 || atlas_data.TexHeight <= 0 || atlas_data.TexWidth > 0x8000 || atlas_data.TexHeight > 0x8000 || (atlas_data.TexBytesPerPixel != 1 && atlas_data.TexBytesPerPixel != 4))
+        return false;
+    const char* custom_rects_pos = ImFontAtlasCacheSkip(&p, p_end, atlas_data.CustomRectsCount, sizeof(unsigned short) * 2);
+    if (custom_rects_pos == NULL)
+        return false;
+    ImVector<const char*> fonts_data;
+    for (int font_n = 0; font_n < atlas_data.FontsCount; font_n++)
+    {
+        ImFontAtlasCacheFontData font_data;
+        fonts_data.push_back(p);
+        if (!ImFontAtlasCacheRead(&p, p_end, &font_data, sizeof(font_data)))
+            return false;
+        if (font_data.FallbackGlyphIndex < -1 || font_data.FallbackGlyphIndex >= font_data.GlyphsCount)
+            return false;
+        if (font_data.IndexPagesCount > ((IM_UNICODE_CODEPOINT_MAX + 1) >> IM_FONT_INDEX_PAGE_SHIFT) || font_data.IndexCount > IM_UNICODE_CODEPOINT_MAX + 1 + IM_FONT_INDEX_PAGE_SIZE || (font_data.IndexCount & (IM_FONT_INDEX_PAGE_SIZE - 1)) != 0)
+            return false;
+        if (ImFontAtlasCacheSkip(&p, p_end, font_data.GlyphsCount, sizeof(ImFontGlyph)) == NULL)
+            return false;
+        const char* index_pages = ImFontAtlasCacheSkip(&p, p_end, font_data.IndexPagesCount, sizeof(ImU16));
+        if (index_pages == NULL || ImFontAtlasCacheSkip(&p, p_end, font_data.IndexCount, sizeof(float)) == NULL)
+            return false;
+        for (int n = 0; n < font_data.IndexPagesCount; n++)
+        {
+            ImU16 page_n;
+            memcpy(&page_n, index_pages + n * sizeof(ImU16), sizeof(page_n));
+            if (page_n >= (font_data.IndexCount >> IM_FONT_INDEX_PAGE_SHIFT))
+                return false;
+        }
+        const char* index_lookup = ImFontAtlasCacheSkip(&p, p_end, font_data.IndexCount, sizeof(ImU16));
+        if (index_lookup == NULL)
+            return false;
+        for (int n = 0; n < font_data.IndexCount; n++)
+        {
+            ImU16 glyph_idx;
+            memcpy(&glyph_idx, index_lookup + n * sizeof(ImU16), sizeof(glyph_idx));
+            if (glyph_idx != (ImU16)-1 && glyph_idx >= font_data.GlyphsCount)
+                return false;
+        }
     }
+    const char* tex_pixels = ImFontAtlasCacheSkip(&p, p_end, atlas_data.TexWidth * atlas_data.TexHeight, (size_t)atlas_data.TexBytesPerPixel);
+    if (tex_pixels == NULL || p != p_end)
+        return false;
 
-    // Build all fonts lookup tables
-    for (ImFont* font : atlas->Fonts)
-        if (font->DirtyLookupTables)
-            font->BuildLookupTable();
+    // Restore texture (same as what builders do before packing)
+    atlas->TexID = (ImTextureID)NULL;
+    atlas->ClearTexData();
+    atlas->TexWidth = atlas_data.TexWidth;
+    atlas->TexHeight = atlas_data.TexHeight;
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+    atlas->TexUvWhitePixel = atlas_data.TexUvWhitePixel;
+    memcpy(atlas->TexUvLines, atlas_data.TexUvLines, sizeof(atlas->TexUvLines));
+    const size_t tex_size = (size_t)atlas->TexWidth * atlas->TexHeight * atlas_data.TexBytesPerPixel;
+    if (atlas_data.TexBytesPerPixel == 1)
+        memcpy(atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(tex_size), tex_pixels, tex_size);
+    else
+        memcpy(atlas->TexPixelsRGBA32 = (unsigned int*)IM_ALLOC(tex_size), tex_pixels, tex_size);
+    atlas->TexPixelsUseColors = (atlas_data.TexPixelsUseColors != 0);
+    for (ImFontAtlasCustomRect& r : atlas->CustomRects)
+    {
+        unsigned short pos[2];
+        memcpy(pos, custom_rects_pos, sizeof(pos));
+        custom_rects_pos += sizeof(pos);
+        r.X = pos[0];
+        r.Y = pos[1];
+    }
 
+    // Restore fonts
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+    {
+        ImFont* font = atlas->Fonts[font_n];
+        p = fonts_data[font_n];
+        ImFontAtlasCacheFontData font_data;
+        ImFontAtlasCacheRead(&p, p_end, &font_data, sizeof(font_data));
+        font->ClearOutputData();
+        font->ContainerAtlas = atlas;
+        font->FontSize = font_data.FontSize;
+        font->Ascent = font_data.Ascent;
+        font->Descent = font_data.Descent;
+        font->FallbackAdvanceX = font_data.FallbackAdvanceX;
+        font->EllipsisWidth = font_data.EllipsisWidth;
+        font->EllipsisCharStep = font_data.EllipsisCharStep;
+        font->EllipsisCharCount = (short)font_data.EllipsisCharCount;
+        font->EllipsisChar = (ImWchar)font_data.EllipsisChar;
+        font->FallbackChar = (ImWchar)font_data.FallbackChar;
+        font->MetricsTotalSurface = font_data.MetricsTotalSurface;
+        memcpy(font->Used8kPagesMap, font_data.Used8kPagesMap, sizeof(font->Used8kPagesMap));
+        font->Glyphs.resize(font_data.GlyphsCount);
+        font->IndexPages.resize(font_data.IndexPagesCount);
+        font->IndexAdvanceX.resize(font_data.IndexCount);
+        font->IndexLookup.resize(font_data.IndexCount);
+        ImFontAtlasCacheRead(&p, p_end, font->Glyphs.Data, (size_t)font->Glyphs.size_in_bytes());
+        ImFontAtlasCacheRead(&p, p_end, font->IndexPages.Data, (size_t)font->IndexPages.size_in_bytes());
+        ImFontAtlasCacheRead(&p, p_end, font->IndexAdvanceX.Data, (size_t)font->IndexAdvanceX.size_in_bytes());
+        ImFontAtlasCacheRead(&p, p_end, font->IndexLookup.Data, (size_t)font->IndexLookup.size_in_bytes());
+        font->FallbackGlyph = (font_data.FallbackGlyphIndex != -1) ? &font->Glyphs[font_data.FallbackGlyphIndex] : NULL;
+        font->DirtyLookupTables = false;
+    }
     atlas->TexReady = true;
+    return true;
+}
+
+bool ImFontAtlasBuildCacheSaveToFile(ImFontAtlas* atlas, ImU64 inputs_hash, const char* filename)
+{
+    ImVector<char> buf;
+    ImFontAtlasBuildCacheSaveToMemory(atlas, inputs_hash, &buf);
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+        return false;
+    const bool ret = ImFileWrite(buf.Data, 1, (ImU64)buf.Size, f) == (ImU64)buf.Size;
+    ImFileClose(f);
+    return ret;
+}
+
+bool ImFontAtlasBuildCacheLoadFromFile(ImFontAtlas* atlas, ImU64 inputs_hash, const char* filename)
+{
+    size_t data_size = 0;
+    void* data = ImFileLoadToMemory(filename, "rb", &data_size);
+    if (data == NULL)
+        return false;
+    const bool ret = ImFontAtlasBuildCacheLoadFromMemory(atlas, inputs_hash, data, data_size);
+    IM_FREE(data);
+    return ret;
 }
 
 //-------------------------------------------------------------------------
@@ -3712,6 +7040,8 @@ void    ImFont::ClearOutputData()
     FontSize = 0.0f;
     FallbackAdvanceX = 0.0f;
     Glyphs.clear();
+    GlyphsLastUsedFrame.clear();
+    IndexPages.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
     FallbackGlyph = NULL;
@@ -3737,18 +7067,23 @@ void ImFont::BuildLookupTable()
         max_codepoint = ImMax(max_codepoint, (int)Glyphs[i].Codepoint);
 
     // Build lookup table
+    // Page 0 is shared by all blocks of codepoints without glyphs, other pages are allocated on first use.
     IM_ASSERT(Glyphs.Size > 0 && "Font has not loaded glyph!");
     IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
+    IndexPages.clear();
+    IndexPages.resize((max_codepoint >> IM_FONT_INDEX_PAGE_SHIFT) + 1, 0);
     IndexAdvanceX.clear();
+    IndexAdvanceX.resize(IM_FONT_INDEX_PAGE_SIZE, -1.0f);
     IndexLookup.clear();
+    IndexLookup.resize(IM_FONT_INDEX_PAGE_SIZE, (ImU16)-1);
     DirtyLookupTables = false;
     memset(Used8kPagesMap, 0, sizeof(Used8kPagesMap));
-    GrowIndex(max_codepoint + 1);
     for (int i = 0; i < Glyphs.Size; i++)
     {
         int codepoint = (int)Glyphs[i].Codepoint;
-        IndexAdvanceX[codepoint] = Glyphs[i].AdvanceX;
-        IndexLookup[codepoint] = (ImU16)i;
+        const int index_slot = AllocIndexSlot((ImWchar)codepoint);
+        IndexAdvanceX[index_slot] = Glyphs[i].AdvanceX;
+        IndexLookup[index_slot] = (ImU16)i;
 
         // Mark 4K page as used
         const int page_n = codepoint / 8192;
@@ -3765,8 +7100,9 @@ void ImFont::BuildLookupTable()
         tab_glyph = *FindGlyph((ImWchar)' ');
         tab_glyph.Codepoint = '\t';
         tab_glyph.AdvanceX *= IM_TABSIZE;
-        IndexAdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX;
-        IndexLookup[(int)tab_glyph.Codepoint] = (ImU16)(Glyphs.Size - 1);
+        const int index_slot = AllocIndexSlot((ImWchar)tab_glyph.Codepoint);
+        IndexAdvanceX[index_slot] = (float)tab_glyph.AdvanceX;
+        IndexLookup[index_slot] = (ImU16)(Glyphs.Size - 1);
     }
 
     // Mark special glyphs as not visible (note that AddGlyph already mark as non-visible glyphs with zero-size polygons)
@@ -3789,9 +7125,10 @@ void ImFont::BuildLookupTable()
         }
     }
     FallbackAdvanceX = FallbackGlyph->AdvanceX;
-    for (int i = 0; i < max_codepoint + 1; i++)
-        if (IndexAdvanceX[i] < 0.0f)
-            IndexAdvanceX[i] = FallbackAdvanceX;
+    if (ContainerAtlas == NULL || ContainerAtlas->DynamicData == NULL) // With ImFontAtlasFlags_DynamicGlyphs, negative values mark glyphs which haven't been looked up yet.
+        for (float& advance_x : IndexAdvanceX)
+            if (advance_x < 0.0f)
+                advance_x = FallbackAdvanceX;
 
     // Setup Ellipsis character. It is required for rendering elided text. We prefer using U+2026 (horizontal ellipsis).
     // However some old fonts may contain ellipsis at U+0085. Here we auto-detect most suitable ellipsis character.
@@ -3801,18 +7138,20 @@ void ImFont::BuildLookupTable()
     if (EllipsisChar == 0)
         EllipsisChar = FindFirstExistingGlyph(this, ellipsis_chars, IM_ARRAYSIZE(ellipsis_chars));
     const ImWchar dot_char = FindFirstExistingGlyph(this, dots_chars, IM_ARRAYSIZE(dots_chars));
+    // Signed distance field glyphs have a margin around their visible box
+    const float sdf_margin = (ContainerAtlas != NULL && (ContainerAtlas->Flags & ImFontAtlasFlags_SignedDistanceField)) ? ContainerAtlas->TexSdfSpread / ConfigData->RasterizerDensity : 0.0f;
     if (EllipsisChar != 0)
     {
         EllipsisCharCount = 1;
-        EllipsisWidth = EllipsisCharStep = FindGlyph(EllipsisChar)->X1;
+        EllipsisWidth = EllipsisCharStep = FindGlyph(EllipsisChar)->X1 - sdf_margin;
     }
     else if (dot_char != 0)
     {
         const ImFontGlyph* dot_glyph = FindGlyph(dot_char);
         EllipsisChar = dot_char;
         EllipsisCharCount = 3;
-        EllipsisCharStep = (float)(int)(dot_glyph->X1 - dot_glyph->X0) + 1.0f;
-        EllipsisWidth = ImMax(dot_glyph->AdvanceX, dot_glyph->X0 + EllipsisCharStep * 3.0f - 1.0f); // FIXME: Slightly odd for normally mono-space fonts but since this is used for trailing contents.
+        EllipsisCharStep = (float)(int)(dot_glyph->X1 - dot_glyph->X0 - sdf_margin * 2.0f) + 1.0f;
+        EllipsisWidth = ImMax(dot_glyph->AdvanceX, dot_glyph->X0 + sdf_margin + EllipsisCharStep * 3.0f - 1.0f); // FIXME: Slightly odd for normally mono-space fonts but since this is used for trailing contents.
     }
 }
 
@@ -3829,13 +7168,23 @@ bool ImFont::IsGlyphRangeUnused(unsigned int c_begin, unsigned int c_last)
     return true;
 }
 
-void ImFont::GrowIndex(int new_size)
+int ImFont::AllocIndexSlot(ImWchar c)
 {
-    IM_ASSERT(IndexAdvanceX.Size == IndexLookup.Size);
-    if (new_size <= IndexLookup.Size)
-        return;
-    IndexAdvanceX.resize(new_size, -1.0f);
-    IndexLookup.resize(new_size, (ImU16)-1);
+    IM_ASSERT(IndexAdvanceX.Size == IndexLookup.Size && IndexLookup.Size >= IM_FONT_INDEX_PAGE_SIZE); // Shared page 0 is created by BuildLookupTable()
+    const int page_n = (int)((unsigned int)c >> IM_FONT_INDEX_PAGE_SHIFT);
+    if (page_n >= IndexPages.Size)
+        IndexPages.resize(page_n + 1, 0);
+    if (IndexPages.Data[page_n] == 0)
+    {
+        // Allocate page, copying values from shared page 0
+        const int new_page_offset = IndexLookup.Size;
+        IndexPages.Data[page_n] = (ImU16)(new_page_offset >> IM_FONT_INDEX_PAGE_SHIFT);
+        IndexAdvanceX.resize(new_page_offset + IM_FONT_INDEX_PAGE_SIZE);
+        IndexLookup.resize(new_page_offset + IM_FONT_INDEX_PAGE_SIZE);
+        memcpy(IndexAdvanceX.Data + new_page_offset, IndexAdvanceX.Data, IM_FONT_INDEX_PAGE_SIZE * sizeof(float));
+        memcpy(IndexLookup.Data + new_page_offset, IndexLookup.Data, IM_FONT_INDEX_PAGE_SIZE * sizeof(ImU16));
+    }
+    return ((int)IndexPages.Data[page_n] << IM_FONT_INDEX_PAGE_SHIFT) | (int)(c & (IM_FONT_INDEX_PAGE_SIZE - 1));
 }
 
 // x0/y0/x1/y1 are offset from the character upper-left layout position, in pixels. Therefore x0/y0 are often fairly close to zero.
@@ -3890,34 +7239,43 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
     IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
-    unsigned int index_size = (unsigned int)IndexLookup.Size;
+    const int dst_slot = GetIndexSlot(dst);
+    const int src_slot = GetIndexSlot(src);
 
-    if (dst < index_size && IndexLookup.Data[dst] == (ImU16)-1 && !overwrite_dst) // 'dst' already exists
+    if (dst_slot >= 0 && IndexLookup.Data[dst_slot] == (ImU16)-1 && !overwrite_dst) // 'dst' already exists
         return;
-    if (src >= index_size && dst >= index_size) // both 'dst' and 'src' don't exist -> no-op
+    if (src_slot < 0 && dst_slot < 0) // both 'dst' and 'src' don't exist -> no-op
         return;
 
-    GrowIndex(dst + 1);
-    IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (ImU16)-1;
-    IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    const ImU16 src_glyph_idx = (src_slot >= 0) ? IndexLookup.Data[src_slot] : (ImU16)-1;
+    const float src_advance_x = (src_slot >= 0) ? IndexAdvanceX.Data[src_slot] : 1.0f;
+    const int new_dst_slot = AllocIndexSlot(dst);
+    IndexLookup[new_dst_slot] = src_glyph_idx;
+    IndexAdvanceX[new_dst_slot] = src_advance_x;
 }
 
 // Find glyph, return fallback if missing
 ImFontGlyph* ImFont::FindGlyph(ImWchar c)
 {
-    if (c >= (size_t)IndexLookup.Size)
-        return FallbackGlyph;
-    const ImU16 i = IndexLookup.Data[c];
-    if (i == (ImU16)-1)
-        return FallbackGlyph;
-    return &Glyphs.Data[i];
+    const int slot = GetIndexSlot(c);
+    if (slot >= 0)
+    {
+        const ImU16 i = IndexLookup.Data[slot];
+        if (i != (ImU16)-1)
+            return &Glyphs.Data[i];
+    }
+    if (ContainerAtlas != NULL && ContainerAtlas->DynamicData != NULL)
+        if (ImFontGlyph* glyph = ImFontAtlasDynamicLoadGlyph(ContainerAtlas, this, c))
+            return glyph;
+    return FallbackGlyph;
 }
 
 ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c)
 {
-    if (c >= (size_t)IndexLookup.Size)
+    const int slot = GetIndexSlot(c);
+    if (slot < 0)
         return NULL;
-    const ImU16 i = IndexLookup.Data[c];
+    const ImU16 i = IndexLookup.Data[slot];
     if (i == (ImU16)-1)
         return NULL;
     return &Glyphs.Data[i];
@@ -3933,7 +7291,45 @@ static inline const char* CalcWordWrapNextLineStartA(const char* text, const cha
     return text;
 }
 
-#define ImFontGetCharAdvanceX(_FONT, _CH)  ((int)(_CH) < (_FONT)->IndexAdvanceX.Size ? (_FONT)->IndexAdvanceX.Data[_CH] : (_FONT)->FallbackAdvanceX)
+// Return the end of the run of printable ASCII characters (0x20..0x7F) starting at 'text': they need no UTF-8 decoding and no special handling.
+// With SSE2/NEON, 16 bytes are classified at a time: bytes >= 0x80 are negative as signed, so a single signed comparison catches both control and non-ASCII bytes.
+// Scan at most 64 bytes ahead: callers often stop early (wrapping, max_width) and shouldn't pay for the rest of the text. They call us again at the end of the run.
+static inline const char* CalcTextSkipPrintableAscii(const char* text, const char* text_end)
+{
+    if (text_end - text > 64)
+        text_end = text + 64;
+#if defined(IMGUI_ENABLE_SSE)
+    const __m128i v_min = _mm_set1_epi8(0x20);
+    while (text_end - text >= 16 && _mm_movemask_epi8(_mm_cmplt_epi8(_mm_loadu_si128((const __m128i*)(const void*)text), v_min)) == 0)
+        text += 16;
+#elif defined(IMGUI_ENABLE_NEON)
+    const int8x16_t v_min = vdupq_n_s8(0x20);
+    while (text_end - text >= 16 && vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vcltq_s8(vld1q_s8((const int8_t*)(const void*)text), v_min)), 4)), 0) == 0)
+        text += 16;
+#endif
+    while (text < text_end && (unsigned char)*text >= 0x20 && (unsigned char)*text < 0x80)
+        text++;
+    return text;
+}
+
+float ImFont::GetCharAdvanceSlow(ImWchar c)
+{
+    if (ContainerAtlas != NULL && ContainerAtlas->DynamicData != NULL)
+        if (ImFontGlyph* glyph = ImFontAtlasDynamicLoadGlyph(ContainerAtlas, this, c))
+            return glyph->AdvanceX;
+    const int slot = GetIndexSlot(c);
+    return (slot >= 0 && IndexAdvanceX.Data[slot] >= 0.0f) ? IndexAdvanceX.Data[slot] : FallbackAdvanceX;
+}
+
+// Same as ImFont::GetCharAdvance(), spelled out as macro so it gets inlined in debug builds.
+// Negative values are only found with ImFontAtlasFlags_DynamicGlyphs, for glyphs which haven't been looked up yet.
+#define ImFontGetCharAdvanceX(_FONT, _CH, _OUT) \
+    do { \
+        const unsigned int page_n = (unsigned int)(_CH) >> IM_FONT_INDEX_PAGE_SHIFT; \
+        _OUT = (page_n < (unsigned int)(_FONT)->IndexPages.Size) ? (_FONT)->IndexAdvanceX.Data[((int)(_FONT)->IndexPages.Data[page_n] << IM_FONT_INDEX_PAGE_SHIFT) | (int)((_CH) & (IM_FONT_INDEX_PAGE_SIZE - 1))] : -1.0f; \
+        if (_OUT < 0.0f) \
+            _OUT = (_FONT)->GetCharAdvanceSlow((ImWchar)(_CH)); \
+    } while (0)
 
 // Simple word-wrapping for English, not full-featured. Please submit failing cases!
 // This will return the next location to wrap from. If no wrapping if necessary, this will fast-forward to e.g. text_end.
@@ -3961,33 +7357,46 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     bool inside_word = true;
 
     const char* s = text;
+    const char* ascii_run_end = text; // Characters before this are printable ASCII (see CalcTextSkipPrintableAscii())
     IM_ASSERT(text_end != NULL);
     while (s < text_end)
     {
         unsigned int c = (unsigned int)*s;
         const char* next_s;
-        if (c < 0x80)
+        if (s < ascii_run_end)
+        {
             next_s = s + 1;
+        }
         else
-            next_s = s + ImTextCharFromUtf8(&c, s, text_end);
-
-        if (c < 32)
         {
-            if (c == '\n')
+            if (c < 0x80)
+                next_s = s + 1;
+            else
+                next_s = s + ImTextCharFromUtf8(&c, s, text_end);
+
+            if (c < 32)
             {
-                line_width = word_width = blank_width = 0.0f;
-                inside_word = true;
-                s = next_s;
-                continue;
+                if (c == '\n')
+                {
+                    line_width = word_width = blank_width = 0.0f;
+                    inside_word = true;
+                    s = next_s;
+                    continue;
+                }
+                if (c == '\r')
+                {
+                    s = next_s;
+                    continue;
+                }
             }
-            if (c == '\r')
+            else if (c < 0x80)
             {
-                s = next_s;
-                continue;
+                ascii_run_end = CalcTextSkipPrintableAscii(next_s, text_end);
             }
         }
 
-        const float char_width = ImFontGetCharAdvanceX(this, c);
+        float char_width;
+        ImFontGetCharAdvanceX(this, c, char_width);
         if (ImCharIsBlankW(c))
         {
             if (inside_word)
@@ -4049,50 +7458,64 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
 
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
+    const char* ascii_run_end = text_begin; // Characters before this are printable ASCII and before next wrapping point: they need no decoding and no checks.
 
     const char* s = text_begin;
     while (s < text_end)
     {
-        if (word_wrap_enabled)
-        {
-            // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
-            if (!word_wrap_eol)
-                word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - line_width);
-
-            if (s >= word_wrap_eol)
-            {
-                if (text_size.x < line_width)
-                    text_size.x = line_width;
-                text_size.y += line_height;
-                line_width = 0.0f;
-                word_wrap_eol = NULL;
-                s = CalcWordWrapNextLineStartA(s, text_end); // Wrapping skips upcoming blanks
-                continue;
-            }
-        }
-
-        // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
-        if (c < 0x80)
+        if (s < ascii_run_end)
+        {
             s += 1;
+        }
         else
-            s += ImTextCharFromUtf8(&c, s, text_end);
-
-        if (c < 32)
         {
-            if (c == '\n')
+            if (word_wrap_enabled)
             {
-                text_size.x = ImMax(text_size.x, line_width);
-                text_size.y += line_height;
-                line_width = 0.0f;
-                continue;
+                // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
+                if (!word_wrap_eol)
+                    word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - line_width);
+
+                if (s >= word_wrap_eol)
+                {
+                    if (text_size.x < line_width)
+                        text_size.x = line_width;
+                    text_size.y += line_height;
+                    line_width = 0.0f;
+                    word_wrap_eol = NULL;
+                    s = CalcWordWrapNextLineStartA(s, text_end); // Wrapping skips upcoming blanks
+                    continue;
+                }
+            }
+
+            // Decode and advance source
+            if (c < 0x80)
+                s += 1;
+            else
+                s += ImTextCharFromUtf8(&c, s, text_end);
+
+            if (c < 32)
+            {
+                if (c == '\n')
+                {
+                    text_size.x = ImMax(text_size.x, line_width);
+                    text_size.y += line_height;
+                    line_width = 0.0f;
+                    continue;
+                }
+                if (c == '\r')
+                    continue;
+            }
+            else if (c < 0x80)
+            {
+                ascii_run_end = CalcTextSkipPrintableAscii(s, word_wrap_enabled ? word_wrap_eol : text_end);
             }
-            if (c == '\r')
-                continue;
         }
 
-        const float char_width = ImFontGetCharAdvanceX(this, c) * scale;
+        float char_width;
+        ImFontGetCharAdvanceX(this, c, char_width);
+        char_width *= scale;
         if (line_width + char_width >= max_width)
         {
             s = prev_s;
@@ -4120,6 +7543,16 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     const ImFontGlyph* glyph = FindGlyph(c);
     if (!glyph || !glyph->Visible)
         return;
+    if (GlyphsLastUsedFrame.Size > 0 && ContainerAtlas->DynamicData != NULL)
+    {
+        if (!ContainerAtlas->DynamicData->LoadingLocked)
+            GlyphsLastUsedFrame.Data[glyph - Glyphs.Data] = ContainerAtlas->DynamicData->FrameCount;
+        if (draw_list->_Fragment != NULL)
+        {
+            ImDrawListFragmentGlyph fragment_glyph = { this, (ImWchar)glyph->Codepoint, glyph->U0, glyph->V0 };
+            draw_list->_Fragment->Glyphs.push_back(fragment_glyph);
+        }
+    }
     if (glyph->Colored)
         col |= ~IM_COL32_A_MASK;
     float scale = (size >= 0.0f) ? (size / FontSize) : 1.0f;
@@ -4147,25 +7580,31 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     const bool word_wrap_enabled = (wrap_width > 0.0f);
 
     // Fast-forward to first visible line
+    // With word-wrapping, the end of current line is only searched again once we pass it: a long paragraph is only scanned once for \n.
     const char* s = text_begin;
     if (y + line_height < clip_rect.y)
+    {
+        const char* line_end = NULL;
         while (y + line_height < clip_rect.y && s < text_end)
         {
-            const char* line_end = (const char*)memchr(s, '\n', text_end - s);
+            if (line_end == NULL || line_end < s)
+            {
+                line_end = (const char*)memchr(s, '\n', text_end - s);
+                if (line_end == NULL)
+                    line_end = text_end;
+            }
             if (word_wrap_enabled)
             {
-                // FIXME-OPT: This is not optimal as do first do a search for \n before calling CalcWordWrapPositionA().
-                // If the specs for CalcWordWrapPositionA() were reworked to optionally return on \n we could combine both.
-                // However it is still better than nothing performing the fast-forward!
-                s = CalcWordWrapPositionA(scale, s, line_end ? line_end : text_end, wrap_width);
+                s = CalcWordWrapPositionA(scale, s, line_end, wrap_width);
                 s = CalcWordWrapNextLineStartA(s, text_end);
             }
             else
             {
-                s = line_end ? line_end + 1 : text_end;
+                s = (line_end < text_end) ? line_end + 1 : text_end;
             }
             y += line_height;
         }
+    }
 
     // For large text, scan for the last visible line in order to avoid over-reserving in the call to PrimReserve()
     // Note that very large horizontal line will still be affected by the issue (e.g. a one megabyte string buffer without a newline will likely crash atm)
@@ -4184,62 +7623,107 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     if (s == text_end)
         return;
 
-    // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
-    const int vtx_count_max = (int)(text_end - s) * 4;
-    const int idx_count_max = (int)(text_end - s) * 6;
+    // Reserve vertices (or rectangle instances) for remaining worse case (over-reserving is useful and easily amortized)
+    const bool use_instances = (draw_list->Flags & ImDrawListFlags_AllowRectInstances) != 0;
+    const int vtx_count_max = use_instances ? 0 : (int)(text_end - s) * 4;
+    const int idx_count_max = use_instances ? 0 : (int)(text_end - s) * 6;
+    const int inst_count_max = use_instances ? (int)(text_end - s) : 0;
     const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
-    draw_list->PrimReserve(idx_count_max, vtx_count_max);
+    const int inst_expected_size = draw_list->InstBuffer.Size + inst_count_max;
+    if (use_instances)
+        draw_list->PrimReserveInstances(inst_count_max);
+    else
+        draw_list->PrimReserve(idx_count_max, vtx_count_max);
     ImDrawVert*  vtx_write = draw_list->_VtxWritePtr;
     ImDrawIdx*   idx_write = draw_list->_IdxWritePtr;
     unsigned int vtx_index = draw_list->_VtxCurrentIdx;
+    ImDrawRectInstance* inst_write = draw_list->_InstWritePtr;
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
     const char* word_wrap_eol = NULL;
+    const char* ascii_run_end = s; // Characters before this are printable ASCII and before next wrapping point: they need no decoding and no checks.
+
+    // With ImFontAtlasFlags_DynamicGlyphs: track glyphs usage for eviction. While loading is locked (detached draw lists exist),
+    // fonts can't be modified: record missing glyphs instead, ImGui::Render() will load them for next frames.
+    ImFontAtlasDynamicData* dynamic_data = (GlyphsLastUsedFrame.Size > 0 && ContainerAtlas != NULL) ? ContainerAtlas->DynamicData : NULL;
+    const bool dynamic_loading_locked = dynamic_data ? dynamic_data->LoadingLocked : false;
+    const int dynamic_frame_count = (dynamic_data && !dynamic_loading_locked) ? dynamic_data->FrameCount : 0;
 
     while (s < text_end)
     {
-        if (word_wrap_enabled)
+        unsigned int c = (unsigned int)*s;
+        if (s < ascii_run_end)
         {
-            // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
-            if (!word_wrap_eol)
-                word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - origin_x));
-
-            if (s >= word_wrap_eol)
+            s += 1;
+        }
+        else
+        {
+            if (word_wrap_enabled)
             {
-                x = origin_x;
-                y += line_height;
-                if (y > clip_rect.w)
-                    break; // break out of main loop
-                word_wrap_eol = NULL;
-                s = CalcWordWrapNextLineStartA(s, text_end); // Wrapping skips upcoming blanks
-                continue;
+                // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
+                if (!word_wrap_eol)
+                    word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - origin_x));
+
+                if (s >= word_wrap_eol)
+                {
+                    x = origin_x;
+                    y += line_height;
+                    if (y > clip_rect.w)
+                        break; // break out of main loop
+                    word_wrap_eol = NULL;
+                    s = CalcWordWrapNextLineStartA(s, text_end); // Wrapping skips upcoming blanks
+                    continue;
+                }
             }
-        }
 
-        // Decode and advance source
-        unsigned int c = (unsigned int)*s;
-        if (c < 0x80)
-            s += 1;
-        else
-            s += ImTextCharFromUtf8(&c, s, text_end);
+            // Decode and advance source
+            c = (unsigned int)*s;
+            if (c < 0x80)
+                s += 1;
+            else
+                s += ImTextCharFromUtf8(&c, s, text_end);
 
-        if (c < 32)
-        {
-            if (c == '\n')
+            if (c < 32)
             {
-                x = origin_x;
-                y += line_height;
-                if (y > clip_rect.w)
-                    break; // break out of main loop
-                continue;
+                if (c == '\n')
+                {
+                    x = origin_x;
+                    y += line_height;
+                    if (y > clip_rect.w)
+                        break; // break out of main loop
+                    continue;
+                }
+                if (c == '\r')
+                    continue;
+            }
+            else if (c < 0x80)
+            {
+                ascii_run_end = CalcTextSkipPrintableAscii(s, word_wrap_enabled ? word_wrap_eol : text_end);
             }
-            if (c == '\r')
-                continue;
         }
 
         const ImFontGlyph* glyph = FindGlyph((ImWchar)c);
         if (glyph == NULL)
             continue;
+        if (dynamic_data != NULL)
+        {
+            if (!dynamic_loading_locked)
+                GlyphsLastUsedFrame.Data[glyph - Glyphs.Data] = dynamic_frame_count; // Not hoisted: loading a glyph may reallocate
+            else if (glyph == FallbackGlyph && c != FallbackChar)
+            {
+                const int index_slot = GetIndexSlot((ImWchar)c);
+                if (index_slot < 0 || IndexAdvanceX.Data[index_slot] < 0.0f) // Not known to be missing
+                {
+                    ImFontGlyphRequest req = { this, (ImWchar)c };
+                    draw_list->_Data->GlyphRequests.push_back(req);
+                }
+            }
+            if (draw_list->_Fragment != NULL && glyph->Visible)
+            {
+                ImDrawListFragmentGlyph fragment_glyph = { this, (ImWchar)glyph->Codepoint, glyph->U0, glyph->V0 };
+                draw_list->_Fragment->Glyphs.push_back(fragment_glyph);
+            }
+        }
 
         float char_width = glyph->AdvanceX * scale;
         if (glyph->Visible)
@@ -4291,11 +7775,20 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
                 ImU32 glyph_col = glyph->Colored ? col_untinted : col;
 
                 // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
+                if (use_instances)
+                {
+                    inst_write->PosMin.x = x1; inst_write->PosMin.y = y1; inst_write->PosMax.x = x2; inst_write->PosMax.y = y2;
+                    inst_write->UvMin.x = u1; inst_write->UvMin.y = v1; inst_write->UvMax.x = u2; inst_write->UvMax.y = v2;
+                    inst_write->Col = glyph_col; inst_write->Rounding = 0.0f; inst_write->Thickness = 0.0f;
+                    inst_write->RoundingCorners = 0x0F; inst_write->Ellipse = 0; inst_write->_Pad0 = 0;
+                    inst_write++;
+                }
+                else
                 {
-                    vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
-                    vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
-                    vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
-                    vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                    ImDrawVert_Write(&vtx_write[0], x1, y1, u1, v1, glyph_col);
+                    ImDrawVert_Write(&vtx_write[1], x2, y1, u2, v1, glyph_col);
+                    ImDrawVert_Write(&vtx_write[2], x2, y2, u2, v2, glyph_col);
+                    ImDrawVert_Write(&vtx_write[3], x1, y2, u1, v2, glyph_col);
                     idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
                     idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
                     vtx_write += 4;
@@ -4308,6 +7801,13 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     }
 
     // Give back unused vertices (clipped ones, blanks) ~ this is essentially a PrimUnreserve() action.
+    if (use_instances)
+    {
+        draw_list->InstBuffer.Size = (int)(inst_write - draw_list->InstBuffer.Data); // Same as calling shrink()
+        draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].InstCount -= (inst_expected_size - draw_list->InstBuffer.Size);
+        draw_list->_InstWritePtr = inst_write;
+        return;
+    }
     draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data); // Same as calling shrink()
     draw_list->IdxBuffer.Size = (int)(idx_write - draw_list->IdxBuffer.Data);
     draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
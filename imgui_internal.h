@@ -66,6 +66,11 @@ Index of this file:
 #include <nmmintrin.h>
 #endif
 #endif
+// Enable NEON intrinsics if available
+#if (defined __ARM_NEON || defined __ARM_NEON__) && !defined(IMGUI_DISABLE_NEON)
+#define IMGUI_ENABLE_NEON
+#include <arm_neon.h>
+#endif
 // Emscripten has partial SSE 4.2 support where _mm_crc32_u32 is not available. See https://emscripten.org/docs/porting/simd.html#id11 and #8213
 #if defined(IMGUI_ENABLE_SSE4_2) && !defined(IMGUI_USE_LEGACY_CRC32_ADLER) && !defined(__EMSCRIPTEN__)
 #define IMGUI_ENABLE_SSE4_2_CRC
@@ -135,10 +140,12 @@ Index of this file:
 struct ImBitVector;                 // Store 1-bit per value
 struct ImRect;                      // An axis-aligned rectangle (2 points)
 struct ImGuiTextIndex;              // Maintain a line index for a text buffer.
+struct ImGuiTextMeasureCache;       // Text sizes measured by CalcTextSize() during the previous frame (io.ConfigTextMeasureCache)
 
 // ImDrawList/ImFontAtlas
 struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
 struct ImDrawListSharedData;        // Data shared between all ImDrawList instances
+struct ImSweepTriangulator;         // Sweep line triangulator used by AddConcavePolyFilled() with multiple contours
 
 // ImGui
 struct ImGuiBoxSelectState;         // Box-selection state (currently used by multi-selection, could potentially be used by others)
@@ -245,12 +252,8 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 
 // "Paranoid" Debug Asserts are meant to only be enabled during specific debugging/work, otherwise would slow down the code too much.
 // We currently don't have many of those so the effect is currently negligible, but onward intent to add more aggressive ones in the code.
+// IM_ASSERT_PARANOID() is defined in imgui.h, so inline vertex helpers can use it too.
 //#define IMGUI_DEBUG_PARANOID
-#ifdef IMGUI_DEBUG_PARANOID
-#define IM_ASSERT_PARANOID(_EXPR)       IM_ASSERT(_EXPR)
-#else
-#define IM_ASSERT_PARANOID(_EXPR)
-#endif
 
 // Misc Macros
 #define IM_PI                           3.14159265358979323846f
@@ -773,6 +776,26 @@ IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStorag
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImDrawList: AddConcavePolyFilled() uses ear clipping (O(N^2) worst case, smallest output) up to this number of points, sweep line triangulation above.
+#ifndef IM_DRAWLIST_CONCAVE_EARCLIP_MAX
+#define IM_DRAWLIST_CONCAVE_EARCLIP_MAX                         64
+#endif
+
+// ImDrawList: Lookup table of unit circles used by AddCircleFilled()/AddNgonFilled() for up to IM_DRAWLIST_CIRCLE_VTX_CACHE_MAX segments.
+// Vertices of a circle with N segments are stored at offset IM_DRAWLIST_CIRCLE_VTX_CACHE_OFFSET(N).
+#ifndef IM_DRAWLIST_CIRCLE_VTX_CACHE_MAX
+#define IM_DRAWLIST_CIRCLE_VTX_CACHE_MAX                        64
+#endif
+#define IM_DRAWLIST_CIRCLE_VTX_CACHE_OFFSET(_N)                 ((_N) * ((_N) - 1) / 2 - 3)
+#define IM_DRAWLIST_CIRCLE_VTX_CACHE_SIZE                       IM_DRAWLIST_CIRCLE_VTX_CACHE_OFFSET(IM_DRAWLIST_CIRCLE_VTX_CACHE_MAX + 1)
+
+// Glyph missed by a font lookup which wasn't allowed to load it (ImFontAtlasFlags_DynamicGlyphs, while detached draw lists exist)
+struct ImFontGlyphRequest
+{
+    ImFont*                 Font;
+    ImWchar                 Codepoint;
+};
+
 // Data shared between all ImDrawList instances
 // Conceptually this could have been called e.g. ImDrawListSharedContext
 // Typically one ImGui context would create and maintain one of this.
@@ -789,21 +812,56 @@ struct IMGUI_API ImDrawListSharedData
     ImVec4          ClipRectFullscreen;         // Value for PushClipRectFullscreen()
     ImDrawListFlags InitialFlags;               // Initial flags at the beginning of the frame (it is possible to alter flags on a per-drawlist basis afterwards)
     ImVector<ImVec2> TempBuffer;                // Temporary write buffer
+    ImSweepTriangulator* TempSweepTriangulator; // Temporary storage for AddConcavePolyFilled() with multiple contours (created on first use)
+    ImVector<ImFontGlyphRequest> GlyphRequests; // Glyphs missed by ImFont::RenderText() while ImFontAtlasFlags_DynamicGlyphs loading was locked (loaded by ImGui::Render())
 
     // Lookup tables
     ImVec2          ArcFastVtx[IM_DRAWLIST_ARCFAST_TABLE_SIZE]; // Sample points on the quarter of the circle.
     float           ArcFastRadiusCutoff;                        // Cutoff radius after which arc drawing will fallback to slower PathArcTo()
     ImU8            CircleSegmentCounts[64];    // Precomputed segment count for given radius before we calculate it dynamically (to avoid calculation overhead)
+    ImVec2          CircleVtxCache[IM_DRAWLIST_CIRCLE_VTX_CACHE_SIZE];         // Unit circles with 3..IM_DRAWLIST_CIRCLE_VTX_CACHE_MAX segments, starting at angle 0, clockwise.
+    float           CircleFringeScale[IM_DRAWLIST_CIRCLE_VTX_CACHE_MAX + 1];   // Length of anti-aliasing fringe normals of a regular polygon with N segments (1/cos(PI/N)).
 
     ImDrawListSharedData();
+    ~ImDrawListSharedData();
     void SetCircleTessellationMaxError(float max_error);
 };
 
+// [Internal] Source command and output batch for MergeDrawDataCommands()
+struct ImDrawDataMergeCmd
+{
+    const ImDrawList*       SrcList;
+    const ImDrawCmd*        SrcCmd;
+    unsigned int            IdxDelta;       // Added to source indices, as vertices of all lists are copied into a single buffer
+    int                     NextInBatch;    // Index of next command in same batch, -1 if last
+};
+
+struct ImDrawDataMergeBatch
+{
+    ImDrawCmdHeader         Header;         // ClipRect, TextureId, VtxOffset in merged list
+    ImRect                  Bounds;         // Union of bounds of all commands (vertices or instances, clipped)
+    int                     CmdFirst;
+    int                     CmdLast;
+    bool                    IsInstances;    // Never merge triangles with rectangle instances
+    bool                    IsCallback;     // Callbacks are never merged nor moved over
+};
+
 struct ImDrawDataBuilder
 {
     ImVector<ImDrawList*>*  Layers[2];      // Pointers to global layers for: regular, tooltip. LayersP[0] is owned by DrawData.
     ImVector<ImDrawList*>   LayerData1;
 
+    // io.ConfigDrawDataMergeCommands
+    ImDrawList*             MergedList;     // Single list replacing all lists of the ImDrawData (owned by us)
+    ImVector<ImDrawDataMergeCmd>    MergeCmds;
+    ImVector<ImDrawDataMergeBatch>  MergeBatches;
+    int                     MergeCmdsCountBefore;   // Number of non-empty commands in source lists (for Metrics)
+    int                     MergeCmdsCountAfter;    // Number of commands in MergedList (for Metrics)
+
+    // io.ConfigDrawDataCulling
+    ImVector<ImRect>        CullOccluders;
+    int                     CullCmdsCount;          // Number of commands removed (for Metrics)
+
     ImDrawDataBuilder()                     { memset(this, 0, sizeof(*this)); }
 };
 
@@ -1103,6 +1161,41 @@ struct IMGUI_API ImGuiMenuColumns
     void        CalcNextTotalWidth(bool update_offsets);
 };
 
+// Text sizes measured by CalcTextSize(), for io.ConfigTextMeasureCache.
+// - Entries not used during a frame are discarded by NewFrame(), in batches: only when they make up more than half of entries.
+// - Widgets generally measure the same labels in the same order every frame: lookups first try the entry following the previous hit.
+//   An open-addressing hash table is built on the first out-of-order lookup, then maintained by Add().
+struct ImGuiTextMeasureCacheEntry
+{
+    ImFont*     Font;           // Key (with FontSize, WrapWidth and text)
+    float       FontSize;
+    float       WrapWidth;
+    int         TextOffset;     // Copy of the measured text in TextBuf[]
+    int         TextLen;
+    ImGuiID     Hash;           // Hash of key, 0 if not computed yet
+    int         LastFrameUsed;
+    ImVec2      Size;           // Output of CalcTextSize()
+};
+
+struct IMGUI_API ImGuiTextMeasureCache
+{
+    ImVector<ImGuiTextMeasureCacheEntry> Entries;
+    ImVector<char>  TextBuf;
+    ImVector<int>   Buckets;                // Open addressing hash table, index+1 in Entries or 0 when empty
+    int             SeqIndex;               // Index in Entries expected for next lookup
+    int             FrameCount;
+    int             FrameUsedCount;         // Number of entries used during current frame
+    int             FontAtlasBuildCount;    // Value of ImFontAtlas::BuildCount when entries were measured
+    int             HitsCount, MissesCount; // Lookups during the current frame
+    int             LastFrameHitsCount, LastFrameMissesCount;
+
+    ImGuiTextMeasureCache()     { SeqIndex = FrameCount = FrameUsedCount = FontAtlasBuildCount = HitsCount = MissesCount = LastFrameHitsCount = LastFrameMissesCount = 0; }
+    void            NewFrame(int frame_count, int font_atlas_build_count);
+    void            Clear();
+    const ImGuiTextMeasureCacheEntry* Find(ImFont* font, float font_size, float wrap_width, const char* text, int text_len, ImGuiID* out_hash); // Set *out_hash when computed, to be passed to Add()
+    void            Add(ImFont* font, float font_size, float wrap_width, const char* text, int text_len, ImGuiID hash, const ImVec2& size);
+};
+
 // Internal temporary state for deactivating InputText() instances.
 struct IMGUI_API ImGuiInputTextDeactivatedState
 {
@@ -1852,7 +1945,7 @@ struct ImGuiViewportP : public ImGuiViewport
     ImVec2              BuildWorkInsetMax;      // "
 
     ImGuiViewportP()    { BgFgDrawListsLastFrame[0] = BgFgDrawListsLastFrame[1] = -1; BgFgDrawLists[0] = BgFgDrawLists[1] = NULL; }
-    ~ImGuiViewportP()   { if (BgFgDrawLists[0]) IM_DELETE(BgFgDrawLists[0]); if (BgFgDrawLists[1]) IM_DELETE(BgFgDrawLists[1]); }
+    ~ImGuiViewportP()   { if (BgFgDrawLists[0]) IM_DELETE(BgFgDrawLists[0]); if (BgFgDrawLists[1]) IM_DELETE(BgFgDrawLists[1]); if (DrawDataBuilder.MergedList) IM_DELETE(DrawDataBuilder.MergedList); }
 
     // Calculate work rect pos/size given a set of offset (we have 1 pair of offset for rect locked from last frame data, and 1 pair for currently building rect)
     ImVec2  CalcWorkRectPos(const ImVec2& inset_min) const                           { return ImVec2(Pos.x + inset_min.x, Pos.y + inset_min.y); }
@@ -2063,6 +2156,8 @@ struct ImGuiContext
     float                   FontScale;                          // == FontSize / Font->FontSize
     float                   CurrentDpiScale;                    // Current window/viewport DpiScale
     ImDrawListSharedData    DrawListSharedData;
+    ImGuiTextMeasureCache   TextMeasureCache;                   // Sizes measured by CalcTextSize() (io.ConfigTextMeasureCache)
+    int                     DetachedDrawListsCount;             // Number of draw lists created with CreateDetachedDrawList(). While > 0, only allocations from the thread which created them are tracked.
     double                  Time;
     int                     FrameCount;
     int                     FrameCountEnded;
@@ -2399,6 +2494,7 @@ struct ImGuiContext
     ImGuiMetricsConfig      DebugMetricsConfig;
     ImGuiIDStackTool        DebugIDStackTool;
     ImGuiDebugAllocInfo     DebugAllocInfo;
+    int                     DebugAllocUntrackedScope;           // While > 0, MemAlloc()/MemFree() don't call DebugAllocHook(). Used around allocations of detached draw lists, which other threads may free.
 
     // Misc
     float                   FramerateSecPerFrame[60];           // Calculate estimate of framerate for user over the last 60 frames..
@@ -2543,6 +2639,7 @@ struct IMGUI_API ImGuiWindow
     // The best way to understand what those rectangles are is to use the 'Metrics->Tools->Show Windows Rectangles' viewer.
     // The main 'OuterRect', omitted as a field, is window->Rect().
     ImRect                  OuterRectClipped;                   // == Window->Rect() just after setup in Begin(). == window->Rect() for root window.
+    ImRect                  OccludingRect;                      // Area fully covered by opaque background/title bar, used by io.ConfigDrawDataCulling. Empty if none.
     ImRect                  InnerRect;                          // Inner rectangle (omit title bar, menu bar, scroll bar)
     ImRect                  InnerClipRect;                      // == InnerRect shrunk by WindowPadding*0.5f on each side, clipped within viewport or parent clip rect.
     ImRect                  WorkRect;                           // Initially covers the whole scrolling region. Reduced by containers e.g columns/tables when active. Shrunk by WindowPadding*1.0f on each side. This is meant to replace ContentRegionRect over time (from 1.71+ onward).
@@ -3030,6 +3127,8 @@ namespace ImGui
     IMGUI_API ImDrawList*   GetBackgroundDrawList(ImGuiViewport* viewport);                     // get background draw list for the given viewport. this draw list will be the first rendering one. Useful to quickly draw shapes/text behind dear imgui contents.
     IMGUI_API ImDrawList*   GetForegroundDrawList(ImGuiViewport* viewport);                     // get foreground draw list for the given viewport. this draw list will be the last rendered one. Useful to quickly draw shapes/text over dear imgui contents.
     IMGUI_API void          AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>* out_list, ImDrawList* draw_list);
+    IMGUI_API void          UpdateDrawDataContentHash(ImDrawData* draw_data);
+    IMGUI_API bool          MergeDrawDataCommands(ImDrawData* draw_data, ImDrawDataBuilder* builder, bool allow_reorder, bool allow_vtx_offset);
 
     // Init
     IMGUI_API void          Initialize();
@@ -3569,7 +3668,101 @@ namespace ImGui
 struct ImFontBuilderIO
 {
     bool    (*FontBuilder_Build)(ImFontAtlas* atlas);
-};
+    const char* FontBuilder_Name;   // Optional: required to use ImFontAtlas::CacheFilename. Part of the hash identifying cached output.
+    const char* FontBuilder_Version;// Optional: version of the builder and of libraries affecting its output (e.g. FreeType runtime version). Part of the hash identifying cached output.
+
+    // Optional: support for ImFontAtlasFlags_DynamicGlyphs
+    // - FontBuilder_Build() only bakes glyphs for which ImFontAtlasBuildIsPreloadedGlyph() returns true, and stores its per-source state in atlas->DynamicData->BuilderData.
+    // - FontBuilder_LoadGlyph() rasterizes one glyph into a rectangle from ImFontAtlasDynamicAllocRect() and registers it with ImFontAtlasDynamicAddGlyph().
+    //   Return false if no source of 'font' provides the glyph.
+    bool    (*FontBuilder_LoadGlyph)(ImFontAtlas* atlas, ImFont* font, ImWchar codepoint);
+    void    (*FontBuilder_DestroyData)(ImFontAtlas* atlas);
+
+    // Optional: support for ImFontAtlasFlags_IncrementalBuild
+    // - FontBuilder_Build() hands its rectangle packer state over to atlas->IncrementalData (PackContext/PackNodes) instead of freeing it.
+    // - FontBuilder_BuildIncremental() packs custom rectangles and rasterizes sources added since last build into existing texture data (see ImFontAtlasIncrementalData).
+    //   Return false without modifying the atlas if this is not possible, Build() then does a full build.
+    bool    (*FontBuilder_BuildIncremental)(ImFontAtlas* atlas);
+};
+
+// [Internal] A rectangle of the texture holding one glyph loaded on demand
+struct ImFontAtlasDynamicSlot
+{
+    ImFont*                 Font;               // Owner font (glyph is Font->Glyphs[GlyphIndex])
+    ImWchar                 Codepoint;
+    int                     GlyphIndex;
+    unsigned short          X, Y, W, H;         // Rectangle in texture, including leading padding. Reused glyphs may be smaller.
+};
+
+// [Internal] A horizontal band of the texture, filled from left to right
+struct ImFontAtlasDynamicShelf
+{
+    int                     X, Y, H;            // X: first free column
+};
+
+// [Internal] Storage for glyphs loaded on demand (ImFontAtlasFlags_DynamicGlyphs)
+struct ImFontAtlasDynamicData
+{
+    const ImFontBuilderIO*  BuilderIO;          // Builder which created BuilderData
+    void*                   BuilderData;        // Per-source state kept alive by the builder (parsed font data)
+    bool                    Ready;              // Set by ImFontAtlasBuildFinish()
+    bool                    LoadingLocked;      // Set while detached draw lists exist: lookups don't modify the atlas
+    bool                    AllocFailed;        // Set by ImFontAtlasDynamicAllocRect() when texture is full
+    int                     FrameCount;         // Updated by ImGui::NewFrame()
+    int                     FullFrame;          // Last frame during which an allocation failed
+    int                     FullW, FullH;       // Size of smallest allocation which failed during FullFrame (don't retry larger ones until next frame)
+    int                     AreaY;              // First line of texture available to dynamic glyphs (below baked data)
+    int                     ShelvesY;           // First line of texture not used by a shelf
+    ImVector<ImFontAtlasDynamicShelf> Shelves;  // Horizontal bands of texture, filled from left to right
+    ImVector<ImFontAtlasDynamicSlot> Slots;
+
+    // Statistics (displayed in Metrics)
+    int                     GlyphsLoaded;
+    int                     GlyphsEvicted;
+    int                     GlyphsRequested;    // Glyphs loaded from requests queued while detached draw lists existed
+
+    ImFontAtlasDynamicData() { memset((void*)this, 0, sizeof(*this)); }
+};
+
+// Helpers for ImFontAtlasFlags_DynamicGlyphs
+IMGUI_API bool          ImFontAtlasBuildIsPreloadedGlyph(const ImFontConfig* cfg, unsigned int codepoint);    // Glyphs baked by Build()
+IMGUI_API bool          ImFontAtlasBuildIsInGlyphRanges(ImFontAtlas* atlas, const ImFontConfig* cfg, unsigned int codepoint);
+IMGUI_API int           ImFontAtlasDynamicAllocRect(ImFontAtlas* atlas, int w, int h);                          // Return slot index, or -1 when texture is full
+IMGUI_API ImFontGlyph*  ImFontAtlasDynamicAddGlyph(ImFontAtlas* atlas, int slot_n, ImFont* font, const ImFontConfig* src_cfg, ImWchar codepoint, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x);
+IMGUI_API ImFontGlyph*  ImFontAtlasDynamicLoadGlyph(ImFontAtlas* atlas, ImFont* font, ImWchar codepoint);        // Called on lookup misses
+IMGUI_API void          ImFontAtlasDynamicUpdateState(ImFontAtlas* atlas, int frame_count, bool loading_locked);
+IMGUI_API void          ImFontAtlasDynamicLoadRequests(ImFontAtlas* atlas, ImVector<ImFontGlyphRequest>* requests);
+IMGUI_API void          ImFontAtlasDynamicDestroy(ImFontAtlas* atlas);
+
+// [Internal] Packing state kept between builds (ImFontAtlasFlags_IncrementalBuild)
+struct ImFontAtlasIncrementalData
+{
+    const ImFontBuilderIO*  BuilderIO;          // Builder which did the last full build
+    ImFontAtlasFlags        Flags;              // Settings of the last full build, which need to be unchanged for an incremental build
+    int                     TexGlyphPadding;
+    int                     TexSdfSpread;
+    void*                   PackContext;        // stbrp_context covering texture width and unlimited height, allocated with IM_ALLOC()
+    void*                   PackNodes;          // stbrp_node[] used by PackContext, allocated with IM_ALLOC()
+    int                     ConfigDataBuilt;    // atlas->ConfigData[] entries built so far (updated by ImFontAtlasBuildFinish())
+    int                     CustomRectsBuilt;   // atlas->CustomRects[] entries packed so far (updated by ImFontAtlasBuildFinish())
+
+    // Statistics (displayed in Metrics)
+    int                     BuildsCount;        // Incremental builds since last full build
+
+    ImFontAtlasIncrementalData() { memset((void*)this, 0, sizeof(*this)); }
+};
+
+// Helpers for ImFontAtlasFlags_IncrementalBuild
+IMGUI_API void          ImFontAtlasBuildGrowTexHeight(ImFontAtlas* atlas, int new_height);                    // Grow pixel buffers and rescale V coordinates of existing glyphs
+IMGUI_API void          ImFontAtlasBuildUpdateTexRect(ImFontAtlas* atlas, int x, int y, int w, int h);        // Mark area as modified for GetTexDataUpdateRect(), convert it to RGBA32 if needed
+IMGUI_API void          ImFontAtlasIncrementalDestroy(ImFontAtlas* atlas);
+
+// Helpers for ImFontAtlas::CacheFilename
+IMGUI_API ImU64         ImFontAtlasBuildCacheHashInputs(ImFontAtlas* atlas, const ImFontBuilderIO* builder_io);
+IMGUI_API void          ImFontAtlasBuildCacheSaveToMemory(ImFontAtlas* atlas, ImU64 inputs_hash, ImVector<char>* out_buf);
+IMGUI_API bool          ImFontAtlasBuildCacheLoadFromMemory(ImFontAtlas* atlas, ImU64 inputs_hash, const void* data, size_t data_size);   // Return false and leave atlas untouched if data is invalid or doesn't match inputs_hash
+IMGUI_API bool          ImFontAtlasBuildCacheSaveToFile(ImFontAtlas* atlas, ImU64 inputs_hash, const char* filename);
+IMGUI_API bool          ImFontAtlasBuildCacheLoadFromFile(ImFontAtlas* atlas, ImU64 inputs_hash, const char* filename);
 
 // Helper for font builder
 #ifdef IMGUI_ENABLE_STB_TRUETYPE
@@ -3578,7 +3771,7 @@ IMGUI_API const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype();
 IMGUI_API void      ImFontAtlasUpdateConfigDataPointers(ImFontAtlas* atlas);
 IMGUI_API void      ImFontAtlasBuildInit(ImFontAtlas* atlas);
 IMGUI_API void      ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent);
-IMGUI_API void      ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opaque);
+IMGUI_API void      ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opaque, int rects_begin = 0);
 IMGUI_API void      ImFontAtlasBuildFinish(ImFontAtlas* atlas);
 IMGUI_API void      ImFontAtlasBuildRender8bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned char in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned int in_marker_pixel_value);
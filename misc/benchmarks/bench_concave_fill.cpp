@@ -0,0 +1,159 @@
+// Benchmark: ImDrawList::AddConcavePolyFilled() with large polygons (~10k vertices)
+// - Above IM_DRAWLIST_CONCAVE_EARCLIP_MAX points, a single contour goes through the sweep line triangulator, like multiple contours.
+// - Shapes are designed to stress the sweep line: many edges crossing a same line (comb, star), many holes, self-intersections.
+// - Check: area covered by the non anti-aliased fill must match the area of the shape.
+
+#include "imgui.h"
+#include "imgui_benchmarks.h"
+#include <stdio.h>
+#include <math.h>
+
+struct ConcaveFillShape
+{
+    const char*         Name;
+    ImVector<ImVec2>    Points;
+    ImVector<int>       ContoursNumPoints;
+    ImDrawFlags         Flags = ImDrawFlags_None;
+    bool                CheckArea = true;   // Only for shapes without self-intersections
+};
+
+static unsigned int RandomSeed = 1;
+static float RandomFloat() { RandomSeed = RandomSeed * 1664525u + 1013904223u; return (float)(RandomSeed >> 8) / 16777216.0f; }
+
+static void AddCircleContour(ConcaveFillShape* shape, ImVec2 center, float radius, int points_count, bool reverse)
+{
+    for (int n = 0; n < points_count; n++)
+    {
+        const float a = (reverse ? -1.0f : 1.0f) * (float)n * 2.0f * 3.14159265f / (float)points_count;
+        shape->Points.push_back(ImVec2(center.x + cosf(a) * radius, center.y + sinf(a) * radius));
+    }
+    shape->ContoursNumPoints.push_back(points_count);
+}
+
+static void InitShapes(ConcaveFillShape* shapes)
+{
+    // Star: ~5000 edges crossing the middle line
+    ConcaveFillShape* s = &shapes[0];
+    s->Name = "star";
+    for (int n = 0; n < 10000; n++)
+    {
+        const float a = (float)n * 2.0f * 3.14159265f / 10000.0f;
+        const float r = (n & 1) ? 200.0f : 400.0f;
+        s->Points.push_back(ImVec2(500.0f + cosf(a) * r, 500.0f + sinf(a) * r));
+    }
+    s->ContoursNumPoints.push_back(s->Points.Size);
+
+    // Random star-shaped polygon
+    s = &shapes[1];
+    s->Name = "random radius";
+    for (int n = 0; n < 10000; n++)
+    {
+        const float a = (float)n * 2.0f * 3.14159265f / 10000.0f;
+        const float r = 50.0f + 450.0f * RandomFloat();
+        s->Points.push_back(ImVec2(500.0f + cosf(a) * r, 500.0f + sinf(a) * r));
+    }
+    s->ContoursNumPoints.push_back(s->Points.Size);
+
+    // Comb: teeth of different lengths, every tip is on its own line
+    s = &shapes[2];
+    s->Name = "comb";
+    for (int n = 0; n < 4999; n++)
+    {
+        s->Points.push_back(ImVec2(n * 4.0f, 0.0f));
+        s->Points.push_back(ImVec2(n * 4.0f + 2.0f, 100.0f + n * 0.05f));
+    }
+    s->Points.push_back(ImVec2(4999 * 4.0f, 0.0f));
+    s->Points.push_back(ImVec2(4999 * 4.0f, 400.0f));
+    s->Points.push_back(ImVec2(0.0f, 400.0f));
+    s->ContoursNumPoints.push_back(s->Points.Size);
+
+    // Disc with 99 holes
+    s = &shapes[3];
+    s->Name = "disc with holes";
+    AddCircleContour(s, ImVec2(500.0f, 500.0f), 500.0f, 100, false);
+    for (int y = 0; y < 11; y++)
+        for (int x = 0; x < 11; x++)
+        {
+            const ImVec2 center(500.0f + (x - 5) * 60.0f, 500.0f + (y - 5) * 60.0f);
+            if (s->ContoursNumPoints.Size < 100 && (center.x - 500.0f) * (center.x - 500.0f) + (center.y - 500.0f) * (center.y - 500.0f) < 440.0f * 440.0f)
+                AddCircleContour(s, center, 25.0f, 100, true);
+        }
+
+    // Self-intersecting: random points, even-odd fill rule
+    s = &shapes[4];
+    s->Name = "random points";
+    for (int n = 0; n < 1000; n++)
+        s->Points.push_back(ImVec2(1000.0f * RandomFloat(), 1000.0f * RandomFloat()));
+    s->ContoursNumPoints.push_back(s->Points.Size);
+    s->Flags = ImDrawFlags_FillRuleEvenOdd;
+    s->CheckArea = false;
+}
+
+static double GetShapeArea(const ConcaveFillShape& shape)
+{
+    double area = 0.0;
+    const ImVec2* points = shape.Points.Data;
+    for (int contour_size : shape.ContoursNumPoints)
+    {
+        for (int i0 = contour_size - 1, i1 = 0; i1 < contour_size; i0 = i1++)
+            area += (double)points[i0].x * points[i1].y - (double)points[i1].x * points[i0].y;
+        points += contour_size;
+    }
+    return fabs(area) * 0.5;
+}
+
+static double GetDrawListArea(const ImDrawList* draw_list)
+{
+    double area = 0.0;
+    for (int n = 0; n + 2 < draw_list->IdxBuffer.Size; n += 3)
+    {
+        const ImVec2 a = draw_list->VtxBuffer[draw_list->IdxBuffer[n]].pos;
+        const ImVec2 b = draw_list->VtxBuffer[draw_list->IdxBuffer[n + 1]].pos;
+        const ImVec2 c = draw_list->VtxBuffer[draw_list->IdxBuffer[n + 2]].pos;
+        area += fabs(((double)b.x - a.x) * ((double)c.y - a.y) - ((double)c.x - a.x) * ((double)b.y - a.y)) * 0.5;
+    }
+    return area;
+}
+
+bool Benchmark_ConcaveFill()
+{
+    ImGui::CreateContext();
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    ConcaveFillShape shapes[5];
+    InitShapes(shapes);
+
+    bool ok = true;
+    printf("%-18s %8s %8s %12s %12s\n", "Shape", "Points", "Contours", "ms (AA)", "ms (no AA)");
+    for (const ConcaveFillShape& shape : shapes)
+    {
+        double ms[2];
+        for (int aa = 1; aa >= 0; aa--)
+        {
+            ms[aa ? 0 : 1] = BenchmarkMeasure([&]()
+            {
+                draw_list._ResetForNewFrame();
+                draw_list.Flags = aa ? ImDrawListFlags_AntiAliasedFill : ImDrawListFlags_None;
+                draw_list.PushClipRect(ImVec2(-10000.0f, -10000.0f), ImVec2(30000.0f, 30000.0f));
+                draw_list.PushTextureID(ImTextureID());
+                draw_list.AddConcavePolyFilled(shape.Points.Data, shape.ContoursNumPoints.Data, shape.ContoursNumPoints.Size, IM_COL32_WHITE, shape.Flags);
+            });
+        }
+        printf("%-18s %8d %8d %12.3f %12.3f\n", shape.Name, shape.Points.Size, shape.ContoursNumPoints.Size, ms[0], ms[1]);
+
+        // Draw list contains the non anti-aliased fill from the last call
+        if (shape.CheckArea)
+        {
+            const double expected_area = GetShapeArea(shape);
+            const double area = GetDrawListArea(&draw_list);
+            if (fabs(area - expected_area) > expected_area * 1e-4)
+            {
+                printf("  Error: filled area %.1f, expected %.1f\n", area, expected_area);
+                ok = false;
+            }
+        }
+    }
+
+    draw_list._ClearFreeMemory();
+    ImGui::DestroyContext();
+    return ok;
+}
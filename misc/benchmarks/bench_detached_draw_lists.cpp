@@ -0,0 +1,149 @@
+// Stress test: record detached draw lists from N threads (see ImGui::CreateDetachedDrawList()), while the main thread runs frames.
+// - Every frame, each thread records the same content, which is compared with a reference recorded by the main thread.
+//   A mismatch means that recording touched state shared with another thread (e.g. a scratch buffer).
+// - Output is spliced into a window with ImDrawList::AddDrawList(). Resulting clipping rectangles must never be inverted,
+//   including for callbacks whose clipping rectangle is outside of the window.
+// - Timings: average wall clock time per frame, for 1 to 16 threads.
+
+#include "imgui.h"
+#include "imgui_benchmarks.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <thread>
+
+static void DetachedDrawListsCallback(const ImDrawList*, const ImDrawCmd*)
+{
+}
+
+// Use primitives relying on scratch buffers (thick lines, concave fill), text, and a callback outside of the destination window
+static void RecordContent(ImDrawList* draw_list, int seed)
+{
+    ImVec2 star[80];
+    for (int n = 0; n < 100; n++)
+    {
+        const float x = (float)((seed * 131 + n * 37) % 1200);
+        const float y = (float)((seed * 71 + n * 53) % 680);
+        const ImU32 col = IM_COL32(n * 11, seed * 40, 255 - n, 255);
+        draw_list->AddRectFilled(ImVec2(x, y), ImVec2(x + 20.0f, y + 10.0f), col, 4.0f);
+        draw_list->AddCircle(ImVec2(x + 10.0f, y + 30.0f), 8.0f + (n % 5), col, 0, 2.0f);
+        draw_list->AddBezierCubic(ImVec2(x, y), ImVec2(x + 30.0f, y - 20.0f), ImVec2(x + 60.0f, y + 20.0f), ImVec2(x + 90.0f, y), col, 1.5f);
+        draw_list->AddText(ImVec2(x, y + 40.0f), col, "Detached draw list");
+        if ((n % 10) == 0)
+        {
+            for (int i = 0; i < IM_ARRAYSIZE(star); i++)
+            {
+                const float a = (float)i * 2.0f * 3.14159265f / IM_ARRAYSIZE(star);
+                const float r = (i & 1) ? 20.0f : 40.0f;
+                star[i] = ImVec2(x + cosf(a) * r, y + sinf(a) * r);
+            }
+            draw_list->AddConcavePolyFilled(star, IM_ARRAYSIZE(star), col);
+        }
+    }
+    draw_list->PushClipRect(ImVec2(-1000.0f, -1000.0f), ImVec2(-900.0f, -900.0f));
+    draw_list->AddCallback(DetachedDrawListsCallback, nullptr);
+    draw_list->PopClipRect();
+}
+
+static bool IsSameOutput(const ImDrawList* a, const ImDrawList* b)
+{
+    return a->VtxBuffer.Size == b->VtxBuffer.Size && a->IdxBuffer.Size == b->IdxBuffer.Size && a->CmdBuffer.Size == b->CmdBuffer.Size
+        && memcmp(a->VtxBuffer.Data, b->VtxBuffer.Data, (size_t)a->VtxBuffer.size_in_bytes()) == 0
+        && memcmp(a->IdxBuffer.Data, b->IdxBuffer.Data, (size_t)a->IdxBuffer.size_in_bytes()) == 0;
+}
+
+bool Benchmark_DetachedDrawLists()
+{
+    const int threads_max = 16;
+    const int frames_count = 30;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* tex_pixels = nullptr;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    ImDrawList* draw_lists[threads_max];
+    ImDrawList* references[threads_max];
+    for (int n = 0; n < threads_max; n++)
+    {
+        draw_lists[n] = ImGui::CreateDetachedDrawList("Thread");
+        references[n] = ImGui::CreateDetachedDrawList("Reference");
+    }
+
+    bool ok = true;
+    printf("%-8s %12s %12s\n", "Threads", "ms/frame", "Primitives");
+    for (int threads_count = 1; threads_count <= threads_max && ok; threads_count *= 2)
+    {
+        double total_ms = 0.0;
+        for (int frame_n = 0; frame_n < frames_count && ok; frame_n++)
+        {
+            io.DisplaySize = ImVec2(1280.0f, 720.0f);
+            io.DeltaTime = 1.0f / 60.0f;
+            ImGui::NewFrame();
+            if (frame_n == 0)
+                for (int n = 0; n < threads_count; n++)
+                {
+                    ImGui::SyncDetachedDrawList(references[n]);
+                    RecordContent(references[n], n);
+                }
+
+            // Record from worker threads, while main thread submits widgets
+            const double t0 = BenchmarkGetTime();
+            std::thread threads[threads_max];
+            for (int n = 0; n < threads_count; n++)
+            {
+                ImGui::SyncDetachedDrawList(draw_lists[n]);
+                threads[n] = std::thread(RecordContent, draw_lists[n], n);
+            }
+            static float value = 0.0f;
+            ImGui::Begin("Main thread");
+            for (int n = 0; n < 50; n++)
+            {
+                ImGui::PushID(n);
+                ImGui::SliderFloat("Value", &value, 0.0f, 1.0f);
+                ImGui::Button("Button");
+                ImGui::PopID();
+            }
+            ImGui::End();
+            for (int n = 0; n < threads_count; n++)
+                threads[n].join();
+            total_ms += BenchmarkGetTime() - t0;
+
+            // Check and splice output
+            ImGui::SetNextWindowPos(ImVec2(100.0f, 100.0f));
+            ImGui::SetNextWindowSize(ImVec2(600.0f, 400.0f));
+            ImGui::Begin("Output");
+            ImDrawList* window_draw_list = ImGui::GetWindowDrawList();
+            for (int n = 0; n < threads_count; n++)
+            {
+                if (!IsSameOutput(draw_lists[n], references[n]))
+                {
+                    printf("  Error: thread %d/%d output differs from reference on frame %d\n", n, threads_count, frame_n);
+                    ok = false;
+                }
+                window_draw_list->AddDrawList(draw_lists[n]);
+            }
+            for (const ImDrawCmd& cmd : window_draw_list->CmdBuffer)
+                if (cmd.ClipRect.z < cmd.ClipRect.x || cmd.ClipRect.w < cmd.ClipRect.y)
+                {
+                    printf("  Error: inverted clipping rectangle (%.1f,%.1f)-(%.1f,%.1f)%s\n", cmd.ClipRect.x, cmd.ClipRect.y, cmd.ClipRect.z, cmd.ClipRect.w, cmd.UserCallback ? " in callback" : "");
+                    ok = false;
+                    break;
+                }
+            ImGui::End();
+            ImGui::Render();
+        }
+        printf("%-8d %12.3f %12d\n", threads_count, total_ms / frames_count, threads_count * 100 * 4);
+    }
+
+    for (int n = 0; n < threads_max; n++)
+    {
+        ImGui::DestroyDetachedDrawList(draw_lists[n]);
+        ImGui::DestroyDetachedDrawList(references[n]);
+    }
+    ImGui::DestroyContext();
+    return ok;
+}
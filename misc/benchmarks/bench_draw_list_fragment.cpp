@@ -0,0 +1,155 @@
+// Benchmark: ImDrawListFragment, replaying recorded output with ImDrawList::AddFragment() instead of drawing again
+// - Content: a static node graph (rounded boxes, borders, text, circles, bezier links), like large custom drawings which don't change every frame.
+// - Timings: drawing directly, recording (BeginFragment()/EndFragment() around drawing), replaying as-is, replaying with a translation and/or a color multiply.
+// - Check: replayed triangles must match drawing directly (translated by the replay offset).
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "imgui_benchmarks.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+static const int FRAGMENT_NODES_COUNT = 500;
+
+static void DrawNodeGraph(ImDrawList* draw_list, const ImVec2& offset)
+{
+    char title[32];
+    for (int n = 0; n < FRAGMENT_NODES_COUNT; n++)
+    {
+        const ImVec2 pos = offset + ImVec2((float)(n % 25) * 120.0f, (float)(n / 25) * 80.0f);
+        const ImU32 col = IM_COL32(60 + (n * 7) % 150, 60 + (n * 13) % 150, 90, 255);
+        draw_list->AddRectFilled(pos, pos + ImVec2(100.0f, 60.0f), col, 6.0f);
+        draw_list->AddRect(pos, pos + ImVec2(100.0f, 60.0f), IM_COL32_WHITE, 6.0f, 0, 1.5f);
+        snprintf(title, IM_ARRAYSIZE(title), "Node %d", n);
+        draw_list->AddText(pos + ImVec2(8.0f, 4.0f), IM_COL32_WHITE, title);
+        for (int port_n = 0; port_n < 3; port_n++)
+            draw_list->AddCircleFilled(pos + ImVec2(100.0f, 20.0f + port_n * 15.0f), 4.0f, IM_COL32(200, 200, 100, 255));
+        if ((n % 25) != 24)
+            draw_list->AddBezierCubic(pos + ImVec2(100.0f, 20.0f), pos + ImVec2(110.0f, 20.0f), pos + ImVec2(110.0f, 50.0f), pos + ImVec2(120.0f, 50.0f), IM_COL32(200, 200, 100, 255), 2.0f);
+    }
+}
+
+static void ResetDrawList(ImDrawList* draw_list)
+{
+    draw_list->_ResetForNewFrame();
+    draw_list->Flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill | ImDrawListFlags_AllowVtxOffset; // More than 64k vertices
+    draw_list->PushClipRect(ImVec2(-10000.0f, -10000.0f), ImVec2(10000.0f, 10000.0f));
+    draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+}
+
+// Vertices of all triangles, in order (commands may be split at different places when using ImDrawCmd::VtxOffset)
+static void GetTrianglesVertices(const ImDrawList* draw_list, ImVector<ImDrawVert>* out)
+{
+    out->resize(0);
+    for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        for (unsigned int idx_n = cmd.IdxOffset; idx_n < cmd.IdxOffset + cmd.ElemCount; idx_n++)
+            out->push_back(draw_list->VtxBuffer[cmd.VtxOffset + draw_list->IdxBuffer[idx_n]]);
+}
+
+// Compare triangles of 'replay' with those of 'reference' translated by 'offset'. Colors are only compared without tint.
+static bool IsSameTriangles(const ImDrawList* replay, const ImDrawList* reference, const ImVec2& offset, bool compare_colors)
+{
+    ImVector<ImDrawVert> replay_vertices, reference_vertices;
+    GetTrianglesVertices(replay, &replay_vertices);
+    GetTrianglesVertices(reference, &reference_vertices);
+    if (replay_vertices.Size != reference_vertices.Size || replay_vertices.Size != reference->IdxBuffer.Size)
+        return false;
+    for (int n = 0; n < replay_vertices.Size; n++)
+    {
+        const ImVec2 pos_a = ImDrawVert_GetPos(&replay_vertices[n]);
+        const ImVec2 pos_b = ImDrawVert_GetPos(&reference_vertices[n]) + offset;
+        if (fabsf(pos_a.x - pos_b.x) > 1e-3f || fabsf(pos_a.y - pos_b.y) > 1e-3f || (compare_colors && replay_vertices[n].col != reference_vertices[n].col))
+            return false;
+    }
+    return true;
+}
+
+bool Benchmark_DrawListFragment()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    unsigned char* tex_pixels = nullptr;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    io.DisplaySize = ImVec2(1280.0f, 720.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame(); // Setup font in shared draw list data
+
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    ImDrawList reference(ImGui::GetDrawListSharedData());
+    ImDrawListFragment fragment;
+    const ImGuiID fragment_id = 0x1234;
+    const ImVec2 replay_offset(10.0f, 20.5f);
+
+    ResetDrawList(&reference);
+    DrawNodeGraph(&reference, ImVec2(0.0f, 0.0f));
+
+    printf("%-22s %10s %10s\n", "Mode", "ms", "Vertices");
+    const double draw_ms = BenchmarkMeasure([&]()
+    {
+        ResetDrawList(&draw_list);
+        DrawNodeGraph(&draw_list, ImVec2(0.0f, 0.0f));
+    });
+    printf("%-22s %10.3f %10d\n", "draw", draw_ms, draw_list.VtxBuffer.Size);
+
+    const double record_ms = BenchmarkMeasure([&]()
+    {
+        ResetDrawList(&draw_list);
+        draw_list.BeginFragment(&fragment, fragment_id);
+        DrawNodeGraph(&draw_list, ImVec2(0.0f, 0.0f));
+        draw_list.EndFragment(&fragment);
+    });
+    printf("%-22s %10.3f %10d\n", "record", record_ms, fragment.VtxBuffer.Size);
+
+    bool ok = true;
+    if (!fragment.IsValid(fragment_id))
+    {
+        printf("  Error: fragment is not valid after recording\n");
+        ok = false;
+    }
+
+    const double replay_ms = BenchmarkMeasure([&]()
+    {
+        ResetDrawList(&draw_list);
+        draw_list.AddFragment(&fragment);
+    });
+    printf("%-22s %10.3f %10d\n", "replay", replay_ms, draw_list.VtxBuffer.Size);
+    if (!IsSameTriangles(&draw_list, &reference, ImVec2(0.0f, 0.0f), true))
+    {
+        printf("  Error: replayed output differs from drawing directly\n");
+        ok = false;
+    }
+
+    struct ReplayConfig { const char* Name; ImVec2 Offset; ImU32 ColMul; };
+    const ReplayConfig replay_configs[] =
+    {
+        { "replay, offset",         replay_offset,          IM_COL32_WHITE },
+        { "replay, alpha",          ImVec2(0.0f, 0.0f),     IM_COL32(255, 255, 255, 128) },
+        { "replay, offset+tint",    replay_offset,          IM_COL32(255, 128, 64, 128) },
+    };
+    for (const ReplayConfig& config : replay_configs)
+    {
+        const double ms = BenchmarkMeasure([&]()
+        {
+            ResetDrawList(&draw_list);
+            draw_list.AddFragment(&fragment, config.Offset, config.ColMul);
+        });
+        printf("%-22s %10.3f %10d\n", config.Name, ms, draw_list.VtxBuffer.Size);
+        if (!IsSameTriangles(&draw_list, &reference, config.Offset, config.ColMul == IM_COL32_WHITE))
+        {
+            printf("  Error: '%s' replayed output differs from drawing directly\n", config.Name);
+            ok = false;
+        }
+    }
+    printf("Replay speedup: %.1fx\n", draw_ms / replay_ms);
+
+    fragment.Clear();
+    draw_list._ClearFreeMemory();
+    reference._ClearFreeMemory();
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    return ok;
+}
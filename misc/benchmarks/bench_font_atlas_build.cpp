@@ -0,0 +1,143 @@
+// Benchmark: ImFontAtlas::Build() at application startup, with glyphs rasterized by ImFontAtlas::ParallelForFunc jobs on 1 to 16 threads
+// - Atlas: 4 fonts from misc/fonts/ at 3 sizes each, Latin + Cyrillic + Greek glyph ranges, 2x2 oversampling.
+// - Timings: Build() with no ParallelForFunc, then with a ParallelForFunc spawning 1, 4, 8 and 16 threads. Speedup is relative to no ParallelForFunc.
+//   Only glyph rendering runs in parallel: the speedup is bounded by font loading and packing, and by the number of cores on the machine.
+// - Check: texture and glyphs must be identical to the single-threaded build.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "imgui_benchmarks.h"
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+
+struct FontAtlasBuildThreads
+{
+    int                 ThreadsCount;
+    ImFontAtlasJobFunc  JobFunc;
+    void*               JobData;
+    int                 JobsCount;
+    std::atomic<int>    NextJob;
+};
+
+static void FontAtlasBuildThreadMain(FontAtlasBuildThreads* threads)
+{
+    for (int job_n = threads->NextJob++; job_n < threads->JobsCount; job_n = threads->NextJob++)
+        threads->JobFunc(threads->JobData, job_n);
+}
+
+// Minimal ImFontAtlas::ParallelForFunc: spawn threads which pull jobs from a shared counter
+static void FontAtlasBuildParallelFor(ImFontAtlasJobFunc job_func, void* job_data, int jobs_count, void* user_data)
+{
+    FontAtlasBuildThreads* threads = (FontAtlasBuildThreads*)user_data;
+    threads->JobFunc = job_func;
+    threads->JobData = job_data;
+    threads->JobsCount = jobs_count;
+    threads->NextJob = 0;
+    std::thread workers[16];
+    IM_ASSERT(threads->ThreadsCount <= IM_ARRAYSIZE(workers));
+    for (int n = 1; n < threads->ThreadsCount; n++)
+        workers[n] = std::thread(FontAtlasBuildThreadMain, threads);
+    FontAtlasBuildThreadMain(threads);
+    for (int n = 1; n < threads->ThreadsCount; n++)
+        workers[n].join();
+}
+
+struct FontAtlasBuildFontFile
+{
+    const char* Filename;
+    void*       Data;
+    size_t      DataSize;
+};
+
+static void AddFonts(ImFontAtlas* atlas, const FontAtlasBuildFontFile* files, int files_count, const ImWchar* ranges)
+{
+    const float sizes[] = { 13.0f, 18.0f, 26.0f };
+    for (int file_n = 0; file_n < files_count; file_n++)
+        for (float size : sizes)
+        {
+            ImFontConfig cfg;
+            cfg.FontDataOwnedByAtlas = false;
+            cfg.OversampleH = cfg.OversampleV = 2;
+            atlas->AddFontFromMemoryTTF(files[file_n].Data, (int)files[file_n].DataSize, size, &cfg, ranges);
+        }
+}
+
+static ImU32 GetAtlasHash(ImFontAtlas* atlas)
+{
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+    ImU32 hash = ImHashData(pixels, (size_t)width * height);
+    for (ImFont* font : atlas->Fonts)
+        hash = ImHashData(font->Glyphs.Data, (size_t)font->Glyphs.size_in_bytes(), hash);
+    return hash;
+}
+
+bool Benchmark_FontAtlasBuild()
+{
+    FontAtlasBuildFontFile files[] =
+    {
+        { "../../misc/fonts/Roboto-Medium.ttf",   nullptr, 0 },
+        { "../../misc/fonts/Cousine-Regular.ttf", nullptr, 0 },
+        { "../../misc/fonts/DroidSans.ttf",       nullptr, 0 },
+        { "../../misc/fonts/Karla-Regular.ttf",   nullptr, 0 },
+    };
+    for (FontAtlasBuildFontFile& file : files)
+        if ((file.Data = ImFileLoadToMemory(file.Filename, "rb", &file.DataSize)) == NULL)
+        {
+            printf("  Error: could not load '%s' (run from misc/benchmarks/)\n", file.Filename);
+            return false;
+        }
+
+    ImVector<ImWchar> ranges;
+    ImFontGlyphRangesBuilder ranges_builder;
+    ImFontAtlas ranges_atlas;
+    ranges_builder.AddRanges(ranges_atlas.GetGlyphRangesCyrillic());
+    ranges_builder.AddRanges(ranges_atlas.GetGlyphRangesGreek());
+    ranges_builder.BuildRanges(&ranges);
+
+    bool ok = true;
+    ImU32 reference_hash = 0;
+    double reference_ms = 0.0;
+    printf("%-8s %10s %10s %10s %10s\n", "Threads", "ms", "Speedup", "Jobs", "Hash");
+    const int threads_counts[] = { 0, 1, 4, 8, 16 };
+    for (int threads_count : threads_counts)
+    {
+        FontAtlasBuildThreads threads;
+        threads.ThreadsCount = threads_count;
+        int jobs_count = 0;
+        ImU32 hash = 0;
+        const double ms = BenchmarkMeasure([&]()
+        {
+            ImFontAtlas atlas;
+            if (threads_count > 0)
+            {
+                atlas.ParallelForFunc = FontAtlasBuildParallelFor;
+                atlas.ParallelForUserData = &threads;
+            }
+            AddFonts(&atlas, files, IM_ARRAYSIZE(files), ranges.Data);
+            atlas.Build();
+            jobs_count = (threads_count > 0) ? threads.JobsCount : 1;
+            hash = GetAtlasHash(&atlas);
+        });
+        if (threads_count == 0)
+        {
+            reference_hash = hash;
+            reference_ms = ms;
+            printf("%-8s %10.2f %10.2f %10d   %08X\n", "none", ms, 1.0, jobs_count, hash);
+        }
+        else
+            printf("%-8d %10.2f %10.2f %10d   %08X\n", threads_count, ms, reference_ms / ms, jobs_count, hash);
+        if (hash != reference_hash)
+        {
+            printf("  Error: output with %d threads differs from single-threaded build\n", threads_count);
+            ok = false;
+        }
+    }
+    printf("(%u hardware threads)\n", std::thread::hardware_concurrency());
+
+    for (FontAtlasBuildFontFile& file : files)
+        IM_FREE(file.Data);
+    return ok;
+}
@@ -0,0 +1,80 @@
+// Benchmark: ImDrawList::AddPolyline() with large polylines (10k points), which spends most of its time computing normals (SSE/NEON code paths)
+// - Anti-aliased and non anti-aliased, thin and thick, open and closed.
+// - Check: all vertices must be finite and close to the polyline (normals are never longer than 10 times the thickness).
+// - Hash: hash of the vertex buffer, to compare the output of builds with different SIMD settings (e.g. IMGUI_DISABLE_SSE).
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "imgui_benchmarks.h"
+#include <stdio.h>
+#include <math.h>
+
+struct PolylineConfig
+{
+    const char*     Name;
+    ImDrawListFlags Flags;
+    float           Thickness;
+};
+
+bool Benchmark_Polyline()
+{
+    ImGui::CreateContext();
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+
+    // Sine wave with increasing frequency (sharp joins at the end), and circle
+    const int points_count = 10000;
+    ImVector<ImVec2> wave, circle;
+    wave.resize(points_count);
+    circle.resize(points_count);
+    for (int n = 0; n < points_count; n++)
+    {
+        const float t = (float)n / points_count;
+        wave[n] = ImVec2(t * 1000.0f, 500.0f + sinf(t * t * 2000.0f) * 200.0f);
+        circle[n] = ImVec2(500.0f + cosf(t * 2.0f * 3.14159265f) * 400.0f, 500.0f + sinf(t * 2.0f * 3.14159265f) * 400.0f);
+    }
+
+    const PolylineConfig configs[] =
+    {
+        { "AA, thin",       ImDrawListFlags_AntiAliasedLines,   1.0f },
+        { "AA, thick",      ImDrawListFlags_AntiAliasedLines,   4.0f },
+        { "no AA, thin",    ImDrawListFlags_None,               1.0f },
+        { "no AA, thick",   ImDrawListFlags_None,               4.0f },
+    };
+
+    bool ok = true;
+    printf("%-8s %-14s %10s %10s %10s\n", "Shape", "Config", "ms", "Vertices", "Hash");
+    for (int shape_n = 0; shape_n < 2; shape_n++)
+        for (const PolylineConfig& config : configs)
+        {
+            const ImVector<ImVec2>& points = (shape_n == 0) ? wave : circle;
+            const ImDrawFlags flags = (shape_n == 0) ? ImDrawFlags_None : ImDrawFlags_Closed;
+            const double ms = BenchmarkMeasure([&]()
+            {
+                draw_list._ResetForNewFrame();
+                draw_list.Flags = config.Flags;
+                draw_list.PushClipRect(ImVec2(-10000.0f, -10000.0f), ImVec2(10000.0f, 10000.0f));
+                draw_list.PushTextureID(ImTextureID());
+                draw_list.AddPolyline(points.Data, points.Size, IM_COL32_WHITE, flags, config.Thickness);
+            });
+
+            const float margin = config.Thickness * 10.0f + 2.0f;
+            int bad_count = 0;
+            for (const ImDrawVert& vtx : draw_list.VtxBuffer)
+            {
+                const ImVec2 pos = ImDrawVert_GetPos(&vtx);
+                if (!(pos.x >= -margin && pos.x <= 1000.0f + margin && pos.y >= 100.0f - margin && pos.y <= 900.0f + margin))
+                    bad_count++;
+            }
+            printf("%-8s %-14s %10.3f %10d   %08X\n", (shape_n == 0) ? "wave" : "circle", config.Name, ms, draw_list.VtxBuffer.Size,
+                ImHashData(draw_list.VtxBuffer.Data, (size_t)draw_list.VtxBuffer.size_in_bytes()));
+            if (bad_count > 0)
+            {
+                printf("  Error: %d vertices are not finite or too far from the polyline\n", bad_count);
+                ok = false;
+            }
+        }
+
+    draw_list._ClearFreeMemory();
+    ImGui::DestroyContext();
+    return ok;
+}
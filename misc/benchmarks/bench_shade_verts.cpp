@@ -0,0 +1,158 @@
+// Benchmark: ImGui::ShadeVertsXXX() functions (SSE/NEON code paths)
+// - Each function is compared with a copy of the scalar loop, on the same 100k vertices.
+//   Non-clamped ShadeVertsLinearUV() and ImDrawData::ScaleClipRects() have no SIMD path, as SIMD versions measured no faster than the scalar loops.
+// - Check: output must match the scalar loop. It is expected to be bit-identical, but compilers contracting
+//   multiply-adds into FMA (e.g. GCC on AArch64) may do it differently in both paths: the last bit may differ then.
+// - Timings: milliseconds per call, for the scalar loop and for the library function.
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "imgui_benchmarks.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+static unsigned int RandomSeed = 1;
+static float RandomFloat(float min, float max) { RandomSeed = RandomSeed * 1664525u + 1013904223u; return min + (max - min) * (float)(RandomSeed >> 8) / 16777216.0f; }
+
+// Scalar loops, as in imgui_draw.cpp without SIMD
+static void ReferenceLinearColorGradientKeepAlpha(ImDrawVert* vert, ImDrawVert* vert_end, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1)
+{
+    ImVec2 gradient_extent = gradient_p1 - gradient_p0;
+    float gradient_inv_length2 = 1.0f / ImLengthSqr(gradient_extent);
+    const int col0_r = (int)(col0 >> IM_COL32_R_SHIFT) & 0xFF;
+    const int col0_g = (int)(col0 >> IM_COL32_G_SHIFT) & 0xFF;
+    const int col0_b = (int)(col0 >> IM_COL32_B_SHIFT) & 0xFF;
+    const int col_delta_r = ((int)(col1 >> IM_COL32_R_SHIFT) & 0xFF) - col0_r;
+    const int col_delta_g = ((int)(col1 >> IM_COL32_G_SHIFT) & 0xFF) - col0_g;
+    const int col_delta_b = ((int)(col1 >> IM_COL32_B_SHIFT) & 0xFF) - col0_b;
+    for (; vert < vert_end; vert++)
+    {
+        float d = ImDot(ImDrawVert_GetPos(vert) - gradient_p0, gradient_extent);
+        float t = ImClamp(d * gradient_inv_length2, 0.0f, 1.0f);
+        int r = (int)(col0_r + col_delta_r * t);
+        int g = (int)(col0_g + col_delta_g * t);
+        int b = (int)(col0_b + col_delta_b * t);
+        vert->col = (r << IM_COL32_R_SHIFT) | (g << IM_COL32_G_SHIFT) | (b << IM_COL32_B_SHIFT) | (vert->col & IM_COL32_A_MASK);
+    }
+}
+
+static void ReferenceLinearUV(ImDrawVert* vertex, ImDrawVert* vert_end, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp)
+{
+    const ImVec2 size = b - a;
+    const ImVec2 uv_size = uv_b - uv_a;
+    const ImVec2 scale = ImVec2(size.x != 0.0f ? (uv_size.x / size.x) : 0.0f, size.y != 0.0f ? (uv_size.y / size.y) : 0.0f);
+    const ImVec2 min = ImMin(uv_a, uv_b);
+    const ImVec2 max = ImMax(uv_a, uv_b);
+    for (; vertex < vert_end; ++vertex)
+        ImDrawVert_SetUV(vertex, clamp ? ImClamp(uv_a + ImMul(ImDrawVert_GetPos(vertex) - a, scale), min, max) : uv_a + ImMul(ImDrawVert_GetPos(vertex) - a, scale));
+}
+
+static void ReferenceTransformPos(ImDrawVert* vertex, ImDrawVert* vert_end, const ImVec2& pivot_in, float cos_a, float sin_a, const ImVec2& pivot_out)
+{
+    for (; vertex < vert_end; ++vertex)
+        ImDrawVert_SetPos(vertex, ImRotate(ImDrawVert_GetPos(vertex) - pivot_in, cos_a, sin_a) + pivot_out);
+}
+
+// Compare float arrays: return largest difference relative to magnitude, 0.0f when bit-identical
+static float CompareFloats(const float* a, const float* b, int count)
+{
+    float max_diff = 0.0f;
+    for (int n = 0; n < count; n++)
+        if (memcmp(&a[n], &b[n], sizeof(float)) != 0)
+            max_diff = ImMax(max_diff, (a[n] != a[n] || b[n] != b[n]) ? 1.0f : ImFabs(a[n] - b[n]) / ImMax(1.0f, ImFabs(a[n])));
+    return max_diff;
+}
+
+static float CompareVertices(const ImVector<ImDrawVert>& a, const ImVector<ImDrawVert>& b)
+{
+    float max_diff = 0.0f;
+    for (int n = 0; n < a.Size; n++)
+    {
+        const ImVec2 pos_a = ImDrawVert_GetPos(&a[n]), pos_b = ImDrawVert_GetPos(&b[n]);
+        const ImVec2 uv_a = ImDrawVert_GetUV(&a[n]), uv_b = ImDrawVert_GetUV(&b[n]);
+        max_diff = ImMax(max_diff, ImMax(CompareFloats(&pos_a.x, &pos_b.x, 2), CompareFloats(&uv_a.x, &uv_b.x, 2)));
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            const int channel_diff = ImAbs((int)((a[n].col >> shift) & 0xFF) - (int)((b[n].col >> shift) & 0xFF));
+            max_diff = ImMax(max_diff, (float)channel_diff / 255.0f);
+        }
+    }
+    return max_diff;
+}
+
+bool Benchmark_ShadeVerts()
+{
+    const int vtx_count = 100000;
+    ImGui::CreateContext();
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    ImDrawList reference(ImGui::GetDrawListSharedData());
+
+    // Random vertices around a 1000x1000 rectangle, so UV clamping and gradient clamping are exercised.
+    // A few exact values (pivots, bounds) are included.
+    ImVector<ImDrawVert> source;
+    source.resize(vtx_count);
+    for (int n = 0; n < vtx_count; n++)
+    {
+        ImDrawVert_Write(&source[n], RandomFloat(-200.0f, 1200.0f), RandomFloat(-200.0f, 1200.0f), 0.0f, 0.0f, IM_COL32(n & 0xFF, 128, 255, (n * 7) & 0xFF));
+        if ((n % 1000) == 0)
+            ImDrawVert_SetPos(&source[n], ImVec2(((n / 1000) & 1) ? 1000.0f : 0.0f, 0.0f));
+    }
+
+    bool ok = true;
+    printf("%-32s %12s %12s %12s\n", "Function", "ms (scalar)", "ms", "Max diff");
+    for (int func_n = 0; func_n < 3; func_n++)
+    {
+        const char* name = NULL;
+        auto apply = [&](bool use_reference)
+        {
+            ImDrawList* dst = use_reference ? &reference : &draw_list;
+            ImDrawVert* vtx = dst->VtxBuffer.Data;
+            switch (func_n)
+            {
+            case 0:
+                name = "ShadeVertsLinearColorGradient";
+                if (use_reference)
+                    ReferenceLinearColorGradientKeepAlpha(vtx, vtx + vtx_count, ImVec2(100.0f, 50.0f), ImVec2(900.0f, 700.0f), IM_COL32(255, 20, 0, 255), IM_COL32(0, 200, 255, 0));
+                else
+                    ImGui::ShadeVertsLinearColorGradientKeepAlpha(dst, 0, vtx_count, ImVec2(100.0f, 50.0f), ImVec2(900.0f, 700.0f), IM_COL32(255, 20, 0, 255), IM_COL32(0, 200, 255, 0));
+                break;
+            case 1:
+                name = "ShadeVertsLinearUV (clamp)";
+                if (use_reference)
+                    ReferenceLinearUV(vtx, vtx + vtx_count, ImVec2(0.0f, 0.0f), ImVec2(1000.0f, 1000.0f), ImVec2(0.1f, 0.7f), ImVec2(0.3f, 0.2f), true);
+                else
+                    ImGui::ShadeVertsLinearUV(dst, 0, vtx_count, ImVec2(0.0f, 0.0f), ImVec2(1000.0f, 1000.0f), ImVec2(0.1f, 0.7f), ImVec2(0.3f, 0.2f), true);
+                break;
+            case 2:
+                name = "ShadeVertsTransformPos";
+                if (use_reference)
+                    ReferenceTransformPos(vtx, vtx + vtx_count, ImVec2(500.0f, 500.0f), cosf(0.3f), sinf(0.3f), ImVec2(640.0f, 360.0f));
+                else
+                    ImGui::ShadeVertsTransformPos(dst, 0, vtx_count, ImVec2(500.0f, 500.0f), cosf(0.3f), sinf(0.3f), ImVec2(640.0f, 360.0f));
+                break;
+            }
+        };
+
+        // Compare output of a single call, then measure repeated calls on the same vertices
+        reference.VtxBuffer = source;
+        draw_list.VtxBuffer = source;
+        apply(true);
+        apply(false);
+        const float max_diff = CompareVertices(draw_list.VtxBuffer, reference.VtxBuffer);
+        const double ms_reference = BenchmarkMeasure([&]() { apply(true); });
+        const double ms = BenchmarkMeasure([&]() { apply(false); });
+        printf("%-32s %12.3f %12.3f %12g\n", name, ms_reference, ms, max_diff);
+        if (max_diff > 1e-5f)
+        {
+            printf("  Error: output differs from scalar loop\n");
+            ok = false;
+        }
+    }
+
+    draw_list._ClearFreeMemory();
+    reference._ClearFreeMemory();
+    ImGui::DestroyContext();
+    return ok;
+}
@@ -0,0 +1,194 @@
+// Benchmark: ImDrawListSplitter::Merge() with 64 channels, like a table with 64 columns (each column is recorded into its own channel)
+// - Merge only: same clipping rectangle in all channels (commands are merged, like tables merging columns), or one per channel.
+//   Only the Merge() call is timed. Channel 0 is left empty or used: tables always use it, the empty case swaps storage with the first channel instead of copying it.
+// - Check: merged commands and triangles must match a draw list recording the same content in channel order, and the merged buffers must be consistent.
+// - Table frame: full NewFrame()/Render() with a 64 columns table, for reference.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "imgui_benchmarks.h"
+#include <stdio.h>
+#include <string.h>
+
+struct SplitterMergeConfig
+{
+    const char* Name;
+    bool        SameClipRect;
+    bool        UseChannel0;
+};
+
+static const int SPLITTER_COLUMNS = 64;
+static const int SPLITTER_ROWS = 100;
+
+static void RecordCell(ImDrawList* draw_list, int column_n, int row_n)
+{
+    const float x = column_n * 20.0f;
+    const float y = row_n * 10.0f;
+    const ImU32 col = IM_COL32(column_n * 4, row_n * 2, 255, 255);
+    draw_list->AddRectFilled(ImVec2(x, y), ImVec2(x + 18.0f, y + 8.0f), col);
+    draw_list->AddLine(ImVec2(x, y + 9.0f), ImVec2(x + 18.0f, y + 9.0f), col);
+}
+
+static ImVec4 GetColumnClipRect(const SplitterMergeConfig& config, int column_n)
+{
+    if (config.SameClipRect || column_n < 0)
+        return ImVec4(0.0f, 0.0f, 2000.0f, 2000.0f);
+    return ImVec4(column_n * 20.0f, 0.0f, column_n * 20.0f + 20.0f, 2000.0f);
+}
+
+// Record cells row by row, switching channels for each column.
+// Like tables, change clipping rectangle before switching channel (see ImGui::SetWindowClipRectBeforeSetChannel()).
+static void RecordSplit(ImDrawList* draw_list, ImDrawListSplitter* splitter, const SplitterMergeConfig& config)
+{
+    draw_list->_ResetForNewFrame();
+    draw_list->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(2000.0f, 2000.0f));
+    draw_list->PushTextureID(ImTextureID());
+    splitter->Split(draw_list, SPLITTER_COLUMNS + 1);
+    for (int row_n = 0; row_n < SPLITTER_ROWS; row_n++)
+        for (int column_n = config.UseChannel0 ? -1 : 0; column_n < SPLITTER_COLUMNS; column_n++)
+        {
+            const ImVec4 clip_rect = GetColumnClipRect(config, column_n);
+            draw_list->_CmdHeader.ClipRect = draw_list->_ClipRectStack.back() = clip_rect;
+            splitter->SetCurrentChannel(draw_list, column_n + 1);
+            if (column_n < 0)
+                draw_list->AddRectFilled(ImVec2(0.0f, row_n * 10.0f), ImVec2(SPLITTER_COLUMNS * 20.0f, row_n * 10.0f + 10.0f), IM_COL32(0, 0, 0, 255));
+            else
+                RecordCell(draw_list, column_n, row_n);
+        }
+}
+
+// Record the same content in channel order
+static void RecordReference(ImDrawList* draw_list, const SplitterMergeConfig& config)
+{
+    draw_list->_ResetForNewFrame();
+    draw_list->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(2000.0f, 2000.0f));
+    draw_list->PushTextureID(ImTextureID());
+    if (config.UseChannel0)
+        for (int row_n = 0; row_n < SPLITTER_ROWS; row_n++)
+            draw_list->AddRectFilled(ImVec2(0.0f, row_n * 10.0f), ImVec2(SPLITTER_COLUMNS * 20.0f, row_n * 10.0f + 10.0f), IM_COL32(0, 0, 0, 255));
+    for (int column_n = 0; column_n < SPLITTER_COLUMNS; column_n++)
+    {
+        const ImVec4 clip_rect = GetColumnClipRect(config, column_n);
+        draw_list->PushClipRect(ImVec2(clip_rect.x, clip_rect.y), ImVec2(clip_rect.z, clip_rect.w));
+        for (int row_n = 0; row_n < SPLITTER_ROWS; row_n++)
+            RecordCell(draw_list, column_n, row_n);
+        draw_list->PopClipRect();
+    }
+    draw_list->_PopUnusedDrawCmd();
+}
+
+static bool IsSameOutput(const ImDrawList* a, const ImDrawList* b)
+{
+    if (a->IdxBuffer.Size != b->IdxBuffer.Size || a->CmdBuffer.Size != b->CmdBuffer.Size)
+        return false;
+    for (int n = 0; n < a->CmdBuffer.Size; n++)
+        if (memcmp(&a->CmdBuffer[n].ClipRect, &b->CmdBuffer[n].ClipRect, sizeof(ImVec4)) != 0 || a->CmdBuffer[n].ElemCount != b->CmdBuffer[n].ElemCount)
+            return false;
+    for (int n = 0; n < a->IdxBuffer.Size; n++)
+        if (memcmp(&a->VtxBuffer[a->IdxBuffer[n]], &b->VtxBuffer[b->IdxBuffer[n]], sizeof(ImDrawVert)) != 0)
+            return false;
+    return true;
+}
+
+static bool IsConsistent(const ImDrawList* draw_list)
+{
+    unsigned int idx_offset = 0;
+    for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+    {
+        if (cmd.IdxOffset != idx_offset)
+            return false;
+        idx_offset += cmd.ElemCount;
+    }
+    if (idx_offset != (unsigned int)draw_list->IdxBuffer.Size || draw_list->_IdxWritePtr != draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size)
+        return false;
+    for (ImDrawIdx idx : draw_list->IdxBuffer)
+        if ((int)idx >= draw_list->VtxBuffer.Size)
+            return false;
+    return true;
+}
+
+bool Benchmark_SplitterMerge()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* tex_pixels = nullptr;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    ImDrawList reference(ImGui::GetDrawListSharedData());
+    ImDrawListSplitter splitter;
+
+    const SplitterMergeConfig configs[] =
+    {
+        { "same clip rect",             true,   false },
+        { "same clip rect, ch0",        true,   true },
+        { "clip rect per column",       false,  false },
+        { "clip rect per column, ch0",  false,  true },
+    };
+
+    bool ok = true;
+    printf("%-26s %10s %10s %10s\n", "Config", "ms (merge)", "Commands", "Indices");
+    for (const SplitterMergeConfig& config : configs)
+    {
+        // Check output of the first merge, then time Merge() only
+        RecordSplit(&draw_list, &splitter, config);
+        splitter.Merge(&draw_list);
+        RecordReference(&reference, config);
+        if (!IsConsistent(&draw_list) || !IsSameOutput(&draw_list, &reference))
+        {
+            printf("  Error: '%s' merged output differs from reference\n", config.Name);
+            ok = false;
+        }
+        const int cmd_count = draw_list.CmdBuffer.Size;
+
+        double total_ms = 0.0;
+        int calls_count = 0;
+        const double t_end = BenchmarkGetTime() + 200.0;
+        do
+        {
+            RecordSplit(&draw_list, &splitter, config);
+            const double t0 = BenchmarkGetTime();
+            splitter.Merge(&draw_list);
+            total_ms += BenchmarkGetTime() - t0;
+            calls_count++;
+        }
+        while (BenchmarkGetTime() < t_end);
+        printf("%-26s %10.4f %10d %10d\n", config.Name, total_ms / calls_count, cmd_count, draw_list.IdxBuffer.Size);
+    }
+    splitter.ClearFreeMemory();
+    draw_list._ClearFreeMemory();
+    reference._ClearFreeMemory();
+
+    // Table frame: each column has its own channel, merged by EndTable()
+    const double frame_ms = BenchmarkMeasure([&]()
+    {
+        io.DisplaySize = ImVec2(1280.0f, 720.0f);
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Table");
+        if (ImGui::BeginTable("64 columns", SPLITTER_COLUMNS, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY))
+        {
+            for (int row_n = 0; row_n < SPLITTER_ROWS; row_n++)
+            {
+                ImGui::TableNextRow();
+                for (int column_n = 0; column_n < SPLITTER_COLUMNS; column_n++)
+                {
+                    ImGui::TableSetColumnIndex(column_n);
+                    ImGui::Text("%d,%d", column_n, row_n);
+                }
+            }
+            ImGui::EndTable();
+        }
+        ImGui::End();
+        ImGui::Render();
+    });
+    printf("%-26s %10.4f (ms/frame)\n", "table frame", frame_ms);
+
+    ImGui::DestroyContext();
+    return ok;
+}
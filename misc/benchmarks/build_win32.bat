@@ -0,0 +1,3 @@
+@REM Build for Visual Studio compiler. Run your copy of vcvars32.bat or vcvarsall.bat to setup command-line compiler.
+mkdir Release
+cl /nologo /Zi /MD /O2 /utf-8 /I ..\.. %* *.cpp ..\..\imgui.cpp ..\..\imgui_draw.cpp ..\..\imgui_tables.cpp ..\..\imgui_widgets.cpp /FeRelease/imgui_benchmarks.exe /FoRelease/ /link imm32.lib
@@ -0,0 +1,56 @@
+// dear imgui: micro-benchmarks for performance sensitive code paths
+// Usage: imgui_benchmarks [name_filter...]
+// - Run all benchmarks, or those whose name contains one of the filters.
+// - Exit code is 1 when a benchmark detected an error, so this can also run as a test.
+// - Build with optimizations (see Makefile and build_win32.bat). Each benchmark is in its own bench_xxx.cpp file.
+
+#include "imgui.h"
+#include "imgui_benchmarks.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+double BenchmarkGetTime()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct BenchmarkEntry
+{
+    const char* Name;
+    bool        (*Func)();
+};
+
+static const BenchmarkEntry Benchmarks[] =
+{
+    { "concave_fill",           Benchmark_ConcaveFill },
+    { "detached_draw_lists",    Benchmark_DetachedDrawLists },
+    { "draw_list_fragment",     Benchmark_DrawListFragment },
+    { "font_atlas_build",       Benchmark_FontAtlasBuild },
+    { "polyline",               Benchmark_Polyline },
+    { "shade_verts",            Benchmark_ShadeVerts },
+    { "splitter_merge",         Benchmark_SplitterMerge },
+};
+
+int main(int argc, char** argv)
+{
+    IMGUI_CHECKVERSION();
+    int failed_count = 0;
+    for (const BenchmarkEntry& benchmark : Benchmarks)
+    {
+        bool selected = (argc <= 1);
+        for (int n = 1; n < argc; n++)
+            if (strstr(benchmark.Name, argv[n]) != nullptr)
+                selected = true;
+        if (!selected)
+            continue;
+        printf("[%s]\n", benchmark.Name);
+        if (!benchmark.Func())
+        {
+            printf("[%s] FAILED\n", benchmark.Name);
+            failed_count++;
+        }
+        printf("\n");
+    }
+    return (failed_count > 0) ? 1 : 0;
+}
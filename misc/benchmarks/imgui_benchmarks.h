@@ -0,0 +1,34 @@
+// dear imgui: micro-benchmarks for performance sensitive code paths
+// See imgui_benchmarks.cpp for usage.
+
+#pragma once
+
+// Time in milliseconds, from a monotonic clock
+double BenchmarkGetTime();
+
+// Call 'func' once to warm up, then repeatedly for at least 'min_ms' milliseconds. Return average duration of a call in milliseconds.
+template<typename T>
+double BenchmarkMeasure(T func, double min_ms = 200.0)
+{
+    func();
+    int calls_count = 0;
+    const double t0 = BenchmarkGetTime();
+    double t1 = t0;
+    do
+    {
+        func();
+        calls_count++;
+        t1 = BenchmarkGetTime();
+    }
+    while (t1 - t0 < min_ms);
+    return (t1 - t0) / calls_count;
+}
+
+// Benchmarks: print their results, return false if they detected an error (e.g. mismatching output between two code paths)
+bool Benchmark_ConcaveFill();
+bool Benchmark_DetachedDrawLists();
+bool Benchmark_DrawListFragment();
+bool Benchmark_FontAtlasBuild();
+bool Benchmark_Polyline();
+bool Benchmark_ShadeVerts();
+bool Benchmark_SplitterMerge();
@@ -0,0 +1,600 @@
+// dear imgui: binary stream writer/reader for ImDrawData (e.g. remote rendering)
+// (code)
+
+// Message layout (little-endian):
+//   u32     message size in bytes (including this field)
+//   u32     magic 'IMDS'
+//   u8      version, u8 sizeof(ImDrawVert), u8 sizeof(ImDrawIdx), u8 flags (ImDrawDataStreamFrameFlags_)
+//   u32     frame number, u32 frame number that delta are based on (== previous frame number, unused on key frames)
+//   float   DisplayPos.x/y, DisplaySize.x/y, FramebufferScale.x/y
+//   varint  textures count, for each: u64 id, u32 width, u32 height, u8 bytes per pixel, pixels
+//   varint  draw lists count, for each: u32 id, u8 flags (ImDrawDataStreamListFlags_), then unless unchanged:
+//           4 buffer deltas: commands (ImDrawDataStreamCmd), vertices, indices, instances.
+// Buffer delta:
+//   varint  elements count, followed by runs covering all elements:
+//   varint  (run_length << 1) | 0: keep previous elements at same offset
+//   varint  (run_length << 1) | 1: followed by run_length elements
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_drawdata_stream.h"
+#include "imgui_internal.h"     // ImHashStr(), ImMin()
+#include <string.h>             // memcpy, memcmp
+
+#define IMDS_MAGIC      0x53444D49  // "IMDS"
+#define IMDS_VERSION    1
+
+enum ImDrawDataStreamFrameFlags_
+{
+    ImDrawDataStreamFrameFlags_KeyFrame     = 1 << 0,
+};
+
+enum ImDrawDataStreamListFlags_
+{
+    ImDrawDataStreamListFlags_Unchanged     = 1 << 0,
+};
+
+enum ImDrawDataStreamCallback_
+{
+    ImDrawDataStreamCallback_None = 0,
+    ImDrawDataStreamCallback_ResetRenderState = 1,
+};
+
+// Serialized ImDrawCmd (no padding, no pointers)
+struct ImDrawDataStreamCmd
+{
+    ImVec4          ClipRect;
+    ImU64           TextureId;
+    unsigned int    VtxOffset;
+    unsigned int    IdxOffset;
+    unsigned int    ElemCount;
+    unsigned int    InstOffset;
+    unsigned int    InstCount;
+    unsigned int    Callback;   // ImDrawDataStreamCallback_
+};
+IM_STATIC_ASSERT(sizeof(ImDrawDataStreamCmd) == 48);
+IM_STATIC_ASSERT(sizeof(ImTextureID) <= sizeof(ImU64));
+
+struct ImDrawDataStreamList
+{
+    ImGuiID                         ID;
+    ImDrawList*                     DrawList;   // Writer: copy of last sent contents. Reader: decoded contents, referenced by DrawData.
+    ImVector<ImDrawDataStreamCmd>   Cmds;       // Last sent/received commands
+
+    ImDrawDataStreamList()  { ID = 0; DrawList = IM_NEW(ImDrawList)(NULL); }
+    ~ImDrawDataStreamList() { IM_DELETE(DrawList); }
+};
+
+//-----------------------------------------------------------------------------
+// Helpers
+//-----------------------------------------------------------------------------
+
+static ImU64 ImDrawDataStream_TexIdToU64(ImTextureID tex_id)
+{
+    ImU64 v = 0;
+    memcpy(&v, &tex_id, sizeof(tex_id));
+    return v;
+}
+
+static ImTextureID ImDrawDataStream_U64ToTexId(ImU64 v)
+{
+    ImTextureID tex_id;
+    memcpy(&tex_id, &v, sizeof(tex_id));
+    return tex_id;
+}
+
+static void ImDrawDataStream_WriteBytes(ImVector<unsigned char>* out, const void* data, size_t size)
+{
+    int off = out->Size;
+    out->resize(off + (int)size);
+    memcpy(out->Data + off, data, size);
+}
+
+static void ImDrawDataStream_WriteU8(ImVector<unsigned char>* out, unsigned int v)      { out->push_back((unsigned char)v); }
+static void ImDrawDataStream_WriteU32(ImVector<unsigned char>* out, ImU32 v)            { ImDrawDataStream_WriteBytes(out, &v, 4); }
+static void ImDrawDataStream_WriteU64(ImVector<unsigned char>* out, ImU64 v)            { ImDrawDataStream_WriteBytes(out, &v, 8); }
+static void ImDrawDataStream_WriteFloat(ImVector<unsigned char>* out, float v)          { ImDrawDataStream_WriteBytes(out, &v, 4); }
+
+static void ImDrawDataStream_WriteVarint(ImVector<unsigned char>* out, ImU32 v)
+{
+    while (v >= 0x80)
+    {
+        out->push_back((unsigned char)(v | 0x80));
+        v >>= 7;
+    }
+    out->push_back((unsigned char)v);
+}
+
+// Write elements of 'curr' as runs of unchanged/changed elements compared to 'prev'
+static void ImDrawDataStream_WriteBufferDelta(ImVector<unsigned char>* out, const void* prev_data, int prev_count, const void* curr_data, int curr_count, int elem_size)
+{
+    const unsigned char* prev = (const unsigned char*)prev_data;
+    const unsigned char* curr = (const unsigned char*)curr_data;
+    const int common_count = ImMin(prev_count, curr_count);
+    ImDrawDataStream_WriteVarint(out, (ImU32)curr_count);
+    int n = 0;
+    while (n < curr_count)
+    {
+        int run_end = n;
+        while (run_end < common_count && memcmp(curr + run_end * elem_size, prev + run_end * elem_size, elem_size) == 0)
+            run_end++;
+        if (run_end > n)
+        {
+            ImDrawDataStream_WriteVarint(out, (ImU32)(run_end - n) << 1);
+            n = run_end;
+            continue;
+        }
+        while (run_end < curr_count && (run_end >= common_count || memcmp(curr + run_end * elem_size, prev + run_end * elem_size, elem_size) != 0))
+            run_end++;
+        ImDrawDataStream_WriteVarint(out, ((ImU32)(run_end - n) << 1) | 1);
+        ImDrawDataStream_WriteBytes(out, curr + n * elem_size, (size_t)(run_end - n) * elem_size);
+        n = run_end;
+    }
+}
+
+template<typename T>
+static bool ImDrawDataStream_BufferEquals(const ImVector<T>& a, const ImVector<T>& b)
+{
+    return a.Size == b.Size && (a.Size == 0 || memcmp(a.Data, b.Data, (size_t)a.Size * sizeof(T)) == 0);
+}
+
+template<typename T>
+static void ImDrawDataStream_BufferCopy(ImVector<T>* dst, const ImVector<T>& src)
+{
+    dst->resize(src.Size);
+    if (src.Size > 0)
+        memcpy(dst->Data, src.Data, (size_t)src.Size * sizeof(T));
+}
+
+// Bounds-checked reading from a message
+struct ImDrawDataStreamCursor
+{
+    const unsigned char*    Data;
+    const unsigned char*    DataEnd;
+    bool                    Error;
+
+    ImDrawDataStreamCursor(const void* data, size_t size) { Data = (const unsigned char*)data; DataEnd = Data + size; Error = false; }
+
+    const unsigned char* ReadBytes(size_t size)
+    {
+        if (Error || (size_t)(DataEnd - Data) < size) { Error = true; return NULL; }
+        const unsigned char* p = Data;
+        Data += size;
+        return p;
+    }
+    unsigned int ReadU8()       { const unsigned char* p = ReadBytes(1); return p ? *p : 0; }
+    ImU32   ReadU32()           { ImU32 v = 0; if (const unsigned char* p = ReadBytes(4)) memcpy(&v, p, 4); return v; }
+    ImU64   ReadU64()           { ImU64 v = 0; if (const unsigned char* p = ReadBytes(8)) memcpy(&v, p, 8); return v; }
+    float   ReadFloat()         { float v = 0.0f; if (const unsigned char* p = ReadBytes(4)) memcpy(&v, p, 4); return v; }
+    ImU32   ReadVarint()
+    {
+        ImU32 v = 0;
+        for (int shift = 0; shift < 32; shift += 7)
+        {
+            const unsigned int b = ReadU8();
+            v |= (ImU32)(b & 0x7F) << shift;
+            if ((b & 0x80) == 0 || Error)
+                return v;
+        }
+        Error = true;
+        return 0;
+    }
+};
+
+// Apply a buffer delta in place: unchanged elements are left untouched, changed ones are copied from the message.
+template<typename T>
+static bool ImDrawDataStream_ReadBufferDelta(ImDrawDataStreamCursor* in, ImVector<T>* buf)
+{
+    const int prev_count = buf->Size;
+    const ImU32 count = in->ReadVarint();
+    if (in->Error || count > (ImU32)prev_count + (size_t)(in->DataEnd - in->Data) / sizeof(T)) // New elements can't be more than message contents
+        return false;
+    buf->resize((int)count);
+    ImU32 n = 0;
+    while (n < count)
+    {
+        const ImU32 op = in->ReadVarint();
+        const ImU32 run = op >> 1;
+        if (in->Error || run == 0 || run > count - n)
+            return false;
+        if (op & 1)
+        {
+            const unsigned char* src = in->ReadBytes((size_t)run * sizeof(T));
+            if (src == NULL)
+                return false;
+            memcpy(buf->Data + n, src, (size_t)run * sizeof(T));
+        }
+        else if (n + run > (ImU32)prev_count)
+        {
+            return false;
+        }
+        n += run;
+    }
+    return true;
+}
+
+static ImDrawDataStreamList* ImDrawDataStream_TakeList(ImVector<ImDrawDataStreamList*>* lists, ImGuiID id, int hint_n)
+{
+    // Lists are generally submitted in the same order as previous frame: try same index first.
+    if (hint_n < lists->Size && (*lists)[hint_n] != NULL && (*lists)[hint_n]->ID == id)
+    {
+        ImDrawDataStreamList* list = (*lists)[hint_n];
+        (*lists)[hint_n] = NULL;
+        return list;
+    }
+    for (ImDrawDataStreamList*& list : *lists)
+        if (list != NULL && list->ID == id)
+        {
+            ImDrawDataStreamList* found = list;
+            list = NULL;
+            return found;
+        }
+    return NULL;
+}
+
+static void ImDrawDataStream_DeleteLists(ImVector<ImDrawDataStreamList*>* lists)
+{
+    for (ImDrawDataStreamList* list : *lists)
+        if (list != NULL)
+            IM_DELETE(list);
+    lists->clear();
+}
+
+static ImDrawDataStreamTexture* ImDrawDataStream_FindTexture(ImVector<ImDrawDataStreamTexture>* textures, ImTextureID id)
+{
+    for (ImDrawDataStreamTexture& tex : *textures)
+        if (memcmp(&tex.ID, &id, sizeof(id)) == 0)
+            return &tex;
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+// ImDrawDataStreamWriter
+//-----------------------------------------------------------------------------
+
+ImDrawDataStreamWriter::ImDrawDataStreamWriter()
+{
+    FrameCount = 0;
+    KeyFrameRequested = false;
+    LastFrameSize = LastFrameRawSize = 0;
+}
+
+ImDrawDataStreamWriter::~ImDrawDataStreamWriter()
+{
+    Clear();
+}
+
+void ImDrawDataStreamWriter::Clear()
+{
+    ImDrawDataStream_DeleteLists(&Lists);
+    Textures.clear_destruct();
+    Buffer.clear();
+    FrameCount = 0;
+    KeyFrameRequested = false;
+}
+
+void ImDrawDataStreamWriter::SetTexture(ImTextureID id, int width, int height, const void* pixels, int bytes_per_pixel)
+{
+    IM_ASSERT(width > 0 && height > 0 && pixels != NULL && (bytes_per_pixel == 1 || bytes_per_pixel == 4));
+    ImDrawDataStreamTexture* tex = ImDrawDataStream_FindTexture(&Textures, id);
+    if (tex == NULL)
+    {
+        Textures.push_back(ImDrawDataStreamTexture());
+        tex = &Textures.back();
+        tex->ID = id;
+    }
+    const int size = width * height * bytes_per_pixel;
+    if (tex->Width == width && tex->Height == height && tex->BytesPerPixel == bytes_per_pixel && memcmp(tex->Pixels.Data, pixels, (size_t)size) == 0)
+        return;
+    tex->Width = width;
+    tex->Height = height;
+    tex->BytesPerPixel = bytes_per_pixel;
+    tex->Pixels.resize(size);
+    memcpy(tex->Pixels.Data, pixels, (size_t)size);
+    tex->Dirty = true;
+}
+
+void ImDrawDataStreamWriter::WriteFrame(const ImDrawData* draw_data, ImDrawDataStreamWriteFunc write_func, void* user_data)
+{
+    IM_ASSERT(draw_data != NULL && write_func != NULL);
+    const bool key_frame = (FrameCount == 0 || KeyFrameRequested);
+    KeyFrameRequested = false;
+
+    // Header
+    ImVector<unsigned char>* out = &Buffer;
+    out->resize(0);
+    ImDrawDataStream_WriteU32(out, 0); // Message size, patched below
+    ImDrawDataStream_WriteU32(out, IMDS_MAGIC);
+    ImDrawDataStream_WriteU8(out, IMDS_VERSION);
+    ImDrawDataStream_WriteU8(out, sizeof(ImDrawVert));
+    ImDrawDataStream_WriteU8(out, sizeof(ImDrawIdx));
+    ImDrawDataStream_WriteU8(out, key_frame ? ImDrawDataStreamFrameFlags_KeyFrame : 0);
+    ImDrawDataStream_WriteU32(out, FrameCount + 1);
+    ImDrawDataStream_WriteU32(out, FrameCount);
+    ImDrawDataStream_WriteFloat(out, draw_data->DisplayPos.x);
+    ImDrawDataStream_WriteFloat(out, draw_data->DisplayPos.y);
+    ImDrawDataStream_WriteFloat(out, draw_data->DisplaySize.x);
+    ImDrawDataStream_WriteFloat(out, draw_data->DisplaySize.y);
+    ImDrawDataStream_WriteFloat(out, draw_data->FramebufferScale.x);
+    ImDrawDataStream_WriteFloat(out, draw_data->FramebufferScale.y);
+
+    // Textures
+    int textures_count = 0;
+    for (ImDrawDataStreamTexture& tex : Textures)
+        if (key_frame || tex.Dirty)
+            textures_count++;
+    ImDrawDataStream_WriteVarint(out, (ImU32)textures_count);
+    for (ImDrawDataStreamTexture& tex : Textures)
+        if (key_frame || tex.Dirty)
+        {
+            ImDrawDataStream_WriteU64(out, ImDrawDataStream_TexIdToU64(tex.ID));
+            ImDrawDataStream_WriteU32(out, (ImU32)tex.Width);
+            ImDrawDataStream_WriteU32(out, (ImU32)tex.Height);
+            ImDrawDataStream_WriteU8(out, (unsigned int)tex.BytesPerPixel);
+            ImDrawDataStream_WriteBytes(out, tex.Pixels.Data, (size_t)tex.Pixels.Size);
+            tex.Dirty = false;
+        }
+
+    // Draw lists
+    if (key_frame)
+        ImDrawDataStream_DeleteLists(&Lists);
+    ImVector<ImDrawDataStreamList*> new_lists;
+    new_lists.reserve(draw_data->CmdListsCount);
+    ImVector<ImDrawDataStreamCmd> cmds;
+    int raw_size = 0;
+    ImDrawDataStream_WriteVarint(out, (ImU32)draw_data->CmdListsCount);
+    for (int list_n = 0; list_n < draw_data->CmdListsCount; list_n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[list_n];
+
+        // Identify draw list by owner name. Disambiguate lists sharing a name (or without a name) by their order.
+        ImGuiID id = draw_list->_OwnerName ? ImHashStr(draw_list->_OwnerName) : 0;
+        for (int prev_n = 0; prev_n < new_lists.Size; prev_n++)
+            if (new_lists[prev_n]->ID == id)
+            {
+                id = ImHashData(&id, sizeof(id), (ImGuiID)list_n);
+                prev_n = -1;
+            }
+
+        // Serialize commands
+        cmds.resize(0);
+        for (const ImDrawCmd& src_cmd : draw_list->CmdBuffer)
+        {
+            if (src_cmd.UserCallback != NULL && src_cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                continue;
+            ImDrawDataStreamCmd cmd;
+            cmd.ClipRect = src_cmd.ClipRect;
+            cmd.TextureId = ImDrawDataStream_TexIdToU64(src_cmd.TextureId);
+            cmd.VtxOffset = src_cmd.VtxOffset;
+            cmd.IdxOffset = src_cmd.IdxOffset;
+            cmd.ElemCount = src_cmd.ElemCount;
+            cmd.InstOffset = src_cmd.InstOffset;
+            cmd.InstCount = src_cmd.InstCount;
+            cmd.Callback = src_cmd.UserCallback ? ImDrawDataStreamCallback_ResetRenderState : ImDrawDataStreamCallback_None;
+            cmds.push_back(cmd);
+        }
+        raw_size += cmds.size_in_bytes() + draw_list->VtxBuffer.size_in_bytes() + draw_list->IdxBuffer.size_in_bytes() + draw_list->InstBuffer.size_in_bytes();
+
+        ImDrawDataStreamList* prev = ImDrawDataStream_TakeList(&Lists, id, list_n);
+        const bool unchanged = prev != NULL
+            && ImDrawDataStream_BufferEquals(cmds, prev->Cmds)
+            && ImDrawDataStream_BufferEquals(draw_list->VtxBuffer, prev->DrawList->VtxBuffer)
+            && ImDrawDataStream_BufferEquals(draw_list->IdxBuffer, prev->DrawList->IdxBuffer)
+            && ImDrawDataStream_BufferEquals(draw_list->InstBuffer, prev->DrawList->InstBuffer);
+        if (prev == NULL)
+        {
+            prev = IM_NEW(ImDrawDataStreamList)();
+            prev->ID = id;
+        }
+        new_lists.push_back(prev);
+
+        ImDrawDataStream_WriteU32(out, id);
+        ImDrawDataStream_WriteU8(out, unchanged ? ImDrawDataStreamListFlags_Unchanged : 0);
+        if (unchanged)
+            continue;
+        ImDrawList* prev_list = prev->DrawList;
+        ImDrawDataStream_WriteBufferDelta(out, prev->Cmds.Data, prev->Cmds.Size, cmds.Data, cmds.Size, sizeof(ImDrawDataStreamCmd));
+        ImDrawDataStream_WriteBufferDelta(out, prev_list->VtxBuffer.Data, prev_list->VtxBuffer.Size, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size, sizeof(ImDrawVert));
+        ImDrawDataStream_WriteBufferDelta(out, prev_list->IdxBuffer.Data, prev_list->IdxBuffer.Size, draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size, sizeof(ImDrawIdx));
+        ImDrawDataStream_WriteBufferDelta(out, prev_list->InstBuffer.Data, prev_list->InstBuffer.Size, draw_list->InstBuffer.Data, draw_list->InstBuffer.Size, sizeof(ImDrawRectInstance));
+        ImDrawDataStream_BufferCopy(&prev->Cmds, cmds);
+        ImDrawDataStream_BufferCopy(&prev_list->VtxBuffer, draw_list->VtxBuffer);
+        ImDrawDataStream_BufferCopy(&prev_list->IdxBuffer, draw_list->IdxBuffer);
+        ImDrawDataStream_BufferCopy(&prev_list->InstBuffer, draw_list->InstBuffer);
+    }
+
+    // Forget about lists which were not submitted this frame
+    ImDrawDataStream_DeleteLists(&Lists);
+    Lists.swap(new_lists);
+
+    const ImU32 message_size = (ImU32)out->Size;
+    memcpy(out->Data, &message_size, 4);
+    FrameCount++;
+    LastFrameSize = out->Size;
+    LastFrameRawSize = raw_size;
+    write_func(out->Data, (size_t)out->Size, user_data);
+}
+
+//-----------------------------------------------------------------------------
+// ImDrawDataStreamReader
+//-----------------------------------------------------------------------------
+
+ImDrawDataStreamReader::ImDrawDataStreamReader()
+{
+    FrameCount = 0;
+    HasKeyFrame = false;
+}
+
+ImDrawDataStreamReader::~ImDrawDataStreamReader()
+{
+    Clear();
+}
+
+void ImDrawDataStreamReader::Clear()
+{
+    DrawData.Clear();
+    ImDrawDataStream_DeleteLists(&Lists);
+    Textures.clear_destruct();
+    FrameCount = 0;
+    HasKeyFrame = false;
+}
+
+ImDrawDataStreamTexture* ImDrawDataStreamReader::FindTexture(ImTextureID id)
+{
+    return ImDrawDataStream_FindTexture(&Textures, id);
+}
+
+bool ImDrawDataStreamReader::ReadFrame(const void* data, size_t size)
+{
+    // Header
+    ImDrawDataStreamCursor in(data, size);
+    const ImU32 message_size = in.ReadU32();
+    const ImU32 magic = in.ReadU32();
+    const unsigned int version = in.ReadU8();
+    const unsigned int sizeof_vtx = in.ReadU8();
+    const unsigned int sizeof_idx = in.ReadU8();
+    const unsigned int frame_flags = in.ReadU8();
+    const ImU32 frame_count = in.ReadU32();
+    const ImU32 base_frame_count = in.ReadU32();
+    if (in.Error || message_size != size || magic != IMDS_MAGIC || version != IMDS_VERSION)
+        return false;
+    if (sizeof_vtx != sizeof(ImDrawVert) || sizeof_idx != sizeof(ImDrawIdx))
+        return false; // ImDrawVert/ImDrawIdx layout differ between sender and receiver!
+    const bool key_frame = (frame_flags & ImDrawDataStreamFrameFlags_KeyFrame) != 0;
+    if (!key_frame && (!HasKeyFrame || base_frame_count != FrameCount))
+        return false; // Missing frame: need a key frame.
+
+    // From this point the previous frame is lost if the message is malformed.
+    HasKeyFrame = false;
+    const ImVec2 prev_display_pos = DrawData.DisplayPos;
+    const ImVec2 prev_display_size = DrawData.DisplaySize;
+    const ImVec2 prev_framebuffer_scale = DrawData.FramebufferScale;
+    DrawData.Clear();
+    DrawData.DisplayPos.x = in.ReadFloat();
+    DrawData.DisplayPos.y = in.ReadFloat();
+    DrawData.DisplaySize.x = in.ReadFloat();
+    DrawData.DisplaySize.y = in.ReadFloat();
+    DrawData.FramebufferScale.x = in.ReadFloat();
+    DrawData.FramebufferScale.y = in.ReadFloat();
+
+    // Textures
+    for (ImDrawDataStreamTexture& tex : Textures)
+        tex.Dirty = false;
+    const ImU32 textures_count = in.ReadVarint();
+    for (ImU32 tex_n = 0; tex_n < textures_count && !in.Error; tex_n++)
+    {
+        const ImTextureID tex_id = ImDrawDataStream_U64ToTexId(in.ReadU64());
+        const ImU32 width = in.ReadU32();
+        const ImU32 height = in.ReadU32();
+        const unsigned int bytes_per_pixel = in.ReadU8();
+        if (in.Error || (bytes_per_pixel != 1 && bytes_per_pixel != 4) || width == 0 || height == 0 || width > 0x8000 || height > 0x8000)
+            return false;
+        const unsigned char* pixels = in.ReadBytes((size_t)width * height * bytes_per_pixel);
+        if (pixels == NULL)
+            return false;
+        ImDrawDataStreamTexture* tex = FindTexture(tex_id);
+        if (tex == NULL)
+        {
+            Textures.push_back(ImDrawDataStreamTexture());
+            tex = &Textures.back();
+            tex->ID = tex_id;
+        }
+        tex->Width = (int)width;
+        tex->Height = (int)height;
+        tex->BytesPerPixel = (int)bytes_per_pixel;
+        tex->Pixels.resize((int)(width * height * bytes_per_pixel));
+        memcpy(tex->Pixels.Data, pixels, (size_t)tex->Pixels.Size);
+        tex->Dirty = true;
+    }
+
+    // Draw lists
+    if (key_frame)
+        ImDrawDataStream_DeleteLists(&Lists);
+    ImVector<ImDrawDataStreamList*> new_lists;
+    const ImU32 lists_count = in.ReadVarint();
+    bool all_unchanged = !key_frame && textures_count == 0;
+    all_unchanged &= (DrawData.DisplayPos.x == prev_display_pos.x && DrawData.DisplayPos.y == prev_display_pos.y && DrawData.DisplaySize.x == prev_display_size.x && DrawData.DisplaySize.y == prev_display_size.y);
+    all_unchanged &= (DrawData.FramebufferScale.x == prev_framebuffer_scale.x && DrawData.FramebufferScale.y == prev_framebuffer_scale.y);
+    for (ImU32 list_n = 0; list_n < lists_count && !in.Error; list_n++)
+    {
+        const ImGuiID id = in.ReadU32();
+        const unsigned int list_flags = in.ReadU8();
+        ImDrawDataStreamList* list = ImDrawDataStream_TakeList(&Lists, id, (int)list_n);
+        const bool unchanged = (list_flags & ImDrawDataStreamListFlags_Unchanged) != 0;
+        if (list == NULL && (unchanged || in.Error))
+            break;
+        if (list == NULL)
+        {
+            list = IM_NEW(ImDrawDataStreamList)();
+            list->ID = id;
+        }
+        new_lists.push_back(list);
+
+        ImDrawList* draw_list = list->DrawList;
+        draw_list->ContentUnchanged = unchanged;
+        all_unchanged &= unchanged;
+        if (unchanged)
+            continue;
+        if (!ImDrawDataStream_ReadBufferDelta(&in, &list->Cmds) ||
+            !ImDrawDataStream_ReadBufferDelta(&in, &draw_list->VtxBuffer) ||
+            !ImDrawDataStream_ReadBufferDelta(&in, &draw_list->IdxBuffer) ||
+            !ImDrawDataStream_ReadBufferDelta(&in, &draw_list->InstBuffer))
+        {
+            in.Error = true;
+            break;
+        }
+
+        // Rebuild commands, validating ranges so a renderer can't read out of bounds
+        draw_list->CmdBuffer.resize(list->Cmds.Size);
+        for (int cmd_n = 0; cmd_n < list->Cmds.Size; cmd_n++)
+        {
+            const ImDrawDataStreamCmd& src_cmd = list->Cmds[cmd_n];
+            if ((ImU64)src_cmd.IdxOffset + src_cmd.ElemCount > (ImU64)draw_list->IdxBuffer.Size || src_cmd.VtxOffset > (unsigned int)draw_list->VtxBuffer.Size ||
+                (ImU64)src_cmd.InstOffset + src_cmd.InstCount > (ImU64)draw_list->InstBuffer.Size || src_cmd.Callback > ImDrawDataStreamCallback_ResetRenderState)
+            {
+                in.Error = true;
+                break;
+            }
+            const ImDrawIdx* idx = draw_list->IdxBuffer.Data + src_cmd.IdxOffset;
+            for (unsigned int idx_n = 0; idx_n < src_cmd.ElemCount; idx_n++)
+                if ((unsigned int)idx[idx_n] >= (unsigned int)draw_list->VtxBuffer.Size - src_cmd.VtxOffset)
+                    in.Error = true;
+            if (in.Error)
+                break;
+            ImDrawCmd& cmd = draw_list->CmdBuffer[cmd_n];
+            cmd = ImDrawCmd();
+            cmd.ClipRect = src_cmd.ClipRect;
+            cmd.TextureId = ImDrawDataStream_U64ToTexId(src_cmd.TextureId);
+            cmd.VtxOffset = src_cmd.VtxOffset;
+            cmd.IdxOffset = src_cmd.IdxOffset;
+            cmd.ElemCount = src_cmd.ElemCount;
+            cmd.InstOffset = src_cmd.InstOffset;
+            cmd.InstCount = src_cmd.InstCount;
+            cmd.UserCallback = (src_cmd.Callback == ImDrawDataStreamCallback_ResetRenderState) ? ImDrawCallback_ResetRenderState : NULL;
+        }
+    }
+    ImDrawDataStream_DeleteLists(&Lists);
+    Lists.swap(new_lists);
+    if (in.Error || (ImU32)Lists.Size != lists_count || in.Data != in.DataEnd)
+    {
+        ImDrawDataStream_DeleteLists(&Lists);
+        return false;
+    }
+
+    // Expose decoded lists
+    for (ImDrawDataStreamList* list : Lists)
+    {
+        DrawData.CmdLists.push_back(list->DrawList);
+        DrawData.TotalVtxCount += list->DrawList->VtxBuffer.Size;
+        DrawData.TotalIdxCount += list->DrawList->IdxBuffer.Size;
+        DrawData.TotalInstCount += list->DrawList->InstBuffer.Size;
+    }
+    DrawData.CmdListsCount = Lists.Size;
+    DrawData.ContentUnchanged = all_unchanged;
+    DrawData.Valid = true;
+    FrameCount = frame_count;
+    HasKeyFrame = true;
+    return true;
+}
+
+#endif // #ifndef IMGUI_DISABLE
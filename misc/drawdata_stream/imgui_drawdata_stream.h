@@ -0,0 +1,81 @@
+// dear imgui: binary stream writer/reader for ImDrawData (e.g. remote rendering)
+// (headers)
+
+// Usage:
+// - Sending side (e.g. headless application):
+//     ImDrawDataStreamWriter writer;
+//     writer.SetTexture(io.Fonts->TexID, tex_w, tex_h, tex_pixels, 4);     // Font atlas and other textures used by your ImDrawCmd. Only sent when contents changed.
+//     [every frame] ImGui::Render(); writer.WriteFrame(ImGui::GetDrawData(), MyWriteFunc, &my_connection);
+// - Receiving side:
+//     ImDrawDataStreamReader reader;
+//     [for every message] if (reader.ReadFrame(data, size)) { UploadDirtyTextures(reader.Textures); MyRenderDrawData(&reader.DrawData); }
+//     ImDrawCmd::TextureId values are the ones of the sending side: map them to your textures (see ImDrawDataStreamTexture).
+
+// About the format:
+// - WriteFrame() calls 'write_func' once per frame with a whole message. Messages start with their size (4 bytes),
+//   so you may also write them into a byte stream (e.g. TCP socket) and split them on the receiving side.
+// - Draw lists are identified by their owner name (e.g. window name). Only differences with the previous frame are sent:
+//   unchanged draw lists take a few bytes, other buffers are sent as runs of unchanged/changed elements.
+// - ReadFrame() decodes changed elements directly into the ImDrawList buffers it owns: unchanged data is not touched.
+// - If a message is lost or the reader is recreated, ReadFrame() returns false until a key frame is received:
+//   call writer.RequestKeyFrame() to send one (e.g. when a new client connects).
+// - Both sides need the same ImDrawVert layout, ImDrawIdx size and endianness. This is checked by ReadFrame().
+// - User callbacks cannot be transmitted: only ImDrawCallback_ResetRenderState is, other callbacks are dropped.
+
+#pragma once
+#include "imgui.h"      // IMGUI_API, ImDrawData
+#ifndef IMGUI_DISABLE
+
+// Called by WriteFrame() with a whole message
+typedef void (*ImDrawDataStreamWriteFunc)(const void* data, size_t size, void* user_data);
+
+// A texture used by transmitted draw commands (e.g. font atlas)
+struct ImDrawDataStreamTexture
+{
+    ImTextureID             ID;             // Texture identifier on the sending side
+    int                     Width;
+    int                     Height;
+    int                     BytesPerPixel;  // 1 (Alpha8) or 4 (RGBA32)
+    ImVector<unsigned char> Pixels;
+    bool                    Dirty;          // Writer: needs to be sent. Reader: received during last ReadFrame(), you need to (re)create your texture.
+
+    ImDrawDataStreamTexture() { ID = ImTextureID(); Width = Height = BytesPerPixel = 0; Dirty = false; }
+};
+
+// [Internal] Draw list contents from previous frame, for delta encoding/decoding
+struct ImDrawDataStreamList;
+
+struct ImDrawDataStreamWriter
+{
+    ImVector<ImDrawDataStreamList*>     Lists;          // Draw lists sent in last frame
+    ImVector<ImDrawDataStreamTexture>   Textures;
+    ImVector<unsigned char>             Buffer;         // Message being built
+    unsigned int                        FrameCount;     // Number of frames written
+    bool                                KeyFrameRequested;
+    int                                 LastFrameSize;  // Size of last message, in bytes
+    int                                 LastFrameRawSize; // Size of commands, vertices, indices and instances of last frame, in bytes (for comparison)
+
+    IMGUI_API ImDrawDataStreamWriter();
+    IMGUI_API ~ImDrawDataStreamWriter();
+    IMGUI_API void  Clear();
+    void            RequestKeyFrame()   { KeyFrameRequested = true; }   // Next frame will be sent in full, along with all textures
+    IMGUI_API void  SetTexture(ImTextureID id, int width, int height, const void* pixels, int bytes_per_pixel); // Pixels are copied and compared with previous call
+    IMGUI_API void  WriteFrame(const ImDrawData* draw_data, ImDrawDataStreamWriteFunc write_func, void* user_data);
+};
+
+struct ImDrawDataStreamReader
+{
+    ImDrawData                          DrawData;       // Last decoded frame, valid after ReadFrame() returned true. Draw lists are owned by the reader.
+    ImVector<ImDrawDataStreamList*>     Lists;
+    ImVector<ImDrawDataStreamTexture>   Textures;
+    unsigned int                        FrameCount;     // Frame number of DrawData on the sending side
+    bool                                HasKeyFrame;    // False until a key frame is received, or after an error
+
+    IMGUI_API ImDrawDataStreamReader();
+    IMGUI_API ~ImDrawDataStreamReader();
+    IMGUI_API void  Clear();
+    IMGUI_API bool  ReadFrame(const void* data, size_t size); // Decode a whole message. Return false if malformed or not applicable (missing key frame).
+    IMGUI_API ImDrawDataStreamTexture* FindTexture(ImTextureID id);
+};
+
+#endif // #ifndef IMGUI_DISABLE
@@ -6,6 +6,7 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2025/02/24: added support for ImFontAtlasFlags_DynamicGlyphs (glyphs loaded on demand). FreeType library and faces are kept alive until the atlas is rebuilt or cleared.
 //  2024/10/17: added plutosvg support for SVG Fonts (seems faster/better than lunasvg). Enable by using '#define IMGUI_ENABLE_FREETYPE_PLUTOSVG'. (#7927)
 //  2023/11/13: added support for ImFontConfig::RasterizationDensity field for scaling render density without scaling metrics.
 //  2023/08/01: added support for SVG fonts, enable by using '#define IMGUI_ENABLE_FREETYPE_LUNASVG'. (#6591)
@@ -441,9 +442,21 @@ struct ImFontBuildDstDataFT
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// Persistent data for glyphs loaded on demand (ImFontAtlasFlags_DynamicGlyphs), stored in atlas->DynamicData->BuilderData
+struct ImFontBuildDynamicDataFT
+{
+    FT_MemoryRec_       MemoryRec;          // Needs to outlive Library
+    FT_Library          Library;
+    ImVector<FreeTypeFont> Fonts;           // Index into atlas->ConfigData[]
+    ImVector<unsigned int> BitmapBuffer;    // Temporary buffer for BlitGlyph()
+
+    ImFontBuildDynamicDataFT() { memset((void*)&MemoryRec, 0, sizeof(MemoryRec)); Library = nullptr; }
+};
+
 bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, unsigned int extra_flags)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
+    IM_ASSERT(!(atlas->Flags & ImFontAtlasFlags_SignedDistanceField) && "ImFontAtlasFlags_SignedDistanceField is not supported by the FreeType builder yet, use the stb_truetype builder.");
 
     ImFontAtlasBuildInit(atlas);
 
@@ -510,11 +523,14 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
         if (dst_tmp.GlyphsSet.Storage.empty())
             dst_tmp.GlyphsSet.Create(dst_tmp.GlyphsHighest + 1);
 
+        const ImFontConfig& cfg = atlas->ConfigData[src_i];
         for (const ImWchar* src_range = src_tmp.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
             for (int codepoint = src_range[0]; codepoint <= (int)src_range[1]; codepoint++)
             {
                 if (dst_tmp.GlyphsSet.TestBit(codepoint))    // Don't overwrite existing glyphs. We could make this an option (e.g. MergeOverwrite)
                     continue;
+                if (atlas->DynamicData != nullptr && !ImFontAtlasBuildIsPreloadedGlyph(&cfg, codepoint)) // Will be loaded on demand
+                    continue;
                 uint32_t glyph_index = FT_Get_Char_Index(src_tmp.Font.Face, codepoint); // It is actually in the font? (FIXME-OPT: We are not storing the glyph_index..)
                 if (glyph_index == 0)
                     continue;
@@ -633,6 +649,8 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
     atlas->TexHeight = 0;
     if (atlas->TexDesiredWidth > 0)
         atlas->TexWidth = atlas->TexDesiredWidth;
+    else if (atlas->DynamicData != nullptr)
+        atlas->TexWidth = 1024; // Leave room for glyphs loaded on demand
     else
         atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
 
@@ -664,6 +682,8 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
 
     // 7. Allocate texture
     atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
+    if (atlas->DynamicData != nullptr)
+        atlas->TexHeight = ImMax(atlas->TexHeight, atlas->TexWidth);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     if (src_load_color)
     {
@@ -755,6 +775,18 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
     }
     atlas->TexPixelsUseColors = tex_use_colors;
 
+    // Keep faces alive for glyphs loaded on demand
+    if (atlas->DynamicData != nullptr && atlas->DynamicData->BuilderData != nullptr)
+    {
+        ImFontBuildDynamicDataFT* bd = (ImFontBuildDynamicDataFT*)atlas->DynamicData->BuilderData;
+        bd->Fonts.resize(src_tmp_array.Size);
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        {
+            bd->Fonts[src_i] = src_tmp_array[src_i].Font;
+            src_tmp_array[src_i].Font.Face = nullptr; // Ownership transferred
+        }
+    }
+
     // Cleanup
     for (int buf_i = 0; buf_i < buf_bitmap_buffers.Size; buf_i++)
         IM_FREE(buf_bitmap_buffers[buf_i]);
@@ -801,8 +833,12 @@ static void* FreeType_Realloc(FT_Memory /*memory*/, long cur_size, long new_size
 
 static bool ImFontAtlasBuildWithFreeType(ImFontAtlas* atlas)
 {
+    // With ImFontAtlasFlags_DynamicGlyphs, library and faces are kept alive for glyphs loaded on demand
+    ImFontBuildDynamicDataFT* dynamic_data = (atlas->DynamicData != nullptr) ? IM_NEW(ImFontBuildDynamicDataFT)() : nullptr;
+
     // FreeType memory management: https://www.freetype.org/freetype2/docs/design/design-4.html
-    FT_MemoryRec_ memory_rec = {};
+    FT_MemoryRec_ local_memory_rec = {};
+    FT_MemoryRec_& memory_rec = dynamic_data ? dynamic_data->MemoryRec : local_memory_rec;
     memory_rec.user = nullptr;
     memory_rec.alloc = &FreeType_Alloc;
     memory_rec.free = &FreeType_Free;
@@ -812,7 +848,10 @@ static bool ImFontAtlasBuildWithFreeType(ImFontAtlas* atlas)
     FT_Library ft_library;
     FT_Error error = FT_New_Library(&memory_rec, &ft_library);
     if (error != 0)
+    {
+        IM_DELETE(dynamic_data);
         return false;
+    }
 
     // If you don't call FT_Add_Default_Modules() the rest of code may work, but FreeType won't use our custom allocator.
     FT_Add_Default_Modules(ft_library);
@@ -829,16 +868,146 @@ static bool ImFontAtlasBuildWithFreeType(ImFontAtlas* atlas)
     FT_Property_Set(ft_library, "ot-svg", "svg-hooks", plutosvg_ft_svg_hooks());
 #endif // IMGUI_ENABLE_FREETYPE_PLUTOSVG
 
+    if (dynamic_data != nullptr)
+    {
+        dynamic_data->Library = ft_library;
+        atlas->DynamicData->BuilderData = dynamic_data; // Released by ImFontAtlasDestroyDataWithFreeType()
+    }
     bool ret = ImFontAtlasBuildWithFreeTypeEx(ft_library, atlas, atlas->FontBuilderFlags);
-    FT_Done_Library(ft_library);
+    if (dynamic_data == nullptr)
+        FT_Done_Library(ft_library);
 
     return ret;
 }
 
+// Rasterize a single glyph into free texture space (ImFontAtlasFlags_DynamicGlyphs).
+// Same as steps 4-9 of ImFontAtlasBuildWithFreeTypeEx(), so glyphs are identical to baked ones.
+static bool ImFontAtlasLoadGlyphWithFreeType(ImFontAtlas* atlas, ImFont* font, ImWchar codepoint)
+{
+    ImFontBuildDynamicDataFT* bd = (ImFontBuildDynamicDataFT*)atlas->DynamicData->BuilderData;
+    if (bd == nullptr || bd->Fonts.Size != atlas->ConfigData.Size)
+        return false;
+    for (int cfg_n = 0; cfg_n < font->ConfigDataCount; cfg_n++)
+    {
+        // First source providing the glyph wins (same as merging rules in ImFontAtlasBuildWithFreeTypeEx())
+        const ImFontConfig& cfg = font->ConfigData[cfg_n];
+        FreeTypeFont& font_face = bd->Fonts[(int)(&cfg - atlas->ConfigData.Data)];
+        if (!ImFontAtlasBuildIsInGlyphRanges(atlas, &cfg, codepoint) || FT_Get_Char_Index(font_face.Face, codepoint) == 0)
+            continue;
+
+        // Render glyph into a bitmap (currently held by FreeType)
+        GlyphInfo info;
+        const FT_Glyph_Metrics* metrics = font_face.LoadGlyph(codepoint);
+        const FT_Bitmap* ft_bitmap = metrics ? font_face.RenderGlyphAndGetInfo(&info) : nullptr;
+        if (ft_bitmap == nullptr)
+            return false;
+
+        // Allocate texture space (empty glyphs don't need any)
+        const int padding = atlas->TexGlyphPadding;
+        int slot_n = -1;
+        int tx = 0, ty = 0;
+        if (info.Width + padding > 0 && info.Height + padding > 0)
+        {
+            slot_n = ImFontAtlasDynamicAllocRect(atlas, info.Width + padding, info.Height + padding);
+            if (slot_n == -1)
+                return false;
+            tx = atlas->DynamicData->Slots[slot_n].X + padding;
+            ty = atlas->DynamicData->Slots[slot_n].Y + padding;
+        }
+
+        // Blit to temporary buffer, then to texture
+        if (info.Width > 0 && info.Height > 0)
+        {
+            unsigned char multiply_table[256];
+            const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
+            if (multiply_enabled)
+                ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+            bd->BitmapBuffer.resize(info.Width * info.Height);
+            font_face.BlitGlyph(ft_bitmap, bd->BitmapBuffer.Data, info.Width, multiply_enabled ? multiply_table : nullptr);
+
+            size_t blit_src_stride = (size_t)info.Width;
+            size_t blit_dst_stride = (size_t)atlas->TexWidth;
+            const unsigned int* blit_src = bd->BitmapBuffer.Data;
+            if (atlas->TexPixelsAlpha8 != nullptr)
+            {
+                unsigned char* blit_dst = atlas->TexPixelsAlpha8 + (ty * blit_dst_stride) + tx;
+                for (int y = 0; y < info.Height; y++, blit_dst += blit_dst_stride, blit_src += blit_src_stride)
+                    for (int x = 0; x < info.Width; x++)
+                        blit_dst[x] = (unsigned char)((blit_src[x] >> IM_COL32_A_SHIFT) & 0xFF);
+            }
+            else
+            {
+                unsigned int* blit_dst = atlas->TexPixelsRGBA32 + (ty * blit_dst_stride) + tx;
+                for (int y = 0; y < info.Height; y++, blit_dst += blit_dst_stride, blit_src += blit_src_stride)
+                    for (int x = 0; x < info.Width; x++)
+                        blit_dst[x] = blit_src[x];
+            }
+        }
+
+        // Register glyph
+        const float font_off_x = cfg.GlyphOffset.x;
+        const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(font->Ascent);
+        float x0 = info.OffsetX * font_face.InvRasterizationDensity + font_off_x;
+        float y0 = info.OffsetY * font_face.InvRasterizationDensity + font_off_y;
+        float x1 = x0 + info.Width * font_face.InvRasterizationDensity;
+        float y1 = y0 + info.Height * font_face.InvRasterizationDensity;
+        float u0 = (tx) / (float)atlas->TexWidth;
+        float v0 = (ty) / (float)atlas->TexHeight;
+        float u1 = (tx + info.Width) / (float)atlas->TexWidth;
+        float v1 = (ty + info.Height) / (float)atlas->TexHeight;
+        ImFontGlyph* dst_glyph = ImFontAtlasDynamicAddGlyph(atlas, slot_n, font, &cfg, codepoint, x0, y0, x1, y1, u0, v0, u1, v1, info.AdvanceX * font_face.InvRasterizationDensity);
+        if (info.IsColored)
+            dst_glyph->Colored = atlas->TexPixelsUseColors = true;
+        return true;
+    }
+    return false;
+}
+
+static void ImFontAtlasDestroyDataWithFreeType(ImFontAtlas* atlas)
+{
+    ImFontBuildDynamicDataFT* bd = (ImFontBuildDynamicDataFT*)atlas->DynamicData->BuilderData;
+    for (FreeTypeFont& font_face : bd->Fonts)
+        font_face.CloseFont();
+    FT_Done_Library(bd->Library);
+    IM_DELETE(bd);
+}
+
+// Runtime version of the FreeType library (which may be a shared library updated independently of us), and SVG renderer.
+// Part of the hash identifying ImFontAtlas::CacheFilename contents.
+static const char* ImFontAtlasGetVersionWithFreeType()
+{
+    static char version[64] = "";
+    if (version[0] != 0)
+        return version;
+    FT_Int major = 0, minor = 0, patch = 0;
+    FT_MemoryRec_ memory_rec = {};
+    memory_rec.alloc = &FreeType_Alloc;
+    memory_rec.free = &FreeType_Free;
+    memory_rec.realloc = &FreeType_Realloc;
+    FT_Library ft_library;
+    if (FT_New_Library(&memory_rec, &ft_library) == 0)
+    {
+        FT_Library_Version(ft_library, &major, &minor, &patch);
+        FT_Done_Library(ft_library);
+    }
+    const char* svg_renderer = "";
+#if defined(IMGUI_ENABLE_FREETYPE_LUNASVG)
+    svg_renderer = " lunasvg";
+#elif defined(IMGUI_ENABLE_FREETYPE_PLUTOSVG)
+    svg_renderer = " plutosvg";
+#endif
+    ImFormatString(version, IM_ARRAYSIZE(version), "%d.%d.%d%s", (int)major, (int)minor, (int)patch, svg_renderer);
+    return version;
+}
+
 const ImFontBuilderIO* ImGuiFreeType::GetBuilderForFreeType()
 {
     static ImFontBuilderIO io;
     io.FontBuilder_Build = ImFontAtlasBuildWithFreeType;
+    io.FontBuilder_Name = "imgui_freetype";
+    io.FontBuilder_Version = ImFontAtlasGetVersionWithFreeType();
+    io.FontBuilder_LoadGlyph = ImFontAtlasLoadGlyphWithFreeType;
+    io.FontBuilder_DestroyData = ImFontAtlasDestroyDataWithFreeType;
     return &io;
 }
 